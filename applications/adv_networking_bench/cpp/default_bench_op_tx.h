@@ -192,64 +192,56 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
       return;
     }
 
-    // For HDS mode or CPU mode populate the packet headers
-    for (int num_pkt = 0; num_pkt < adv_net_get_num_pkts(msg); num_pkt++) {
-      if (!gpu_direct_.get() || hds_.get() > 0) {
-        if ((ret = adv_net_set_eth_hdr(msg, num_pkt, eth_dst_)) != AdvNetStatus::SUCCESS) {
-          HOLOSCAN_LOG_ERROR("Failed to set Ethernet header for packet {}", num_pkt);
-          adv_net_free_all_pkts_and_burst(msg);
-          return;
-        }
-
-        // Remove Eth + IP size
-        const auto ip_len = payload_size_.get() + header_size_.get() - (14 + 20);
-        if ((ret = adv_net_set_ipv4_hdr(msg, num_pkt, ip_len, 17, ip_src_, ip_dst_)) !=
+    // For HDS mode or CPU mode stamp the queue's header template onto the whole burst
+    if (!gpu_direct_.get() || hds_.get() > 0) {
+      if (!hdr_template_set_) {
+        AdvNetUdpTxTemplate tmpl;
+        memcpy(tmpl.eth_dst, eth_dst_, sizeof(tmpl.eth_dst));
+        tmpl.ip_src = ip_src_;
+        tmpl.ip_dst = ip_dst_;
+        tmpl.udp_src = udp_src_port_.get();
+        tmpl.udp_dst = udp_dst_port_.get();
+        tmpl.hds_len = hds_.get();
+        if ((ret = adv_net_set_udp_tx_template(port_id_, queue_id, tmpl)) !=
             AdvNetStatus::SUCCESS) {
-          HOLOSCAN_LOG_ERROR("Failed to set IP header for packet {}", 0);
+          HOLOSCAN_LOG_ERROR("Failed to register UDP header template");
           adv_net_free_all_pkts_and_burst(msg);
           return;
         }
+        hdr_template_set_ = true;
+      }
+
+      // Remove Eth + IP + UDP headers
+      const uint16_t udp_payload_len = payload_size_.get() + header_size_.get() - (14 + 20 + 8);
+      if ((ret = adv_net_set_udp_hdrs(msg, udp_payload_len)) != AdvNetStatus::SUCCESS) {
+        HOLOSCAN_LOG_ERROR("Failed to set UDP headers: {}", static_cast<int>(ret));
+        adv_net_free_all_pkts_and_burst(msg);
+        return;
+      }
+    }
 
-        if ((ret = adv_net_set_udp_hdr(msg,
-                                       num_pkt,
-                                       // Remove Eth + IP + UDP headers
-                                       payload_size_.get() + header_size_.get() - (14 + 20 + 8),
-                                       udp_src_port_.get(),
-                                       udp_dst_port_.get())) != AdvNetStatus::SUCCESS) {
-          HOLOSCAN_LOG_ERROR("Failed to set UDP header for packet {}", 0);
+    for (int num_pkt = 0; num_pkt < adv_net_get_num_pkts(msg); num_pkt++) {
+      // Only set payload on CPU buffer if we're not in HDS mode
+      if (!gpu_direct_.get() && hds_.get() == 0) {
+        if ((ret = adv_net_set_udp_payload(
+                 msg,
+                 num_pkt,
+                 static_cast<char*>(full_batch_data_h_) + num_pkt * payload_size_.get(),
+                 payload_size_.get())) != AdvNetStatus::SUCCESS) {
+          HOLOSCAN_LOG_ERROR("Failed to set UDP payload for packet {}", num_pkt);
           adv_net_free_all_pkts_and_burst(msg);
           return;
         }
-
-        // Only set payload on CPU buffer if we're not in HDS mode
-        if (hds_.get() == 0) {
-          if ((ret = adv_net_set_udp_payload(
-                   msg,
-                   num_pkt,
-                   static_cast<char*>(full_batch_data_h_) + num_pkt * payload_size_.get(),
-                   payload_size_.get())) != AdvNetStatus::SUCCESS) {
-            HOLOSCAN_LOG_ERROR("Failed to set UDP payload for packet {}", num_pkt);
-            adv_net_free_all_pkts_and_burst(msg);
-            return;
-          }
-        }
       }
 
-      // Figure out the CPU and GPU length portions for ANO
+      // Lengths of CPU and HDS packets were set with the headers. GPU-only packets still need
+      // theirs set here
       if (gpu_direct_.get() && hds_.get() > 0) {
         gpu_bufs[cur_idx][num_pkt] =
             reinterpret_cast<uint8_t*>(adv_net_get_seg_pkt_ptr(msg, 1, num_pkt));
-        if ((ret = adv_net_set_pkt_lens(msg, num_pkt, {hds_.get(), payload_size_.get()})) !=
-            AdvNetStatus::SUCCESS) {
-          HOLOSCAN_LOG_ERROR("Failed to set lengths for packet {}", num_pkt);
-          adv_net_free_all_pkts_and_burst(msg);
-          return;
-        }
-      } else {
-        if (gpu_direct_.get()) {
-          gpu_bufs[cur_idx][num_pkt] =
-              reinterpret_cast<uint8_t*>(adv_net_get_seg_pkt_ptr(msg, 0, num_pkt));
-        }
+      } else if (gpu_direct_.get()) {
+        gpu_bufs[cur_idx][num_pkt] =
+            reinterpret_cast<uint8_t*>(adv_net_get_seg_pkt_ptr(msg, 0, num_pkt));
 
         if ((ret =
                  adv_net_set_pkt_lens(msg, num_pkt, {payload_size_.get() + header_size_.get()})) !=
@@ -316,6 +308,7 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
   void* gds_header_;
   int cur_idx = 0;
   int port_id_;
+  bool hdr_template_set_ = false;
   Parameter<int> hds_;          // Header-data split point
   Parameter<bool> gpu_direct_;  // GPUDirect enabled
   Parameter<uint32_t> batch_size_;
@@ -14,7 +14,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#if ANO_MGR_DPDK || ANO_MGR_RIVERMAX
+#if ANO_MGR_DPDK || ANO_MGR_RIVERMAX || ANO_MGR_SOCKET
 #include "default_bench_op_rx.h"
 #include "default_bench_op_tx.h"
 #endif
@@ -112,6 +112,31 @@ class App : public holoscan::Application {
 #else
       HOLOSCAN_LOG_ERROR("RIVERMAX ANO manager/backend is not supported");
       exit(1);
+#endif
+    } else if (mgr_type == holoscan::ops::AnoMgrType::SOCKET) {
+#if ANO_MGR_SOCKET
+      // The socket manager delivers the same frame layout as DPDK in host memory
+      if (rx_en) {
+        auto adv_net_rx =
+            make_operator<ops::AdvNetworkOpRx>("adv_network_rx",
+                                               from_config("advanced_network"),
+                                               make_condition<BooleanCondition>("is_alive", true));
+        auto bench_rx =
+            make_operator<ops::AdvNetworkingBenchDefaultRxOp>("bench_rx", from_config("bench_rx"));
+        add_flow(adv_net_rx, bench_rx, {{ "bench_rx_out", "burst_in" }});
+      }
+      if (tx_en) {
+        auto adv_net_tx =
+            make_operator<ops::AdvNetworkOpTx>("adv_network_tx", from_config("advanced_network"));
+        auto bench_tx = make_operator<ops::AdvNetworkingBenchDefaultTxOp>(
+            "bench_tx",
+            from_config("bench_tx"),
+            make_condition<BooleanCondition>("is_alive", true));
+        add_flow(bench_tx, adv_net_tx, {{ "burst_out", "burst_in" }});
+      }
+#else
+      HOLOSCAN_LOG_ERROR("SOCKET ANO manager/backend is disabled");
+      exit(1);
 #endif
     } else {
       HOLOSCAN_LOG_ERROR("Invalid ANO manager/backend");
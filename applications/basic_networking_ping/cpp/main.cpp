@@ -63,7 +63,7 @@ class BasicNetworkPingRxOp : public Operator {
     auto val = *reinterpret_cast<int*>(in->data);
     HOLOSCAN_LOG_INFO("Ping message received with value {}", val);
 
-    delete[] in->data;
+    if (!in->pooled) { delete[] in->data; }
 
     if (val == NUM_MSGS - 1) { GxfGraphInterrupt(context.context()); }
   }
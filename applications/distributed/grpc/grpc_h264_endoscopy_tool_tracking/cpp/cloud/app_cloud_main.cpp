@@ -16,6 +16,7 @@
  */
 
 #include <getopt.h>
+#include <algorithm>
 #include <csignal>
 #include <iostream>
 #include <string>
@@ -32,16 +33,22 @@ using namespace holohub::grpc_h264_endoscopy_tool_tracking;
 
 /** Helper function to parse the command line arguments */
 bool parse_arguments(int argc, char** argv, uint32_t& port, std::string& data_path,
-                     std::string& config_path) {
+                     std::string& config_path, uint32_t& instances) {
   static struct option long_options[] = {{"port", required_argument, 0, 'p'},
                                          {"data", required_argument, 0, 'd'},
                                          {"config", required_argument, 0, 'c'},
+                                         {"instances", required_argument, 0, 'i'},
                                          {0, 0, 0, 0}};
 
   int c;
   while (optind < argc) {
-    if ((c = getopt_long(argc, argv, "p:", long_options, NULL)) != -1) {
+    if ((c = getopt_long(argc, argv, "p:i:", long_options, NULL)) != -1) {
       switch (c) {
+        case 'i':
+          try {
+            instances = std::stoi(optarg);
+          } catch (const std::exception& e) { std::cerr << e.what() << ":" << optarg << '\n'; }
+          break;
         case 'c':
           config_path = optarg;
           break;
@@ -87,7 +94,8 @@ void signal_handler(int signum) {
  * 3. If the data directory is not provided, it attempts to retrieve it from the environment
  * variable `HOLOSCAN_INPUT_PATH` or defaults to a directory named `data/endoscopy` in the current
  * working directory.
- * 4. Registers the Endoscopy Tool Tracking application with the `ApplicationFactory`.
+ * 4. Registers the Endoscopy Tool Tracking application with the `ApplicationFactory`. With
+ * `--instances N`, N pipelines are started up front so N edge devices can stream at once.
  * 5. Starts the gRPC service on the specified port.
  *
  * @param argc The number of command-line arguments.
@@ -99,8 +107,9 @@ int main(int argc, char** argv) {
   uint32_t port = 50051;
   std::string config_path = "";
   std::string data_directory = "";
+  uint32_t instances = 0;
 
-  if (!parse_arguments(argc, argv, port, data_directory, config_path)) { return 1; }
+  if (!parse_arguments(argc, argv, port, data_directory, config_path, instances)) { return 1; }
 
   if (config_path.empty()) {
     // Get the input data environment variable
@@ -129,22 +138,24 @@ int main(int argc, char** argv) {
 
   // Register each gRPC service with a Holoscan application:
   // - the callback function (create_application_instance_func) is used to create a new instance of
-  //   the application when a new RPC call is received.
+  //   the application when a new RPC call is received or when warming up the pool.
+  // - each instance serves one session since the video decoder holds per-stream state.
+  ApplicationPoolOptions pool_options;
+  pool_options.warm_instances = instances;
+  pool_options.max_instances = std::max(instances, 1U);
+  pool_options.max_sessions_per_instance = 1;
   ApplicationFactory::get_instance()->register_application(
       "EntityStream",
-      [config_path, data_directory](
-          std::queue<std::shared_ptr<nvidia::gxf::Entity>> incoming_request_queue,
-          std::queue<std::shared_ptr<EntityResponse>>
-              outgoing_response_queue) {
+      [config_path, data_directory]() {
         ApplicationInstance application_instance;
-        application_instance.instance = holoscan::make_application<AppCloudPipeline>(
-            incoming_request_queue, outgoing_response_queue);
+        application_instance.instance = holoscan::make_application<AppCloudPipeline>();
         application_instance.instance->config(config_path);
         application_instance.instance->set_data_path(data_directory);
         application_instance.instance->set_scheduler("scheduler");
         application_instance.future = application_instance.instance->run_async();
         return application_instance;
-      });
+      },
+      pool_options);
 
   struct sigaction sa;
   memset(&sa, 0, sizeof(sa));
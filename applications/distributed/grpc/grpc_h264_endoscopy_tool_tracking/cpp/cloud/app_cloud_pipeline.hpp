@@ -49,9 +49,7 @@ using holoscan::entity::EntityResponse;
  */
 class AppCloudPipeline : public HoloscanGrpcApplication {
  public:
-  AppCloudPipeline(std::queue<std::shared_ptr<nvidia::gxf::Entity>> incoming_request_queue,
-                   std::queue<std::shared_ptr<EntityResponse>> outgoing_response_queue)
-      : HoloscanGrpcApplication(incoming_request_queue, outgoing_response_queue) {}
+  AppCloudPipeline() = default;
 
   void compose() override {
     // Call base class compose to initialize the queues.
@@ -64,11 +64,8 @@ class GrpcService {
     service_ = std::make_unique<HoloscanEntityServiceImpl>(
         // Callback function to create a new instance of a Holoscan application when a new RPC call
         // is received.
-        [this](const std::string& service_name,
-               std::queue<std::shared_ptr<nvidia::gxf::Entity>>& incoming_request_queue,
-               std::queue<std::shared_ptr<EntityResponse>>& outgoing_response_queue) {
-          return application_factory_->create_application_instance(
-              service_name, incoming_request_queue, outgoing_response_queue);
+        [this](const std::string& service_name) {
+          return application_factory_->create_application_instance(service_name);
         },
         // Callback function to handle the completion of an entity stream RPC.
         [this](std::shared_ptr<HoloscanGrpcApplication> application_instance) {
@@ -75,11 +75,13 @@ void BasicConnectorOpRx::compute(InputContext& op_input,
   auto in = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in").value();
   num_rx += in->num_pkts;
 
+  // Bursts from the pooled receiver keep each packet in its own slot
+  const size_t stride = in->stride != 0 ? in->stride : payload_size.get();
   uint8_t *buf_ptr = in->data;
   for (size_t i = 0; i < in->num_pkts; i++) {
     // Get packet and adjust pointer
     pkt_buf[i] = RFPacket(buf_ptr);
-    buf_ptr += payload_size;  // RFPacket::packet_size(pkt_buf[i].get_num_samples());
+    buf_ptr += stride;  // RFPacket::packet_size(pkt_buf[i].get_num_samples());
 
     // Make sure this isn't wrapping the buffer - drop if it is
     if ((pkt_buf[i].get_waveform_id() >= buffer_track.pos + buffer_size.get()) ||
@@ -119,7 +121,7 @@ void BasicConnectorOpRx::compute(InputContext& op_input,
     }
   }
 
-  delete[] in->data;
+  if (!in->pooled) { delete[] in->data; }
 
   // Check if we can emit an array
   if (buffer_track.is_ready(samples_per_arr)) {
@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_BENCHMARK_OPERATORS_HPP
+#define DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_BENCHMARK_OPERATORS_HPP
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <gxf/std/tensor.hpp>
+#include <holoscan/holoscan.hpp>
+
+#include "transport_stats.hpp"
+
+namespace holohub::distributed_transport_benchmarking {
+
+using namespace holoscan;
+
+/**
+ * @brief Emits a host "payload" tensor of uint8 [height, width, channels] and a "timing" tensor.
+ *
+ * The payload is left uninitialized: the transports under test do not look at its contents. The
+ * sequence number and the send time are written to the timing tensor just before emitting.
+ */
+class SyntheticTensorSourceOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(SyntheticTensorSourceOp)
+
+  SyntheticTensorSourceOp() = default;
+
+  void setup(OperatorSpec& spec) override {
+    spec.output<gxf::Entity>("out");
+
+    spec.param(allocator_, "allocator", "Allocator", "Allocator of the emitted tensors.");
+    spec.param(height_, "height", "Height", "First dimension of the payload tensor.", 480);
+    spec.param(width_, "width", "Width", "Second dimension of the payload tensor.", 854);
+    spec.param(channels_, "channels", "Channels", "Third dimension of the payload tensor.", 3);
+  }
+
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override {
+    auto message = make_message(context.context());
+    auto timing = message.get<nvidia::gxf::Tensor>("timing");
+    int64_t* stamps = timing.value()->data<int64_t>().value();
+    stamps[kSequence] = sequence_++;
+    stamps[kSent] = now_ns();
+    op_output.emit(message, "out");
+  }
+
+ protected:
+  std::shared_ptr<Allocator> allocator() { return allocator_.get(); }
+
+  nvidia::gxf::Entity make_message(gxf_context_t context) {
+    auto allocator =
+        nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context, allocator_->gxf_cid());
+    if (!allocator) { throw std::runtime_error("Failed to create GXF allocator"); }
+    auto message = nvidia::gxf::Entity::New(context);
+    if (!message) { throw std::runtime_error("Failed to create GXF entity"); }
+
+    auto payload = message->add<nvidia::gxf::Tensor>("payload");
+    if (!payload ||
+        !payload.value()->reshape<uint8_t>(
+            nvidia::gxf::Shape{height_.get(), width_.get(), channels_.get()},
+            nvidia::gxf::MemoryStorageType::kHost,
+            allocator.value())) {
+      throw std::runtime_error("Failed to allocate payload tensor");
+    }
+
+    auto timing = message->add<nvidia::gxf::Tensor>("timing");
+    if (!timing || !timing.value()->reshape<int64_t>(nvidia::gxf::Shape{kNumTimingSlots},
+                                                     nvidia::gxf::MemoryStorageType::kHost,
+                                                     allocator.value())) {
+      throw std::runtime_error("Failed to allocate timing tensor");
+    }
+    int64_t* stamps = timing.value()->data<int64_t>().value();
+    std::fill(stamps, stamps + kNumTimingSlots, 0);
+    return message.value();
+  }
+
+ private:
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  Parameter<int32_t> height_;
+  Parameter<int32_t> width_;
+  Parameter<int32_t> channels_;
+  int64_t sequence_ = 0;
+};
+
+/**
+ * @brief Stamps the arrival and departure times into the timing tensor and sends the message back.
+ *
+ * The received entity is already a private copy made by the transport, so it is updated in place
+ * and forwarded without copying the payload.
+ */
+class TimestampEchoOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(TimestampEchoOp)
+
+  TimestampEchoOp() = default;
+
+  void setup(OperatorSpec& spec) override {
+    spec.input<gxf::Entity>("in");
+    spec.output<gxf::Entity>("out");
+  }
+
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override {
+    auto message = op_input.receive<gxf::Entity>("in");
+    if (!message) { return; }
+    const int64_t received = now_ns();
+
+    auto timing = static_cast<nvidia::gxf::Entity&>(message.value()).get<nvidia::gxf::Tensor>(
+        "timing");
+    if (!timing) {
+      HOLOSCAN_LOG_ERROR("Message without a timing tensor");
+      return;
+    }
+    int64_t* stamps = timing.value()->data<int64_t>().value();
+    stamps[kEchoReceived] = received;
+    stamps[kEchoSent] = now_ns();
+    op_output.emit(message.value(), "out");
+  }
+};
+
+/**
+ * @brief Records the timing tensor of every message that completed the loop.
+ */
+class LatencySinkOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(LatencySinkOp)
+
+  HOLOSCAN_OPERATOR_FORWARD_TEMPLATE()
+  LatencySinkOp(std::shared_ptr<TransportStats> stats, ArgT&& arg, ArgsT&&... args)
+      : Operator(std::forward<ArgT>(arg), std::forward<ArgsT>(args)...), stats_(std::move(stats)) {}
+
+  explicit LatencySinkOp(std::shared_ptr<TransportStats> stats) : stats_(std::move(stats)) {}
+
+  LatencySinkOp() = default;
+
+  void setup(OperatorSpec& spec) override { spec.input<gxf::Entity>("in"); }
+
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override {
+    auto message = op_input.receive<gxf::Entity>("in");
+    if (!message) { return; }
+    const int64_t received = now_ns();
+
+    auto timing = static_cast<nvidia::gxf::Entity&>(message.value()).get<nvidia::gxf::Tensor>(
+        "timing");
+    if (!timing) {
+      HOLOSCAN_LOG_ERROR("Message without a timing tensor");
+      return;
+    }
+    stats_->record_message(timing.value()->data<int64_t>().value(), received);
+  }
+
+ private:
+  std::shared_ptr<TransportStats> stats_;
+};
+
+}  // namespace holohub::distributed_transport_benchmarking
+
+#endif /* DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_BENCHMARK_OPERATORS_HPP */
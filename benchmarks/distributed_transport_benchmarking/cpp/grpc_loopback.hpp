@@ -0,0 +1,257 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_GRPC_LOOPBACK_HPP
+#define DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_GRPC_LOOPBACK_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+#include <holoscan/holoscan.hpp>
+
+#include <grpc_client.hpp>
+#include <grpc_server.hpp>
+
+#include "benchmark_operators.hpp"
+#include "transport_stats.hpp"
+
+namespace holohub::distributed_transport_benchmarking {
+
+using namespace holoscan;
+using namespace holoscan::ops;
+
+/**
+ * @brief Server side of the gRPC loop: requests are stamped and returned as responses.
+ */
+class GrpcEchoApplication : public HoloscanGrpcApplication {
+ public:
+  GrpcEchoApplication() = default;
+
+  void compose() override {
+    HoloscanGrpcApplication::compose();
+
+    auto echo = make_operator<TimestampEchoOp>("echo", streaming_enabled);
+    add_flow(grpc_request_op, echo, {{"output", "in"}});
+    add_flow(echo, grpc_response_op, {{"out", "input"}});
+  }
+};
+
+/**
+ * @brief gRPC server listening on localhost that starts a GrpcEchoApplication per EntityStream.
+ */
+class LoopbackGrpcServer {
+ public:
+  LoopbackGrpcServer(const std::string& config_path, uint32_t port,
+                     const std::string& request_rate)
+      : server_address_(fmt::format("localhost:{}", port)) {
+    ApplicationFactory::get_instance()->register_application(
+        "EntityStream", [config_path, request_rate]() {
+          ApplicationInstance application_instance;
+          auto app = holoscan::make_application<GrpcEchoApplication>();
+          app->config(config_path);
+          app->set_scheduler("scheduler");
+          app->set_request_rate(request_rate);
+          application_instance.instance = app;
+          application_instance.future = app->run_async();
+          return application_instance;
+        });
+  }
+
+  ~LoopbackGrpcServer() { stop(); }
+
+  const std::string& address() const { return server_address_; }
+
+  void start() {
+    service_ = std::make_unique<HoloscanEntityServiceImpl>(
+        [](const std::string& service_name) {
+          return ApplicationFactory::get_instance()->create_application_instance(service_name);
+        },
+        [](std::shared_ptr<HoloscanGrpcApplication> application_instance) {
+          ApplicationFactory::get_instance()->destroy_application_instance(application_instance);
+        });
+
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(server_address_, grpc::InsecureServerCredentials());
+    builder.RegisterService(service_.get());
+    server_ = builder.BuildAndStart();
+    if (!server_) {
+      throw std::runtime_error(fmt::format("Failed to start gRPC server on {}", server_address_));
+    }
+    HOLOSCAN_LOG_INFO("grpc: Loopback server listening on {}", server_address_);
+  }
+
+  void stop() {
+    if (!server_) { return; }
+    server_->Shutdown();
+    server_.reset();
+  }
+
+ private:
+  std::string server_address_;
+  std::unique_ptr<grpc::Server> server_;
+  std::unique_ptr<HoloscanEntityServiceImpl> service_;
+};
+
+/**
+ * @brief Source that measures the gRPC serialization cost of its message before streaming.
+ *
+ * The operators serialize inside the gRPC library, out of reach of the pipeline, so the cost is
+ * measured here on an identical message: the TensorProto conversion plus the protobuf wire
+ * encoding, and the reverse. Chunking is applied as configured on the client.
+ */
+class GrpcCodecProbeSourceOp : public SyntheticTensorSourceOp {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_TEMPLATE()
+  GrpcCodecProbeSourceOp(std::shared_ptr<TransportStats> stats, ArgT&& arg, ArgsT&&... args)
+      : SyntheticTensorSourceOp(std::forward<ArgT>(arg), std::forward<ArgsT>(args)...),
+        stats_(std::move(stats)) {}
+
+  void setup(OperatorSpec& spec) override {
+    SyntheticTensorSourceOp::setup(spec);
+
+    spec.param(iterations_,
+               "codec_probe_iterations",
+               "Codec probe iterations",
+               "Messages encoded and decoded to measure serialization; 0 to skip.",
+               100U);
+    spec.param(max_chunk_size_,
+               "max_chunk_size",
+               "Max chunk size",
+               "Chunk size used by the client; 0 to disable chunking.",
+               0U);
+  }
+
+  void start() override {
+    if (iterations_.get() == 0) { return; }
+    auto context = fragment()->executor().context();
+    auto gxf_allocator =
+        nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context, allocator()->gxf_cid());
+    if (!gxf_allocator) { throw std::runtime_error("Failed to create GXF allocator"); }
+    auto message = make_message(context);
+
+    // Host tensors only, so the default stream is never used
+    const cudaStream_t cuda_stream = nullptr;
+    std::vector<std::string> wire;
+    for (uint32_t i = 0; i < iterations_.get(); i++) {
+      wire.clear();
+      const int64_t started = now_ns();
+      TensorProtoChunker<EntityRequest> chunker(
+          max_chunk_size_.get(), cuda_stream, [&wire](std::shared_ptr<EntityRequest> request) {
+            request->SerializeToString(&wire.emplace_back());
+          });
+      chunker.add(message);
+      chunker.finish();
+      const int64_t serialized = now_ns();
+
+      auto decoded = nvidia::gxf::Entity::New(context);
+      if (!decoded) { throw std::runtime_error("Failed to create GXF entity"); }
+      for (const auto& bytes : wire) {
+        EntityRequest request;
+        if (!request.ParseFromString(bytes)) {
+          throw std::runtime_error("Failed to parse EntityRequest");
+        }
+        TensorProto::entity_request_to_tensor(
+            &request, decoded.value(), gxf_allocator.value(), cuda_stream);
+      }
+      stats_->record_codec(serialized - started, now_ns() - serialized);
+    }
+  }
+
+ private:
+  std::shared_ptr<TransportStats> stats_;
+  Parameter<uint32_t> iterations_;
+  Parameter<uint32_t> max_chunk_size_;
+};
+
+/**
+ * @brief Client side of the gRPC loop.
+ *
+ * Synthetic tensors go out through GrpcClientRequestOp on an EntityStream to the loopback server
+ * and the echoed responses come back through GrpcClientResponseOp to the sink.
+ */
+class GrpcLoopbackApplication : public holoscan::Application {
+ public:
+  GrpcLoopbackApplication(const RunConfig& run, const std::string& server_address,
+                          std::shared_ptr<TransportStats> stats)
+      : run_(run), server_address_(server_address), stats_(std::move(stats)) {}
+
+  ~GrpcLoopbackApplication() {
+    if (entity_client_service_) { entity_client_service_->stop_entity_stream(); }
+  }
+
+  void compose() override {
+    condition_ = make_condition<AsynchronousCondition>("response_available_condition");
+    request_queue_ =
+        make_resource<ConditionVariableQueue<std::shared_ptr<EntityRequest>>>("request_queue");
+    response_queue_ =
+        make_resource<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>>(
+            "response_queue", condition_);
+    auto allocator = make_resource<UnboundedAllocator>("pool");
+
+    auto source = make_operator<GrpcCodecProbeSourceOp>(
+        "source",
+        stats_,
+        make_condition<CountCondition>(run_.count),
+        Arg("allocator") = allocator,
+        Arg("height") = run_.height,
+        Arg("width") = run_.width,
+        Arg("channels") = run_.channels,
+        Arg("codec_probe_iterations") = run_.codec_probe_iterations,
+        Arg("max_chunk_size") = run_.max_chunk_size);
+    if (run_.rate_hz > 0) {
+      source->add_arg(make_condition<PeriodicCondition>(
+          "periodic-condition", Arg("recess_period") = fmt::format("{}hz", run_.rate_hz)));
+    }
+
+    auto outgoing_requests =
+        make_operator<GrpcClientRequestOp>("outgoing_requests",
+                                           Arg("request_queue") = request_queue_,
+                                           Arg("allocator") = allocator,
+                                           Arg("max_chunk_size") = run_.max_chunk_size);
+    auto incoming_responses =
+        make_operator<GrpcClientResponseOp>("incoming_responses",
+                                            Arg("condition") = condition_,
+                                            Arg("response_queue") = response_queue_);
+    auto sink = make_operator<LatencySinkOp>("sink", stats_);
+
+    add_flow(source, outgoing_requests, {{"out", "input"}});
+    add_flow(incoming_responses, sink, {{"output", "in"}});
+
+    entity_client_service_ = std::make_shared<EntityClientService>(
+        server_address_,
+        from_config("grpc_client.rpc_timeout").as<uint32_t>(),
+        request_queue_,
+        response_queue_,
+        outgoing_requests);
+    entity_client_service_->start_entity_stream();
+  }
+
+ private:
+  RunConfig run_;
+  std::string server_address_;
+  std::shared_ptr<TransportStats> stats_;
+  std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue_;
+  std::shared_ptr<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>> response_queue_;
+  std::shared_ptr<AsynchronousCondition> condition_;
+  std::shared_ptr<EntityClientService> entity_client_service_;
+};
+
+}  // namespace holohub::distributed_transport_benchmarking
+
+#endif /* DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_GRPC_LOOPBACK_HPP */
@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <getopt.h>
+#include <yaml-cpp/yaml.h>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <holoscan/holoscan.hpp>
+
+#include "grpc_loopback.hpp"
+#include "transport_stats.hpp"
+#include "ucx_loopback.hpp"
+
+using namespace holoscan;
+using namespace holohub::distributed_transport_benchmarking;
+
+struct BenchmarkSettings {
+  std::vector<std::string> transports;
+  std::vector<std::array<int32_t, 3>> payloads;
+  RunConfig run;
+  std::chrono::milliseconds idle_timeout{10000};
+  uint32_t grpc_port = 50151;
+  std::string grpc_request_rate = "1000hz";
+};
+
+BenchmarkSettings load_settings(const std::string& config_path) {
+  const YAML::Node config = YAML::LoadFile(config_path);
+  const YAML::Node benchmark = config["benchmark"];
+  const YAML::Node grpc = config["grpc"];
+
+  BenchmarkSettings settings;
+  settings.transports = benchmark["transports"].as<std::vector<std::string>>();
+  for (const auto& payload : benchmark["payloads"]) {
+    const auto dims = payload.as<std::vector<int32_t>>();
+    if (dims.size() != 3) {
+      throw std::runtime_error("benchmark.payloads entries must be [height, width, channels]");
+    }
+    settings.payloads.push_back({dims[0], dims[1], dims[2]});
+  }
+  settings.run.rate_hz = benchmark["rate_hz"].as<double>(30.0);
+  settings.run.count = benchmark["count"].as<uint64_t>(600);
+  settings.run.warmup = benchmark["warmup"].as<uint64_t>(30);
+  settings.run.codec_probe_iterations = benchmark["codec_probe_iterations"].as<uint32_t>(100);
+  settings.idle_timeout =
+      std::chrono::milliseconds(benchmark["idle_timeout_ms"].as<uint32_t>(10000));
+  settings.run.max_chunk_size = grpc["max_chunk_size"].as<uint32_t>(0);
+  settings.grpc_port = grpc["port"].as<uint32_t>(50151);
+  settings.grpc_request_rate = grpc["request_rate"].as<std::string>("1000hz");
+  return settings;
+}
+
+bool parse_arguments(int argc, char** argv, std::string& config_path, std::string& transport,
+                     std::string& output_path) {
+  static struct option long_options[] = {{"config", required_argument, 0, 'c'},
+                                         {"transport", required_argument, 0, 't'},
+                                         {"output", required_argument, 0, 'o'},
+                                         {0, 0, 0, 0}};
+
+  int c;
+  while (optind < argc) {
+    if ((c = getopt_long(argc, argv, "c:t:o:", long_options, NULL)) != -1) {
+      switch (c) {
+        case 'c':
+          config_path = optarg;
+          break;
+        case 't':
+          transport = optarg;
+          if (transport != "grpc" && transport != "ucx") {
+            HOLOSCAN_LOG_ERROR("Unknown transport '{}', expected grpc or ucx", transport);
+            return false;
+          }
+          break;
+        case 'o':
+          output_path = optarg;
+          break;
+        default:
+          HOLOSCAN_LOG_ERROR("Unhandled option '{}'", static_cast<char>(c));
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Runs the application until every message came back, then returns the report of the run
+template <typename AppT>
+std::string run_benchmark(std::shared_ptr<AppT> app, std::shared_ptr<TransportStats> stats,
+                          std::chrono::milliseconds idle_timeout, bool interrupt) {
+  auto future = app->run_async();
+  if (!stats->wait_until_complete(idle_timeout)) {
+    HOLOSCAN_LOG_WARN("No message came back for {} ms, ending the run", idle_timeout.count());
+  }
+  // The gRPC client keeps waiting for responses and has to be stopped
+  if (interrupt) { app->executor().interrupt(); }
+  future.wait();
+  return stats->report();
+}
+
+int main(int argc, char** argv) {
+  std::string config_path = "";
+  std::string transport = "";
+  std::string output_path = "";
+  if (!parse_arguments(argc, argv, config_path, transport, output_path)) { return 1; }
+
+  if (config_path.empty()) {
+    auto config_file_path = std::getenv("HOLOSCAN_CONFIG_PATH");
+    if (config_file_path == nullptr || config_file_path[0] == '\0') {
+      auto config_file = std::filesystem::canonical(argv[0]).parent_path();
+      config_path = config_file / std::filesystem::path("distributed_transport_benchmarking.yaml");
+    } else {
+      config_path = config_file_path;
+    }
+  }
+  HOLOSCAN_LOG_INFO("Using configuration file from {}", config_path);
+
+  BenchmarkSettings settings;
+  try {
+    settings = load_settings(config_path);
+  } catch (const std::exception& e) {
+    HOLOSCAN_LOG_ERROR("Failed to load {}: {}", config_path, e.what());
+    return 1;
+  }
+  if (!transport.empty()) { settings.transports = {transport}; }
+
+  std::unique_ptr<LoopbackGrpcServer> grpc_server;
+  std::vector<std::string> rows;
+  for (const auto& name : settings.transports) {
+    for (const auto& payload : settings.payloads) {
+      RunConfig run = settings.run;
+      run.transport = name;
+      run.height = payload[0];
+      run.width = payload[1];
+      run.channels = payload[2];
+      auto stats = std::make_shared<TransportStats>(run);
+
+      if (name == "grpc") {
+        if (!grpc_server) {
+          grpc_server = std::make_unique<LoopbackGrpcServer>(
+              config_path, settings.grpc_port, settings.grpc_request_rate);
+          grpc_server->start();
+        }
+        auto app = holoscan::make_application<GrpcLoopbackApplication>(
+            run, grpc_server->address(), stats);
+        app->config(config_path);
+        app->scheduler(app->make_scheduler<EventBasedScheduler>("event-scheduler",
+                                                                app->from_config("scheduler")));
+        rows.push_back(run_benchmark(app, stats, settings.idle_timeout, true));
+      } else if (name == "ucx") {
+        auto app = holoscan::make_application<UcxLoopbackApplication>(run, stats);
+        app->config(config_path);
+        rows.push_back(run_benchmark(app, stats, settings.idle_timeout, false));
+      } else {
+        HOLOSCAN_LOG_ERROR("Unknown transport '{}' in benchmark.transports", name);
+        return 1;
+      }
+    }
+  }
+  if (grpc_server) { grpc_server->stop(); }
+
+  if (!output_path.empty()) {
+    const bool new_file = !std::filesystem::exists(output_path);
+    std::ofstream output(output_path, std::ios::app);
+    if (!output) {
+      HOLOSCAN_LOG_ERROR("Failed to open {}", output_path);
+      return 1;
+    }
+    if (new_file) { output << TransportStats::csv_header() << "\n"; }
+    for (const auto& row : rows) { output << row << "\n"; }
+    HOLOSCAN_LOG_INFO("Results appended to {}", output_path);
+  }
+
+  return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_TRANSPORT_STATS_HPP
+#define DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_TRANSPORT_STATS_HPP
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <holoscan/holoscan.hpp>
+
+namespace holohub::distributed_transport_benchmarking {
+
+/**
+ * @brief Monotonic clock shared by every fragment of the benchmark.
+ *
+ * All fragments run in one process, so stamps taken on either side of a transport can be
+ * subtracted directly.
+ */
+inline int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Slots of the "timing" tensor carried next to the payload of every message
+enum TimingSlot : int32_t { kSequence = 0, kSent, kEchoReceived, kEchoSent, kNumTimingSlots };
+
+/**
+ * @brief Settings of one benchmark run.
+ */
+struct RunConfig {
+  std::string transport;
+  int32_t height = 0;
+  int32_t width = 0;
+  int32_t channels = 0;
+  double rate_hz = 0.0;  // 0 sends as fast as the transport accepts
+  uint64_t count = 0;
+  uint64_t warmup = 0;
+  uint32_t max_chunk_size = 0;
+  uint32_t codec_probe_iterations = 0;
+
+  size_t payload_bytes() const { return static_cast<size_t>(height) * width * channels; }
+};
+
+/**
+ * @brief Exact latency distribution of a run; samples are kept and sorted when summarized.
+ */
+class LatencySamples {
+ public:
+  struct Summary {
+    size_t count = 0;
+    double mean_us = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+  };
+
+  void add(int64_t ns) { samples_.push_back(std::max<int64_t>(ns, 0)); }
+
+  bool empty() const { return samples_.empty(); }
+
+  double mean_ns() const {
+    if (samples_.empty()) { return 0.0; }
+    double sum = 0.0;
+    for (auto ns : samples_) { sum += ns; }
+    return sum / samples_.size();
+  }
+
+  const std::vector<int64_t>& samples() const { return samples_; }
+
+  Summary summarize() const {
+    Summary s;
+    if (samples_.empty()) { return s; }
+    std::vector<int64_t> sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+    const auto at = [&sorted](double q) {
+      return sorted[std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()))] / 1e3;
+    };
+    s.count = sorted.size();
+    s.mean_us = mean_ns() / 1e3;
+    s.p50_us = at(0.5);
+    s.p99_us = at(0.99);
+    s.max_us = sorted.back() / 1e3;
+    return s;
+  }
+
+ private:
+  std::vector<int64_t> samples_;
+};
+
+/**
+ * @brief Collects the timings of one run and turns them into the per-stage report.
+ *
+ * Every message makes two hops: source to echo ("out") and echo back to the sink ("back"). A hop
+ * covers serialization, transport and deserialization. When the serialization cost of the
+ * transport can be measured on its own (gRPC), it is recorded with record_codec() and taken off
+ * each hop to give the transport time; otherwise the whole hop is reported as transport.
+ */
+class TransportStats {
+ public:
+  explicit TransportStats(const RunConfig& run) : run_(run) {}
+
+  void record_codec(int64_t serialize_ns, int64_t deserialize_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    serialize_.add(serialize_ns);
+    deserialize_.add(deserialize_ns);
+  }
+
+  /**
+   * @brief Records a message arriving at the sink with the stamps of its timing tensor.
+   */
+  void record_message(const int64_t* stamps, int64_t received_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    received_++;
+    received_cv_.notify_all();
+    if (static_cast<uint64_t>(stamps[kSequence]) < run_.warmup) { return; }
+
+    hop_out_.add(stamps[kEchoReceived] - stamps[kSent]);
+    hop_back_.add(received_ns - stamps[kEchoSent]);
+    round_trip_.add(received_ns - stamps[kSent]);
+    first_received_ns_ = std::min(first_received_ns_, received_ns);
+    last_received_ns_ = std::max(last_received_ns_, received_ns);
+  }
+
+  /**
+   * @brief Waits until every message of the run came back.
+   *
+   * @return false if no message arrived for idle_timeout before that.
+   */
+  bool wait_until_complete(std::chrono::milliseconds idle_timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (received_ < run_.count) {
+      const uint64_t received = received_;
+      if (!received_cv_.wait_for(
+              lock, idle_timeout, [this, received]() { return received_ != received; })) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Logs the report of the run and returns it as a CSV row matching csv_header().
+   */
+  std::string report() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool has_codec = !serialize_.empty();
+    const double codec_ns = serialize_.mean_ns() + deserialize_.mean_ns();
+    const auto transport = [codec_ns](const LatencySamples& hop) {
+      LatencySamples out;
+      for (auto ns : hop.samples()) { out.add(ns - static_cast<int64_t>(codec_ns)); }
+      return out.summarize();
+    };
+
+    const auto ser = serialize_.summarize();
+    const auto deser = deserialize_.summarize();
+    const auto out = transport(hop_out_);
+    const auto back = transport(hop_back_);
+    const auto rtt = round_trip_.summarize();
+
+    const size_t measured = rtt.count;
+    const double window_s = (last_received_ns_ - first_received_ns_) / 1e9;
+    const double fps = (measured > 1 && window_s > 0) ? (measured - 1) / window_s : 0.0;
+    const double mbps = fps * run_.payload_bytes() / 1e6;
+    const uint64_t lost = run_.count > received_ ? run_.count - received_ : 0;
+
+    HOLOSCAN_LOG_INFO(
+        "[{}] {}x{}x{} ({:.2f} MB) at {}: {} frames measured, {} lost, {:.2f} frames/s, "
+        "{:.1f} MB/s",
+        run_.transport,
+        run_.height,
+        run_.width,
+        run_.channels,
+        run_.payload_bytes() / 1e6,
+        run_.rate_hz > 0 ? fmt::format("{} Hz", run_.rate_hz) : std::string("max rate"),
+        measured,
+        lost,
+        fps,
+        mbps);
+    HOLOSCAN_LOG_INFO(
+        "  {:<16}{:>12}{:>12}{:>12}{:>12}", "stage (us)", "mean", "p50", "p99", "max");
+    const auto row = [has_codec](const char* name, const LatencySamples::Summary& s, bool codec) {
+      if (codec && !has_codec) {
+        HOLOSCAN_LOG_INFO("  {:<16}{:>12}", name, "in transport");
+        return;
+      }
+      HOLOSCAN_LOG_INFO(
+          "  {:<16}{:>12.1f}{:>12.1f}{:>12.1f}{:>12.1f}", name, s.mean_us, s.p50_us, s.p99_us,
+          s.max_us);
+    };
+    row("serialize", ser, true);
+    row("transport out", out, false);
+    row("transport back", back, false);
+    row("deserialize", deser, true);
+    row("round trip", rtt, false);
+
+    return fmt::format("{},{},{},{},{},{},{},{},{:.2f},{:.2f},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},"
+                       "{:.1f},{:.1f},{:.1f},{:.1f},{:.1f}",
+                       run_.transport,
+                       run_.height,
+                       run_.width,
+                       run_.channels,
+                       run_.payload_bytes(),
+                       run_.rate_hz,
+                       measured,
+                       lost,
+                       fps,
+                       mbps,
+                       ser.p50_us,
+                       ser.p99_us,
+                       deser.p50_us,
+                       deser.p99_us,
+                       out.p50_us,
+                       out.p99_us,
+                       back.p50_us,
+                       back.p99_us,
+                       rtt.p50_us,
+                       rtt.p99_us);
+  }
+
+  static std::string csv_header() {
+    return "transport,height,width,channels,payload_bytes,rate_hz,frames,lost,fps,mb_per_s,"
+           "serialize_p50_us,serialize_p99_us,deserialize_p50_us,deserialize_p99_us,"
+           "transport_out_p50_us,transport_out_p99_us,transport_back_p50_us,"
+           "transport_back_p99_us,round_trip_p50_us,round_trip_p99_us";
+  }
+
+ private:
+  RunConfig run_;
+  std::mutex mutex_;
+  std::condition_variable received_cv_;
+  LatencySamples serialize_;
+  LatencySamples deserialize_;
+  LatencySamples hop_out_;
+  LatencySamples hop_back_;
+  LatencySamples round_trip_;
+  uint64_t received_ = 0;
+  int64_t first_received_ns_ = std::numeric_limits<int64_t>::max();
+  int64_t last_received_ns_ = 0;
+};
+
+}  // namespace holohub::distributed_transport_benchmarking
+
+#endif /* DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_TRANSPORT_STATS_HPP */
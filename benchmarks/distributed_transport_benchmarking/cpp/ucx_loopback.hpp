@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_UCX_LOOPBACK_HPP
+#define DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_UCX_LOOPBACK_HPP
+
+#include <memory>
+#include <utility>
+
+#include <holoscan/holoscan.hpp>
+
+#include "benchmark_operators.hpp"
+#include "transport_stats.hpp"
+
+namespace holohub::distributed_transport_benchmarking {
+
+using namespace holoscan;
+
+class SourceFragment : public holoscan::Fragment {
+ public:
+  explicit SourceFragment(const RunConfig& run) : run_(run) {}
+
+  void compose() override {
+    auto source = make_operator<SyntheticTensorSourceOp>(
+        "source",
+        make_condition<CountCondition>(run_.count),
+        Arg("allocator") = make_resource<UnboundedAllocator>("pool"),
+        Arg("height") = run_.height,
+        Arg("width") = run_.width,
+        Arg("channels") = run_.channels);
+    if (run_.rate_hz > 0) {
+      source->add_arg(make_condition<PeriodicCondition>(
+          "periodic-condition", Arg("recess_period") = fmt::format("{}hz", run_.rate_hz)));
+    }
+    add_operator(source);
+  }
+
+ private:
+  RunConfig run_;
+};
+
+class EchoFragment : public holoscan::Fragment {
+ public:
+  void compose() override { add_operator(make_operator<TimestampEchoOp>("echo")); }
+};
+
+class SinkFragment : public holoscan::Fragment {
+ public:
+  explicit SinkFragment(std::shared_ptr<TransportStats> stats) : stats_(std::move(stats)) {}
+
+  void compose() override { add_operator(make_operator<LatencySinkOp>("sink", stats_)); }
+
+ private:
+  std::shared_ptr<TransportStats> stats_;
+};
+
+/**
+ * @brief UCX side of the benchmark: source, echo and sink run as three fragments.
+ *
+ * Started without --driver/--worker, all fragments run in this process and exchange messages over
+ * UCX on localhost, making the same two hops as the gRPC loop.
+ */
+class UcxLoopbackApplication : public holoscan::Application {
+ public:
+  UcxLoopbackApplication(const RunConfig& run, std::shared_ptr<TransportStats> stats)
+      : run_(run), stats_(std::move(stats)) {}
+
+  void compose() override {
+    auto source = make_fragment<SourceFragment>("source_fragment", run_);
+    auto echo = make_fragment<EchoFragment>("echo_fragment");
+    auto sink = make_fragment<SinkFragment>("sink_fragment", stats_);
+
+    add_flow(source, echo, {{"source.out", "echo.in"}});
+    add_flow(echo, sink, {{"echo.out", "sink.in"}});
+  }
+
+ private:
+  RunConfig run_;
+  std::shared_ptr<TransportStats> stats_;
+};
+
+}  // namespace holohub::distributed_transport_benchmarking
+
+#endif /* DISTRIBUTED_TRANSPORT_BENCHMARKING_CPP_UCX_LOOPBACK_HPP */
@@ -19,11 +19,14 @@
 #define HOLOSCAN_BENCHMARK
 
 #include <stdlib.h>
+#include <memory>
 #include <string>
 #include <unordered_set>
 
 #include "holoscan/holoscan.hpp"
 
+#include "flow_telemetry.hpp"
+
 class BenchmarkedApplication : public holoscan::Application {
  public:
   inline void add_flow(const std::shared_ptr<holoscan::Operator>& upstream_op,
@@ -55,10 +58,16 @@ class BenchmarkedApplication : public holoscan::Application {
     tracker_ = data_flow_tracker();
     // Get the data flow tracking logging file name from the environment variable
     const char* flow_tracking_log_file = std::getenv("HOLOSCAN_FLOW_TRACKING_LOG_FILE");
-    if (!flow_tracking_log_file) {
-      tracker_->enable_logging();
-    } else {
-      tracker_->enable_logging(flow_tracking_log_file);
+    if (!flow_tracking_log_file) { flow_tracking_log_file = kDefaultFlowTrackingLogFile; }
+    tracker_->enable_logging(flow_tracking_log_file);
+
+    // Publish live latencies from the log if HOLOSCAN_FLOW_TELEMETRY_* is set
+    auto telemetry_config =
+        holohub::flow_benchmarking::FlowTelemetryConfig::from_environment(flow_tracking_log_file);
+    if (telemetry_config.enabled()) {
+      telemetry_ =
+          std::make_unique<holohub::flow_benchmarking::FlowTelemetry>(std::move(telemetry_config));
+      telemetry_->start();
     }
 
     // Load scheduler parameters from environment variables
@@ -93,12 +102,18 @@ class BenchmarkedApplication : public holoscan::Application {
 
     // Call the parent's class' run()
     holoscan::Application::run();
+
+    if (telemetry_) { telemetry_->stop(); }
   }
   ~BenchmarkedApplication() { /*tracker_->print();*/
   }
 
  private:
+  // Same as the default of DataFlowTracker::enable_logging()
+  static constexpr const char* kDefaultFlowTrackingLogFile = "logger.log";
+
   holoscan::DataFlowTracker* tracker_ = nullptr;
+  std::unique_ptr<holohub::flow_benchmarking::FlowTelemetry> telemetry_;
   std::unordered_set<std::shared_ptr<holoscan::Operator>> conditioned_nodes_;
   int num_source_messages_ = 100;
 };
@@ -0,0 +1,540 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "flow_log_reader.hpp"
+#include "latency_sketch.hpp"
+
+using namespace holohub::flow_benchmarking;
+
+// Analyzes the log files of Holoscan data flow tracking (HOLOSCAN_FLOW_TRACKING_LOG_FILE) like
+// analyze.py, without keeping the latencies in memory.
+
+struct Options {
+  std::vector<std::vector<std::string>> groups;
+  std::vector<double> percentiles;
+  bool max = false;
+  bool avg = false;
+  bool median = false;
+  bool stddev = false;
+  bool min = false;
+  bool tail = false;
+  bool flatness = false;
+  bool save_csv = false;
+  bool cdash = false;
+  std::string json_file;
+  std::string csv_file;
+  std::string cdf_file;
+  uint32_t skip_begin_messages = 10;
+  uint32_t discard_last_messages = 10;
+  unsigned threads = std::max(std::thread::hardware_concurrency(), 1U);
+};
+
+/**
+ * Latencies of the paths of a group of log files, paths are kept in order of first appearance
+ */
+struct Group {
+  std::string name;
+  std::vector<std::string> log_files;
+  std::vector<std::string> paths;
+  std::vector<LatencySketch> latencies;
+  std::unordered_map<std::string, size_t> path_ids;
+
+  size_t path_id(const std::string& path) {
+    auto it = path_ids.find(path);
+    if (it != path_ids.end()) { return it->second; }
+    path_ids.emplace(path, paths.size());
+    paths.push_back(path);
+    latencies.emplace_back();
+    return paths.size() - 1;
+  }
+};
+
+/**
+ * Leaves out the first and last messages of a path in a log file, as merge_path_latencies() of
+ * analyze.py. The last messages are only known at the end of the file, so they are held back.
+ */
+class PathTrimmer {
+ public:
+  void add(int64_t latency_us, const Options& options, LatencySketch& sketch) {
+    if (seen_++ < options.skip_begin_messages) { return; }
+    if (options.discard_last_messages == 0) {
+      sketch.add(latency_us);
+    } else if (held_back_.size() < options.discard_last_messages) {
+      held_back_.push_back(latency_us);
+    } else {
+      sketch.add(held_back_[next_]);
+      held_back_[next_] = latency_us;
+      next_ = (next_ + 1) % held_back_.size();
+    }
+  }
+
+ private:
+  uint64_t seen_ = 0;
+  std::vector<int64_t> held_back_;
+  size_t next_ = 0;
+};
+
+// Adds the paths and latencies of one log file to a group, as parse_log_as_paths_latencies() of
+// log_parser.py
+void analyze_log_file(const std::string& log_file, const Options& options, FlowLogReader& reader,
+                      Group& group) {
+  std::vector<PathTrimmer> trimmers(group.paths.size());
+  std::vector<std::vector<size_t>> group_path_ids(options.threads);
+  bool has_previous = false;
+  size_t previous_path = 0;
+  FlowRecord previous{};
+
+  const uint64_t malformed = reader.read(
+      log_file,
+      [&](size_t parser, const std::vector<FlowRecord>& records,
+          const std::vector<std::string>& paths) {
+        auto& ids = group_path_ids[parser];
+        while (ids.size() < paths.size()) { ids.push_back(group.path_id(paths[ids.size()])); }
+        if (trimmers.size() < group.paths.size()) { trimmers.resize(group.paths.size()); }
+
+        for (const auto& record : records) {
+          const size_t path = ids[record.path];
+          // A line is a duplicate of the previous one if the path and the source stamps are the
+          // same and the sinks published within 20 us
+          if (has_previous && path == previous_path &&
+              record.first_receive == previous.first_receive &&
+              record.first_publish == previous.first_publish &&
+              std::llabs(record.last_publish - previous.last_publish) <= 20) {
+            continue;
+          }
+          has_previous = true;
+          previous_path = path;
+          previous = record;
+          trimmers[path].add(record.latency_us(), options, group.latencies[path]);
+        }
+      });
+  if (malformed > 0) {
+    std::cerr << "\033[93mWarning: " << malformed << " malformed lines skipped in " << log_file
+              << "\033[0m" << std::endl;
+  }
+}
+
+// Value as printed by "{:.2f}".format() in analyze.py, e.g. 1.50
+std::string format_ms(double value) {
+  char text[64];
+  std::snprintf(text, sizeof(text), "%.2f", value);
+  return text;
+}
+
+// Value as printed by str(round(value, 2)) of a numpy float in analyze.py, e.g. 1.5 or 12.0
+std::string format_rounded_ms(double value) {
+  std::string result = format_ms(std::nearbyint(value * 100.0) / 100.0);
+  if (result.find_first_of("ni") != std::string::npos) { return result; }
+  while (result.back() == '0' && result[result.size() - 2] != '.') { result.pop_back(); }
+  return result;
+}
+
+// Percentile as printed by Python, e.g. 99.0 or 99.9
+std::string format_percentile(double percentile) {
+  char text[64];
+  std::snprintf(text, sizeof(text), "%.15g", percentile);
+  std::string result = text;
+  if (result.find_first_of(".e") == std::string::npos) { result += ".0"; }
+  return result;
+}
+
+std::string json_string(const std::string& value) {
+  std::string result = "\"";
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      result += escaped;
+    } else {
+      result += c;
+    }
+  }
+  return result + "\"";
+}
+
+std::string csv_string(const std::string& value) {
+  if (value.find_first_of(",\"\n") == std::string::npos) { return value; }
+  std::string result = "\"";
+  for (const char c : value) { result += c == '"' ? std::string("\"\"") : std::string(1, c); }
+  return result + "\"";
+}
+
+struct Metric {
+  std::string title;
+  std::string csv_file;
+  // CDash name attribute without the group suffix, verbatim from analyze.py including the
+  // whitespace of its line continuations so the measurement names stay the same
+  std::string cdash_name;
+  std::function<double(const LatencySketch&)> value;
+  std::string (*format)(double);
+};
+
+// The metrics of analyze.py, in its order
+std::vector<Metric> all_metrics(const std::vector<double>& percentiles) {
+  std::vector<Metric> metrics = {
+      {"Maximum (Worst-case) Latencies",
+       "max_values.csv",
+       "name=\"maximum_latency",
+       [](const LatencySketch& s) { return s.max_ms(); },
+       format_rounded_ms},
+      {"Average Latencies",
+       "avg_values.csv",
+       "name=\"average_latency",
+       [](const LatencySketch& s) { return s.mean_ms(); },
+       format_rounded_ms},
+      {"Median Latencies",
+       "median_values.csv",
+       "name=\"median_latency",
+       [](const LatencySketch& s) { return s.median_ms(); },
+       format_rounded_ms},
+      {"Standard Deviation of Latencies",
+       "stddev_values.csv",
+       "name=\"stddev_latency",
+       [](const LatencySketch& s) { return s.stddev_ms(); },
+       format_rounded_ms},
+      {"Minimum Latencies",
+       "min_values.csv",
+       "name=\"min_latency",
+       [](const LatencySketch& s) { return s.min_ms(); },
+       format_rounded_ms},
+      {"Latency Distribution Tail (95-100 percentile)",
+       "tail_values.csv",
+       "name=\"distribution_tail",
+       [](const LatencySketch& s) { return s.percentile_ms(100) - s.percentile_ms(95); },
+       format_ms},
+      {"Latency Distribution Flatness (10-90 percentile)",
+       "flatness_values.csv",
+       "name=\"" + std::string(22, ' ') + "distribution_flatness",
+       [](const LatencySketch& s) { return s.percentile_ms(90) - s.percentile_ms(10); },
+       format_ms},
+  };
+  for (const double percentile : percentiles) {
+    const std::string name = format_percentile(percentile);
+    const auto value = [percentile](const LatencySketch& s) { return s.percentile_ms(percentile); };
+    metrics.push_back({"Latency Percentile (" + name + ")",
+                       "percentile_" + name + "_values.csv",
+                       "name" + std::string(26, ' ') + "=\"percentile_" + name,
+                       value,
+                       format_ms});
+  }
+  return metrics;
+}
+
+// Metrics selected on the command line, all metrics are always written to JSON and CSV
+std::vector<bool> selected_metrics(const Options& options) {
+  std::vector<bool> selected = {options.max,
+                                options.avg,
+                                options.median,
+                                options.stddev,
+                                options.min,
+                                options.tail,
+                                options.flatness};
+  selected.resize(selected.size() + options.percentiles.size(), true);
+  return selected;
+}
+
+void print_metrics(const std::vector<Group>& groups, const Options& options) {
+  const auto metrics = all_metrics(options.percentiles);
+  const auto selected = selected_metrics(options);
+  for (size_t index = 0; index < metrics.size(); index++) {
+    if (!selected[index]) { continue; }
+    const Metric& metric = metrics[index];
+    if (options.save_csv) { std::ofstream(metric.csv_file, std::ios::trunc); }
+
+    const std::string bar(60, '=');
+    const size_t padding = metric.title.size() < 60 ? 60 - metric.title.size() : 0;
+    std::cout << "\n\033[42m" << bar << "\033[0m\n"
+              << "\033[42m" << std::string(padding / 2, ' ') << metric.title
+              << std::string(padding - padding / 2, ' ') << "\033[0m\n"
+              << "\033[42m" << bar << "\033[0m\n";
+
+    for (const auto& group : groups) {
+      std::cout << "\n\033[94mGroup: \033[1m" << group.name << "\033[0m \033[90m(";
+      for (size_t file = 0; file < group.log_files.size(); file++) {
+        std::cout << (file ? ", " : "") << group.log_files[file];
+      }
+      std::cout << ")\033[0m\n--------------------\n";
+
+      const LatencySketch* first_latencies = nullptr;
+      for (size_t path = 0; path < group.paths.size(); path++) {
+        const LatencySketch& latencies = group.latencies[path];
+        if (latencies.count() == 0) { continue; }
+        if (!first_latencies) { first_latencies = &latencies; }
+        std::cout << "\033[1mPath:\033[0m " << group.paths[path] << ": \033[1m\033[94m"
+                  << metric.format(metric.value(latencies)) << " ms\033[0m\n";
+      }
+      // Like analyze.py, only the first path of a group is reported to CDash and the CSV files,
+      // after all paths of the group are printed
+      if (!first_latencies) { continue; }
+      const std::string value = metric.format(metric.value(*first_latencies));
+      if (options.cdash) {
+        std::cout << "<CTestMeasurement type=\"numeric/double\" " << metric.cdash_name << "_"
+                  << group.name << "\">" << value << "</CTestMeasurement>\n";
+      }
+      if (options.save_csv) { std::ofstream(metric.csv_file, std::ios::app) << value << ","; }
+    }
+  }
+  std::cout << std::flush;
+}
+
+bool write_json(const std::vector<Group>& groups, const Options& options) {
+  std::ofstream out(options.json_file);
+  if (!out) { return false; }
+  out << std::fixed << std::setprecision(3);
+  out << "{\n  \"groups\": [";
+  for (size_t g = 0; g < groups.size(); g++) {
+    const Group& group = groups[g];
+    out << (g ? "," : "") << "\n    {\n      \"name\": " << json_string(group.name)
+        << ",\n      \"log_files\": [";
+    for (size_t file = 0; file < group.log_files.size(); file++) {
+      out << (file ? ", " : "") << json_string(group.log_files[file]);
+    }
+    out << "],\n      \"paths\": [";
+    bool first_path = true;
+    for (size_t path = 0; path < group.paths.size(); path++) {
+      const LatencySketch& s = group.latencies[path];
+      if (s.count() == 0) { continue; }
+      out << (first_path ? "" : ",") << "\n        {\"path\": " << json_string(group.paths[path])
+          << ", \"count\": " << s.count() << ", \"max_ms\": " << s.max_ms()
+          << ", \"avg_ms\": " << s.mean_ms() << ", \"median_ms\": " << s.median_ms()
+          << ", \"stddev_ms\": " << s.stddev_ms() << ", \"min_ms\": " << s.min_ms()
+          << ", \"tail_ms\": " << s.percentile_ms(100) - s.percentile_ms(95)
+          << ", \"flatness_ms\": " << s.percentile_ms(90) - s.percentile_ms(10)
+          << ", \"percentiles_ms\": {";
+      for (size_t p = 0; p < options.percentiles.size(); p++) {
+        out << (p ? ", " : "") << json_string(format_percentile(options.percentiles[p])) << ": "
+            << s.percentile_ms(options.percentiles[p]);
+      }
+      out << "}}";
+      first_path = false;
+    }
+    out << "\n      ]\n    }";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+bool write_csv(const std::vector<Group>& groups, const Options& options) {
+  std::ofstream out(options.csv_file);
+  if (!out) { return false; }
+  out << std::fixed << std::setprecision(3);
+  out << "group,path,count,max_ms,avg_ms,median_ms,stddev_ms,min_ms,tail_ms,flatness_ms";
+  for (const double percentile : options.percentiles) {
+    out << ",percentile_" << format_percentile(percentile) << "_ms";
+  }
+  out << "\n";
+  for (const auto& group : groups) {
+    for (size_t path = 0; path < group.paths.size(); path++) {
+      const LatencySketch& s = group.latencies[path];
+      if (s.count() == 0) { continue; }
+      out << csv_string(group.name) << "," << csv_string(group.paths[path]) << "," << s.count()
+          << "," << s.max_ms() << "," << s.mean_ms() << "," << s.median_ms() << ","
+          << s.stddev_ms() << "," << s.min_ms() << ","
+          << s.percentile_ms(100) - s.percentile_ms(95) << ","
+          << s.percentile_ms(90) - s.percentile_ms(10);
+      for (const double percentile : options.percentiles) {
+        out << "," << s.percentile_ms(percentile);
+      }
+      out << "\n";
+    }
+  }
+  return static_cast<bool>(out);
+}
+
+// CDF of every path, the data of the --draw-cdf-paths graph of analyze.py
+bool write_cdf(const std::vector<Group>& groups, const Options& options) {
+  std::ofstream out(options.cdf_file);
+  if (!out) { return false; }
+  out << std::fixed << std::setprecision(6);
+  out << "group,path,latency_ms,cdf\n";
+  for (const auto& group : groups) {
+    for (size_t path = 0; path < group.paths.size(); path++) {
+      for (const auto& point : group.latencies[path].cdf()) {
+        out << csv_string(group.name) << "," << csv_string(group.paths[path]) << ","
+            << point.first << "," << point.second << "\n";
+      }
+    }
+  }
+  return static_cast<bool>(out);
+}
+
+void print_usage(const char* program) {
+  std::cout
+      << "Usage: " << program << " -g <log files> [group name] [-g ...] [options]\n\n"
+      << "Analyzes the log files generated by the data flow tracking of Holoscan SDK.\n\n"
+      << "  -g, --group-log-files   a group of log files to combine and analyze, optionally\n"
+      << "                          followed by a group name\n"
+      << "  -m, --max               show the maximum latencies for all paths\n"
+      << "  -a, --avg               show the average latencies for all paths\n"
+      << "  --median                show the median latencies for all paths\n"
+      << "  --stddev                show the standard deviation of latencies for all paths\n"
+      << "  --min                   show the minimum latencies for all paths\n"
+      << "  --tail                  show the difference between 95 and 100 percentile latencies\n"
+      << "  --flatness              show the difference between 10 and 90 percentile latencies\n"
+      << "  -p, --percentile        list of percentiles (e.g. '90 95 99 99.9') to show\n"
+      << "  --save-csv              save the metric of the first path of every group to\n"
+      << "                          <metric>_values.csv, as analyze.py\n"
+      << "  --cdash                 write out the values for CTest/CDash\n"
+      << "  --json <file>           write all metrics of all paths as JSON\n"
+      << "  --csv <file>            write all metrics of all paths as CSV\n"
+      << "  --cdf <file>            write the latency CDF of all paths as CSV\n"
+      << "  --skip-begin <n>        messages left out at the beginning of each path (10)\n"
+      << "  --discard-last <n>      messages left out at the end of each path (10)\n"
+      << "  -j, --threads <n>       parser threads (number of CPUs)\n";
+}
+
+bool parse_arguments(int argc, char** argv, Options& options) {
+  const auto values = [argc, argv](int& index) {
+    std::vector<std::string> result;
+    while (index + 1 < argc && (argv[index + 1][0] != '-' || argv[index + 1][1] == '\0')) {
+      result.push_back(argv[++index]);
+    }
+    return result;
+  };
+  const auto value = [argc, argv](int& index, std::string& result) {
+    if (index + 1 >= argc) { return false; }
+    result = argv[++index];
+    return true;
+  };
+
+  for (int index = 1; index < argc; index++) {
+    const std::string arg = argv[index];
+    std::string text;
+    if (arg == "-g" || arg == "--group-log-files") {
+      options.groups.push_back(values(index));
+    } else if (arg == "-p" || arg == "--percentile") {
+      for (const auto& percentile : values(index)) {
+        options.percentiles.push_back(std::stod(percentile));
+      }
+    } else if (arg == "-m" || arg == "--max") {
+      options.max = true;
+    } else if (arg == "-a" || arg == "--avg") {
+      options.avg = true;
+    } else if (arg == "--median") {
+      options.median = true;
+    } else if (arg == "--stddev") {
+      options.stddev = true;
+    } else if (arg == "--min") {
+      options.min = true;
+    } else if (arg == "--tail") {
+      options.tail = true;
+    } else if (arg == "--flatness") {
+      options.flatness = true;
+    } else if (arg == "--save-csv") {
+      options.save_csv = true;
+    } else if (arg == "--cdash") {
+      options.cdash = true;
+    } else if (arg == "--json" && value(index, text)) {
+      options.json_file = text;
+    } else if (arg == "--csv" && value(index, text)) {
+      options.csv_file = text;
+    } else if (arg == "--cdf" && value(index, text)) {
+      options.cdf_file = text;
+    } else if (arg == "--skip-begin" && value(index, text)) {
+      options.skip_begin_messages = std::stoul(text);
+    } else if (arg == "--discard-last" && value(index, text)) {
+      options.discard_last_messages = std::stoul(text);
+    } else if ((arg == "-j" || arg == "--threads") && value(index, text)) {
+      options.threads = std::max(std::stoul(text), 1UL);
+    } else if (arg == "-h" || arg == "--help") {
+      print_usage(argv[0]);
+      std::exit(0);
+    } else {
+      std::cerr << "Unknown or incomplete option '" << arg << "'" << std::endl;
+      return false;
+    }
+  }
+  if (options.groups.empty()) {
+    std::cerr << "At least one group of log files (-g) is required" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  try {
+    if (!parse_arguments(argc, argv, options)) {
+      print_usage(argv[0]);
+      return 1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Invalid argument: " << e.what() << std::endl;
+    return 1;
+  }
+
+  // Tell CTest to send the full output to CDash
+  if (options.cdash) { std::cout << "CTEST_FULL_OUTPUT" << std::endl; }
+
+  FlowLogReader reader(options.threads);
+  std::vector<Group> groups;
+  int group_counter = 1;
+  for (auto& files : options.groups) {
+    Group group;
+    // if the last entry has no dot, it's the name of the group
+    if (!files.empty() && files.back().find('.') == std::string::npos) {
+      group.name = files.back();
+      files.pop_back();
+    } else {
+      group.name = "Group" + std::to_string(group_counter++);
+    }
+    if (files.empty()) {
+      std::cerr << "\033[91mError: No log files provided for group: " << group.name << "\033[0m"
+                << std::endl;
+      return 1;
+    }
+    group.log_files = files;
+    try {
+      for (const auto& log_file : files) { analyze_log_file(log_file, options, reader, group); }
+    } catch (const std::exception& e) {
+      std::cerr << "\033[91mError: " << e.what() << "\033[0m" << std::endl;
+      return 1;
+    }
+    groups.push_back(std::move(group));
+  }
+
+  print_metrics(groups, options);
+
+  const std::vector<std::pair<std::string, bool (*)(const std::vector<Group>&, const Options&)>>
+      outputs = {{options.json_file, write_json},
+                 {options.csv_file, write_csv},
+                 {options.cdf_file, write_cdf}};
+  for (const auto& output : outputs) {
+    if (output.first.empty()) { continue; }
+    if (!output.second(groups, options)) {
+      std::cerr << "\033[91mError: Failed to write " << output.first << "\033[0m" << std::endl;
+      return 1;
+    }
+    std::cout << "Saved " << output.first << std::endl;
+  }
+  return 0;
+}
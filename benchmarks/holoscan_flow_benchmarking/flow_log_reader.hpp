@@ -0,0 +1,309 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_FLOW_BENCHMARKING_FLOW_LOG_READER_HPP
+#define HOLOSCAN_FLOW_BENCHMARKING_FLOW_LOG_READER_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace holohub::flow_benchmarking {
+
+// Separator of the operator names of a path, as used by analyze.py
+constexpr char kPathSeparator[] = "→ ";
+
+/**
+ * @brief One line of the flow tracking log:
+ * (Operator1,receive timestamp,publish timestamp) -> ... -> (OperatorN,receive,publish)
+ *
+ * Only the stamps needed for the end-to-end latency and to detect duplicate lines are kept.
+ */
+struct FlowRecord {
+  uint32_t path;  // index into the path names of the parser that produced the record
+  int64_t first_receive;
+  int64_t first_publish;
+  int64_t last_publish;
+
+  int64_t latency_us() const { return last_publish - first_receive; }
+};
+
+/**
+ * @brief Paths seen by one parser, each path is stored once and referred to by its index.
+ */
+class PathTable {
+ public:
+  uint32_t intern(const std::string& path) {
+    auto it = ids_.find(path);
+    if (it != ids_.end()) { return it->second; }
+    const auto id = static_cast<uint32_t>(names_.size());
+    ids_.emplace(path, id);
+    names_.push_back(path);
+    return id;
+  }
+
+  const std::vector<std::string>& names() const { return names_; }
+
+ private:
+  std::unordered_map<std::string, uint32_t> ids_;
+  std::vector<std::string> names_;
+};
+
+/**
+ * @brief Receive and publish timestamps of one operator on a path.
+ */
+struct FlowStamp {
+  std::string_view name;
+  int64_t receive;
+  int64_t publish;
+};
+
+/**
+ * @brief Splits one log line into the stamps of its operators, in path order.
+ *
+ * @return false if the line is not a flow tracking line
+ */
+inline bool parse_flow_stamps(const char* begin, const char* end, std::vector<FlowStamp>& stamps) {
+  const auto skip_spaces = [end](const char* p) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) { p++; }
+    return p;
+  };
+  const auto parse_stamp = [end, &skip_spaces](const char*& p, char terminator, int64_t& stamp) {
+    p = skip_spaces(p);
+    const auto result = std::from_chars(p, end, stamp);
+    if (result.ec != std::errc()) { return false; }
+    p = skip_spaces(result.ptr);
+    if (p == end || *p != terminator) { return false; }
+    p++;
+    return true;
+  };
+
+  stamps.clear();
+  const char* p = begin;
+  while (true) {
+    if (p == end || *p != '(') { return false; }
+    const char* name = ++p;
+    while (p < end && *p != ',') { p++; }
+    if (p == end) { return false; }
+    FlowStamp stamp{std::string_view(name, p - name), 0, 0};
+    p++;
+    if (!parse_stamp(p, ',', stamp.receive) || !parse_stamp(p, ')', stamp.publish)) {
+      return false;
+    }
+    stamps.push_back(stamp);
+
+    p = skip_spaces(p);
+    if (p == end) { return true; }
+    if (end - p < 2 || p[0] != '-' || p[1] != '>') { return false; }
+    p = skip_spaces(p + 2);
+  }
+}
+
+/**
+ * @brief Joins the operator names of a path, as analyze.py.
+ */
+inline void flow_path_name(const std::vector<FlowStamp>& stamps, std::string& path) {
+  path.clear();
+  for (size_t index = 0; index < stamps.size(); index++) {
+    if (index > 0) { path += kPathSeparator; }
+    path += stamps[index].name;
+  }
+}
+
+/**
+ * @brief Parses one log line into `record`, the path goes through `path`.
+ *
+ * @return false if the line is not a flow tracking line
+ */
+inline bool parse_flow_line(const char* begin, const char* end, std::vector<FlowStamp>& stamps,
+                            std::string& path, PathTable& paths, FlowRecord& record) {
+  if (!parse_flow_stamps(begin, end, stamps)) { return false; }
+  flow_path_name(stamps, path);
+  record.path = paths.intern(path);
+  record.first_receive = stamps.front().receive;
+  record.first_publish = stamps.front().publish;
+  record.last_publish = stamps.back().publish;
+  return true;
+}
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& file_name) {
+    fd_ = open(file_name.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      throw std::runtime_error("Failed to open " + file_name + ": " + std::strerror(errno));
+    }
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0) {
+      close(fd_);
+      throw std::runtime_error("Failed to stat " + file_name + ": " + std::strerror(errno));
+    }
+    size_ = file_stat.st_size;
+    if (size_ == 0) { return; }
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (data == MAP_FAILED) {
+      close(fd_);
+      throw std::runtime_error("Failed to map " + file_name + ": " + std::strerror(errno));
+    }
+    data_ = static_cast<const char*>(data);
+    madvise(data, size_, MADV_SEQUENTIAL);
+  }
+
+  ~MappedFile() {
+    if (data_) { munmap(const_cast<char*>(data_), size_); }
+    close(fd_);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  /// Drop the pages of a range which was read from the resident set
+  void release(size_t offset, size_t size) const {
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const size_t begin = offset / page * page;
+    if (size == 0) { return; }
+    madvise(const_cast<char*>(data_) + begin, offset + size - begin, MADV_DONTNEED);
+  }
+
+ private:
+  int fd_ = -1;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief Streams a flow tracking log through a memory mapping.
+ *
+ * The file is read in windows of `threads` chunks which end at line boundaries. The chunks of a
+ * window are parsed in parallel, each by its own parser with its own path table, and then handed
+ * to the consumer in file order, so that duplicate lines can be detected across chunks. Memory use
+ * depends on the window size, not on the size of the log.
+ */
+class FlowLogReader {
+ public:
+  /**
+   * @param threads number of parser threads, at least one
+   * @param chunk_bytes bytes of the log parsed by a thread per window
+   */
+  explicit FlowLogReader(unsigned threads, size_t chunk_bytes = 16 << 20)
+      : parsers_(std::max(threads, 1U)), chunk_bytes_(std::max<size_t>(chunk_bytes, 4096)) {}
+
+  /**
+   * @brief Parses a log file.
+   *
+   * @param consume called with (parser index, records of a chunk, path names of that parser) for
+   * each chunk in file order; path indices of the records refer to the path names
+   * @return number of malformed flow tracking lines, which were skipped
+   */
+  template <typename Consume>
+  uint64_t read(const std::string& file_name, Consume&& consume) {
+    MappedFile file(file_name);
+    for (auto& parser : parsers_) { parser = Parser(); }
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    std::vector<std::thread> threads;
+    size_t offset = 0;
+    while (offset < file.size()) {
+      // Split the next window at line ends
+      chunks.clear();
+      size_t begin = offset;
+      while (chunks.size() < parsers_.size() && begin < file.size()) {
+        const size_t limit = std::min(file.size(), begin + chunk_bytes_);
+        const void* line_end =
+            limit < file.size() ? memchr(file.data() + limit, '\n', file.size() - limit) : nullptr;
+        const size_t end =
+            line_end ? static_cast<const char*>(line_end) - file.data() + 1 : file.size();
+        chunks.emplace_back(begin, end);
+        begin = end;
+      }
+
+      threads.clear();
+      for (size_t index = 1; index < chunks.size(); index++) {
+        threads.emplace_back(
+            [this, &file, &chunks, index]() { parsers_[index].parse(file.data(), chunks[index]); });
+      }
+      parsers_[0].parse(file.data(), chunks[0]);
+      for (auto& thread : threads) { thread.join(); }
+
+      for (size_t index = 0; index < chunks.size(); index++) {
+        consume(index, parsers_[index].records, parsers_[index].paths.names());
+      }
+      file.release(offset, begin - offset);
+      offset = begin;
+    }
+
+    uint64_t skipped = 0;
+    for (const auto& parser : parsers_) { skipped += parser.skipped_lines; }
+    return skipped;
+  }
+
+ private:
+  struct Parser {
+    void parse(const char* data, std::pair<size_t, size_t> chunk) {
+      records.clear();
+      const char* line = data + chunk.first;
+      const char* end = data + chunk.second;
+      while (line < end) {
+        const char* line_end = static_cast<const char*>(memchr(line, '\n', end - line));
+        if (!line_end) { line_end = end; }
+        // Other output in the log is skipped, as by log_parser.py
+        if (line < line_end && *line == '(') {
+          FlowRecord record;
+          if (parse_flow_line(line, line_end, stamps, path, paths, record)) {
+            records.push_back(record);
+          } else {
+            skipped_lines++;
+          }
+        }
+        line = line_end + 1;
+      }
+    }
+
+    PathTable paths;
+    std::vector<FlowRecord> records;
+    std::vector<FlowStamp> stamps;
+    std::string path;
+    uint64_t skipped_lines = 0;
+  };
+
+  std::vector<Parser> parsers_;
+  size_t chunk_bytes_;
+};
+
+}  // namespace holohub::flow_benchmarking
+
+#endif /* HOLOSCAN_FLOW_BENCHMARKING_FLOW_LOG_READER_HPP */
@@ -0,0 +1,607 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_FLOW_BENCHMARKING_FLOW_TELEMETRY_HPP
+#define HOLOSCAN_FLOW_BENCHMARKING_FLOW_TELEMETRY_HPP
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "holoscan/logger/logger.hpp"
+
+#include "flow_log_reader.hpp"
+#include "latency_sketch.hpp"
+
+namespace holohub::flow_benchmarking {
+
+/// Sketch of the live telemetry, with a relative error of at most 0.8% in a few kB per metric
+using TelemetrySketch = BasicLatencySketch<7>;
+
+/**
+ * @brief Latencies of a sliding window and of the whole run.
+ *
+ * The window is split into slots by the log timestamps; a slot is cleared and reused once the
+ * timestamps move past the window, so memory does not grow with the length of the run.
+ */
+class RollingLatency {
+ public:
+  RollingLatency(int64_t slot_us, size_t slots)
+      : slot_us_(std::max<int64_t>(slot_us, 1)), slots_(std::max<size_t>(slots, 1)),
+        slot_ids_(slots_.size(), -1) {}
+
+  void add(int64_t time_us, int64_t latency_us) {
+    total_.add(latency_us);
+    const int64_t slot = time_us / slot_us_;
+    const size_t index = slot % slots_.size();
+    // a late record of a slot which was already reused only counts for the run
+    if (slot < slot_ids_[index]) { return; }
+    if (slot > slot_ids_[index]) {
+      slots_[index].clear();
+      slot_ids_[index] = slot;
+    }
+    slots_[index].add(latency_us);
+  }
+
+  /// Latencies of the window ending at `time_us`
+  TelemetrySketch window(int64_t time_us) const {
+    const int64_t last = time_us / slot_us_;
+    TelemetrySketch window;
+    for (size_t index = 0; index < slots_.size(); index++) {
+      if (slot_ids_[index] > last - static_cast<int64_t>(slots_.size()) &&
+          slot_ids_[index] <= last) {
+        window.merge(slots_[index]);
+      }
+    }
+    return window;
+  }
+
+  const TelemetrySketch& total() const { return total_; }
+
+ private:
+  int64_t slot_us_;
+  std::vector<TelemetrySketch> slots_;
+  std::vector<int64_t> slot_ids_;
+  TelemetrySketch total_;
+};
+
+/**
+ * @brief Where and how often the live telemetry is published.
+ */
+struct FlowTelemetryConfig {
+  std::string log_file;       ///< flow tracking log which is followed
+  std::string snapshot_file;  ///< JSON snapshot written each period, none if empty
+  std::string socket_path;    ///< Unix socket serving the snapshot over HTTP, none if empty
+  int port = 0;               ///< port on 127.0.0.1 serving the snapshot over HTTP, none if 0
+  std::chrono::milliseconds period{1000};
+  std::chrono::seconds window{60};
+
+  bool enabled() const { return !snapshot_file.empty() || !socket_path.empty() || port > 0; }
+
+  /**
+   * @brief Reads the configuration from the HOLOSCAN_FLOW_TELEMETRY_* environment variables.
+   *
+   * Telemetry is enabled if HOLOSCAN_FLOW_TELEMETRY_PORT, HOLOSCAN_FLOW_TELEMETRY_SOCKET or
+   * HOLOSCAN_FLOW_TELEMETRY_FILE is set.
+   */
+  static FlowTelemetryConfig from_environment(const std::string& log_file) {
+    FlowTelemetryConfig config;
+    config.log_file = log_file;
+    if (const char* value = std::getenv("HOLOSCAN_FLOW_TELEMETRY_FILE")) {
+      config.snapshot_file = value;
+    }
+    if (const char* value = std::getenv("HOLOSCAN_FLOW_TELEMETRY_SOCKET")) {
+      config.socket_path = value;
+    }
+    if (const char* value = std::getenv("HOLOSCAN_FLOW_TELEMETRY_PORT")) {
+      config.port = std::atoi(value);
+    }
+    if (const char* value = std::getenv("HOLOSCAN_FLOW_TELEMETRY_PERIOD_MS")) {
+      config.period = std::chrono::milliseconds(std::max(std::atoi(value), 10));
+    }
+    if (const char* value = std::getenv("HOLOSCAN_FLOW_TELEMETRY_WINDOW_S")) {
+      config.window = std::chrono::seconds(std::max(std::atoi(value), 1));
+    }
+    return config;
+  }
+};
+
+/**
+ * @brief Live latency telemetry of a running application.
+ *
+ * Follows the flow tracking log while the application writes it and keeps, per path, the
+ * end-to-end latency and throughput, per operator, the execution time from receive to publish,
+ * and per connection, the time a message waits between the publish of one operator and the
+ * receive of the next. Each metric has the percentiles of the last `window` seconds and of the
+ * whole run. Latencies are binned by the log timestamps, so the window follows the application
+ * even if the log is flushed in bursts.
+ *
+ * Every `period` a JSON snapshot is built, written to the snapshot file and served over HTTP on
+ * 127.0.0.1 and/or a Unix socket, e.g. `curl localhost:<port>` or
+ * `curl --unix-socket <path> localhost`. Everything runs on two threads of its own, the
+ * application threads are not touched.
+ */
+class FlowTelemetry {
+ public:
+  explicit FlowTelemetry(FlowTelemetryConfig config) : config_(std::move(config)) {}
+
+  ~FlowTelemetry() { stop(); }
+
+  FlowTelemetry(const FlowTelemetry&) = delete;
+  FlowTelemetry& operator=(const FlowTelemetry&) = delete;
+
+  /// Starts following the log and serving the snapshot, endpoints which fail are skipped
+  void start() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (running_) { return; }
+      running_ = true;
+    }
+    if (config_.port > 0) { listen_tcp(); }
+    if (!config_.socket_path.empty()) { listen_unix(); }
+    collector_ = std::thread([this]() { collect(); });
+    if (!listen_fds_.empty()) { server_ = std::thread([this]() { serve(); }); }
+  }
+
+  /// Reads what is left of the log, publishes a last snapshot and stops the threads
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) { return; }
+      running_ = false;
+    }
+    wake_.notify_all();
+    if (collector_.joinable()) { collector_.join(); }
+    if (server_.joinable()) { server_.join(); }
+    for (int fd : listen_fds_) { close(fd); }
+    listen_fds_.clear();
+    if (!config_.socket_path.empty()) { unlink(config_.socket_path.c_str()); }
+    if (log_fd_ >= 0) {
+      close(log_fd_);
+      log_fd_ = -1;
+    }
+  }
+
+  /// Latest JSON snapshot
+  std::string snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return snapshot_;
+  }
+
+ private:
+  static constexpr size_t kReadSize = 1 << 20;
+  // Lines longer than this are not flow tracking lines and are dropped
+  static constexpr size_t kMaxLineSize = 1 << 20;
+  // Number of slots the window is split into
+  static constexpr size_t kWindowSlots = 12;
+  // How long the threads sleep when there is nothing to do
+  static constexpr auto kPollInterval = std::chrono::milliseconds(100);
+
+  struct PathMetrics {
+    explicit PathMetrics(std::string path_name, int64_t slot_us)
+        : name(std::move(path_name)), latency(slot_us, kWindowSlots) {}
+    std::string name;
+    RollingLatency latency;
+    int64_t first_receive = -1;
+    int64_t first_publish = -1;
+    int64_t last_publish = -1;
+  };
+
+  // Execution time of an operator and wait time of a connection; an operator on several paths
+  // appears on several lines for the same message, which is counted once
+  struct StageMetrics {
+    explicit StageMetrics(int64_t slot_us) : latency(slot_us, kWindowSlots) {}
+    RollingLatency latency;
+    int64_t last_begin = -1;
+    int64_t last_end = -1;
+  };
+
+  void collect() {
+    auto next_snapshot = std::chrono::steady_clock::now();
+    while (true) {
+      bool stopping;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping = !running_;
+      }
+      const bool read = read_log();
+      const auto now = std::chrono::steady_clock::now();
+      if (stopping || now >= next_snapshot) {
+        publish(make_snapshot());
+        next_snapshot = now + config_.period;
+      }
+      if (stopping) { break; }
+      if (!read) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait_for(lock, std::min<std::chrono::milliseconds>(kPollInterval, config_.period),
+                       [this]() { return !running_; });
+      }
+    }
+  }
+
+  // Reads the lines appended to the log since the last call, returns false if there were none
+  bool read_log() {
+    if (log_fd_ < 0) {
+      log_fd_ = open(config_.log_file.c_str(), O_RDONLY);
+      if (log_fd_ < 0) { return false; }
+    }
+    struct stat file_stat;
+    if (fstat(log_fd_, &file_stat) == 0 && file_stat.st_size < log_offset_) {
+      // the log was truncated, e.g. by a new run with the same file name
+      log_offset_ = 0;
+      pending_.clear();
+    }
+
+    bool read_any = false;
+    std::vector<char> buffer(kReadSize);
+    while (true) {
+      const ssize_t size = pread(log_fd_, buffer.data(), buffer.size(), log_offset_);
+      if (size <= 0) { break; }
+      log_offset_ += size;
+      read_any = true;
+
+      const char* begin = buffer.data();
+      const char* end = begin + size;
+      while (begin < end) {
+        const char* line_end = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        if (!line_end) {
+          // keep the start of a line which is still being written
+          pending_.append(begin, end);
+          if (pending_.size() > kMaxLineSize) { pending_.clear(); }
+          break;
+        }
+        if (pending_.empty()) {
+          add_line(begin, line_end);
+        } else {
+          pending_.append(begin, line_end);
+          add_line(pending_.data(), pending_.data() + pending_.size());
+          pending_.clear();
+        }
+        begin = line_end + 1;
+      }
+    }
+    return read_any;
+  }
+
+  void add_line(const char* begin, const char* end) {
+    if (begin == end || *begin != '(' || !parse_flow_stamps(begin, end, stamps_)) { return; }
+    const auto& first = stamps_.front();
+    const auto& last = stamps_.back();
+    if (first_us_ < 0) { first_us_ = first.receive; }
+    latest_us_ = std::max(latest_us_, last.publish);
+
+    flow_path_name(stamps_, path_);
+    auto& path = path_metrics(path_);
+    // analyze.py drops a line repeating the previous message of the path
+    const bool duplicate = first.receive == path.first_receive &&
+                           first.publish == path.first_publish &&
+                           std::abs(last.publish - path.last_publish) <= 20;
+    path.first_receive = first.receive;
+    path.first_publish = first.publish;
+    path.last_publish = last.publish;
+    if (!duplicate) { path.latency.add(last.publish, last.publish - first.receive); }
+
+    for (size_t index = 0; index < stamps_.size(); index++) {
+      const auto& stamp = stamps_[index];
+      add_stage(stage_metrics(operators_, std::string(stamp.name)), stamp.receive, stamp.publish);
+      if (index > 0) {
+        const auto& previous = stamps_[index - 1];
+        key_.assign(previous.name);
+        key_ += kPathSeparator;
+        key_ += stamp.name;
+        add_stage(stage_metrics(queue_waits_, key_), previous.publish, stamp.receive);
+      }
+    }
+  }
+
+  static void add_stage(StageMetrics& stage, int64_t begin, int64_t end) {
+    if (begin == stage.last_begin && end == stage.last_end) { return; }
+    stage.last_begin = begin;
+    stage.last_end = end;
+    stage.latency.add(end, end - begin);
+  }
+
+  PathMetrics& path_metrics(const std::string& name) {
+    auto it = path_ids_.find(name);
+    if (it == path_ids_.end()) {
+      it = path_ids_.emplace(name, paths_.size()).first;
+      paths_.emplace_back(name, slot_us());
+    }
+    return paths_[it->second];
+  }
+
+  StageMetrics& stage_metrics(std::map<std::string, StageMetrics>& stages,
+                              const std::string& name) {
+    auto it = stages.find(name);
+    if (it == stages.end()) { it = stages.emplace(name, StageMetrics(slot_us())).first; }
+    return it->second;
+  }
+
+  int64_t slot_us() const {
+    const int64_t window_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(config_.window).count();
+    return (window_us + kWindowSlots - 1) / kWindowSlots;
+  }
+
+  static void append(std::string& json, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    const int size = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    json.append(buffer, std::min<size_t>(std::max(size, 0), sizeof(buffer) - 1));
+  }
+
+  static void append_string(std::string& json, const std::string& value) {
+    json += '"';
+    for (const char c : value) {
+      if (c == '"' || c == '\\') {
+        json += '\\';
+        json += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        append(json, "\\u%04x", c);
+      } else {
+        json += c;
+      }
+    }
+    json += '"';
+  }
+
+  static void append_stats(std::string& json, const char* name, const TelemetrySketch& sketch) {
+    append(json,
+           "\"%s\": {\"count\": %lu, \"min_ms\": %.3f, \"avg_ms\": %.3f, \"p50_ms\": %.3f, "
+           "\"p90_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f}",
+           name,
+           static_cast<unsigned long>(sketch.count()),
+           sketch.min_ms(),
+           sketch.mean_ms(),
+           sketch.percentile_ms(50),
+           sketch.percentile_ms(90),
+           sketch.percentile_ms(99),
+           sketch.max_ms());
+  }
+
+  void append_metrics(std::string& json, const RollingLatency& latency, double window_s) const {
+    const auto window = latency.window(latest_us_);
+    append(json, "\"throughput_hz\": %.3f, ", window_s > 0 ? window.count() / window_s : 0.0);
+    append_stats(json, "window", window);
+    json += ", ";
+    append_stats(json, "total", latency.total());
+  }
+
+  std::string make_snapshot() const {
+    // The window starts with its oldest slot and ends at the latest timestamp, so it is a bit
+    // shorter than configured, and shorter still at the start of the run
+    const int64_t window_begin_us =
+        (latest_us_ / slot_us() - static_cast<int64_t>(kWindowSlots) + 1) * slot_us();
+    const double window_s =
+        first_us_ < 0 ? 0.0 : (latest_us_ - std::max(window_begin_us, first_us_)) / 1e6;
+
+    std::string json = "{\n  \"log_file\": ";
+    append_string(json, config_.log_file);
+    append(json,
+           ",\n  \"time_us\": %ld,\n  \"window_s\": %.3f,\n",
+           static_cast<long>(latest_us_),
+           window_s);
+
+    json += "  \"paths\": [";
+    for (size_t index = 0; index < paths_.size(); index++) {
+      json += index ? ",\n    {\"path\": " : "\n    {\"path\": ";
+      append_string(json, paths_[index].name);
+      json += ", ";
+      append_metrics(json, paths_[index].latency, window_s);
+      json += "}";
+    }
+    json += "\n  ],\n  \"operators\": [";
+    const char* separator = "\n";
+    for (const auto& [name, stage] : operators_) {
+      json += separator;
+      json += "    {\"operator\": ";
+      append_string(json, name);
+      json += ", ";
+      append_metrics(json, stage.latency, window_s);
+      json += "}";
+      separator = ",\n";
+    }
+    json += "\n  ],\n  \"queue_waits\": [";
+    separator = "\n";
+    for (const auto& [name, stage] : queue_waits_) {
+      const size_t split = name.find(kPathSeparator);
+      json += separator;
+      json += "    {\"from\": ";
+      append_string(json, name.substr(0, split));
+      json += ", \"to\": ";
+      append_string(json, name.substr(split + sizeof(kPathSeparator) - 1));
+      json += ", ";
+      append_metrics(json, stage.latency, window_s);
+      json += "}";
+      separator = ",\n";
+    }
+    json += "\n  ]\n}\n";
+    return json;
+  }
+
+  void publish(std::string json) {
+    if (!config_.snapshot_file.empty()) {
+      // written next to the file and renamed, so that readers never see a partial snapshot
+      const std::string temporary = config_.snapshot_file + ".tmp";
+      FILE* file = std::fopen(temporary.c_str(), "w");
+      if (file) {
+        const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+        if (std::fclose(file) == 0 && written) {
+          std::rename(temporary.c_str(), config_.snapshot_file.c_str());
+        }
+      } else if (!snapshot_file_error_) {
+        HOLOSCAN_LOG_WARN("Flow telemetry: failed to write {}: {}",
+                          temporary,
+                          std::strerror(errno));
+        snapshot_file_error_ = true;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_ = std::move(json);
+  }
+
+  void listen_tcp() {
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) { return; }
+    const int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(config_.port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, 8) != 0) {
+      HOLOSCAN_LOG_WARN("Flow telemetry: failed to listen on port {}: {}",
+                        config_.port,
+                        std::strerror(errno));
+      close(fd);
+      return;
+    }
+    HOLOSCAN_LOG_INFO("Flow telemetry served on http://127.0.0.1:{}", config_.port);
+    listen_fds_.push_back(fd);
+  }
+
+  void listen_unix() {
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) { return; }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (config_.socket_path.size() >= sizeof(address.sun_path)) {
+      HOLOSCAN_LOG_WARN("Flow telemetry: socket path {} is too long", config_.socket_path);
+      close(fd);
+      return;
+    }
+    std::strcpy(address.sun_path, config_.socket_path.c_str());
+    // a socket left behind by a previous run would make bind() fail
+    unlink(config_.socket_path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, 8) != 0) {
+      HOLOSCAN_LOG_WARN("Flow telemetry: failed to listen on {}: {}",
+                        config_.socket_path,
+                        std::strerror(errno));
+      close(fd);
+      return;
+    }
+    HOLOSCAN_LOG_INFO("Flow telemetry served on unix socket {}", config_.socket_path);
+    listen_fds_.push_back(fd);
+  }
+
+  // Answers every request with the latest snapshot, one connection at a time
+  void serve() {
+    std::vector<pollfd> fds;
+    for (int fd : listen_fds_) { fds.push_back(pollfd{fd, POLLIN, 0}); }
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) { break; }
+      }
+      const int timeout_ms = std::chrono::milliseconds(kPollInterval).count();
+      if (poll(fds.data(), fds.size(), timeout_ms) <= 0) { continue; }
+      for (const auto& fd : fds) {
+        if (fd.revents & POLLIN) { answer(fd.fd); }
+      }
+    }
+  }
+
+  void answer(int listen_fd) {
+    const int client = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client < 0) { return; }
+    // a client which does not send its request in time is not waited for
+    timeval timeout{1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    char request[1024];
+    const ssize_t size = recv(client, request, sizeof(request), 0);
+
+    std::string body;
+    const char* status = "200 OK";
+    if (size >= 4 && std::strncmp(request, "GET ", 4) == 0) {
+      body = snapshot();
+    } else {
+      status = "405 Method Not Allowed";
+    }
+    std::string response = "HTTP/1.1 ";
+    response += status;
+    response += "\r\nContent-Type: application/json\r\nContent-Length: ";
+    response += std::to_string(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+
+    size_t sent = 0;
+    while (sent < response.size()) {
+      const ssize_t result =
+          send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+      if (result <= 0) { break; }
+      sent += result;
+    }
+    close(client);
+  }
+
+  const FlowTelemetryConfig config_;
+  std::thread collector_;
+  std::thread server_;
+  std::vector<int> listen_fds_;
+
+  // Guards running_ and snapshot_
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  bool running_ = false;
+  std::string snapshot_ = "{}\n";
+
+  // Owned by the collector thread
+  int log_fd_ = -1;
+  off_t log_offset_ = 0;
+  std::string pending_;
+  std::vector<FlowStamp> stamps_;
+  std::string path_;
+  std::string key_;
+  std::unordered_map<std::string, size_t> path_ids_;
+  std::vector<PathMetrics> paths_;
+  std::map<std::string, StageMetrics> operators_;
+  std::map<std::string, StageMetrics> queue_waits_;
+  int64_t first_us_ = -1;
+  int64_t latest_us_ = 0;
+  bool snapshot_file_error_ = false;
+};
+
+}  // namespace holohub::flow_benchmarking
+
+#endif /* HOLOSCAN_FLOW_BENCHMARKING_FLOW_TELEMETRY_HPP */
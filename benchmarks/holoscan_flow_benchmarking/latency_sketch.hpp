@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_FLOW_BENCHMARKING_LATENCY_SKETCH_HPP
+#define HOLOSCAN_FLOW_BENCHMARKING_LATENCY_SKETCH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace holohub::flow_benchmarking {
+
+/**
+ * @brief Streaming latency distribution in constant memory.
+ *
+ * Latencies are integer microseconds, as in the flow tracking log, and are counted in a
+ * log-linear histogram: values below 2^SubBucketBits us are kept exactly, larger ones in
+ * buckets with a relative width of at most 2^-SubBucketBits. Count, minimum, maximum, mean and
+ * standard deviation are exact. Percentiles follow analyze.py and pick the latency at index
+ * int(n * percentile / 100) of the sorted latencies.
+ *
+ * @tparam SubBucketBits precision of the histogram, memory grows with 2^SubBucketBits
+ */
+template <int SubBucketBits>
+class BasicLatencySketch {
+ public:
+  static constexpr int kSubBucketBits = SubBucketBits;
+  static constexpr uint64_t kSubBuckets = uint64_t(1) << kSubBucketBits;
+
+  void add(int64_t latency_us) {
+    const uint64_t value = static_cast<uint64_t>(std::max<int64_t>(latency_us, 0));
+    const size_t index = bucket(value);
+    if (index >= counts_.size()) { counts_.resize(index + 1, 0); }
+    counts_[index]++;
+
+    count_++;
+    min_us_ = std::min(min_us_, value);
+    max_us_ = std::max(max_us_, value);
+    // Welford's update keeps the variance exact without storing the latencies
+    const double delta = value - mean_us_;
+    mean_us_ += delta / count_;
+    m2_ += delta * (value - mean_us_);
+  }
+
+  /// Adds the latencies of another sketch
+  void merge(const BasicLatencySketch& other) {
+    if (other.count_ == 0) { return; }
+    if (other.counts_.size() > counts_.size()) { counts_.resize(other.counts_.size(), 0); }
+    for (size_t index = 0; index < other.counts_.size(); index++) {
+      counts_[index] += other.counts_[index];
+    }
+
+    const uint64_t count = count_ + other.count_;
+    const double delta = other.mean_us_ - mean_us_;
+    mean_us_ += delta * other.count_ / count;
+    m2_ += other.m2_ + delta * delta * count_ * other.count_ / count;
+    count_ = count;
+    min_us_ = std::min(min_us_, other.min_us_);
+    max_us_ = std::max(max_us_, other.max_us_);
+  }
+
+  /// Removes all latencies, keeping the memory of the histogram
+  void clear() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    min_us_ = std::numeric_limits<uint64_t>::max();
+    max_us_ = 0;
+    mean_us_ = 0.0;
+    m2_ = 0.0;
+  }
+
+  uint64_t count() const { return count_; }
+  double min_ms() const { return count_ ? min_us_ / 1e3 : 0.0; }
+  double max_ms() const { return max_us_ / 1e3; }
+  double mean_ms() const { return mean_us_ / 1e3; }
+  /// Population standard deviation, as numpy.std()
+  double stddev_ms() const { return count_ ? std::sqrt(m2_ / count_) / 1e3 : 0.0; }
+
+  double percentile_ms(double percentile) const {
+    if (count_ == 0) { return 0.0; }
+    if (percentile >= 100.0) { return max_ms(); }
+    const auto rank = static_cast<uint64_t>(count_ * percentile / 100.0);
+    return value_at(std::min(rank, count_ - 1)) / 1e3;
+  }
+
+  /// Median interpolated between the two middle latencies, as numpy.median()
+  double median_ms() const {
+    if (count_ == 0) { return 0.0; }
+    if (count_ % 2) { return value_at(count_ / 2) / 1e3; }
+    return (value_at(count_ / 2 - 1) + value_at(count_ / 2)) / 2e3;
+  }
+
+  /**
+   * @brief Points of the CDF, one per non-empty bucket.
+   *
+   * @return pairs of latency in ms and the fraction of latencies below it
+   */
+  std::vector<std::pair<double, double>> cdf() const {
+    std::vector<std::pair<double, double>> points;
+    uint64_t below = 0;
+    for (size_t index = 0; index < counts_.size(); index++) {
+      if (counts_[index] == 0) { continue; }
+      points.emplace_back(representative(index) / 1e3, static_cast<double>(below) / count_);
+      below += counts_[index];
+    }
+    return points;
+  }
+
+ private:
+  static size_t bucket(uint64_t value) {
+    if (value < kSubBuckets) { return value; }
+    const int shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+  }
+
+  // Middle of the values counted in a bucket, clamped to the observed range
+  uint64_t representative(size_t index) const {
+    if (index < kSubBuckets) { return index; }
+    const int shift = index / kSubBuckets - 1;
+    const uint64_t lower = (index % kSubBuckets + kSubBuckets) << shift;
+    const uint64_t middle = lower + ((uint64_t(1) << shift) - 1) / 2;
+    return std::clamp(middle, min_us_, max_us_);
+  }
+
+  // Latency at a rank of the sorted latencies
+  uint64_t value_at(uint64_t rank) const {
+    uint64_t below = 0;
+    for (size_t index = 0; index < counts_.size(); index++) {
+      below += counts_[index];
+      if (rank < below) { return representative(index); }
+    }
+    return max_us_;
+  }
+
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  uint64_t min_us_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_us_ = 0;
+  double mean_us_ = 0.0;
+  double m2_ = 0.0;
+};
+
+/// Sketch of the analyzer, with a relative error of at most 0.05%
+using LatencySketch = BasicLatencySketch<11>;
+
+}  // namespace holohub::flow_benchmarking
+
+#endif /* HOLOSCAN_FLOW_BENCHMARKING_LATENCY_SKETCH_HPP */
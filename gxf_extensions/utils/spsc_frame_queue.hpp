@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GXF_EXTENSIONS_UTILS_SPSC_FRAME_QUEUE_HPP
+#define GXF_EXTENSIONS_UTILS_SPSC_FRAME_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nvidia {
+namespace holoscan {
+
+/**
+ * What SpscFrameQueue::push() does when the consumer falls behind.
+ */
+enum class SpscQueueMode {
+  /// Only the newest frame is kept, a frame not popped before the next push is dropped
+  kKeepLatest,
+  /// Up to `capacity` frames are kept in order, a frame pushed to a full queue is dropped
+  kBoundedFifo,
+};
+
+/**
+ * Lock-free queue handing frames from one producer thread to one consumer thread.
+ *
+ * Meant to sit between the capture callback of a video source and the tick() function of its
+ * codelet. push() never takes a lock and never waits, the only exception is waking up a consumer
+ * blocked in pop(). Frames which are dropped are passed to the drop function on the producer
+ * thread, so that the source can give the underlying buffer back to the driver.
+ *
+ * - kKeepLatest is a triple buffer: the producer and the consumer each own a slot and exchange
+ *   them atomically with a third one, so the consumer always gets the newest frame.
+ * - kBoundedFifo is a ring buffer of `capacity` slots.
+ *
+ * Indices and slots owned by the producer and by the consumer are kept on separate cache lines.
+ *
+ * Usage:
+ * - push() is called from the producer thread only
+ * - try_pop() and pop() are called from the consumer thread only
+ * - close() makes a blocked pop() return, e.g. when the signal is lost or the source is stopped;
+ *   open() makes pop() wait for frames again
+ *
+ * @tparam T frame type, must be default constructible and movable
+ */
+template <typename T>
+class SpscFrameQueue {
+ public:
+  using DropFunction = std::function<void(T&)>;
+
+  /**
+   * @param mode behavior when the consumer falls behind
+   * @param capacity maximum number of queued frames for kBoundedFifo, ignored for kKeepLatest
+   * @param drop called on the producer thread with each frame which is dropped
+   */
+  explicit SpscFrameQueue(SpscQueueMode mode, size_t capacity = 4, DropFunction drop = nullptr)
+      : mode_(mode),
+        capacity_(mode == SpscQueueMode::kKeepLatest ? 1 : std::max<size_t>(capacity, 1)),
+        slots_(mode == SpscQueueMode::kKeepLatest ? 3 : capacity_),
+        drop_(std::move(drop)) {}
+
+  SpscFrameQueue(const SpscFrameQueue&) = delete;
+  SpscFrameQueue& operator=(const SpscFrameQueue&) = delete;
+
+  /**
+   * Queue a frame, called from the producer thread.
+   *
+   * @return false if the frame was dropped because a kBoundedFifo queue was full
+   */
+  bool push(T item) {
+    producer_.pushed.fetch_add(1, std::memory_order_relaxed);
+    if (mode_ == SpscQueueMode::kKeepLatest) {
+      slots_[producer_.slot].value = std::move(item);
+      const uint32_t previous =
+          shared_.latest.exchange(producer_.slot | kFresh, std::memory_order_acq_rel);
+      producer_.slot = previous & kSlotMask;
+      // the previous frame was never popped, it's superseded
+      if (previous & kFresh) { drop(slots_[producer_.slot].value); }
+    } else {
+      const uint64_t tail = producer_.index.load(std::memory_order_relaxed);
+      if (tail - producer_.cached_index == capacity_) {
+        producer_.cached_index = consumer_.index.load(std::memory_order_acquire);
+        if (tail - producer_.cached_index == capacity_) {
+          drop(item);
+          return false;
+        }
+      }
+      slots_[tail % capacity_].value = std::move(item);
+      producer_.index.store(tail + 1, std::memory_order_release);
+    }
+    wake_consumer();
+    return true;
+  }
+
+  /**
+   * Take the next frame without waiting, called from the consumer thread.
+   *
+   * @return false if there is no frame
+   */
+  bool try_pop(T& item) {
+    if (mode_ == SpscQueueMode::kKeepLatest) {
+      // only the consumer clears the fresh flag, so it can't go away between load and exchange
+      if (!(shared_.latest.load(std::memory_order_acquire) & kFresh)) { return false; }
+      consumer_.slot =
+          shared_.latest.exchange(consumer_.slot, std::memory_order_acq_rel) & kSlotMask;
+      item = std::move(slots_[consumer_.slot].value);
+    } else {
+      const uint64_t head = consumer_.index.load(std::memory_order_relaxed);
+      if (head == consumer_.cached_index) {
+        consumer_.cached_index = producer_.index.load(std::memory_order_acquire);
+        if (head == consumer_.cached_index) { return false; }
+      }
+      item = std::move(slots_[head % capacity_].value);
+      consumer_.index.store(head + 1, std::memory_order_release);
+    }
+    return true;
+  }
+
+  /**
+   * Take the next frame, waiting up to `timeout` for it, called from the consumer thread.
+   *
+   * @return false on timeout or if the queue is closed
+   */
+  template <typename Rep, typename Period>
+  bool pop(T& item, const std::chrono::duration<Rep, Period>& timeout) {
+    if (closed_.load(std::memory_order_acquire)) { return false; }
+    if (try_pop(item)) { return true; }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    consumer_waiting_.store(true, std::memory_order_seq_cst);
+    // pairs with the fence in wake_consumer(): either the producer sees the waiting flag or the
+    // predicate sees the frame
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool ready = condition_.wait_for(lock, timeout, [this] {
+      return closed_.load(std::memory_order_acquire) || has_frame();
+    });
+    consumer_waiting_.store(false, std::memory_order_relaxed);
+    if (!ready || closed_.load(std::memory_order_acquire)) { return false; }
+    return try_pop(item);
+  }
+
+  /**
+   * Make pop() return false until open() is called, wakes up a blocked consumer.
+   */
+  void close() {
+    closed_.store(true, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    condition_.notify_all();
+  }
+
+  /**
+   * Make pop() wait for frames again after close().
+   */
+  void open() { closed_.store(false, std::memory_order_release); }
+
+  /// Number of frames pushed
+  uint64_t pushed() const { return producer_.pushed.load(std::memory_order_relaxed); }
+  /// Number of frames dropped, superseded in kKeepLatest mode or pushed while full in kBoundedFifo
+  uint64_t dropped() const { return producer_.dropped.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+  static constexpr uint32_t kSlotMask = 0x3;
+  static constexpr uint32_t kFresh = 0x4;
+
+  struct alignas(kCacheLineSize) Slot {
+    T value{};
+  };
+
+  bool has_frame() const {
+    if (mode_ == SpscQueueMode::kKeepLatest) {
+      return shared_.latest.load(std::memory_order_acquire) & kFresh;
+    }
+    return producer_.index.load(std::memory_order_acquire) !=
+           consumer_.index.load(std::memory_order_relaxed);
+  }
+
+  void drop(T& item) {
+    producer_.dropped.fetch_add(1, std::memory_order_relaxed);
+    if (drop_) { drop_(item); }
+  }
+
+  void wake_consumer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting_.load(std::memory_order_relaxed)) {
+      // taking the lock makes sure the consumer is either waiting or did not check for frames yet
+      { std::lock_guard<std::mutex> lock(mutex_); }
+      condition_.notify_one();
+    }
+  }
+
+  const SpscQueueMode mode_;
+  const size_t capacity_;
+  std::vector<Slot> slots_;
+  const DropFunction drop_;
+
+  // Written by the producer
+  struct alignas(kCacheLineSize) {
+    std::atomic<uint64_t> index{0};  // kBoundedFifo: next slot to write
+    uint64_t cached_index = 0;       // kBoundedFifo: last seen consumer index
+    uint32_t slot = 0;               // kKeepLatest: slot being written
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> dropped{0};
+  } producer_;
+
+  // Written by the consumer
+  struct alignas(kCacheLineSize) {
+    std::atomic<uint64_t> index{0};  // kBoundedFifo: next slot to read
+    uint64_t cached_index = 0;       // kBoundedFifo: last seen producer index
+    uint32_t slot = 2;               // kKeepLatest: slot last popped
+  } consumer_;
+
+  // kKeepLatest: the slot exchanged between producer and consumer, with the kFresh flag if it
+  // holds a frame which was not popped yet
+  struct alignas(kCacheLineSize) {
+    std::atomic<uint32_t> latest{1};
+  } shared_;
+
+  std::atomic<bool> closed_{false};
+  std::atomic<bool> consumer_waiting_{false};
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+}  // namespace holoscan
+}  // namespace nvidia
+
+#endif /* GXF_EXTENSIONS_UTILS_SPSC_FRAME_QUEUE_HPP */
@@ -24,6 +24,7 @@
 #include <cuda_runtime.h>
 #include <npp.h>
 
+#include <chrono>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -48,6 +49,14 @@ EXPAND_FILE(no_sdk_png)
 namespace nvidia {
 namespace holoscan {
 
+// Time tick() waits for a frame before returning without output
+constexpr std::chrono::milliseconds kFrameTimeout(100);
+
+static void release_preview_frame(PreviewFrame& preview) {
+  PVOID pRCBuffer = QCAP_BUFFER_GET_RCBUFFER(preview.pFrameBuffer, preview.nFrameBufferLen);
+  QCAP_RCBUFFER_RELEASE(pRCBuffer);
+}
+
 QRETURN on_process_signal_removed(PVOID pDevice, ULONG nVideoInput, ULONG nAudioInput,
                                   PVOID pUserData) {
   struct QCAPSource* qcap = (struct QCAPSource*)pUserData;
@@ -55,7 +64,7 @@ QRETURN on_process_signal_removed(PVOID pDevice, ULONG nVideoInput, ULONG nAudio
   GXF_LOG_INFO("QCAP Source: signal removed \n");
 
   qcap->m_status = STATUS_SIGNAL_REMOVED;
-  qcap->m_queue.signal(false);
+  qcap->m_queue.close();
   return QCAP_RT_OK;
 }
 
@@ -66,7 +75,7 @@ QRETURN on_process_no_signal_detected(PVOID pDevice, ULONG nVideoInput, ULONG nA
   GXF_LOG_INFO("QCAP Source: no signal Detected \n");
 
   qcap->m_status = STATUS_NO_SIGNAL;
-  qcap->m_queue.signal(false);
+  qcap->m_queue.close();
   return QCAP_RT_OK;
 }
 
@@ -123,7 +132,7 @@ QRETURN on_process_format_changed(PVOID pDevice, ULONG nVideoInput, ULONG nAudio
       strAudioInput);
 
   qcap->m_status = STATUS_SIGNAL_LOCKED;
-  qcap->m_queue.signal(true);
+  qcap->m_queue.open();
 
   return QCAP_RT_OK;
 }
@@ -139,10 +148,8 @@ QRETURN on_process_video_preview(PVOID pDevice, double dSampleTime, BYTE* pFrame
   preview.pFrameBuffer = pFrameBuffer;
   preview.nFrameBufferLen = nFrameBufferLen;
 
-  qcap->m_queue.push_and_drop(preview, [](PreviewFrame drop) {
-    PVOID pRCBuffer = QCAP_BUFFER_GET_RCBUFFER(drop.pFrameBuffer, drop.nFrameBufferLen);
-    QCAP_RCBUFFER_RELEASE(pRCBuffer);
-  });
+  // A frame superseded before tick() took it is released by release_preview_frame()
+  qcap->m_queue.push(preview);
 
   return QCAP_RT_OK;
 }
@@ -155,7 +162,8 @@ QRETURN on_process_audio_preview(PVOID pDevice, double dSampleTime, BYTE* pFrame
 QCAPSource::QCAPSource()
     : pixel_format_(kDefaultPixelFormat),
       output_pixel_format_(kDefaultOutputPixelFormat),
-      input_type_(kDefaultInputType) {}
+      input_type_(kDefaultInputType),
+      m_queue(SpscQueueMode::kKeepLatest, 1, release_preview_frame) {}
 
 gxf_result_t QCAPSource::registerInterface(gxf::Registrar* registrar) {
   gxf::Expected<void> result;
@@ -420,7 +428,14 @@ gxf_result_t QCAPSource::stop() {
   if (m_hDevice) {
     QCAP_STOP(m_hDevice);
 
-    m_queue.quit();
+    m_queue.close();
+
+    // The callbacks stopped, release the frame tick() did not take
+    PreviewFrame preview;
+    while (m_queue.try_pop(preview)) { release_preview_frame(preview); }
+    GXF_LOG_INFO("QCAP Source: %lu frames captured, %lu dropped",
+                 m_queue.pushed(),
+                 m_queue.dropped());
 
     if (use_rdma_) {
       for (int i = 0; i < kDefaultGPUDirectRingQueueSize; i++) {
@@ -502,7 +517,7 @@ gxf_result_t QCAPSource::tick() {
   }
 
   // GXF_LOG_ERROR("QCAP Source: status %d block >>", m_status);
-  if (m_queue.pop_block(preview) == false) {
+  if (m_queue.pop(preview, kFrameTimeout) == false) {
     // GXF_LOG_ERROR("QCAP Source: status %d block <<<", m_status);
     return GXF_SUCCESS;
   }
@@ -23,7 +23,7 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
-#include "qcap_queue.hpp"
+#include "../utils/spsc_frame_queue.hpp"
 
 #include "gxf/std/codelet.hpp"
 #include "gxf/std/transmitter.hpp"
@@ -183,7 +183,8 @@ class QCAPSource : public gxf::Codelet {
   struct Image m_iSignalRemovedImage;
   struct Image m_iNoSdkImage;
 
-  threadsafe_queue_t<PreviewFrame> m_queue;
+  // Handed from the preview callback to tick(), keeps the newest frame only
+  SpscFrameQueue<PreviewFrame> m_queue;
 };
 
 }  // namespace holoscan
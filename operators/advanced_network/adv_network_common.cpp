@@ -26,6 +26,9 @@
 #if ANO_MGR_RIVERMAX
 #include "adv_network_rmax_mgr.h"
 #endif
+#if ANO_MGR_SOCKET
+#include "adv_network_socket_mgr.h"
+#endif
 
 #define ASSERT_ANO_MGR_INITIALIZED() \
   assert(g_ano_mgr != nullptr && "ANO Manager is not initialized")
@@ -264,6 +267,31 @@ AdvNetStatus adv_net_set_udp_payload(std::shared_ptr<AdvNetBurstParams> burst, i
   return adv_net_set_udp_payload(burst.get(), idx, data, len);
 }
 
+AdvNetStatus adv_net_set_udp_tx_template(int port, int q, const AdvNetUdpTxTemplate& tmpl) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->set_udp_tx_template(port, q, tmpl);
+}
+
+AdvNetStatus adv_net_set_udp_hdrs(AdvNetBurstParams* burst, uint16_t payload_len) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->set_udp_hdrs(burst, nullptr, payload_len);
+}
+
+AdvNetStatus adv_net_set_udp_hdrs(std::shared_ptr<AdvNetBurstParams> burst, uint16_t payload_len) {
+  return adv_net_set_udp_hdrs(burst.get(), payload_len);
+}
+
+AdvNetStatus adv_net_set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  if (payload_lens == nullptr) { return AdvNetStatus::NULL_PTR; }
+  return g_ano_mgr->set_udp_hdrs(burst, payload_lens, 0);
+}
+
+AdvNetStatus adv_net_set_udp_hdrs(std::shared_ptr<AdvNetBurstParams> burst,
+                                  const uint16_t* payload_lens) {
+  return adv_net_set_udp_hdrs(burst.get(), payload_lens);
+}
+
 AdvNetStatus adv_net_set_pkt_lens(AdvNetBurstParams* burst, int idx,
                                   const std::initializer_list<int>& lens) {
   ASSERT_ANO_MGR_INITIALIZED();
@@ -375,6 +403,19 @@ void adv_net_print_stats() {
   g_ano_mgr->print_stats();
 }
 
+std::vector<AdvNetQueueStats> adv_net_get_queue_stats() {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_queue_stats();
+}
+
+std::string adv_net_get_stats_json() {
+  return adv_net_stats_to_json(adv_net_get_queue_stats());
+}
+
+std::string adv_net_get_stats_prometheus() {
+  return adv_net_stats_to_prometheus(adv_net_get_queue_stats());
+}
+
 std::unordered_set<std::string> adv_net_get_port_names(const Config& conf, const std::string& dir) {
   std::unordered_set<std::string> output_ports;
   std::string default_output_name;
@@ -543,6 +584,16 @@ bool YAML::convert<holoscan::ops::AdvNetConfigYaml>::parse_rx_queue_config(
         return false;
       }
     }
+#endif
+#if ANO_MGR_SOCKET
+    if (_manager_type == holoscan::ops::AnoMgrType::SOCKET) {
+      holoscan::ops::AdvNetStatus status =
+          holoscan::ops::SocketMgr::parse_rx_queue_socket_config(q_item, q);
+      if (status != holoscan::ops::AdvNetStatus::SUCCESS) {
+        HOLOSCAN_LOG_ERROR("Failed to parse RX Queue config for socket manager");
+        return false;
+      }
+    }
 #endif
   } catch (const std::exception& e) {
     HOLOSCAN_LOG_ERROR("Error parsing RxQueueConfig: {}", e.what());
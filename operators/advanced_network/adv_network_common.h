@@ -23,6 +23,7 @@
 #include <tuple>
 #include <stdint.h>
 #include "adv_network_types.h"
+#include "adv_network_stats.h"
 #include "holoscan/holoscan.hpp"
 
 namespace holoscan::ops {
@@ -208,6 +209,45 @@ AdvNetStatus adv_net_set_udp_payload(AdvNetBurstParams* burst, int idx, void* da
 AdvNetStatus adv_net_set_udp_payload(std::shared_ptr<AdvNetBurstParams> burst, int idx, void* data,
                                      int len);
 
+/**
+ * @brief Register the Ethernet/IPv4/UDP header template of a TX queue
+ *
+ * The headers are built once here, and adv_net_set_udp_hdrs() copies them into every packet of a
+ * burst, patching only the lengths, IPv4 ID and IPv4 checksum. Call this before the first burst
+ * is built for the queue. Only one operator may build bursts for a queue using a template.
+ *
+ * @param port Port ID
+ * @param q Queue ID
+ * @param tmpl Header fields
+ * @return AdvNetStatus indicating status. Valid values are:
+ *    SUCCESS: Template registered
+ *    INVALID_PARAMETER: Header-data split point is smaller than the headers
+ */
+AdvNetStatus adv_net_set_udp_tx_template(int port, int q, const AdvNetUdpTxTemplate& tmpl);
+
+/**
+ * @brief Set headers and lengths of every packet in a burst from the queue's template
+ *
+ * Replaces per-packet calls to adv_net_set_eth_hdr(), adv_net_set_ipv4_hdr(),
+ * adv_net_set_udp_hdr() and adv_net_set_pkt_lens(). The burst must already have packets from
+ * adv_net_get_tx_pkt_burst(). With header-data split the first segment holds the template's
+ * hds_len bytes and the second segment the rest of the packet.
+ *
+ * @param burst Burst structure to populate
+ * @param payload_len UDP payload length of every packet
+ * @param payload_lens UDP payload length of each packet
+ * @return AdvNetStatus indicating status. Valid values are:
+ *    SUCCESS: Packets populated successfully
+ *    NULL_PTR: payload_lens is null
+ *    INVALID_PARAMETER: No template registered for the burst's queue
+ *    NOT_SUPPORTED: Burst has more than two segments
+ */
+AdvNetStatus adv_net_set_udp_hdrs(AdvNetBurstParams* burst, uint16_t payload_len);
+AdvNetStatus adv_net_set_udp_hdrs(std::shared_ptr<AdvNetBurstParams> burst, uint16_t payload_len);
+AdvNetStatus adv_net_set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens);
+AdvNetStatus adv_net_set_udp_hdrs(std::shared_ptr<AdvNetBurstParams> burst,
+                                  const uint16_t* payload_lens);
+
 /**
  * @brief Test if a TX burst is available
  *
@@ -412,6 +452,27 @@ void adv_net_shutdown();
  */
 void adv_net_print_stats();
 
+/**
+ * @brief Live per-queue telemetry
+ *
+ * Packet, byte and drop counters, burst fill ratio, ring and pool levels, and the RX latency
+ * distribution of every queue. Reading the stats never blocks the manager's workers, so operators
+ * can poll them while traffic is flowing to spot backpressure before packets are dropped.
+ *
+ * @returns One entry per configured queue
+ */
+std::vector<AdvNetQueueStats> adv_net_get_queue_stats();
+
+/**
+ * @brief Live per-queue telemetry as a JSON document
+ */
+std::string adv_net_get_stats_json();
+
+/**
+ * @brief Live per-queue telemetry in the Prometheus text exposition format
+ */
+std::string adv_net_get_stats_prometheus();
+
 /**
  * @brief Get the list (set) of rx/tx ports from a node
  *
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "adv_network_flow.h"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr uint32_t ETH_HDR_LEN = 14;
+constexpr uint32_t VLAN_TAG_LEN = 4;
+constexpr uint32_t IPV4_MIN_HDR_LEN = 20;
+constexpr uint32_t UDP_HDR_LEN = 8;
+constexpr uint16_t ETH_TYPE_IPV4 = 0x0800;
+constexpr uint16_t ETH_TYPE_VLAN = 0x8100;
+constexpr uint16_t ETH_TYPE_QINQ = 0x88a8;
+constexpr uint8_t IP_PROTO_UDP = 17;
+
+inline uint16_t rd16be(const uint8_t* p) {
+  return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+}  // namespace
+
+uint64_t AdvNetFlowClassifier::make_key(int match_class, uint16_t ipv4_len, uint16_t udp_src,
+                                        uint16_t udp_dst) {
+  uint64_t key = VALID_KEY;
+  if (match_class & MATCH_IPV4_LEN) { key |= static_cast<uint64_t>(ipv4_len) << 32; }
+  if (match_class & MATCH_UDP_PORTS) {
+    key |= (static_cast<uint64_t>(udp_src) << 16) | udp_dst;
+  }
+  return key;
+}
+
+bool AdvNetFlowClassifier::compile(const std::vector<FlowConfig>& flows) {
+  for (auto& t : tables_) {
+    t.entries.clear();
+    t.mask = 0;
+  }
+  active_.clear();
+  num_rules_ = 0;
+
+  std::array<std::vector<const FlowConfig*>, NUM_MATCH_CLASSES> by_class;
+  for (const auto& flow : flows) {
+    if (flow.action_.type_ != FlowType::QUEUE) {
+      HOLOSCAN_LOG_ERROR("Flow {} has an action the software classifier can't emulate",
+                         flow.name_);
+      return false;
+    }
+
+    int match_class = 0;
+    if (flow.match_.ipv4_len_ > 0) { match_class |= MATCH_IPV4_LEN; }
+    if (flow.match_.udp_src_ > 0) { match_class |= MATCH_UDP_PORTS; }
+    by_class[match_class].push_back(&flow);
+  }
+
+  for (int match_class = NUM_MATCH_CLASSES - 1; match_class >= 0; match_class--) {
+    const auto& rules = by_class[match_class];
+    if (rules.empty()) { continue; }
+
+    // Keep the load factor at or below 50% so probe sequences stay within a cache line or two
+    size_t size = 4;
+    while (size < rules.size() * 2) { size <<= 1; }
+
+    auto& table = tables_[match_class];
+    table.entries.assign(size, Entry{0, {0, 0}});
+    table.mask = size - 1;
+
+    for (const auto* flow : rules) {
+      const auto& m = flow->match_;
+      const uint64_t key = make_key(match_class, m.ipv4_len_, m.udp_src_, m.udp_dst_);
+      uint64_t slot = hash(key) & table.mask;
+      while (table.entries[slot].key != 0 && table.entries[slot].key != key) {
+        slot = (slot + 1) & table.mask;
+      }
+
+      if (table.entries[slot].key == key) {
+        HOLOSCAN_LOG_WARN("Flow {} has the same match as an earlier flow and is never used",
+                          flow->name_);
+        continue;
+      }
+
+      table.entries[slot] = Entry{key, {flow->action_.id_, flow->id_}};
+      num_rules_++;
+    }
+
+    active_.push_back(match_class);
+  }
+
+  HOLOSCAN_LOG_INFO("Compiled {} flow rules for software classification", num_rules_);
+  return true;
+}
+
+const AdvNetFlowResult* AdvNetFlowClassifier::classify(const uint8_t* pkt, uint32_t len) const {
+  if (num_rules_ == 0 || len < ETH_HDR_LEN) { return nullptr; }
+
+  uint32_t off = ETH_HDR_LEN;
+  uint16_t eth_type = rd16be(pkt + 12);
+  if (eth_type == ETH_TYPE_VLAN || eth_type == ETH_TYPE_QINQ) {
+    if (len < ETH_HDR_LEN + VLAN_TAG_LEN) { return nullptr; }
+    eth_type = rd16be(pkt + 16);
+    off += VLAN_TAG_LEN;
+  }
+
+  if (eth_type != ETH_TYPE_IPV4 || len < off + IPV4_MIN_HDR_LEN) { return nullptr; }
+
+  const uint8_t* ip = pkt + off;
+  const uint32_t ihl = (ip[0] & 0xf) * 4;
+  if ((ip[0] >> 4) != 4 || ihl < IPV4_MIN_HDR_LEN || ip[9] != IP_PROTO_UDP) { return nullptr; }
+
+  // Only the first fragment carries the UDP header
+  if ((rd16be(ip + 6) & 0x1fff) != 0) { return nullptr; }
+  if (len < off + ihl + UDP_HDR_LEN) { return nullptr; }
+
+  const uint16_t ipv4_len = rd16be(ip + 2);
+  const uint8_t* udp = ip + ihl;
+  const uint16_t udp_src = rd16be(udp);
+  const uint16_t udp_dst = rd16be(udp + 2);
+
+  for (const int match_class : active_) {
+    const auto& table = tables_[match_class];
+    const uint64_t key = make_key(match_class, ipv4_len, udp_src, udp_dst);
+    uint64_t slot = hash(key) & table.mask;
+    while (table.entries[slot].key != 0) {
+      if (table.entries[slot].key == key) { return &table.entries[slot].res; }
+      slot = (slot + 1) & table.mask;
+    }
+  }
+
+  return nullptr;
+}
+
+};  // namespace holoscan::ops
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "adv_network_types.h"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Action of the flow rule that matched a packet
+ */
+struct AdvNetFlowResult {
+  uint16_t queue;
+  uint16_t flow_id;
+};
+
+/**
+ * @brief Software implementation of the RX flow rules in the interface flows_ list
+ *
+ * Rules follow the same semantics as the rte_flow rules DpdkMgr creates: only IPv4/UDP frames
+ * (optionally with one VLAN tag) can match, the IPv4 total length is compared when ipv4_len_ is
+ * non-zero, and both UDP ports are compared when udp_src_ is non-zero. A matching packet is
+ * steered to action_.id_ and marked with the rule's id_.
+ *
+ * compile() sorts the rules into one open-addressed hash table per combination of matched fields,
+ * keyed on the masked (IPv4 length, UDP source, UDP destination) tuple. classify() probes the
+ * tables from the most to the least specific, so a lookup costs at most four hash probes no matter
+ * how many rules are configured. When two rules have the same match the first one wins.
+ */
+class AdvNetFlowClassifier {
+ public:
+  AdvNetFlowClassifier() = default;
+
+  bool compile(const std::vector<FlowConfig>& flows);
+  bool empty() const { return num_rules_ == 0; }
+  size_t size() const { return num_rules_; }
+
+  /**
+   * @brief Find the rule matching a frame
+   *
+   * @param pkt Start of the Ethernet header
+   * @param len Number of contiguous bytes available at pkt
+   * @return Matching rule's action, or nullptr if no rule matches
+   */
+  const AdvNetFlowResult* classify(const uint8_t* pkt, uint32_t len) const;
+
+ private:
+  static constexpr int MATCH_IPV4_LEN = 1;
+  static constexpr int MATCH_UDP_PORTS = 2;
+  static constexpr int NUM_MATCH_CLASSES = 4;
+  static constexpr uint64_t VALID_KEY = 1ULL << 63;
+
+  struct Entry {
+    uint64_t key;
+    AdvNetFlowResult res;
+  };
+
+  struct Table {
+    std::vector<Entry> entries;
+    uint64_t mask = 0;
+  };
+
+  static uint64_t make_key(int match_class, uint16_t ipv4_len, uint16_t udp_src, uint16_t udp_dst);
+  static uint64_t hash(uint64_t key) { return (key * 0x9E3779B97F4A7C15ULL) >> 32; }
+
+  std::array<Table, NUM_MATCH_CLASSES> tables_;
+  // Match classes with at least one rule, most specific first
+  std::vector<int> active_;
+  size_t num_rules_ = 0;
+};
+
+};  // namespace holoscan::ops
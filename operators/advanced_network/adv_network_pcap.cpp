@@ -0,0 +1,577 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include "adv_network_pcap.h"
+#include "adv_network_common.h"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr uint32_t PCAP_MAGIC_US = 0xa1b2c3d4;
+constexpr uint32_t PCAP_MAGIC_NS = 0xa1b23c4d;
+constexpr uint32_t PCAPNG_SHB = 0x0a0d0d0a;
+constexpr uint32_t PCAPNG_IDB = 1;
+constexpr uint32_t PCAPNG_SPB = 3;
+constexpr uint32_t PCAPNG_EPB = 6;
+constexpr uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1a2b3c4d;
+constexpr uint16_t OPT_ENDOFOPT = 0;
+constexpr uint16_t OPT_IF_NAME = 2;
+constexpr uint16_t OPT_IF_TSRESOL = 9;
+constexpr uint16_t OPT_EPB_PACKETID = 5;
+constexpr uint16_t OPT_EPB_QUEUE = 6;
+constexpr uint16_t LINKTYPE_ETHERNET = 1;
+
+// Fixed part of an EPB (type, length, interface, timestamp, lengths) plus trailing length
+constexpr size_t EPB_FIXED_LEN = 32;
+// epb_queue + epb_packetid + opt_endofopt
+constexpr size_t EPB_OPTS_LEN = 8 + 12 + 4;
+
+inline size_t pad4(size_t len) {
+  return (4 - (len & 3)) & 3;
+}
+
+inline uint64_t realtime_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+inline bool is_device_ptr(const void* ptr) {
+  cudaPointerAttributes attr;
+  if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+    cudaGetLastError();
+    return false;
+  }
+
+  return attr.type == cudaMemoryTypeDevice;
+}
+
+}  // namespace
+
+AdvNetBurstRecorder::~AdvNetBurstRecorder() {
+  close();
+}
+
+bool AdvNetBurstRecorder::open(const std::string& path, size_t buf_size, int num_bufs) {
+  if (is_open()) { close(); }
+
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+  if (fd_ < 0 && errno == EINVAL) {
+    HOLOSCAN_LOG_WARN("Filesystem for {} does not support O_DIRECT; using buffered writes", path);
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  }
+
+  if (fd_ < 0) {
+    HOLOSCAN_LOG_ERROR("Failed to open capture file {}: {}", path, strerror(errno));
+    return false;
+  }
+
+  buf_size_ = (buf_size + DIRECT_IO_ALIGN - 1) / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN;
+  for (int i = 0; i < std::max(num_bufs, 2); i++) {
+    auto buf = static_cast<uint8_t*>(aligned_alloc(DIRECT_IO_ALIGN, buf_size_));
+    if (buf == nullptr) {
+      HOLOSCAN_LOG_ERROR("Failed to allocate capture buffers");
+      close();
+      return false;
+    }
+    bufs_.push_back(buf);
+    free_.push_back(buf);
+  }
+
+  staging_.resize(UINT16_MAX + 1);
+  stop_ = false;
+  writer_ = std::thread(&AdvNetBurstRecorder::writer_loop, this);
+
+  // Section header block: little-endian, version 1.0, unknown section length
+  const uint32_t shb_len = 28;
+  reserve(shb_len);
+  append_u32(PCAPNG_SHB);
+  append_u32(shb_len);
+  append_u32(PCAPNG_BYTE_ORDER_MAGIC);
+  append_u16(1);
+  append_u16(0);
+  const int64_t section_len = -1;
+  append(&section_len, sizeof(section_len));
+  append_u32(shb_len);
+
+  HOLOSCAN_LOG_INFO("Recording received bursts to {}", path);
+  return true;
+}
+
+void AdvNetBurstRecorder::close() {
+  if (fd_ < 0) { return; }
+
+  // The last buffer is padded for O_DIRECT and the file truncated back to its real length
+  if (cur_ != nullptr && cur_used_ > 0) {
+    const size_t aligned = (cur_used_ + DIRECT_IO_ALIGN - 1) / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN;
+    memset(cur_ + cur_used_, 0, aligned - cur_used_);
+    submit(cur_, aligned);
+    cur_ = nullptr;
+  }
+
+  if (writer_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    writer_.join();
+  }
+
+  if (ftruncate(fd_, file_bytes_) != 0) {
+    HOLOSCAN_LOG_ERROR("Failed to truncate capture file: {}", strerror(errno));
+  }
+  ::close(fd_);
+  fd_ = -1;
+
+  for (auto buf : bufs_) { free(buf); }
+  bufs_.clear();
+  free_.clear();
+  full_.clear();
+  cur_ = nullptr;
+  next_ = nullptr;
+  cur_used_ = 0;
+  if_ids_.clear();
+
+  HOLOSCAN_LOG_INFO("Capture closed: {} packets recorded, {} dropped, {} bytes",
+                    recorded_pkts_,
+                    dropped_pkts_,
+                    file_bytes_);
+  file_bytes_ = 0;
+}
+
+uint8_t* AdvNetBurstRecorder::get_free_buf() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_.empty()) { return nullptr; }
+
+  auto buf = free_.front();
+  free_.pop_front();
+  return buf;
+}
+
+void AdvNetBurstRecorder::submit(uint8_t* buf, size_t len) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    full_.emplace_back(buf, len);
+  }
+  cv_.notify_one();
+}
+
+bool AdvNetBurstRecorder::reserve(size_t len) {
+  if (cur_ == nullptr) {
+    cur_ = get_free_buf();
+    cur_used_ = 0;
+    if (cur_ == nullptr) { return false; }
+  }
+
+  if (cur_used_ + len <= buf_size_) { return true; }
+
+  // A block may straddle two buffers, so the next one must be secured before writing any of it
+  if (next_ == nullptr) { next_ = get_free_buf(); }
+  return next_ != nullptr;
+}
+
+void AdvNetBurstRecorder::append(const void* src, size_t len) {
+  auto p = static_cast<const uint8_t*>(src);
+  file_bytes_ += len;
+  while (len > 0) {
+    const size_t n = std::min(len, buf_size_ - cur_used_);
+    memcpy(cur_ + cur_used_, p, n);
+    cur_used_ += n;
+    p += n;
+    len -= n;
+
+    if (cur_used_ == buf_size_) {
+      submit(cur_, buf_size_);
+      cur_ = next_;
+      next_ = nullptr;
+      cur_used_ = 0;
+    }
+  }
+}
+
+void AdvNetBurstRecorder::append_pad(size_t len) {
+  static constexpr uint8_t zeros[4] = {};
+  append(zeros, len);
+}
+
+bool AdvNetBurstRecorder::write_if_block(uint16_t port) {
+  const std::string name = "port" + std::to_string(port);
+  const size_t name_opt = 4 + name.size() + pad4(name.size());
+  const uint32_t len = 16 + name_opt + 8 + 4 + 4;
+  if (!reserve(len)) { return false; }
+
+  append_u32(PCAPNG_IDB);
+  append_u32(len);
+  append_u16(LINKTYPE_ETHERNET);
+  append_u16(0);
+  append_u32(0);  // No snap length limit
+  append_u16(OPT_IF_NAME);
+  append_u16(name.size());
+  append(name.data(), name.size());
+  append_pad(pad4(name.size()));
+  append_u16(OPT_IF_TSRESOL);
+  append_u16(1);
+  const uint8_t tsresol[4] = {9, 0, 0, 0};  // Nanoseconds
+  append(tsresol, sizeof(tsresol));
+  append_u16(OPT_ENDOFOPT);
+  append_u16(0);
+  append_u32(len);
+
+  const auto id = static_cast<uint32_t>(if_ids_.size());
+  if_ids_[port] = id;
+  return true;
+}
+
+bool AdvNetBurstRecorder::record(AdvNetBurstParams* burst) {
+  if (!is_open()) { return false; }
+
+  const auto num_pkts = adv_net_get_num_pkts(burst);
+  const uint16_t port = burst->hdr.hdr.port_id;
+  const int num_segs = burst->hdr.hdr.num_segs;
+
+  if (if_ids_.find(port) == if_ids_.end() && !write_if_block(port)) {
+    dropped_pkts_ += num_pkts;
+    return false;
+  }
+
+  const uint32_t if_id = if_ids_[port];
+  const uint32_t queue = burst->hdr.hdr.q_id;
+  const uint64_t burst_seq = burst_seq_++;
+  const uint64_t ts = realtime_ns();
+
+  // Memory kind is fixed per segment, so only check the first packet of each
+  std::array<bool, MAX_NUM_SEGS> on_device{};
+  if (num_pkts > 0) {
+    for (int seg = 0; seg < num_segs; seg++) {
+      on_device[seg] = is_device_ptr(adv_net_get_seg_pkt_ptr(burst, seg, 0));
+    }
+  }
+
+  for (int64_t i = 0; i < num_pkts; i++) {
+    uint32_t len = 0;
+    for (int seg = 0; seg < num_segs; seg++) { len += adv_net_get_seg_pkt_len(burst, seg, i); }
+
+    const uint32_t block_len = EPB_FIXED_LEN + len + pad4(len) + EPB_OPTS_LEN;
+    if (!reserve(block_len)) {
+      dropped_pkts_ += num_pkts - i;
+      return false;
+    }
+
+    append_u32(PCAPNG_EPB);
+    append_u32(block_len);
+    append_u32(if_id);
+    append_u32(static_cast<uint32_t>(ts >> 32));
+    append_u32(static_cast<uint32_t>(ts));
+    append_u32(len);
+    append_u32(len);
+
+    for (int seg = 0; seg < num_segs; seg++) {
+      const auto seg_len = adv_net_get_seg_pkt_len(burst, seg, i);
+      const void* ptr = adv_net_get_seg_pkt_ptr(burst, seg, i);
+      if (on_device[seg]) {
+        cudaMemcpy(staging_.data(), ptr, seg_len, cudaMemcpyDeviceToHost);
+        ptr = staging_.data();
+      }
+      append(ptr, seg_len);
+    }
+    append_pad(pad4(len));
+
+    append_u16(OPT_EPB_QUEUE);
+    append_u16(4);
+    append_u32(queue);
+    append_u16(OPT_EPB_PACKETID);
+    append_u16(8);
+    const uint64_t pkt_id = (burst_seq << 32) | ((static_cast<uint64_t>(i) & 0xffff) << 16) |
+                            adv_net_get_pkt_flow_id(burst, i);
+    append(&pkt_id, sizeof(pkt_id));
+    append_u16(OPT_ENDOFOPT);
+    append_u16(0);
+    append_u32(block_len);
+
+    recorded_pkts_++;
+  }
+
+  return true;
+}
+
+void AdvNetBurstRecorder::writer_loop() {
+  while (true) {
+    std::pair<uint8_t*, size_t> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return !full_.empty() || stop_; });
+      if (full_.empty()) { break; }
+      job = full_.front();
+      full_.pop_front();
+    }
+
+    size_t done = 0;
+    while (done < job.second) {
+      const ssize_t ret = ::write(fd_, job.first + done, job.second - done);
+      if (ret < 0) {
+        if (errno == EINTR) { continue; }
+        HOLOSCAN_LOG_ERROR("Failed to write capture file: {}", strerror(errno));
+        break;
+      }
+      done += ret;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(job.first);
+  }
+}
+
+AdvNetCaptureReader::~AdvNetCaptureReader() {
+  close();
+}
+
+bool AdvNetCaptureReader::open(const std::string& path) {
+  close();
+
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    HOLOSCAN_LOG_ERROR("Failed to open capture file {}: {}", path, strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 24) {
+    HOLOSCAN_LOG_ERROR("Capture file {} is too short", path);
+    ::close(fd);
+    return false;
+  }
+
+  void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    HOLOSCAN_LOG_ERROR("Failed to map capture file {}: {}", path, strerror(errno));
+    return false;
+  }
+
+  madvise(map, st.st_size, MADV_SEQUENTIAL);
+  map_ = static_cast<uint8_t*>(map);
+  map_len_ = st.st_size;
+
+  uint32_t magic;
+  memcpy(&magic, map_, sizeof(magic));
+  if (magic == PCAPNG_SHB) {
+    uint32_t bom;
+    memcpy(&bom, map_ + 8, sizeof(bom));
+    if (bom != PCAPNG_BYTE_ORDER_MAGIC) {
+      HOLOSCAN_LOG_ERROR("Big-endian pcapng files are not supported ({})", path);
+      close();
+      return false;
+    }
+    pcapng_ = true;
+    start_ = 0;
+  } else if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS ||
+             magic == __builtin_bswap32(PCAP_MAGIC_US) ||
+             magic == __builtin_bswap32(PCAP_MAGIC_NS)) {
+    pcapng_ = false;
+    swapped_ = magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS;
+    const auto native = swapped_ ? __builtin_bswap32(magic) : magic;
+    pcap_ts_mul_ = native == PCAP_MAGIC_NS ? 1 : 1000;
+    start_ = 24;
+  } else {
+    HOLOSCAN_LOG_ERROR("{} is not a pcap or pcapng file", path);
+    close();
+    return false;
+  }
+
+  rewind();
+  return true;
+}
+
+void AdvNetCaptureReader::close() {
+  if (map_ != nullptr) { munmap(map_, map_len_); }
+  map_ = nullptr;
+  map_len_ = 0;
+  if_res_.clear();
+  if_ports_.clear();
+}
+
+void AdvNetCaptureReader::rewind() {
+  pos_ = start_;
+  if_res_.clear();
+  if_ports_.clear();
+}
+
+uint32_t AdvNetCaptureReader::rd32(const uint8_t* p) const {
+  uint32_t val;
+  memcpy(&val, p, sizeof(val));
+  return swapped_ ? __builtin_bswap32(val) : val;
+}
+
+bool AdvNetCaptureReader::next(AdvNetCapturePkt& pkt) {
+  if (map_ == nullptr) { return false; }
+
+  return pcapng_ ? next_pcapng(pkt) : next_pcap(pkt);
+}
+
+bool AdvNetCaptureReader::next_pcap(AdvNetCapturePkt& pkt) {
+  if (pos_ + 16 > map_len_) { return false; }
+
+  const uint8_t* rec = map_ + pos_;
+  const uint32_t cap_len = rd32(rec + 8);
+  if (pos_ + 16 + cap_len > map_len_) { return false; }
+
+  pkt.ts_ns = static_cast<uint64_t>(rd32(rec)) * 1000000000ULL + rd32(rec + 4) * pcap_ts_mul_;
+  pkt.len = cap_len;
+  pkt.data = rec + 16;
+  pkt.if_id = 0;
+  pkt.port = 0;
+  pkt.queue = 0;
+  pkt.flow_id = 0;
+  pkt.burst_seq = 0;
+  pkt.has_ano_meta = false;
+  pos_ += 16 + cap_len;
+  return true;
+}
+
+void AdvNetCaptureReader::parse_if_block(const uint8_t* body, size_t len) {
+  TsRes res{1000, 1};  // Microseconds unless if_tsresol says otherwise
+  int32_t port = -1;
+  size_t off = 8;
+  while (off + 4 <= len) {
+    uint16_t code, opt_len;
+    memcpy(&code, body + off, sizeof(code));
+    memcpy(&opt_len, body + off + 2, sizeof(opt_len));
+    if (code == OPT_ENDOFOPT) { break; }
+
+    if (code == OPT_IF_NAME && opt_len > 4 && off + 4 + opt_len <= len &&
+        memcmp(body + off + 4, "port", 4) == 0) {
+      // AdvNetBurstRecorder names each interface after the port it recorded
+      const std::string digits(reinterpret_cast<const char*>(body + off + 8), opt_len - 4);
+      if (digits.size() <= 5 &&
+          std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        const auto value = std::stoul(digits);
+        if (value <= UINT16_MAX) { port = static_cast<int32_t>(value); }
+      }
+    } else if (code == OPT_IF_TSRESOL && opt_len >= 1) {
+      const uint8_t tsresol = body[off + 4];
+      const uint8_t exp = tsresol & 0x7f;
+      if (tsresol & 0x80) {
+        res = {1000000000ULL, 1ULL << std::min<uint8_t>(exp, 63)};
+      } else if (exp <= 9) {
+        res = {1, 1};
+        for (int i = exp; i < 9; i++) { res.mul *= 10; }
+      } else {
+        res = {1, 1};
+        for (int i = 9; i < std::min<int>(exp, 18); i++) { res.div *= 10; }
+      }
+    }
+    off += 4 + opt_len + pad4(opt_len);
+  }
+
+  if_res_.push_back(res);
+  if_ports_.push_back(port);
+}
+
+bool AdvNetCaptureReader::next_pcapng(AdvNetCapturePkt& pkt) {
+  while (pos_ + 12 <= map_len_) {
+    const uint8_t* block = map_ + pos_;
+    const uint32_t type = rd32(block);
+    const uint32_t len = rd32(block + 4);
+    if (len < 12 || (len & 3) != 0 || pos_ + len > map_len_) {
+      HOLOSCAN_LOG_ERROR("Corrupt pcapng block at offset {}", pos_);
+      return false;
+    }
+    pos_ += len;
+
+    // Body excludes the leading type/length and trailing length words
+    const uint8_t* body = block + 8;
+    const size_t body_len = len - 12;
+
+    if (type == PCAPNG_SHB) {
+      if_res_.clear();
+      if_ports_.clear();
+    } else if (type == PCAPNG_IDB) {
+      parse_if_block(body, body_len);
+    } else if (type == PCAPNG_EPB && body_len >= 20) {
+      const uint32_t if_id = rd32(body);
+      const uint64_t ticks = (static_cast<uint64_t>(rd32(body + 4)) << 32) | rd32(body + 8);
+      const uint32_t cap_len = rd32(body + 12);
+      if (20 + cap_len > body_len) { continue; }
+
+      const TsRes res = if_id < if_res_.size() ? if_res_[if_id] : TsRes{1000, 1};
+      pkt.ts_ns = ticks * res.mul / res.div;
+      pkt.len = cap_len;
+      pkt.data = body + 20;
+      pkt.if_id = if_id;
+      pkt.port = 0;
+      pkt.queue = 0;
+      pkt.flow_id = 0;
+      pkt.burst_seq = 0;
+      pkt.has_ano_meta = false;
+
+      bool have_queue = false;
+      bool have_id = false;
+      size_t off = 20 + cap_len + pad4(cap_len);
+      while (off + 4 <= body_len) {
+        uint16_t code, opt_len;
+        memcpy(&code, body + off, sizeof(code));
+        memcpy(&opt_len, body + off + 2, sizeof(opt_len));
+        if (code == OPT_ENDOFOPT) { break; }
+
+        if (code == OPT_EPB_QUEUE && opt_len == 4) {
+          pkt.queue = rd32(body + off + 4);
+          have_queue = true;
+        } else if (code == OPT_EPB_PACKETID && opt_len == 8) {
+          uint64_t id;
+          memcpy(&id, body + off + 4, sizeof(id));
+          pkt.burst_seq = id >> 32;
+          pkt.flow_id = id & 0xffff;
+          have_id = true;
+        }
+        off += 4 + opt_len + pad4(opt_len);
+      }
+
+      const int32_t port = if_id < if_ports_.size() ? if_ports_[if_id] : -1;
+      if (port >= 0) { pkt.port = static_cast<uint16_t>(port); }
+      pkt.has_ano_meta = have_queue && have_id && port >= 0;
+      return true;
+    } else if (type == PCAPNG_SPB && body_len >= 4) {
+      const uint32_t orig_len = rd32(body);
+      pkt.len = std::min<size_t>(orig_len, body_len - 4);
+      pkt.data = body + 4;
+      pkt.ts_ns = 0;
+      pkt.if_id = 0;
+      pkt.port = 0;
+      pkt.queue = 0;
+      pkt.flow_id = 0;
+      pkt.burst_seq = 0;
+      pkt.has_ano_meta = false;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+};  // namespace holoscan::ops
@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "adv_network_types.h"
+
+namespace holoscan::ops {
+
+/**
+ * @brief One packet read back from a capture file
+ *
+ * data points into the reader's file mapping and is valid until the reader is closed. Captures
+ * written by AdvNetBurstRecorder also carry the ANO burst metadata (port, queue, flow ID and burst
+ * sequence number); has_ano_meta is false for pcap/pcapng files written by other tools. The port
+ * is taken from the "port<N>" name of the packet's interface.
+ */
+struct AdvNetCapturePkt {
+  const uint8_t* data;
+  uint32_t len;
+  uint64_t ts_ns;
+  uint32_t if_id;
+  uint16_t port;
+  uint16_t queue;
+  uint16_t flow_id;
+  uint32_t burst_seq;
+  bool has_ano_meta;
+};
+
+/**
+ * @brief Records bursts delivered by an ANO manager to a pcapng file
+ *
+ * Each port gets its own interface description block and every packet is written as an enhanced
+ * packet block with a nanosecond timestamp. The queue ID is stored in the standard epb_queue
+ * option and epb_packetid holds (burst sequence << 32) | (packet index << 16) | flow ID, so burst
+ * boundaries and flow IDs survive the round trip while the file still opens in standard tools.
+ * Header-data split segments are concatenated back into the full frame.
+ *
+ * record() only copies packets into large aligned buffers; a dedicated thread writes full buffers
+ * to disk with O_DIRECT. If the disk can't keep up the recorder drops packets rather than stalling
+ * the caller.
+ */
+class AdvNetBurstRecorder {
+ public:
+  static constexpr size_t DEFAULT_BUF_SIZE = 8 * 1024 * 1024;
+  static constexpr int DEFAULT_NUM_BUFS = 8;
+
+  AdvNetBurstRecorder() = default;
+  ~AdvNetBurstRecorder();
+
+  bool open(const std::string& path, size_t buf_size = DEFAULT_BUF_SIZE,
+            int num_bufs = DEFAULT_NUM_BUFS);
+  bool record(AdvNetBurstParams* burst);
+  void close();
+
+  bool is_open() const { return fd_ >= 0; }
+  uint64_t recorded_pkts() const { return recorded_pkts_; }
+  uint64_t dropped_pkts() const { return dropped_pkts_; }
+
+ private:
+  static constexpr size_t DIRECT_IO_ALIGN = 4096;
+
+  bool reserve(size_t len);
+  void append(const void* src, size_t len);
+  void append_u16(uint16_t val) { append(&val, sizeof(val)); }
+  void append_u32(uint32_t val) { append(&val, sizeof(val)); }
+  void append_pad(size_t len);
+  void submit(uint8_t* buf, size_t len);
+  uint8_t* get_free_buf();
+  bool write_if_block(uint16_t port);
+  void writer_loop();
+
+  int fd_ = -1;
+  size_t buf_size_ = 0;
+  std::vector<uint8_t*> bufs_;
+  uint8_t* cur_ = nullptr;
+  size_t cur_used_ = 0;
+  uint8_t* next_ = nullptr;
+  uint64_t file_bytes_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<uint8_t*> free_;
+  std::deque<std::pair<uint8_t*, size_t>> full_;
+  bool stop_ = false;
+  std::thread writer_;
+
+  std::unordered_map<uint16_t, uint32_t> if_ids_;
+  std::vector<uint8_t> staging_;
+  uint32_t burst_seq_ = 0;
+  uint64_t recorded_pkts_ = 0;
+  uint64_t dropped_pkts_ = 0;
+};
+
+/**
+ * @brief Sequential reader for pcap and pcapng capture files
+ *
+ * The file is memory mapped, so packets are returned without copying. Both microsecond and
+ * nanosecond classic pcap files are supported in either byte order; pcapng files must be
+ * little-endian.
+ */
+class AdvNetCaptureReader {
+ public:
+  AdvNetCaptureReader() = default;
+  ~AdvNetCaptureReader();
+
+  bool open(const std::string& path);
+  void close();
+  bool next(AdvNetCapturePkt& pkt);
+  void rewind();
+
+ private:
+  // Timestamp resolution of a pcapng interface as ns = ticks * mul / div
+  struct TsRes {
+    uint64_t mul;
+    uint64_t div;
+  };
+
+  bool next_pcap(AdvNetCapturePkt& pkt);
+  bool next_pcapng(AdvNetCapturePkt& pkt);
+  void parse_if_block(const uint8_t* body, size_t len);
+  uint32_t rd32(const uint8_t* p) const;
+
+  uint8_t* map_ = nullptr;
+  size_t map_len_ = 0;
+  size_t start_ = 0;
+  size_t pos_ = 0;
+  bool pcapng_ = false;
+  bool swapped_ = false;
+  uint64_t pcap_ts_mul_ = 1000;
+  std::vector<TsRes> if_res_;
+  // ANO port of each pcapng interface, -1 if its name isn't "port<N>"
+  std::vector<int32_t> if_ports_;
+};
+
+};  // namespace holoscan::ops
@@ -17,14 +17,26 @@
 
 #include "adv_network_rx.h"
 #include "adv_network_mgr.h"
+#include "adv_network_pcap.h"
+#include <algorithm>
 #include <memory>
 #include <assert.h>
 
 namespace holoscan::ops {
 
 struct AdvNetworkOpRx::AdvNetworkOpRxImpl {
+  // All (port, queue) pairs feeding one output port
+  struct OutputQueues {
+    std::string port_name;
+    std::vector<std::pair<uint16_t, uint16_t>> queues;
+    size_t next = 0;
+  };
+
   AdvNetConfigYaml cfg;
   ANOMgr* mgr;
+  std::vector<OutputQueues> outputs;
+  bool per_queue_rx = true;
+  AdvNetBurstRecorder recorder;
 };
 
 void AdvNetworkOpRx::setup(OperatorSpec& spec) {
@@ -40,10 +52,16 @@ void AdvNetworkOpRx::setup(OperatorSpec& spec) {
              "Configuration",
              "Configuration for the advanced network operator",
              AdvNetConfigYaml());
+  spec.param(capture_file_,
+             "capture_file",
+             "Capture file",
+             "pcapng file to record every received burst to. Recording is disabled when empty",
+             std::string(""));
 }
 
 void AdvNetworkOpRx::stop() {
   HOLOSCAN_LOG_INFO("AdvNetworkOpRx::stop()");
+  impl->recorder.close();
   impl->mgr->shutdown();
 }
 
@@ -75,28 +93,62 @@ int AdvNetworkOpRx::Init() {
 
     for (const auto& q : rx.queues_) {
       pq_map_[(port_opt.value() << 16) | q.common_.id_] = q.output_port_;
+
+      auto out = std::find_if(impl->outputs.begin(), impl->outputs.end(), [&q](const auto& o) {
+        return o.port_name == q.output_port_;
+      });
+      if (out == impl->outputs.end()) {
+        impl->outputs.push_back({q.output_port_, {}});
+        out = impl->outputs.end() - 1;
+      }
+      out->queues.emplace_back(port_opt.value(), q.common_.id_);
     }
   }
 
+  if (!capture_file_.get().empty() && !impl->recorder.open(capture_file_.get())) { return -1; }
+
   return 0;
 }
 
 void AdvNetworkOpRx::compute([[maybe_unused]] InputContext&, OutputContext& op_output,
                              [[maybe_unused]] ExecutionContext&) {
-  int n;
   AdvNetBurstParams* burst;
 
+  // Poll each output port's queues separately so a slow consumer on one port can't hold back
+  // bursts destined for another. At most one burst is emitted per port per call.
+  if (impl->per_queue_rx) {
+    for (auto& out : impl->outputs) {
+      for (size_t i = 0; i < out.queues.size(); i++) {
+        const auto [port, q] = out.queues[out.next];
+        out.next = (out.next + 1) % out.queues.size();
+
+        const auto res = impl->mgr->get_rx_burst(&burst, port, q);
+        if (res == AdvNetStatus::NOT_SUPPORTED) {
+          impl->per_queue_rx = false;
+          break;
+        }
+        if (res != AdvNetStatus::SUCCESS) { continue; }
+
+        if (impl->recorder.is_open()) { impl->recorder.record(burst); }
+        op_output.emit(impl->mgr->make_rx_burst_handle(burst), out.port_name.c_str());
+        break;
+      }
+
+      if (!impl->per_queue_rx) { break; }
+    }
+
+    if (impl->per_queue_rx) { return; }
+    HOLOSCAN_LOG_INFO("Manager has no per-queue RX rings; using shared RX ring");
+  }
+
   const auto res = impl->mgr->get_rx_burst(&burst);
 
   if (res != AdvNetStatus::SUCCESS) { return; }
 
-  auto adv_burst = std::make_shared<AdvNetBurstParams>();
-  memcpy(adv_burst.get(), burst, sizeof(*burst));
-
-  impl->mgr->free_rx_meta(burst);
+  if (impl->recorder.is_open()) { impl->recorder.record(burst); }
 
-  const auto port_str = pq_map_[(adv_burst->hdr.hdr.port_id << 16) | adv_burst->hdr.hdr.q_id];
-  op_output.emit(adv_burst, port_str.c_str());
+  const auto port_str = pq_map_[(burst->hdr.hdr.port_id << 16) | burst->hdr.hdr.q_id];
+  op_output.emit(impl->mgr->make_rx_burst_handle(burst), port_str.c_str());
 }
 
 };  // namespace holoscan::ops
@@ -70,6 +70,7 @@ class AdvNetworkOpRx : public Operator {
   Parameter<int> max_packet_size_;
   Parameter<uint32_t> num_concurrent_batches_;
   Parameter<AdvNetConfigYaml> cfg_;
+  Parameter<std::string> capture_file_;
 };
 
 };  // namespace holoscan::ops
@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "adv_network_stats.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace holoscan::ops {
+
+namespace {
+
+const char* dir_name(AdvNetDirection dir) {
+  return dir == AdvNetDirection::RX ? "rx" : "tx";
+}
+
+}  // namespace
+
+uint64_t AdvNetLatencyHistogram::bucket_upper(int idx) {
+  if (idx < SUB_BUCKETS) { return idx; }
+  const int k = idx - SUB_BUCKETS;
+  const int shift = k / SUB_BUCKETS;
+  const uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + k % SUB_BUCKETS) << shift;
+  return lower + (1ULL << shift) - 1;
+}
+
+AdvNetLatencyHistogram::Summary AdvNetLatencyHistogram::summarize() const {
+  Summary s;
+  std::array<uint64_t, NUM_BUCKETS> counts;
+  for (int i = 0; i < NUM_BUCKETS; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    s.count += counts[i];
+  }
+  s.sum_ns = sum_.load(std::memory_order_relaxed);
+  s.max_ns = max_.load(std::memory_order_relaxed);
+  if (s.count == 0) { return s; }
+
+  // Percentiles are taken from the bucket counts rather than count_ so they stay self-consistent
+  // while other threads keep recording
+  const std::array<double, 4> quantiles = {0.5, 0.9, 0.99, 0.999};
+  std::array<uint64_t*, 4> out = {&s.p50_ns, &s.p90_ns, &s.p99_ns, &s.p999_ns};
+  uint64_t seen = 0;
+  size_t qi = 0;
+  for (int i = 0; i < NUM_BUCKETS && qi < quantiles.size(); i++) {
+    seen += counts[i];
+    while (qi < quantiles.size() && seen >= quantiles[qi] * s.count) {
+      *out[qi++] = std::min(bucket_upper(i), s.max_ns);
+    }
+  }
+
+  return s;
+}
+
+AdvNetQueueStats adv_net_snapshot_counters(const AdvNetQueueCounters& c) {
+  AdvNetQueueStats s;
+  s.port = c.port;
+  s.queue = c.queue;
+  s.dir = c.dir;
+  s.pkts = c.pkts.load(std::memory_order_relaxed);
+  s.bytes = c.bytes.load(std::memory_order_relaxed);
+  s.bursts = c.bursts.load(std::memory_order_relaxed);
+  s.no_buf = c.no_buf.load(std::memory_order_relaxed);
+  s.dropped = c.dropped.load(std::memory_order_relaxed);
+
+  const uint64_t burst_pkts = c.burst_pkts.load(std::memory_order_relaxed);
+  s.burst_fill = (s.bursts == 0 || c.batch_size == 0)
+                     ? 0.0
+                     : static_cast<double>(burst_pkts) / (s.bursts * c.batch_size);
+  s.rx_latency = c.rx_latency.summarize();
+  return s;
+}
+
+std::string adv_net_stats_to_json(const std::vector<AdvNetQueueStats>& stats) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(4);
+  os << "{\"queues\":[";
+  for (size_t i = 0; i < stats.size(); i++) {
+    const auto& s = stats[i];
+    if (i > 0) { os << ","; }
+    os << "{\"port\":" << s.port << ",\"queue\":" << s.queue << ",\"dir\":\"" << dir_name(s.dir)
+       << "\",\"packets\":" << s.pkts << ",\"bytes\":" << s.bytes << ",\"bursts\":" << s.bursts
+       << ",\"dropped\":" << s.dropped << ",\"no_buf\":" << s.no_buf
+       << ",\"burst_fill\":" << s.burst_fill;
+    if (s.ring_depth >= 0) {
+      os << ",\"ring_depth\":" << s.ring_depth << ",\"ring_capacity\":" << s.ring_capacity;
+    }
+    if (s.pool_avail >= 0) {
+      os << ",\"pool_avail\":" << s.pool_avail << ",\"pool_size\":" << s.pool_size;
+    }
+    if (s.dir == AdvNetDirection::RX) {
+      const auto& l = s.rx_latency;
+      os << ",\"latency_ns\":{\"count\":" << l.count << ",\"sum\":" << l.sum_ns
+         << ",\"p50\":" << l.p50_ns << ",\"p90\":" << l.p90_ns << ",\"p99\":" << l.p99_ns
+         << ",\"p999\":" << l.p999_ns << ",\"max\":" << l.max_ns << "}";
+    }
+    os << "}";
+  }
+  os << "]}";
+  return os.str();
+}
+
+std::string adv_net_stats_to_prometheus(const std::vector<AdvNetQueueStats>& stats) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(4);
+
+  const auto labels = [](const AdvNetQueueStats& s) {
+    return "{port=\"" + std::to_string(s.port) + "\",queue=\"" + std::to_string(s.queue) +
+           "\",dir=\"" + dir_name(s.dir) + "\"";
+  };
+
+  const auto metric = [&](const char* name, const char* type, const char* help, auto value,
+                          auto has_value) {
+    os << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+    for (const auto& s : stats) {
+      if (has_value(s)) { os << name << labels(s) << "} " << value(s) << "\n"; }
+    }
+  };
+
+  const auto always = [](const AdvNetQueueStats&) { return true; };
+  metric("ano_queue_packets_total", "counter", "Packets received or sent by the queue",
+         [](const AdvNetQueueStats& s) { return s.pkts; }, always);
+  metric("ano_queue_bytes_total", "counter", "Bytes received or sent by the queue",
+         [](const AdvNetQueueStats& s) { return s.bytes; }, always);
+  metric("ano_queue_bursts_total", "counter", "Bursts passed between the queue and operators",
+         [](const AdvNetQueueStats& s) { return s.bursts; }, always);
+  metric("ano_queue_dropped_total", "counter", "Packets dropped by the manager",
+         [](const AdvNetQueueStats& s) { return s.dropped; }, always);
+  metric("ano_queue_no_buf_total", "counter", "Times the queue ran out of free buffers",
+         [](const AdvNetQueueStats& s) { return s.no_buf; }, always);
+  metric("ano_queue_burst_fill_ratio", "gauge", "Average burst size over the batch size",
+         [](const AdvNetQueueStats& s) { return s.burst_fill; }, always);
+  metric("ano_queue_ring_depth", "gauge", "Bursts waiting in the queue's ring",
+         [](const AdvNetQueueStats& s) { return s.ring_depth; },
+         [](const AdvNetQueueStats& s) { return s.ring_depth >= 0; });
+  metric("ano_queue_ring_capacity", "gauge", "Capacity of the queue's ring",
+         [](const AdvNetQueueStats& s) { return s.ring_capacity; },
+         [](const AdvNetQueueStats& s) { return s.ring_depth >= 0; });
+  metric("ano_queue_pool_avail", "gauge", "Free buffers in the queue's pool",
+         [](const AdvNetQueueStats& s) { return s.pool_avail; },
+         [](const AdvNetQueueStats& s) { return s.pool_avail >= 0; });
+  metric("ano_queue_pool_size", "gauge", "Total buffers in the queue's pool",
+         [](const AdvNetQueueStats& s) { return s.pool_size; },
+         [](const AdvNetQueueStats& s) { return s.pool_avail >= 0; });
+
+  const char* lat = "ano_queue_rx_latency_ns";
+  os << "# HELP " << lat << " Time from a burst leaving the NIC to get_rx_burst() returning it\n"
+     << "# TYPE " << lat << " summary\n";
+  for (const auto& s : stats) {
+    if (s.dir != AdvNetDirection::RX) { continue; }
+    const auto& l = s.rx_latency;
+    const auto base = labels(s);
+    os << lat << base << ",quantile=\"0.5\"} " << l.p50_ns << "\n"
+       << lat << base << ",quantile=\"0.9\"} " << l.p90_ns << "\n"
+       << lat << base << ",quantile=\"0.99\"} " << l.p99_ns << "\n"
+       << lat << base << ",quantile=\"0.999\"} " << l.p999_ns << "\n"
+       << lat << "_sum" << base << "} " << l.sum_ns << "\n"
+       << lat << "_count" << base << "} " << l.count << "\n";
+  }
+
+  return os.str();
+}
+
+};  // namespace holoscan::ops
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "adv_network_types.h"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Monotonic clock used for burst timestamps and latency measurements
+ */
+static inline uint64_t adv_net_stats_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @brief Lock-free log-linear latency histogram
+ *
+ * Values below SUB_BUCKETS nanoseconds get a bucket each. Above that, every power of two is split
+ * into SUB_BUCKETS linear buckets, the same layout as an HDR histogram with one significant
+ * hex digit, so any recorded value is reported within 1/SUB_BUCKETS (~6%) of its true value. The
+ * range tops out at 2^MAX_EXP ns (~68s); larger values land in the last bucket.
+ *
+ * record() is a few relaxed atomic adds and may be called from any thread. summarize() can run
+ * concurrently with record() and returns an approximately consistent view.
+ */
+class AdvNetLatencyHistogram {
+ public:
+  static constexpr int SUB_BUCKET_BITS = 4;
+  static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr int MAX_EXP = 36;
+  static constexpr int NUM_BUCKETS = SUB_BUCKETS + (MAX_EXP - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+  struct Summary {
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+  };
+
+  void record(uint64_t ns) {
+    buckets_[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t cur = max_.load(std::memory_order_relaxed);
+    while (ns > cur && !max_.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {}
+  }
+
+  Summary summarize() const;
+
+  static int bucket_index(uint64_t ns) {
+    if (ns < SUB_BUCKETS) { return static_cast<int>(ns); }
+    const int exp = 63 - __builtin_clzll(ns);
+    if (exp >= MAX_EXP) { return NUM_BUCKETS - 1; }
+    const int sub = static_cast<int>((ns >> (exp - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return SUB_BUCKETS + (exp - SUB_BUCKET_BITS) * SUB_BUCKETS + sub;
+  }
+
+  // Largest value that maps to bucket idx
+  static uint64_t bucket_upper(int idx);
+
+ private:
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @brief Live counters of one queue
+ *
+ * Counters are updated by the manager's worker for the queue and can be read from any thread at
+ * any time. rx_latency is the time from the worker taking the first packet of a burst off the
+ * NIC (rx_timestamp_ns in the burst header) to the burst being returned from get_rx_burst().
+ */
+struct AdvNetQueueCounters {
+  AdvNetQueueCounters(uint16_t port, uint16_t queue, AdvNetDirection dir, uint32_t batch_size)
+      : port(port), queue(queue), dir(dir), batch_size(batch_size) {}
+
+  const uint16_t port;
+  const uint16_t queue;
+  const AdvNetDirection dir;
+  const uint32_t batch_size;
+
+  std::atomic<uint64_t> pkts{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> bursts{0};
+  std::atomic<uint64_t> burst_pkts{0};  // Packets in bursts handed to the application/NIC
+  std::atomic<uint64_t> no_buf{0};
+  std::atomic<uint64_t> dropped{0};
+  AdvNetLatencyHistogram rx_latency;
+
+  void add_burst(uint64_t num_pkts) {
+    bursts.fetch_add(1, std::memory_order_relaxed);
+    burst_pkts.fetch_add(num_pkts, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Point-in-time copy of a queue's counters and gauges
+ *
+ * Gauges a manager can't measure are left at -1 and omitted from the exported text.
+ */
+struct AdvNetQueueStats {
+  uint16_t port;
+  uint16_t queue;
+  AdvNetDirection dir;
+  uint64_t pkts;
+  uint64_t bytes;
+  uint64_t bursts;
+  uint64_t no_buf;
+  uint64_t dropped;
+  double burst_fill;  // Average packets per burst over the configured batch size
+  int64_t ring_depth = -1;
+  int64_t ring_capacity = -1;
+  int64_t pool_avail = -1;
+  int64_t pool_size = -1;
+  AdvNetLatencyHistogram::Summary rx_latency;
+};
+
+AdvNetQueueStats adv_net_snapshot_counters(const AdvNetQueueCounters& c);
+std::string adv_net_stats_to_json(const std::vector<AdvNetQueueStats>& stats);
+std::string adv_net_stats_to_prometheus(const std::vector<AdvNetQueueStats>& stats);
+
+};  // namespace holoscan::ops
@@ -56,6 +56,8 @@ struct AdvNetBurstHdrParams {
   uint32_t max_pkt_size;
   uint32_t gpu_pkt0_idx;
   uintptr_t gpu_pkt0_addr;
+  // adv_net_stats_now_ns() when the first packet of an RX burst was read from the NIC, 0 if unknown
+  uint64_t rx_timestamp_ns;
 };
 
 struct AdvNetBurstHdr {
@@ -84,6 +86,24 @@ struct UDPIPV4Pkt {
   struct udphdr udp;
 } __attribute__((packed));
 
+/**
+ * @brief Ethernet/IPv4/UDP header template for a TX queue
+ *
+ * Registered once per queue with adv_net_set_udp_tx_template() and stamped onto every packet of a
+ * burst with adv_net_set_udp_hdrs(). The Ethernet source address is filled in by the manager.
+ */
+struct AdvNetUdpTxTemplate {
+  char eth_dst[6];
+  uint32_t ip_src;  // Host byte order
+  uint32_t ip_dst;  // Host byte order
+  uint16_t udp_src;
+  uint16_t udp_dst;
+  uint8_t ttl = 64;
+  // Bytes of each packet placed in segment 0 when the queue uses header-data split. Must cover at
+  // least the Ethernet/IPv4/UDP headers; 0 means the headers alone.
+  uint16_t hds_len = 0;
+};
+
 enum class MemoryKind { HOST, HOST_PINNED, HUGE, DEVICE, INVALID };
 
 enum MemoryAccess {
@@ -170,11 +190,13 @@ enum class AnoMgrType {
   DPDK,
   DOCA,
   RIVERMAX,
+  SOCKET,
 };
 
 static constexpr const char* ANO_MGR_STR__DPDK = "dpdk";
 static constexpr const char* ANO_MGR_STR__DOCA = "doca";
 static constexpr const char* ANO_MGR_STR__RIVERMAX = "rivermax";
+static constexpr const char* ANO_MGR_STR__SOCKET = "socket";
 static constexpr const char* ANO_MGR_STR__DEFAULT = "default";
 
 /**
@@ -187,8 +209,10 @@ inline AnoMgrType manager_type_from_string(const std::string& str) {
   if (str == ANO_MGR_STR__DPDK) return AnoMgrType::DPDK;
   if (str == ANO_MGR_STR__DOCA) return AnoMgrType::DOCA;
   if (str == ANO_MGR_STR__RIVERMAX) return AnoMgrType::RIVERMAX;
+  if (str == ANO_MGR_STR__SOCKET) return AnoMgrType::SOCKET;
   if (str == ANO_MGR_STR__DEFAULT) return AnoMgrType::DEFAULT;
-  throw std::logic_error("Unrecognized manager type, available options dpdk/doca/rivermax/default");
+  throw std::logic_error(
+      "Unrecognized manager type, available options dpdk/doca/rivermax/socket/default");
 }
 
 /**
@@ -205,6 +229,8 @@ inline std::string manager_type_to_string(AnoMgrType type) {
       return ANO_MGR_STR__DOCA;
     case AnoMgrType::RIVERMAX:
       return ANO_MGR_STR__RIVERMAX;
+    case AnoMgrType::SOCKET:
+      return ANO_MGR_STR__SOCKET;
     case AnoMgrType::DEFAULT:
       return ANO_MGR_STR__DEFAULT;
     default:
@@ -14,7 +14,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <arpa/inet.h>
 #include <cuda.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
 #include "adv_network_mgr.h"
 // Include the appropriate headers based on which ANO_MGR types are defined
 #if ANO_MGR_DPDK
@@ -26,6 +31,9 @@
 #if ANO_MGR_RIVERMAX
 #include "adv_network_rmax_mgr.h"
 #endif
+#if ANO_MGR_SOCKET
+#include "adv_network_socket_mgr.h"
+#endif
 
 #if ANO_MGR_DPDK || ANO_MGR_DOCA
 #include <rte_common.h>
@@ -50,6 +58,8 @@ AnoMgrType AnoMgrFactory::get_default_manager_type() {
   mgr_type = AnoMgrType::DOCA;
 #elif ANO_MGR_RIVERMAX
   mgr_type = AnoMgrType::RIVERMAX;
+#elif ANO_MGR_SOCKET
+  mgr_type = AnoMgrType::SOCKET;
 #else
 #error "No advanced network operator manager defined"
 #endif
@@ -73,6 +83,11 @@ std::unique_ptr<ANOMgr> AnoMgrFactory::create_instance(AnoMgrType type) {
     case AnoMgrType::RIVERMAX:
       _manager = std::make_unique<RmaxMgr>();
       break;
+#endif
+#if ANO_MGR_SOCKET
+    case AnoMgrType::SOCKET:
+      _manager = std::make_unique<SocketMgr>();
+      break;
 #endif
     case AnoMgrType::DEFAULT:
       _manager = create_instance(get_default_manager_type());
@@ -112,6 +127,216 @@ AnoMgrType AnoMgrFactory::get_manager_type(const Config& config) {
 
 template AnoMgrType AnoMgrFactory::get_manager_type<Config>(const Config&);
 
+AdvNetStatus ANOMgr::get_rx_burst(AdvNetBurstParams** burst, int port, int q) {
+  return AdvNetStatus::NOT_SUPPORTED;
+}
+
+AdvNetStatus ANOMgr::set_udp_tx_template(int port, int q, const AdvNetUdpTxTemplate& tmpl) {
+  if (tmpl.hds_len != 0 && tmpl.hds_len < UDP_HDRS_LEN) {
+    HOLOSCAN_LOG_ERROR("Header-data split point {} doesn't cover the {} bytes of UDP headers",
+                       tmpl.hds_len,
+                       UDP_HDRS_LEN);
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  UDPIPV4Pkt pkt{};
+  memcpy(pkt.eth.h_dest, tmpl.eth_dst, sizeof(pkt.eth.h_dest));
+  if (get_mac(port, reinterpret_cast<char*>(pkt.eth.h_source)) != AdvNetStatus::SUCCESS) {
+    HOLOSCAN_LOG_WARN("Failed to get MAC address of port {}; leaving source address empty", port);
+    memset(pkt.eth.h_source, 0, sizeof(pkt.eth.h_source));
+  }
+  pkt.eth.h_proto = htons(ETH_P_IP);
+
+  pkt.ip.version = 4;
+  pkt.ip.ihl = sizeof(pkt.ip) / 4;
+  pkt.ip.ttl = tmpl.ttl;
+  pkt.ip.protocol = IPPROTO_UDP;
+  pkt.ip.saddr = htonl(tmpl.ip_src);
+  pkt.ip.daddr = htonl(tmpl.ip_dst);
+
+  pkt.udp.source = htons(tmpl.udp_src);
+  pkt.udp.dest = htons(tmpl.udp_dst);
+
+  auto t = std::make_unique<TxHdrTemplate>();
+  memcpy(t->hdr.data(), &pkt, sizeof(pkt));
+  t->hds_len = tmpl.hds_len;
+
+  const uint8_t* ip = t->hdr.data() + sizeof(pkt.eth);
+  t->ip_sum = 0;
+  for (size_t i = 0; i < sizeof(pkt.ip); i += 2) { t->ip_sum += (ip[i] << 8) | ip[i + 1]; }
+
+  {
+    std::unique_lock<std::shared_mutex> lock(tx_templates_mutex_);
+    tx_templates_[(port << 16) | q] = t.get();
+    tx_template_store_.push_back(std::move(t));
+  }
+  HOLOSCAN_LOG_INFO("Registered UDP header template for TX port {} queue {}", port, q);
+  return AdvNetStatus::SUCCESS;
+}
+
+ANOMgr::TxHdrTemplate* ANOMgr::find_tx_template(const AdvNetBurstParams* burst) {
+  std::shared_lock<std::shared_mutex> lock(tx_templates_mutex_);
+  const auto it = tx_templates_.find((burst->hdr.hdr.port_id << 16) | burst->hdr.hdr.q_id);
+  if (it == tx_templates_.end()) {
+    HOLOSCAN_LOG_ERROR("No UDP header template registered for TX port {} queue {}",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return nullptr;
+  }
+  return it->second;
+}
+
+void ANOMgr::stamp_udp_hdrs(TxHdrTemplate& tmpl, void* const* hdrs, const uint16_t* payload_lens,
+                            uint16_t payload_len, int num) {
+  constexpr size_t IP_OFF = sizeof(ethhdr);
+  constexpr size_t UDP_OFF = IP_OFF + sizeof(iphdr);
+
+  for (int base = 0; base < num; base += TX_HDR_CHUNK) {
+    const int n = std::min(TX_HDR_CHUNK, num - base);
+    const uint16_t first_ip_id = tmpl.next_ip_id.fetch_add(n, std::memory_order_relaxed);
+    std::array<uint16_t, TX_HDR_CHUNK> ip_len;
+    std::array<uint16_t, TX_HDR_CHUNK> ip_id;
+    std::array<uint16_t, TX_HDR_CHUNK> ip_csum;
+
+    // Per-packet fields are computed over flat arrays first so the compiler can vectorize the
+    // length and checksum arithmetic, then scattered into the headers
+    for (int i = 0; i < n; i++) {
+      const uint16_t len = payload_lens != nullptr ? payload_lens[base + i] : payload_len;
+      ip_len[i] = static_cast<uint16_t>(sizeof(iphdr) + sizeof(udphdr) + len);
+      ip_id[i] = static_cast<uint16_t>(first_ip_id + i);
+    }
+
+    for (int i = 0; i < n; i++) {
+      uint32_t sum = tmpl.ip_sum + ip_len[i] + ip_id[i];
+      sum = (sum & 0xffff) + (sum >> 16);
+      sum = (sum & 0xffff) + (sum >> 16);
+      ip_csum[i] = static_cast<uint16_t>(~sum);
+    }
+
+    for (int i = 0; i < n; i++) {
+      auto hdr = static_cast<uint8_t*>(hdrs[base + i]);
+      const uint16_t udp_len = ip_len[i] - sizeof(iphdr);
+      memcpy(hdr, tmpl.hdr.data(), tmpl.hdr.size());
+      hdr[IP_OFF + 2] = ip_len[i] >> 8;
+      hdr[IP_OFF + 3] = ip_len[i] & 0xff;
+      hdr[IP_OFF + 4] = ip_id[i] >> 8;
+      hdr[IP_OFF + 5] = ip_id[i] & 0xff;
+      hdr[IP_OFF + 10] = ip_csum[i] >> 8;
+      hdr[IP_OFF + 11] = ip_csum[i] & 0xff;
+      hdr[UDP_OFF + 4] = udp_len >> 8;
+      hdr[UDP_OFF + 5] = udp_len & 0xff;
+    }
+  }
+}
+
+AdvNetStatus ANOMgr::set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens,
+                                  uint16_t payload_len) {
+  return AdvNetStatus::NOT_SUPPORTED;
+}
+
+AdvNetQueueCounters* ANOMgr::add_queue_counters(int port, int q, AdvNetDirection dir,
+                                                uint32_t batch_size) {
+  auto& map = dir == AdvNetDirection::RX ? rx_counters_ : tx_counters_;
+  const uint32_t key = (port << 16) | q;
+  const auto it = map.find(key);
+  if (it != map.end()) { return it->second; }
+
+  queue_counters_.push_back(std::make_unique<AdvNetQueueCounters>(port, q, dir, batch_size));
+  map[key] = queue_counters_.back().get();
+  return map[key];
+}
+
+AdvNetQueueCounters* ANOMgr::find_queue_counters(int port, int q, AdvNetDirection dir) const {
+  const auto& map = dir == AdvNetDirection::RX ? rx_counters_ : tx_counters_;
+  const auto it = map.find((port << 16) | q);
+  return it == map.end() ? nullptr : it->second;
+}
+
+std::vector<AdvNetQueueStats> ANOMgr::get_queue_stats() const {
+  std::vector<AdvNetQueueStats> stats;
+  stats.reserve(queue_counters_.size());
+  for (const auto& c : queue_counters_) {
+    stats.push_back(adv_net_snapshot_counters(*c));
+    fill_queue_gauges(stats.back());
+  }
+  return stats;
+}
+
+namespace {
+
+/**
+ * @brief Free list of fixed-size blocks backing the shared_ptr control blocks of RX burst handles
+ *
+ * Handles are created and dropped at the burst rate, so the control blocks are recycled here
+ * instead of going through the heap. The list only grows to the peak number of bursts in flight.
+ */
+class BurstHandleBlockPool {
+ public:
+  static constexpr size_t BLOCK_SIZE = 128;
+
+  static BurstHandleBlockPool& instance() {
+    // Never destroyed so handles released during static destruction are still safe
+    static auto* pool = new BurstHandleBlockPool();
+    return *pool;
+  }
+
+  void* get(size_t bytes) {
+    if (bytes > BLOCK_SIZE) { return ::operator new(bytes); }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.empty()) { return ::operator new(BLOCK_SIZE); }
+    void* block = free_.back();
+    free_.pop_back();
+    return block;
+  }
+
+  void put(void* block, size_t bytes) {
+    if (bytes > BLOCK_SIZE) {
+      ::operator delete(block);
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(block);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<void*> free_;
+};
+
+template <typename T>
+struct BurstHandleAllocator {
+  using value_type = T;
+
+  BurstHandleAllocator() = default;
+  template <typename U>
+  BurstHandleAllocator(const BurstHandleAllocator<U>&) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(BurstHandleBlockPool::instance().get(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) { BurstHandleBlockPool::instance().put(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const BurstHandleAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const BurstHandleAllocator<U>&) const {
+    return false;
+  }
+};
+
+}  // namespace
+
+std::shared_ptr<AdvNetBurstParams> ANOMgr::make_rx_burst_handle(AdvNetBurstParams* burst) {
+  return std::shared_ptr<AdvNetBurstParams>(
+      burst,
+      [this](AdvNetBurstParams* b) { free_rx_meta(b); },
+      BurstHandleAllocator<AdvNetBurstParams>());
+}
+
 AdvNetStatus ANOMgr::allocate_memory_regions() {
   HOLOSCAN_LOG_INFO("Registering memory regions");
 #if ANO_MGR_DPDK || ANO_MGR_DOCA
@@ -18,7 +18,12 @@
 #pragma once
 
 #include "adv_network_types.h"
+#include "adv_network_stats.h"
+#include <array>
+#include <atomic>
+#include <memory>
 #include <optional>
+#include <shared_mutex>
 
 namespace holoscan::ops {
 
@@ -53,6 +58,12 @@ class ANOMgr {
                                    uint16_t src_port, uint16_t dst_port) = 0;
   virtual AdvNetStatus set_udp_payload(AdvNetBurstParams* burst, int idx, void* data, int len) = 0;
   virtual bool tx_burst_available(AdvNetBurstParams* burst) = 0;
+  // Batched header construction. payload_lens holds one UDP payload length per packet, or is
+  // nullptr to use payload_len for the whole burst. Managers that build headers on the CPU
+  // override set_udp_hdrs(); the default returns NOT_SUPPORTED.
+  virtual AdvNetStatus set_udp_tx_template(int port, int q, const AdvNetUdpTxTemplate& tmpl);
+  virtual AdvNetStatus set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens,
+                                    uint16_t payload_len);
 
   virtual AdvNetStatus set_pkt_lens(AdvNetBurstParams* burst, int idx,
                                     const std::initializer_list<int>& lens) = 0;
@@ -71,6 +82,11 @@ class ANOMgr {
   /* Internal functions used by ANO operators */
   virtual std::optional<uint16_t> get_port_from_ifname(const std::string& name) = 0;
   virtual AdvNetStatus get_rx_burst(AdvNetBurstParams** burst) = 0;
+  // Per-queue variant. Managers without per-queue rings return NOT_SUPPORTED.
+  virtual AdvNetStatus get_rx_burst(AdvNetBurstParams** burst, int port, int q);
+  // Wraps a burst from get_rx_burst() without copying it. The burst is returned to the manager's
+  // RX metadata pool with free_rx_meta() once the last reference is dropped.
+  std::shared_ptr<AdvNetBurstParams> make_rx_burst_handle(AdvNetBurstParams* burst);
   virtual void free_rx_meta(AdvNetBurstParams* burst) = 0;
   virtual void free_tx_meta(AdvNetBurstParams* burst) = 0;
   virtual AdvNetStatus get_tx_meta_buf(AdvNetBurstParams** burst) = 0;
@@ -78,6 +94,8 @@ class ANOMgr {
   virtual AdvNetStatus get_mac(int port, char* mac) = 0;
   virtual int address_to_port(const std::string& addr) = 0;
   virtual bool validate_config() const;
+  // Snapshot of every queue's counters and gauges. Safe to call from any thread at runtime.
+  std::vector<AdvNetQueueStats> get_queue_stats() const;
 
   virtual ~ANOMgr() = default;
 
@@ -88,12 +106,69 @@ class ANOMgr {
   static constexpr uint32_t GPU_PAGE_SIZE = (1UL << GPU_PAGE_SHIFT);
   static constexpr uint32_t JUMBO_FRAME_MAX_SIZE = 0x2600;
   static constexpr uint32_t NON_JUMBO_FRAME_MAX_SIZE = 1518;
+  static constexpr uint16_t UDP_HDRS_LEN = sizeof(UDPIPV4Pkt);
+  static constexpr int TX_HDR_CHUNK = 64;
   bool initialized_ = false;
   AdvNetConfigYaml cfg_;
   std::unordered_map<std::string, AllocRegion> ar_;
 
+  /**
+   * @brief Prebuilt headers of a TX queue
+   *
+   * hdr has zero IPv4 length, ID and checksum. ip_sum is the one's complement sum of the IPv4
+   * header as stored, so the checksum of each packet only needs its length and ID added in.
+   * Several TX operators may send on the same queue, so IP IDs are reserved atomically.
+   */
+  struct TxHdrTemplate {
+    std::array<uint8_t, sizeof(UDPIPV4Pkt)> hdr;
+    uint32_t ip_sum;
+    uint16_t hds_len;
+    std::atomic<uint16_t> next_ip_id{0};
+  };
+
+  /**
+   * Templates may be registered from an operator's compute() while other TX operators and
+   * manager threads look theirs up, so the map is guarded. A template is never freed before the
+   * manager, so the pointer returned stays valid if the queue's template is replaced.
+   */
+  TxHdrTemplate* find_tx_template(const AdvNetBurstParams* burst);
+  static void stamp_udp_hdrs(TxHdrTemplate& tmpl, void* const* hdrs, const uint16_t* payload_lens,
+                             uint16_t payload_len, int num);
+  static void tx_seg_lens(const TxHdrTemplate& tmpl, uint16_t payload_len, uint32_t& seg0,
+                          uint32_t& seg1) {
+    const uint32_t total = UDP_HDRS_LEN + payload_len;
+    seg0 = tmpl.hds_len == 0 ? UDP_HDRS_LEN : tmpl.hds_len;
+    seg1 = total - seg0;
+  }
+
   virtual AdvNetStatus allocate_memory_regions();
   virtual void adjust_memory_regions() {}
+
+  /**
+   * @brief Per-queue telemetry
+   *
+   * Managers create the counters of each queue during initialization, before any worker starts.
+   * The set of counters never changes afterwards, so workers update them and get_queue_stats()
+   * reads them without locks. fill_queue_gauges() adds the ring and pool levels a manager can
+   * measure; the defaults leave them unknown.
+   */
+  AdvNetQueueCounters* add_queue_counters(int port, int q, AdvNetDirection dir,
+                                          uint32_t batch_size);
+  AdvNetQueueCounters* find_queue_counters(int port, int q, AdvNetDirection dir) const;
+  virtual void fill_queue_gauges(AdvNetQueueStats& stats) const {}
+  static void record_rx_latency(AdvNetQueueCounters* counters, const AdvNetBurstParams* burst) {
+    if (counters != nullptr && burst->hdr.hdr.rx_timestamp_ns != 0) {
+      counters->rx_latency.record(adv_net_stats_now_ns() - burst->hdr.hdr.rx_timestamp_ns);
+    }
+  }
+
+ private:
+  mutable std::shared_mutex tx_templates_mutex_;
+  std::unordered_map<uint32_t, TxHdrTemplate*> tx_templates_;
+  std::vector<std::unique_ptr<TxHdrTemplate>> tx_template_store_;
+  std::vector<std::unique_ptr<AdvNetQueueCounters>> queue_counters_;
+  std::unordered_map<uint32_t, AdvNetQueueCounters*> rx_counters_;
+  std::unordered_map<uint32_t, AdvNetQueueCounters*> tx_counters_;
 };
 
 class AnoMgrFactory {
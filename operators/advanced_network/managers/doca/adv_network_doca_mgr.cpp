@@ -70,6 +70,7 @@ struct RxDocaWorkerQueue {
   uint64_t rx_pkts = 0;
   uint32_t batch_size;
   DocaRxQueue* rxq;
+  AdvNetQueueCounters* stats;
 };
 
 struct RxDocaWorkerParams {
@@ -401,7 +402,7 @@ struct doca_flow_port* DocaMgr::init_doca_flow(uint16_t port_id, uint8_t rxq_num
 }
 
 int DocaMgr::setup_pools_and_rings(int max_tx_batch) {
-  AdvNetBurstParams* bursts_rx[(1U << 6) - 1U];
+  AdvNetBurstParams* bursts_rx[RX_META_POOL_SIZE];
   AdvNetBurstParams* bursts_tx[(1U << 7) - 1U];
   int idx = 0;
 
@@ -415,7 +416,7 @@ int DocaMgr::setup_pools_and_rings(int max_tx_batch) {
 
   HOLOSCAN_LOG_DEBUG("Setting up RX meta pool");
   rx_meta = rte_mempool_create("RX_META_POOL",
-                               (1U << 6) - 1U,
+                               RX_META_POOL_SIZE,
                                sizeof(AdvNetBurstParams),
                                0,
                                0,
@@ -430,7 +431,7 @@ int DocaMgr::setup_pools_and_rings(int max_tx_batch) {
     return -1;
   }
 
-  while (idx < (1U << 6) - 1U &&
+  while (idx < RX_META_POOL_SIZE &&
          rte_mempool_get(rx_meta, reinterpret_cast<void**>(&bursts_rx[idx])) == 0) {
     bursts_rx[idx]->pkts[0] = (void**)calloc(CUDA_MAX_RX_NUM_PKTS, sizeof(void*));
     idx++;
@@ -682,6 +683,7 @@ void DocaMgr::initialize() {
                                        rxq_pkts,
                                        q_max_packet_size,
                                        mtype);
+      add_queue_counters(intf.port_id_, q.common_.id_, AdvNetDirection::RX, q.common_.batch_size_);
     }
 
     for (auto& q : intf.tx_.queues_) {
@@ -1109,6 +1111,8 @@ void DocaMgr::run() {
             params_rx->rxqw[ridx].batch_size = q.common_.batch_size_;
             params_rx->rxqw[ridx].rxq = qinfo;
             params_rx->rxqw[ridx].port = intf.port_id_;
+            params_rx->rxqw[ridx].stats =
+                find_queue_counters(intf.port_id_, q.common_.id_, AdvNetDirection::RX);
 
             ridx++;
           }
@@ -1389,9 +1393,15 @@ int DocaMgr::rx_core(void* arg) {
         burst->hdr.hdr.nbytes = packets_stats->nbytes;
         burst->hdr.hdr.gpu_pkt0_idx = packets_stats->gpu_pkt0_idx;
         burst->hdr.hdr.gpu_pkt0_addr = packets_stats->gpu_pkt0_addr;
+        // The semaphore is the earliest point the CPU sees the burst
+        burst->hdr.hdr.rx_timestamp_ns = adv_net_stats_now_ns();
         HOLOSCAN_LOG_DEBUG(
             "sem {} queue {} num_pkts {}", sem_idx_cpu_list[ridx], ridx, burst->hdr.hdr.num_pkts);
         // Assuming each batch is accumulated by the kernel
+        auto stats = tparams->rxqw[ridx].stats;
+        stats->pkts.fetch_add(burst->hdr.hdr.num_pkts, std::memory_order_relaxed);
+        stats->bytes.fetch_add(burst->hdr.hdr.nbytes, std::memory_order_relaxed);
+        stats->add_burst(burst->hdr.hdr.num_pkts);
         rte_ring_enqueue(tparams->ring, reinterpret_cast<void*>(burst));
 
         result = doca_gpu_semaphore_set_status(tparams->rxqw[ridx].rxq->sem_cpu,
@@ -1746,6 +1756,8 @@ AdvNetStatus DocaMgr::get_rx_burst(AdvNetBurstParams** burst) {
     return AdvNetStatus::NOT_READY;
   }
 
+  const auto& hdr = (*burst)->hdr.hdr;
+  record_rx_latency(find_queue_counters(hdr.port_id, hdr.q_id, AdvNetDirection::RX), *burst);
   return AdvNetStatus::SUCCESS;
 }
 
@@ -90,6 +90,8 @@ static constexpr int DEFAULT_NUM_RX_BURST = 64;
 static constexpr int MAX_IFS = 4;
 static constexpr int num_lcores = 2;
 static constexpr int MEMPOOL_CACHE_SIZE = 32;
+// RX bursts stay out of the pool until the application drops them, so size for batching
+static constexpr uint32_t RX_META_POOL_SIZE = (1U << 8) - 1U;
 static constexpr uint32_t GPU_PAGE_SHIFT = 16;
 static constexpr uint32_t GPU_PAGE_SIZE = (1UL << GPU_PAGE_SHIFT);
 static constexpr uint32_t GPU_PAGE_OFFSET = (GPU_PAGE_SIZE - 1);
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <cuda.h>
@@ -41,6 +42,7 @@ struct TxWorkerParams {
   struct rte_mempool* meta_pool;
   struct rte_mempool* burst_pool;
   struct rte_ether_addr mac_addr;
+  AdvNetQueueCounters* stats;
 };
 
 struct RxWorkerParams {
@@ -52,6 +54,8 @@ struct RxWorkerParams {
   struct rte_mempool* flowid_pool;
   struct rte_mempool* burst_pool;
   struct rte_mempool* meta_pool;
+  const AdvNetFlowClassifier* sw_flows = nullptr;
+  AdvNetQueueCounters* stats;
   uint64_t rx_pkts = 0;
 };
 
@@ -765,11 +769,33 @@ void DpdkMgr::initialize() {
                       conf_ports_eth_addr[intf.port_id_].addr_bytes[4],
                       conf_ports_eth_addr[intf.port_id_].addr_bytes[5]);
 
-    // Start flows
+    // Start flows. Rules the NIC rejects are matched in software by the RX workers instead
     int flow_num = 0;
+    std::vector<FlowConfig> sw_flows;
     for (const auto& flow : rx.flows_) {
       HOLOSCAN_LOG_INFO("Adding RX flow {}", flow.name_);
-      add_flow(intf.port_id_, flow);
+      if (add_flow(intf.port_id_, flow) == nullptr) { sw_flows.push_back(flow); }
+    }
+
+    if (!sw_flows.empty()) {
+      const bool host_hdrs = std::all_of(rx.queues_.begin(), rx.queues_.end(), [this](auto& q) {
+        return cfg_.mrs_[q.common_.mrs_[0]].kind_ != MemoryKind::DEVICE;
+      });
+
+      if (!host_hdrs) {
+        HOLOSCAN_LOG_ERROR(
+            "{} flow rules on port {} were rejected and can't be matched in software since "
+            "packet headers are received into GPU memory",
+            sw_flows.size(),
+            intf.port_id_);
+      } else {
+        HOLOSCAN_LOG_WARN(
+            "{} flow rules on port {} were rejected by the NIC and are matched in software. "
+            "Matching packets get their flow ID but stay on the queue they arrived on",
+            sw_flows.size(),
+            intf.port_id_);
+        if (!sw_flow_classifiers[intf.port_id_].compile(sw_flows)) { return; }
+      }
     }
 
     apply_tx_offloads(intf.port_id_);
@@ -783,12 +809,24 @@ void DpdkMgr::initialize() {
 }
 
 int DpdkMgr::setup_pools_and_rings(int max_rx_batch, int max_tx_batch) {
-  HOLOSCAN_LOG_DEBUG("Setting up RX ring");
-  rx_ring =
-      rte_ring_create("RX_RING", 2048, rte_socket_id(), RING_F_MC_RTS_DEQ | RING_F_MP_RTS_ENQ);
-  if (rx_ring == nullptr) {
-    HOLOSCAN_LOG_CRITICAL("Failed to allocate ring!");
-    return -1;
+  // Each RX queue gets its own ring with exactly one producer (its worker) and one consumer (the
+  // operator polling that queue), so queues never contend with or block each other
+  for (const auto& intf : cfg_.ifs_) {
+    for (const auto& q : intf.rx_.queues_) {
+      const auto name =
+          "RX_RING_P" + std::to_string(intf.port_id_) + "_Q" + std::to_string(q.common_.id_);
+      HOLOSCAN_LOG_DEBUG("Setting up RX ring {}", name);
+      uint32_t key = (intf.port_id_ << 16) | q.common_.id_;
+      rx_rings[key] =
+          rte_ring_create(name.c_str(), 2048, rte_socket_id(), RING_F_SP_ENQ | RING_F_SC_DEQ);
+      if (rx_rings[key] == nullptr) {
+        HOLOSCAN_LOG_CRITICAL("Failed to allocate ring!");
+        return -1;
+      }
+
+      rx_ring_list.push_back(rx_rings[key]);
+      add_queue_counters(intf.port_id_, q.common_.id_, AdvNetDirection::RX, q.common_.batch_size_);
+    }
   }
 
   auto num_rx_ptrs_bufs = (1UL << 13) - 1;
@@ -832,7 +870,7 @@ int DpdkMgr::setup_pools_and_rings(int max_rx_batch, int max_tx_batch) {
 
   HOLOSCAN_LOG_DEBUG("Setting up RX meta pool");
   rx_meta = rte_mempool_create("RX_META_POOL",
-                               (1U << 6) - 1U,
+                               RX_META_POOL_SIZE,
                                sizeof(AdvNetBurstParams),
                                0,
                                0,
@@ -862,6 +900,8 @@ int DpdkMgr::setup_pools_and_rings(int max_rx_batch, int max_tx_batch) {
         return -1;
       }
 
+      add_queue_counters(intf.port_id_, q.common_.id_, AdvNetDirection::TX, q.common_.batch_size_);
+
       name = "TX_BURST_POOL_" + append;
       tx_burst_buffers[key] = rte_mempool_create(name.c_str(),
                                                  (1U << 7) - 1U,
@@ -1006,7 +1046,18 @@ struct rte_flow* DpdkMgr::add_flow(int port, const FlowConfig& cfg) {
 
   pattern[3].type = RTE_FLOW_ITEM_TYPE_END;
 
+  res = rte_flow_validate(port, &attr, pattern, action, &error);
+  if (res != 0) {
+    HOLOSCAN_LOG_ERROR("Failed validation of flow {}: {}",
+                       cfg.name_,
+                       error.message != nullptr ? error.message : "unknown error");
+    return nullptr;
+  }
+
   flow = rte_flow_create(port, &attr, pattern, action, &error);
+  if (flow == nullptr) {
+    HOLOSCAN_LOG_ERROR("rte_flow_create failed for flow {}", cfg.name_);
+  }
   return flow;
 }
 
@@ -1193,12 +1244,15 @@ void DpdkMgr::run() {
         auto params = new RxWorkerParams;
         params->port = intf.port_id_;
         params->num_segs = q.common_.mrs_.size();
-        params->ring = rx_ring;
+        params->ring = rx_rings[(intf.port_id_ << 16) | q.common_.id_];
         params->queue = q.common_.id_;
         params->burst_pool = rx_burst_buffer;
         params->flowid_pool = rx_flow_id_buffer;
         params->meta_pool = rx_meta;
         params->batch_size = q.common_.batch_size_;
+        params->stats = find_queue_counters(intf.port_id_, q.common_.id_, AdvNetDirection::RX);
+        const auto sw_flows = sw_flow_classifiers.find(intf.port_id_);
+        if (sw_flows != sw_flow_classifiers.end()) { params->sw_flows = &sw_flows->second; }
         rte_eal_remote_launch(
             rx_worker, (void*)params, strtol(q.common_.cpu_core_.c_str(), NULL, 10));
       }
@@ -1216,6 +1270,7 @@ void DpdkMgr::run() {
         params->burst_pool = tx_burst_buffers[key];
         params->meta_pool = tx_meta;
         params->batch_size = q.common_.batch_size_;
+        params->stats = find_queue_counters(intf.port_id_, q.common_.id_, AdvNetDirection::TX);
         rte_eth_macaddr_get(intf.port_id_, &params->mac_addr);
         rte_eal_remote_launch(
             tx_worker, (void*)params, strtol(q.common_.cpu_core_.c_str(), NULL, 10));
@@ -1237,6 +1292,21 @@ void DpdkMgr::flush_packets(int port) {
   while (rte_eth_rx_burst(port, 0, &rx_mbuf, 1) != 0) { rte_pktmbuf_free(rx_mbuf); }
 }
 
+/**
+ * @brief Flow ID of a received packet
+ *
+ * Packets marked by a hardware flow rule carry the ID in the mbuf. Otherwise the software
+ * classifier holding the rules the NIC rejected is consulted, if the port has one.
+ */
+static inline uint16_t rx_flow_id(const struct rte_mbuf* mbuf, const AdvNetFlowClassifier* sw) {
+  if (mbuf->ol_flags & RTE_MBUF_F_RX_FDIR_ID) { return mbuf->hash.fdir.hi; }
+  if (sw != nullptr) {
+    const auto res = sw->classify(rte_pktmbuf_mtod(mbuf, const uint8_t*), mbuf->data_len);
+    if (res != nullptr) { return res->flow_id; }
+  }
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 ///  \brief
@@ -1262,6 +1332,7 @@ int DpdkMgr::rx_core_worker(void* arg) {
   int nb_rx = 0;
   int to_copy = 0;
   int cur_pkt_in_batch = 0;
+  uint64_t last_rx_ns = 0;
   //
   //  run loop
   //
@@ -1276,11 +1347,14 @@ int DpdkMgr::rx_core_worker(void* arg) {
     burst->hdr.hdr.q_id = tparams->queue;
     burst->hdr.hdr.port_id = tparams->port;
     burst->hdr.hdr.num_segs = tparams->num_segs;
+    burst->hdr.hdr.nbytes = 0;
+    burst->hdr.hdr.rx_timestamp_ns = 0;
 
     for (int seg = 0; seg < tparams->num_segs; seg++) {
       if (rte_mempool_get(tparams->burst_pool, reinterpret_cast<void**>(&burst->pkts[seg])) < 0) {
         HOLOSCAN_LOG_ERROR(
             "Processing function falling behind. No free flow ID buffers for packets!");
+        tparams->stats->no_buf++;
         continue;
       }
     }
@@ -1288,6 +1362,7 @@ int DpdkMgr::rx_core_worker(void* arg) {
     if (rte_mempool_get(
           tparams->flowid_pool, reinterpret_cast<void**>(&burst->pkt_extra_info)) < 0) {
       HOLOSCAN_LOG_ERROR("Processing function falling behind. No free CPU buffers for packets!");
+      tparams->stats->no_buf++;
       continue;
     }
 
@@ -1295,16 +1370,14 @@ int DpdkMgr::rx_core_worker(void* arg) {
 
     if (nb_rx > 0) {
       burst->hdr.hdr.num_pkts = nb_rx;
+      burst->hdr.hdr.rx_timestamp_ns = last_rx_ns;
 
       // Copy non-scattered buffers
       memcpy(&burst->pkts[0][0], &mbuf_arr[to_copy], sizeof(rte_mbuf*) * nb_rx);
 
       for (int flow_idx = 0; flow_idx < nb_rx; flow_idx++) {
-        if (mbuf_arr[to_copy + flow_idx]->ol_flags & RTE_MBUF_F_RX_FDIR_ID) {
-          pkt_info[flow_idx].flow_id = mbuf_arr[to_copy + flow_idx]->hash.fdir.hi;
-        } else {
-          pkt_info[flow_idx].flow_id = 0;
-        }
+        pkt_info[flow_idx].flow_id = rx_flow_id(mbuf_arr[to_copy + flow_idx], tparams->sw_flows);
+        burst->hdr.hdr.nbytes += mbuf_arr[to_copy + flow_idx]->pkt_len;
       }
 
       if (tparams->num_segs > 1) {  // Extra work when buffers are scattered
@@ -1338,15 +1411,15 @@ int DpdkMgr::rx_core_worker(void* arg) {
 
       if (nb_rx == 0) { continue; }
 
+      last_rx_ns = adv_net_stats_now_ns();
+      if (burst->hdr.hdr.num_pkts == 0) { burst->hdr.hdr.rx_timestamp_ns = last_rx_ns; }
       to_copy = std::min(nb_rx, (int)(tparams->batch_size - burst->hdr.hdr.num_pkts));
       memcpy(&burst->pkts[0][burst->hdr.hdr.num_pkts], &mbuf_arr, sizeof(rte_mbuf*) * to_copy);
 
       for (int flow_idx = 0; flow_idx < to_copy; flow_idx++) {
-        if (mbuf_arr[flow_idx]->ol_flags & RTE_MBUF_F_RX_FDIR_ID) {
-          pkt_info[burst->hdr.hdr.num_pkts + flow_idx].flow_id = mbuf_arr[flow_idx]->hash.fdir.hi;
-        } else {
-          pkt_info[burst->hdr.hdr.num_pkts + flow_idx].flow_id = 0;
-        }
+        pkt_info[burst->hdr.hdr.num_pkts + flow_idx].flow_id =
+            rx_flow_id(mbuf_arr[flow_idx], tparams->sw_flows);
+        burst->hdr.hdr.nbytes += mbuf_arr[flow_idx]->pkt_len;
       }
 
       if (tparams->num_segs > 1) {  // Extra work when buffers are scattered
@@ -1363,11 +1436,26 @@ int DpdkMgr::rx_core_worker(void* arg) {
 
       burst->hdr.hdr.num_pkts += to_copy;
       total_pkts += nb_rx;
+      tparams->stats->pkts.fetch_add(nb_rx, std::memory_order_relaxed);
       nb_rx -= to_copy;
 
       if (burst->hdr.hdr.num_pkts == tparams->batch_size) {
         cur_pkt_in_batch = 0;
-        rte_ring_enqueue(tparams->ring, reinterpret_cast<void*>(burst));
+        const auto nbytes = burst->hdr.hdr.nbytes;
+        if (rte_ring_enqueue(tparams->ring, reinterpret_cast<void*>(burst)) != 0) {
+          // The application isn't keeping up. Drop the burst rather than leak it
+          tparams->stats->dropped.fetch_add(burst->hdr.hdr.num_pkts, std::memory_order_relaxed);
+          rte_pktmbuf_free_bulk(reinterpret_cast<rte_mbuf**>(burst->pkts[0]),
+                                burst->hdr.hdr.num_pkts);
+          for (int seg = 0; seg < tparams->num_segs; seg++) {
+            rte_mempool_put(tparams->burst_pool, burst->pkts[seg]);
+          }
+          rte_mempool_put(tparams->flowid_pool, burst->pkt_extra_info);
+          rte_mempool_put(tparams->meta_pool, burst);
+        } else {
+          tparams->stats->bytes.fetch_add(nbytes, std::memory_order_relaxed);
+          tparams->stats->add_burst(tparams->batch_size);
+        }
         break;
       }
     } while (!force_quit.load());
@@ -1423,6 +1511,10 @@ int DpdkMgr::tx_core_worker(void* arg) {
     //     }
 
     auto pkts_to_transmit = static_cast<int64_t>(msg->hdr.hdr.num_pkts);
+    uint64_t burst_bytes = 0;
+    for (size_t p = 0; p < msg->hdr.hdr.num_pkts; p++) {
+      burst_bytes += reinterpret_cast<struct rte_mbuf*>(msg->pkts[0][p])->pkt_len;
+    }
 
     size_t pkts_tx = 0;
     while (pkts_tx != msg->hdr.hdr.num_pkts && !force_quit.load()) {
@@ -1440,6 +1532,11 @@ int DpdkMgr::tx_core_worker(void* arg) {
     }
 
     ttl_pkts_tx += pkts_tx;
+    tparams->stats->pkts.fetch_add(pkts_tx, std::memory_order_relaxed);
+    tparams->stats->add_burst(pkts_tx);
+    if (pkts_tx == msg->hdr.hdr.num_pkts) {
+      tparams->stats->bytes.fetch_add(burst_bytes, std::memory_order_relaxed);
+    }
 
     for (int seg = 0; seg < msg->hdr.hdr.num_segs; seg++) {
       rte_mempool_put(tparams->burst_pool, static_cast<void*>(msg->pkts[seg]));
@@ -1563,6 +1660,38 @@ AdvNetStatus DpdkMgr::set_udp_payload(AdvNetBurstParams* burst, int idx, void* d
   return AdvNetStatus::SUCCESS;
 }
 
+AdvNetStatus DpdkMgr::set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens,
+                                   uint16_t payload_len) {
+  auto tmpl = find_tx_template(burst);
+  if (tmpl == nullptr) { return AdvNetStatus::INVALID_PARAMETER; }
+  if (burst->hdr.hdr.num_segs > 2) { return AdvNetStatus::NOT_SUPPORTED; }
+
+  const int num = burst->hdr.hdr.num_pkts;
+  auto mbufs = reinterpret_cast<rte_mbuf**>(burst->pkts[0]);
+  std::array<void*, TX_HDR_CHUNK> hdrs;
+  for (int base = 0; base < num; base += TX_HDR_CHUNK) {
+    const int n = std::min(TX_HDR_CHUNK, num - base);
+    const uint16_t* lens = payload_lens != nullptr ? payload_lens + base : nullptr;
+    for (int i = 0; i < n; i++) { hdrs[i] = rte_pktmbuf_mtod(mbufs[base + i], void*); }
+    stamp_udp_hdrs(*tmpl, hdrs.data(), lens, payload_len, n);
+
+    for (int i = 0; i < n; i++) {
+      uint32_t seg0, seg1;
+      tx_seg_lens(*tmpl, lens != nullptr ? lens[i] : payload_len, seg0, seg1);
+      auto mbuf = mbufs[base + i];
+      if (burst->hdr.hdr.num_segs == 1) {
+        mbuf->data_len = seg0 + seg1;
+      } else {
+        mbuf->data_len = seg0;
+        reinterpret_cast<rte_mbuf**>(burst->pkts[1])[base + i]->data_len = seg1;
+      }
+      mbuf->pkt_len = seg0 + seg1;
+    }
+  }
+
+  return AdvNetStatus::SUCCESS;
+}
+
 bool DpdkMgr::tx_burst_available(AdvNetBurstParams* burst) {
   const uint32_t key = (burst->hdr.hdr.port_id << 16) | burst->hdr.hdr.q_id;
   const auto& q = tx_q_map_[key];
@@ -1634,10 +1763,32 @@ std::optional<uint16_t> DpdkMgr::get_port_from_ifname(const std::string& name) {
 }
 
 AdvNetStatus DpdkMgr::get_rx_burst(AdvNetBurstParams** burst) {
-  if (rte_ring_dequeue(rx_ring, reinterpret_cast<void**>(burst)) < 0) {
+  // Round-robin over all queues so a busy queue can't starve the others
+  for (size_t i = 0; i < rx_ring_list.size(); i++) {
+    auto ring = rx_ring_list[rx_ring_next];
+    rx_ring_next = (rx_ring_next + 1) % rx_ring_list.size();
+    if (rte_ring_dequeue(ring, reinterpret_cast<void**>(burst)) == 0) {
+      const auto& hdr = (*burst)->hdr.hdr;
+      record_rx_latency(find_queue_counters(hdr.port_id, hdr.q_id, AdvNetDirection::RX), *burst);
+      return AdvNetStatus::SUCCESS;
+    }
+  }
+
+  return AdvNetStatus::NOT_READY;
+}
+
+AdvNetStatus DpdkMgr::get_rx_burst(AdvNetBurstParams** burst, int port, int q) {
+  const auto ring = rx_rings.find((port << 16) | q);
+  if (ring == rx_rings.end()) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_rx_burst: {}/{}", port, q);
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  if (rte_ring_dequeue(ring->second, reinterpret_cast<void**>(burst)) < 0) {
     return AdvNetStatus::NOT_READY;
   }
 
+  record_rx_latency(find_queue_counters(port, q, AdvNetDirection::RX), *burst);
   return AdvNetStatus::SUCCESS;
 }
 
@@ -1697,6 +1848,39 @@ void DpdkMgr::print_stats() {
   RTE_ETH_FOREACH_DEV(portid) {
     PrintDpdkStats(portid);
   }
+
+  for (const auto& q : get_queue_stats()) {
+    if (q.dir != AdvNetDirection::RX) { continue; }
+    HOLOSCAN_LOG_INFO("RX port {} queue {}: {} bursts, {:.1f}% full, {} dropped, "
+                      "latency p50/p99/max {}/{}/{} ns",
+                      q.port,
+                      q.queue,
+                      q.bursts,
+                      q.burst_fill * 100,
+                      q.dropped,
+                      q.rx_latency.p50_ns,
+                      q.rx_latency.p99_ns,
+                      q.rx_latency.max_ns);
+  }
+}
+
+void DpdkMgr::fill_queue_gauges(AdvNetQueueStats& stats) const {
+  const uint32_t key = (stats.port << 16) | stats.queue;
+  const auto& rings = stats.dir == AdvNetDirection::RX ? rx_rings : tx_rings;
+  const auto& qs = stats.dir == AdvNetDirection::RX ? rx_q_map_ : tx_q_map_;
+
+  const auto ring = rings.find(key);
+  if (ring != rings.end()) {
+    stats.ring_depth = rte_ring_count(ring->second);
+    stats.ring_capacity = rte_ring_get_capacity(ring->second);
+  }
+
+  // Packet buffers of the first segment run out first when the application holds on to bursts
+  const auto q = qs.find(key);
+  if (q != qs.end() && !q->second->pools.empty()) {
+    stats.pool_avail = rte_mempool_avail_count(q->second->pools[0]);
+    stats.pool_size = q->second->pools[0]->size;
+  }
 }
 
 uint64_t DpdkMgr::get_burst_tot_byte(AdvNetBurstParams* burst) {
@@ -49,6 +49,7 @@
 #include <unordered_map>
 #include "adv_network_mgr.h"
 #include "adv_network_common.h"
+#include "adv_network_flow.h"
 
 namespace holoscan::ops {
 
@@ -153,6 +154,8 @@ class DpdkMgr : public ANOMgr {
   int num_ports = 0;
   static constexpr int num_lcores = 2;
   static constexpr int MEMPOOL_CACHE_SIZE = 32;
+  // RX bursts stay out of the pool until the application drops them, so size for batching
+  static constexpr uint32_t RX_META_POOL_SIZE = (1U << 12) - 1U;
   static constexpr int MAX_PKT_BURST = 64;
 
   static constexpr uint32_t GPU_PAGE_OFFSET = (GPU_PAGE_SIZE - 1);
@@ -174,6 +177,8 @@ class DpdkMgr : public ANOMgr {
   AdvNetStatus set_udp_hdr(AdvNetBurstParams* burst, int idx, int udp_len, uint16_t src_port,
                            uint16_t dst_port) override;
   AdvNetStatus set_udp_payload(AdvNetBurstParams* burst, int idx, void* data, int len) override;
+  AdvNetStatus set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens,
+                            uint16_t payload_len) override;
   bool tx_burst_available(AdvNetBurstParams* burst) override;
 
   AdvNetStatus set_pkt_lens(AdvNetBurstParams* burst, int idx,
@@ -187,6 +192,7 @@ class DpdkMgr : public ANOMgr {
   std::optional<uint16_t> get_port_from_ifname(const std::string& name) override;
 
   AdvNetStatus get_rx_burst(AdvNetBurstParams** burst) override;
+  AdvNetStatus get_rx_burst(AdvNetBurstParams** burst, int port, int q) override;
   AdvNetStatus set_pkt_tx_time(AdvNetBurstParams* burst, int idx, uint64_t timestamp);
   void free_rx_meta(AdvNetBurstParams* burst) override;
   void free_tx_meta(AdvNetBurstParams* burst) override;
@@ -201,6 +207,9 @@ class DpdkMgr : public ANOMgr {
   AdvNetBurstParams* create_burst_params() override;
   bool validate_config() const override;
 
+ protected:
+  void fill_queue_gauges(AdvNetQueueStats& stats) const override;
+
  private:
   static void PrintDpdkStats(int port);
   static std::string generate_random_string(int len);
@@ -223,12 +232,15 @@ class DpdkMgr : public ANOMgr {
   std::array<std::string, MAX_IFS> pcie_addrs;
   std::array<struct rte_ether_addr, MAX_IFS> mac_addrs;
   struct rte_ether_addr conf_ports_eth_addr[RTE_MAX_ETHPORTS];
-  struct rte_ring* rx_ring;
+  std::unordered_map<uint32_t, struct rte_ring*> rx_rings;
+  std::vector<struct rte_ring*> rx_ring_list;
+  size_t rx_ring_next = 0;
   std::unordered_map<uint32_t, struct rte_ring*> tx_rings;
   std::unordered_map<uint32_t, struct rte_mempool*> tx_burst_buffers;
   std::unordered_map<std::string, std::shared_ptr<struct rte_pktmbuf_extmem>> ext_pktmbufs_;
   std::unordered_map<uint32_t, DPDKQueueConfig*> rx_q_map_;
   std::unordered_map<uint32_t, DPDKQueueConfig*> tx_q_map_;
+  std::unordered_map<uint16_t, AdvNetFlowClassifier> sw_flow_classifiers;
   struct rte_mempool* pkt_len_buffer;
   struct rte_mempool* rx_burst_buffer;
   struct rte_mempool* rx_flow_id_buffer;
@@ -0,0 +1,1392 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "adv_network_socket_mgr.h"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops {
+
+bool SocketPktPool::get_bulk(void** ptrs, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (!free_.pop(ptrs[i])) {
+      put_bulk(ptrs, i);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void SocketPktPool::put_bulk(void* const* ptrs, size_t n) {
+  for (size_t i = 0; i < n; i++) { free_.push(ptrs[i]); }
+}
+
+static inline uint16_t ipv4_hdr_cksum(const uint8_t* hdr, size_t len) {
+  uint32_t sum = 0;
+  for (size_t i = 0; i + 1 < len; i += 2) {
+    uint16_t word;
+    memcpy(&word, hdr + i, sizeof(word));
+    sum += word;
+  }
+  while (sum >> 16) { sum = (sum & 0xffff) + (sum >> 16); }
+  return static_cast<uint16_t>(~sum);
+}
+
+bool SocketMgr::set_config_and_initialize(const AdvNetConfigYaml& cfg) {
+  num_init++;
+
+  if (!this->initialized_) {
+    cfg_ = cfg;
+
+    // Initialize in a separate thread for parity with the DPDK manager, so nothing done during
+    // setup can change the affinity of the calling thread
+    std::thread t(&SocketMgr::initialize, this);
+    t.join();
+
+    if (!this->initialized_) {
+      HOLOSCAN_LOG_CRITICAL("Failed to initialize socket ANO manager");
+      return false;
+    }
+
+    if (!validate_config()) {
+      HOLOSCAN_LOG_CRITICAL("Config validation failed");
+      return false;
+    }
+
+    run();
+  }
+
+  return true;
+}
+
+void SocketMgr::adjust_memory_regions() {
+  for (auto& mr : cfg_.mrs_) {
+    mr.second.adj_size_ =
+        (mr.second.buf_size_ + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    HOLOSCAN_LOG_INFO("Adjusting buffer size to {} for cache line alignment", mr.second.adj_size_);
+  }
+}
+
+AdvNetStatus SocketMgr::allocate_memory_regions() {
+  HOLOSCAN_LOG_INFO("Registering memory regions");
+  for (auto& mr : cfg_.mrs_) {
+    void* ptr = nullptr;
+    size_t len = 0;
+    RegionAlloc alloc = RegionAlloc::ALIGNED;
+    mr.second.ttl_size_ = mr.second.adj_size_ * mr.second.num_bufs_;
+
+    if (!mr.second.owned_) {
+      HOLOSCAN_LOG_CRITICAL("Socket manager requires owned memory regions ({})", mr.second.name_);
+      return AdvNetStatus::INVALID_PARAMETER;
+    }
+
+    switch (mr.second.kind_) {
+      case MemoryKind::HOST:
+        ptr = aligned_alloc(CACHE_LINE_SIZE, mr.second.ttl_size_);
+        break;
+      case MemoryKind::HOST_PINNED:
+        if (cudaHostAlloc(&ptr, mr.second.ttl_size_, 0) != cudaSuccess) { ptr = nullptr; }
+        alloc = RegionAlloc::PINNED;
+        break;
+      case MemoryKind::HUGE: {
+        const size_t huge_len = (mr.second.ttl_size_ + (2UL << 20) - 1) & ~((2UL << 20) - 1);
+        ptr = mmap(nullptr,
+                   huge_len,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+                   -1,
+                   0);
+        if (ptr == MAP_FAILED) {
+          HOLOSCAN_LOG_WARN("No huge pages available for {}. Falling back to regular pages",
+                            mr.second.name_);
+          ptr = aligned_alloc(CACHE_LINE_SIZE, mr.second.ttl_size_);
+        } else {
+          len = huge_len;
+          alloc = RegionAlloc::MAPPED;
+        }
+        break;
+      }
+      case MemoryKind::DEVICE:
+        HOLOSCAN_LOG_CRITICAL(
+            "Memory region {} uses device memory, which the socket manager does not support",
+            mr.second.name_);
+        return AdvNetStatus::NOT_SUPPORTED;
+      default:
+        HOLOSCAN_LOG_ERROR("Unknown memory type {}!", static_cast<int>(mr.second.kind_));
+        return AdvNetStatus::INVALID_PARAMETER;
+    }
+
+    if (ptr == nullptr) {
+      HOLOSCAN_LOG_CRITICAL("Fatal to allocate {} of type {} for MR",
+                            mr.second.ttl_size_,
+                            static_cast<int>(mr.second.kind_));
+      return AdvNetStatus::NULL_PTR;
+    }
+
+    HOLOSCAN_LOG_INFO(
+        "Successfully allocated memory region {} at {} type {} with {} bytes "
+        "({} elements @ {} bytes total {})",
+        mr.second.name_,
+        ptr,
+        static_cast<int>(mr.second.kind_),
+        mr.second.buf_size_,
+        mr.second.num_bufs_,
+        mr.second.adj_size_,
+        mr.second.ttl_size_);
+    ar_[mr.second.name_] = {mr.second.name_, ptr};
+    owned_regions_.push_back({ptr, len, alloc});
+
+    pools_.emplace_back(std::make_unique<SocketPktPool>(mr.second.name_,
+                                                        static_cast<char*>(ptr),
+                                                        mr.second.adj_size_,
+                                                        mr.second.num_bufs_));
+    mr_pools_[mr.second.name_] = pools_.back().get();
+  }
+
+  HOLOSCAN_LOG_INFO("Finished allocating memory regions");
+  return AdvNetStatus::SUCCESS;
+}
+
+int SocketMgr::open_rx_socket(const AdvNetConfigInterface& intf, int fanout_group) {
+  int fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+  if (fd < 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to open RX packet socket on {}: {}. Is CAP_NET_RAW missing?",
+                          intf.address_,
+                          strerror(errno));
+    return -1;
+  }
+
+  struct sockaddr_ll sll {};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = htons(ETH_P_ALL);
+  sll.sll_ifindex = if_indices_[intf.port_id_];
+  if (bind(fd, reinterpret_cast<struct sockaddr*>(&sll), sizeof(sll)) < 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to bind RX socket to {}: {}", intf.address_, strerror(errno));
+    close(fd);
+    return -1;
+  }
+
+  // Don't deliver our own transmitted frames back to the receive queues
+  int one = 1;
+  if (setsockopt(fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one)) < 0) {
+    HOLOSCAN_LOG_WARN("PACKET_IGNORE_OUTGOING unsupported; TX frames on {} will be seen by RX",
+                      intf.address_);
+  }
+
+  int buf_bytes = SOCKET_BUF_BYTES;
+  if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &buf_bytes, sizeof(buf_bytes)) < 0) {
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf_bytes, sizeof(buf_bytes));
+  }
+
+  struct timeval tv {
+    0, RX_POLL_TIMEOUT_MS * 1000
+  };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  // Spread flows over the queues of an interface the same way RSS would. Interfaces steered by
+  // flow rules pass a negative group since they only use a single socket
+  if (fanout_group >= 0 && intf.rx_.queues_.size() > 1) {
+    int fanout = (fanout_group & 0xffff) | (PACKET_FANOUT_HASH << 16);
+    if (setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &fanout, sizeof(fanout)) < 0) {
+      HOLOSCAN_LOG_CRITICAL(
+          "Failed to join fanout group on {}: {}", intf.address_, strerror(errno));
+      close(fd);
+      return -1;
+    }
+  }
+
+  return fd;
+}
+
+int SocketMgr::open_tx_socket(const AdvNetConfigInterface& intf) {
+  // Protocol 0 means the socket never receives, it's only used for transmit
+  int fd = socket(AF_PACKET, SOCK_RAW, 0);
+  if (fd < 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to open TX packet socket on {}: {}. Is CAP_NET_RAW missing?",
+                          intf.address_,
+                          strerror(errno));
+    return -1;
+  }
+
+  struct sockaddr_ll sll {};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = htons(ETH_P_ALL);
+  sll.sll_ifindex = if_indices_[intf.port_id_];
+  if (bind(fd, reinterpret_cast<struct sockaddr*>(&sll), sizeof(sll)) < 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to bind TX socket to {}: {}", intf.address_, strerror(errno));
+    close(fd);
+    return -1;
+  }
+
+  int one = 1;
+  setsockopt(fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one));
+
+  int buf_bytes = SOCKET_BUF_BYTES;
+  if (setsockopt(fd, SOL_SOCKET, SO_SNDBUFFORCE, &buf_bytes, sizeof(buf_bytes)) < 0) {
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buf_bytes, sizeof(buf_bytes));
+  }
+
+  return fd;
+}
+
+void SocketMgr::initialize() {
+  if (cfg_.ifs_.size() > MAX_IFS) {
+    HOLOSCAN_LOG_CRITICAL("Socket manager supports at most {} interfaces", MAX_IFS);
+    return;
+  }
+
+  // Interfaces are addressed by their Linux link name (ip link). Entries sharing a link name
+  // (for example separate RX and TX entries on "lo") share a port ID
+  std::unordered_map<std::string, uint16_t> link_ports;
+  for (auto& intf : cfg_.ifs_) {
+    const auto existing = link_ports.find(intf.address_);
+    if (existing != link_ports.end()) {
+      intf.port_id_ = existing->second;
+      continue;
+    }
+
+    intf.port_id_ = link_ports.size();
+    link_ports[intf.address_] = intf.port_id_;
+
+    // Interfaces that only replay captures don't need a real link behind them
+    const bool replay_only =
+        intf.tx_.queues_.empty() &&
+        std::all_of(intf.rx_.queues_.begin(), intf.rx_.queues_.end(), [](const auto& q) {
+          return dynamic_cast<SocketRxQueueConfig*>(q.common_.extra_queue_config_) != nullptr;
+        });
+    if (replay_only) {
+      HOLOSCAN_LOG_INFO("Socket init ({}) -- replay only", intf.address_);
+      continue;
+    }
+
+    const int ifindex = if_nametoindex(intf.address_.c_str());
+    if (ifindex == 0) {
+      HOLOSCAN_LOG_CRITICAL("Failed to find Linux interface {} for {}", intf.address_, intf.name_);
+      return;
+    }
+    if_indices_[intf.port_id_] = ifindex;
+
+    struct ifreq ifr {};
+    strncpy(ifr.ifr_name, intf.address_.c_str(), IFNAMSIZ - 1);
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd >= 0 && ioctl(fd, SIOCGIFHWADDR, &ifr) == 0) {
+      memcpy(mac_addrs_[intf.port_id_].data(), ifr.ifr_hwaddr.sa_data, 6);
+    } else {
+      HOLOSCAN_LOG_WARN("Failed to get MAC address of {}", intf.address_);
+    }
+    if (fd >= 0) { close(fd); }
+
+    HOLOSCAN_LOG_INFO("Socket init ({}) -- ifindex: {} RX: {} TX: {}",
+                      intf.address_,
+                      ifindex,
+                      intf.rx_.queues_.size() > 0 ? "ENABLED" : "DISABLED",
+                      intf.tx_.queues_.size() > 0 ? "ENABLED" : "DISABLED");
+  }
+
+  adjust_memory_regions();
+
+  if (allocate_memory_regions() != AdvNetStatus::SUCCESS) {
+    HOLOSCAN_LOG_CRITICAL("Failed to allocate memory");
+    return;
+  }
+
+  size_t max_batch = 0;
+  const int fanout_base = getpid();
+  for (const auto& intf : cfg_.ifs_) {
+    for (const auto& q : intf.rx_.queues_) {
+      auto rxq = std::make_unique<SocketRxQueue>();
+      rxq->port = intf.port_id_;
+      rxq->queue = q.common_.id_;
+      rxq->num_segs = q.common_.mrs_.size();
+      rxq->cpu_core = strtol(q.common_.cpu_core_.c_str(), nullptr, 10);
+      rxq->batch_size = q.common_.batch_size_;
+      rxq->stats = add_queue_counters(
+          intf.port_id_, q.common_.id_, AdvNetDirection::RX, q.common_.batch_size_);
+      if (rxq->num_segs > MAX_NUM_SEGS) {
+        HOLOSCAN_LOG_CRITICAL("Too many memory regions in RX queue {}", q.common_.name_);
+        return;
+      }
+      for (int seg = 0; seg < rxq->num_segs; seg++) {
+        rxq->pools[seg] = mr_pools_[q.common_.mrs_[seg]];
+      }
+
+      rxq->ring = std::make_unique<SocketRing<AdvNetBurstParams*>>(RX_RING_SIZE);
+      const auto replay_cfg = dynamic_cast<SocketRxQueueConfig*>(q.common_.extra_queue_config_);
+      if (replay_cfg != nullptr) {
+        rxq->replay = std::make_unique<AdvNetCaptureReader>();
+        if (!rxq->replay->open(replay_cfg->replay_file_)) { return; }
+        rxq->replay_speed = replay_cfg->replay_speed_;
+        rxq->replay_loop = replay_cfg->replay_loop_;
+      } else if (!intf.rx_.flows_.empty()) {
+        // Fed by the interface's steering worker
+        rxq->steered = true;
+      } else {
+        rxq->fd = open_rx_socket(intf, fanout_base + intf.port_id_);
+        if (rxq->fd < 0) { return; }
+      }
+
+      HOLOSCAN_LOG_INFO("Successfully setup RX port {} queue {}", intf.port_id_, q.common_.id_);
+      max_batch = std::max(max_batch, static_cast<size_t>(q.common_.batch_size_));
+      rx_q_map_[(intf.port_id_ << 16) | q.common_.id_] = rxq.get();
+      rx_qs_.emplace_back(std::move(rxq));
+    }
+
+    if (!intf.rx_.flows_.empty() && !setup_steering(intf)) { return; }
+
+    for (const auto& q : intf.tx_.queues_) {
+      auto txq = std::make_unique<SocketTxQueue>();
+      txq->port = intf.port_id_;
+      txq->queue = q.common_.id_;
+      txq->num_segs = q.common_.mrs_.size();
+      txq->cpu_core = strtol(q.common_.cpu_core_.c_str(), nullptr, 10);
+      txq->batch_size = q.common_.batch_size_;
+      txq->stats = add_queue_counters(
+          intf.port_id_, q.common_.id_, AdvNetDirection::TX, q.common_.batch_size_);
+      if (txq->num_segs > MAX_NUM_SEGS) {
+        HOLOSCAN_LOG_CRITICAL("Too many memory regions in TX queue {}", q.common_.name_);
+        return;
+      }
+      for (int seg = 0; seg < txq->num_segs; seg++) {
+        txq->pools[seg] = mr_pools_[q.common_.mrs_[seg]];
+      }
+
+      txq->ring = std::make_unique<SocketRing<AdvNetBurstParams*>>(TX_RING_SIZE);
+      txq->fd = open_tx_socket(intf);
+      if (txq->fd < 0) { return; }
+
+      HOLOSCAN_LOG_INFO("Successfully set up TX queue {}/{}", intf.port_id_, q.common_.id_);
+      max_batch = std::max(max_batch, static_cast<size_t>(q.common_.batch_size_));
+      tx_qs_[(intf.port_id_ << 16) | q.common_.id_] = std::move(txq);
+    }
+  }
+
+  HOLOSCAN_LOG_INFO("Setting up {} burst buffers of {} packets", NUM_BURST_BUFS, max_batch);
+  burst_bufs_pool_ = std::make_unique<SocketRing<SocketBurstBufs*>>(NUM_BURST_BUFS);
+  for (int i = 0; i < NUM_BURST_BUFS; i++) {
+    burst_bufs_storage_.emplace_back(std::make_unique<SocketBurstBufs>(max_batch));
+    burst_bufs_pool_->push(burst_bufs_storage_.back().get());
+  }
+
+  meta_storage_.resize(2 * NUM_META_BUFS);
+  rx_meta_ = std::make_unique<SocketRing<AdvNetBurstParams*>>(NUM_META_BUFS);
+  tx_meta_ = std::make_unique<SocketRing<AdvNetBurstParams*>>(NUM_META_BUFS);
+  for (int i = 0; i < NUM_META_BUFS; i++) {
+    rx_meta_->push(&meta_storage_[i]);
+    tx_meta_->push(&meta_storage_[NUM_META_BUFS + i]);
+  }
+
+  this->initialized_ = true;
+}
+
+AdvNetStatus SocketMgr::parse_rx_queue_socket_config(const YAML::Node& q_item, RxQueueConfig& q) {
+  const auto& replay = q_item["replay"];
+  if (!replay.IsDefined()) { return AdvNetStatus::SUCCESS; }
+
+  // The queue only takes the config once it parsed and is valid
+  auto cfg = std::make_unique<SocketRxQueueConfig>();
+  try {
+    cfg->replay_file_ = replay["file"].as<std::string>();
+    cfg->replay_speed_ = replay["speed"].as<double>(1.0);
+    cfg->replay_loop_ = replay["loop"].as<bool>(false);
+  } catch (const std::exception& e) {
+    HOLOSCAN_LOG_ERROR("Error parsing socket replay config: {}", e.what());
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  if (cfg->replay_speed_ < 0) {
+    HOLOSCAN_LOG_ERROR("Replay speed must not be negative");
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  q.common_.extra_queue_config_ = cfg.release();
+  return AdvNetStatus::SUCCESS;
+}
+
+bool SocketMgr::validate_config() const {
+  if (!ANOMgr::validate_config()) { return false; }
+
+  for (const auto& intf : cfg_.ifs_) {
+    for (const auto& flow : intf.rx_.flows_) {
+      const bool found =
+          std::any_of(intf.rx_.queues_.begin(), intf.rx_.queues_.end(), [&flow](const auto& q) {
+            return q.common_.id_ == flow.action_.id_;
+          });
+      if (!found) {
+        HOLOSCAN_LOG_ERROR("Flow {} on {} steers to RX queue {}, which isn't configured",
+                           flow.name_,
+                           intf.address_,
+                           flow.action_.id_);
+        return false;
+      }
+    }
+
+    for (const auto& q : intf.rx_.queues_) {
+      if (q.common_.batch_size_ <= 0) {
+        HOLOSCAN_LOG_ERROR("RX queue {} must have a positive batch size", q.common_.name_);
+        return false;
+      }
+    }
+  }
+
+  HOLOSCAN_LOG_INFO("Config validated successfully");
+  return true;
+}
+
+void SocketMgr::pin_thread(int core) {
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(core, &cpuset);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+    HOLOSCAN_LOG_WARN("Failed to pin socket worker to core {}", core);
+  }
+}
+
+void SocketMgr::run() {
+  HOLOSCAN_LOG_INFO("Starting advanced network workers");
+  for (auto& q : rx_qs_) {
+    if (q->replay) {
+      workers_.emplace_back(&SocketMgr::replay_worker, this, q.get());
+    } else if (!q->steered) {
+      workers_.emplace_back(&SocketMgr::rx_worker, this, q.get());
+    }
+  }
+  for (auto& g : steer_groups_) { workers_.emplace_back(&SocketMgr::steer_worker, this, g.get()); }
+  for (auto& q : tx_qs_) { workers_.emplace_back(&SocketMgr::tx_worker, this, q.second.get()); }
+  HOLOSCAN_LOG_INFO("Done starting workers");
+}
+
+void SocketMgr::rx_worker(SocketRxQueue* q) {
+  pin_thread(q->cpu_core);
+  HOLOSCAN_LOG_INFO("Starting RX worker on core {}, port {}, queue {}",
+                    q->cpu_core,
+                    q->port,
+                    q->queue);
+
+  std::array<struct mmsghdr, DEFAULT_NUM_RX_BURST> msgs;
+  std::array<std::array<struct iovec, MAX_NUM_SEGS>, DEFAULT_NUM_RX_BURST> iovs;
+  std::array<size_t, MAX_NUM_SEGS> seg_sizes;
+  for (int seg = 0; seg < q->num_segs; seg++) {
+    seg_sizes[seg] = cfg_.mrs_.at(q->pools[seg]->name_).buf_size_;
+  }
+
+  AdvNetBurstParams* burst = nullptr;
+  SocketBurstBufs* bufs = nullptr;
+
+  while (!force_quit_.load()) {
+    if (burst == nullptr) {
+      burst = alloc_rx_burst(q);
+      if (burst == nullptr) {
+        std::this_thread::yield();
+        continue;
+      }
+      bufs = get_burst_bufs(burst);
+    }
+
+    const size_t cur = burst->hdr.hdr.num_pkts;
+    const auto to_rx = static_cast<unsigned int>(
+        std::min(static_cast<size_t>(DEFAULT_NUM_RX_BURST), q->batch_size - cur));
+
+    // Reserve packet buffers straight in the burst so received frames never need a copy
+    bool have_bufs = true;
+    for (int seg = 0; seg < q->num_segs; seg++) {
+      if (!q->pools[seg]->get_bulk(&bufs->pkts[seg][cur], to_rx)) {
+        for (int s = 0; s < seg; s++) { q->pools[s]->put_bulk(&bufs->pkts[s][cur], to_rx); }
+        have_bufs = false;
+        break;
+      }
+    }
+
+    if (!have_bufs) {
+      q->stats->no_buf++;
+      std::this_thread::yield();
+      continue;
+    }
+
+    for (unsigned int i = 0; i < to_rx; i++) {
+      for (int seg = 0; seg < q->num_segs; seg++) {
+        iovs[i][seg].iov_base = bufs->pkts[seg][cur + i];
+        iovs[i][seg].iov_len = seg_sizes[seg];
+      }
+      memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+      msgs[i].msg_hdr.msg_iov = iovs[i].data();
+      msgs[i].msg_hdr.msg_iovlen = q->num_segs;
+    }
+
+    // Block for the first frame (bounded by SO_RCVTIMEO), then take whatever else is queued
+    const int nb_rx = recvmmsg(q->fd, msgs.data(), to_rx, MSG_WAITFORONE, nullptr);
+    const unsigned int got = nb_rx > 0 ? nb_rx : 0;
+    if (cur == 0 && got > 0) { burst->hdr.hdr.rx_timestamp_ns = adv_net_stats_now_ns(); }
+
+    for (unsigned int i = 0; i < got; i++) {
+      uint32_t remaining = msgs[i].msg_len;
+      for (int seg = 0; seg < q->num_segs; seg++) {
+        const auto seg_len = static_cast<uint32_t>(std::min<size_t>(remaining, seg_sizes[seg]));
+        bufs->lens[seg][cur + i] = seg_len;
+        remaining -= seg_len;
+      }
+      bufs->info[cur + i].flow_id = 0;
+      burst->hdr.hdr.nbytes += msgs[i].msg_len;
+      if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) { q->stats->dropped++; }
+    }
+
+    for (int seg = 0; seg < q->num_segs; seg++) {
+      q->pools[seg]->put_bulk(&bufs->pkts[seg][cur + got], to_rx - got);
+    }
+
+    burst->hdr.hdr.num_pkts += got;
+    q->stats->pkts += got;
+
+    // Hand off when the batch is full, or flush a partial batch once the line goes idle so
+    // low-rate test traffic is not held back indefinitely
+    const bool idle = nb_rx <= 0 && burst->hdr.hdr.num_pkts > 0;
+    if (burst->hdr.hdr.num_pkts == q->batch_size || idle) {
+      flush_rx_burst(q, burst);
+      burst = nullptr;
+    }
+  }
+
+  if (burst != nullptr) {
+    free_all_pkts(burst);
+    free_rx_burst(burst);
+    free_rx_meta(burst);
+  }
+
+  HOLOSCAN_LOG_INFO("Total packets received by application (port/queue {}/{}): {}",
+                    q->port,
+                    q->queue,
+                    q->stats->pkts.load());
+}
+
+bool SocketMgr::setup_steering(const AdvNetConfigInterface& intf) {
+  auto g = std::make_unique<SocketSteerGroup>();
+  g->port = intf.port_id_;
+  g->isolate = intf.flow_isolation_;
+
+  for (const auto& q : rx_qs_) {
+    if (q->port != intf.port_id_ || !q->steered) { continue; }
+    if (g->queues.size() <= q->queue) { g->queues.resize(q->queue + 1, nullptr); }
+    g->queues[q->queue] = q.get();
+
+    // Unmatched frames go to queue 0 like they would without RSS, or the first queue otherwise
+    if (g->default_q == nullptr || q->queue == 0) { g->default_q = q.get(); }
+
+    size_t frame = 0;
+    for (int seg = 0; seg < q->num_segs; seg++) {
+      frame += cfg_.mrs_.at(q->pools[seg]->name_).buf_size_;
+    }
+    g->max_frame = std::max(g->max_frame, frame);
+  }
+
+  // Every queue of the interface replays a capture
+  if (g->default_q == nullptr) { return true; }
+
+  for (const auto& flow : intf.rx_.flows_) {
+    if (flow.action_.id_ >= g->queues.size() || g->queues[flow.action_.id_] == nullptr) {
+      HOLOSCAN_LOG_CRITICAL("Flow {} can't steer to replay queue {}", flow.name_, flow.action_.id_);
+      return false;
+    }
+  }
+
+  g->cpu_core = g->default_q->cpu_core;
+  if (!g->classifier.compile(intf.rx_.flows_)) { return false; }
+
+  g->fd = open_rx_socket(intf, -1);
+  if (g->fd < 0) { return false; }
+
+  HOLOSCAN_LOG_INFO("Steering RX port {} with {} software flow rules",
+                    intf.port_id_,
+                    g->classifier.size());
+  steer_groups_.emplace_back(std::move(g));
+  return true;
+}
+
+AdvNetBurstParams* SocketMgr::alloc_rx_burst(SocketRxQueue* q) {
+  AdvNetBurstParams* burst;
+  SocketBurstBufs* bufs;
+
+  if (!rx_meta_->pop(burst)) {
+    q->stats->no_buf++;
+    return nullptr;
+  }
+
+  if (!burst_bufs_pool_->pop(bufs)) {
+    rx_meta_->push(burst);
+    q->stats->no_buf++;
+    return nullptr;
+  }
+
+  burst->hdr.hdr.port_id = q->port;
+  burst->hdr.hdr.q_id = q->queue;
+  burst->hdr.hdr.num_segs = q->num_segs;
+  burst->hdr.hdr.num_pkts = 0;
+  burst->hdr.hdr.nbytes = 0;
+  burst->hdr.hdr.rx_timestamp_ns = 0;
+  burst->hdr.extra_burst_data = bufs;
+  for (int seg = 0; seg < q->num_segs; seg++) {
+    burst->pkts[seg] = bufs->pkts[seg].data();
+    burst->pkt_lens[seg] = bufs->lens[seg].data();
+  }
+  burst->pkt_extra_info = reinterpret_cast<void**>(bufs->info.data());
+  return burst;
+}
+
+void SocketMgr::flush_rx_burst(SocketRxQueue* q, AdvNetBurstParams* burst) {
+  // The consumer may release the burst as soon as it is pushed, so read it first
+  const auto nbytes = burst->hdr.hdr.nbytes;
+  const auto num_pkts = burst->hdr.hdr.num_pkts;
+  if (!q->ring->push(burst)) {
+    q->stats->dropped += num_pkts;
+    free_all_pkts(burst);
+    free_rx_burst(burst);
+    free_rx_meta(burst);
+  } else {
+    q->stats->bytes += nbytes;
+    q->stats->add_burst(num_pkts);
+  }
+}
+
+void SocketMgr::steer_worker(SocketSteerGroup* g) {
+  pin_thread(g->cpu_core);
+  HOLOSCAN_LOG_INFO("Starting RX steering worker on core {}, port {}", g->cpu_core, g->port);
+
+  // The target queue, and therefore its memory regions, is only known after classification, so
+  // frames land in a staging area first and are copied into the queue's buffers
+  std::vector<uint8_t> staging(DEFAULT_NUM_RX_BURST * g->max_frame);
+  std::array<struct mmsghdr, DEFAULT_NUM_RX_BURST> msgs;
+  std::array<struct iovec, DEFAULT_NUM_RX_BURST> iovs;
+  for (int i = 0; i < DEFAULT_NUM_RX_BURST; i++) {
+    iovs[i].iov_base = &staging[i * g->max_frame];
+    iovs[i].iov_len = g->max_frame;
+  }
+
+  std::vector<AdvNetBurstParams*> bursts(g->queues.size(), nullptr);
+
+  while (!force_quit_.load()) {
+    for (int i = 0; i < DEFAULT_NUM_RX_BURST; i++) {
+      memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const int nb_rx = recvmmsg(g->fd, msgs.data(), DEFAULT_NUM_RX_BURST, MSG_WAITFORONE, nullptr);
+
+    for (int i = 0; i < nb_rx; i++) {
+      const auto* frame = static_cast<const uint8_t*>(iovs[i].iov_base);
+      const uint32_t len = std::min<size_t>(msgs[i].msg_len, g->max_frame);
+      const auto* res = g->classifier.classify(frame, len);
+
+      SocketRxQueue* q = g->default_q;
+      uint16_t flow_id = 0;
+      if (res != nullptr) {
+        q = g->queues[res->queue];
+        flow_id = res->flow_id;
+      } else if (g->isolate) {
+        g->unmatched++;
+        continue;
+      }
+
+      auto& burst = bursts[q->queue];
+      if (burst == nullptr) {
+        burst = alloc_rx_burst(q);
+        if (burst == nullptr) {
+          q->stats->dropped++;
+          continue;
+        }
+      }
+
+      auto bufs = get_burst_bufs(burst);
+      const size_t cur = burst->hdr.hdr.num_pkts;
+      if (cur == 0) { burst->hdr.hdr.rx_timestamp_ns = adv_net_stats_now_ns(); }
+      bool have_bufs = true;
+      for (int seg = 0; seg < q->num_segs; seg++) {
+        if (!q->pools[seg]->get_bulk(&bufs->pkts[seg][cur], 1)) {
+          for (int s = 0; s < seg; s++) { q->pools[s]->put_bulk(&bufs->pkts[s][cur], 1); }
+          have_bufs = false;
+          break;
+        }
+      }
+
+      if (!have_bufs) {
+        q->stats->no_buf++;
+        q->stats->dropped++;
+        continue;
+      }
+
+      uint32_t remaining = len;
+      const uint8_t* src = frame;
+      for (int seg = 0; seg < q->num_segs; seg++) {
+        const auto seg_len = static_cast<uint32_t>(
+            std::min<size_t>(remaining, cfg_.mrs_.at(q->pools[seg]->name_).buf_size_));
+        memcpy(bufs->pkts[seg][cur], src, seg_len);
+        bufs->lens[seg][cur] = seg_len;
+        src += seg_len;
+        remaining -= seg_len;
+      }
+      if (remaining > 0 || (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)) { q->stats->dropped++; }
+
+      bufs->info[cur].flow_id = flow_id;
+      burst->hdr.hdr.nbytes += len - remaining;
+      burst->hdr.hdr.num_pkts++;
+      q->stats->pkts++;
+
+      if (burst->hdr.hdr.num_pkts == q->batch_size) {
+        flush_rx_burst(q, burst);
+        burst = nullptr;
+      }
+    }
+
+    // Flush partial batches of every queue once the line goes idle
+    if (nb_rx <= 0) {
+      for (size_t qid = 0; qid < bursts.size(); qid++) {
+        if (bursts[qid] != nullptr && bursts[qid]->hdr.hdr.num_pkts > 0) {
+          flush_rx_burst(g->queues[qid], bursts[qid]);
+          bursts[qid] = nullptr;
+        }
+      }
+    }
+  }
+
+  for (auto burst : bursts) {
+    if (burst == nullptr) { continue; }
+    free_all_pkts(burst);
+    free_rx_burst(burst);
+    free_rx_meta(burst);
+  }
+
+  HOLOSCAN_LOG_INFO("Steering worker on port {} stopped, {} frames matched no flow rule",
+                    g->port,
+                    g->unmatched.load());
+}
+
+void SocketMgr::replay_worker(SocketRxQueue* q) {
+  pin_thread(q->cpu_core);
+  HOLOSCAN_LOG_INFO("Starting replay worker on core {}, port {}, queue {}",
+                    q->cpu_core,
+                    q->port,
+                    q->queue);
+
+  std::array<size_t, MAX_NUM_SEGS> seg_sizes;
+  for (int seg = 0; seg < q->num_segs; seg++) {
+    seg_sizes[seg] = cfg_.mrs_.at(q->pools[seg]->name_).buf_size_;
+  }
+
+  AdvNetCapturePkt pkt;
+  bool have_pkt = false;
+  bool done = false;
+  // Whether the current pass over the capture had a packet for this queue
+  bool pass_matched = false;
+  bool have_base = false;
+  uint64_t base_ts = 0;
+  auto base_time = std::chrono::steady_clock::now();
+
+  while (!force_quit_.load()) {
+    if (done) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(RX_POLL_TIMEOUT_MS));
+      continue;
+    }
+
+    auto burst = alloc_rx_burst(q);
+    if (burst == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    auto bufs = get_burst_bufs(burst);
+    uint32_t burst_seq = 0;
+
+    while (burst->hdr.hdr.num_pkts < q->batch_size && !force_quit_.load()) {
+      if (!have_pkt) {
+        if (!q->replay->next(pkt)) {
+          if (!q->replay_loop) {
+            HOLOSCAN_LOG_INFO("Replay finished on port {} queue {}", q->port, q->queue);
+            done = true;
+            break;
+          }
+          if (!pass_matched) {
+            // Looping would rescan the file forever without delivering anything
+            HOLOSCAN_LOG_WARN("Capture has no packets for port {} queue {}, stopping replay",
+                              q->port,
+                              q->queue);
+            done = true;
+            break;
+          }
+          q->replay->rewind();
+          pass_matched = false;
+          have_base = false;
+          continue;
+        }
+
+        if (pkt.has_ano_meta && (pkt.port != q->port || pkt.queue != q->queue)) { continue; }
+        have_pkt = true;
+        pass_matched = true;
+      }
+
+      // Keep the burst boundaries of captures recorded by the RX operator
+      const size_t cur = burst->hdr.hdr.num_pkts;
+      if (cur > 0 && pkt.has_ano_meta && pkt.burst_seq != burst_seq) { break; }
+
+      if (cur == 0 && q->replay_speed > 0) {
+        if (!have_base) {
+          base_ts = pkt.ts_ns;
+          base_time = std::chrono::steady_clock::now();
+          have_base = true;
+        }
+
+        const auto offset = std::chrono::nanoseconds(
+            static_cast<int64_t>((pkt.ts_ns - std::min(pkt.ts_ns, base_ts)) / q->replay_speed));
+        while (std::chrono::steady_clock::now() < base_time + offset && !force_quit_.load()) {
+          std::this_thread::yield();
+        }
+      }
+
+      bool have_bufs = true;
+      for (int seg = 0; seg < q->num_segs; seg++) {
+        if (!q->pools[seg]->get_bulk(&bufs->pkts[seg][cur], 1)) {
+          for (int s = 0; s < seg; s++) { q->pools[s]->put_bulk(&bufs->pkts[s][cur], 1); }
+          have_bufs = false;
+          break;
+        }
+      }
+
+      if (!have_bufs) {
+        q->stats->no_buf++;
+        if (cur > 0) { break; }
+        std::this_thread::yield();
+        continue;
+      }
+
+      // Scatter the frame over the segments the same way the kernel does for live traffic
+      uint32_t remaining = pkt.len;
+      const uint8_t* src = pkt.data;
+      for (int seg = 0; seg < q->num_segs; seg++) {
+        const auto seg_len = static_cast<uint32_t>(std::min<size_t>(remaining, seg_sizes[seg]));
+        memcpy(bufs->pkts[seg][cur], src, seg_len);
+        bufs->lens[seg][cur] = seg_len;
+        src += seg_len;
+        remaining -= seg_len;
+      }
+      if (remaining > 0) { q->stats->dropped++; }
+
+      if (cur == 0) { burst->hdr.hdr.rx_timestamp_ns = adv_net_stats_now_ns(); }
+      bufs->info[cur].flow_id = pkt.flow_id;
+      burst->hdr.hdr.nbytes += pkt.len - remaining;
+      burst->hdr.hdr.num_pkts++;
+      burst_seq = pkt.burst_seq;
+      q->stats->pkts++;
+      have_pkt = false;
+    }
+
+    if (burst->hdr.hdr.num_pkts > 0) {
+      flush_rx_burst(q, burst);
+    } else {
+      free_rx_burst(burst);
+      free_rx_meta(burst);
+    }
+  }
+
+  HOLOSCAN_LOG_INFO("Total packets replayed (port/queue {}/{}): {}",
+                    q->port,
+                    q->queue,
+                    q->stats->pkts.load());
+}
+
+void SocketMgr::tx_worker(SocketTxQueue* q) {
+  pin_thread(q->cpu_core);
+  HOLOSCAN_LOG_INFO("Starting TX worker on core {}, port {}, queue {}",
+                    q->cpu_core,
+                    q->port,
+                    q->queue);
+
+  std::array<struct mmsghdr, DEFAULT_NUM_TX_BURST> msgs;
+  std::array<std::array<struct iovec, MAX_NUM_SEGS>, DEFAULT_NUM_TX_BURST> iovs;
+
+  while (!force_quit_.load()) {
+    AdvNetBurstParams* msg;
+    if (!q->ring->pop(msg)) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    size_t pkts_tx = 0;
+    const size_t num_pkts = msg->hdr.hdr.num_pkts;
+    while (pkts_tx < num_pkts && !force_quit_.load()) {
+      const auto to_send = static_cast<unsigned int>(
+          std::min(static_cast<size_t>(DEFAULT_NUM_TX_BURST), num_pkts - pkts_tx));
+
+      for (unsigned int i = 0; i < to_send; i++) {
+        for (int seg = 0; seg < msg->hdr.hdr.num_segs; seg++) {
+          iovs[i][seg].iov_base = msg->pkts[seg][pkts_tx + i];
+          iovs[i][seg].iov_len = msg->pkt_lens[seg][pkts_tx + i];
+        }
+        memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+        msgs[i].msg_hdr.msg_iov = iovs[i].data();
+        msgs[i].msg_hdr.msg_iovlen = msg->hdr.hdr.num_segs;
+      }
+
+      const int tx = sendmmsg(q->fd, msgs.data(), to_send, 0);
+      if (tx < 0) {
+        if (errno == EAGAIN || errno == ENOBUFS || errno == EINTR) { continue; }
+        HOLOSCAN_LOG_ERROR("sendmmsg failed on port {} queue {}: {}",
+                           q->port,
+                           q->queue,
+                           strerror(errno));
+        q->stats->dropped += num_pkts - pkts_tx;
+        break;
+      }
+
+      for (int i = 0; i < tx; i++) { q->stats->bytes += msgs[i].msg_len; }
+      pkts_tx += tx;
+    }
+
+    q->stats->pkts += pkts_tx;
+    q->stats->add_burst(pkts_tx);
+
+    free_all_pkts(msg);
+    free_tx_burst(msg);
+    free_tx_meta(msg);
+  }
+
+  HOLOSCAN_LOG_INFO("Total packets transmitted by application (port/queue {}/{}): {}",
+                    q->port,
+                    q->queue,
+                    q->stats->pkts.load());
+}
+
+SocketPktPool* SocketMgr::find_pool(const void* ptr) const {
+  for (const auto& pool : pools_) {
+    if (pool->owns(ptr)) { return pool.get(); }
+  }
+
+  return nullptr;
+}
+
+void SocketMgr::free_pkts(void* const* ptrs, size_t n) {
+  if (n == 0) { return; }
+
+  // All packets in one segment of a burst come from the same pool
+  auto pool = find_pool(ptrs[0]);
+  if (pool == nullptr) {
+    HOLOSCAN_LOG_ERROR("Attempted to free packet {} not owned by the socket manager", ptrs[0]);
+    return;
+  }
+
+  pool->put_bulk(ptrs, n);
+}
+
+SocketBurstBufs* SocketMgr::get_burst_bufs(AdvNetBurstParams* burst) {
+  return static_cast<SocketBurstBufs*>(burst->hdr.extra_burst_data);
+}
+
+/* ANO interface implementations */
+void* SocketMgr::get_seg_pkt_ptr(AdvNetBurstParams* burst, int seg, int idx) {
+  return burst->pkts[seg][idx];
+}
+
+void* SocketMgr::get_pkt_ptr(AdvNetBurstParams* burst, int idx) {
+  return burst->pkts[0][idx];
+}
+
+uint16_t SocketMgr::get_seg_pkt_len(AdvNetBurstParams* burst, int seg, int idx) {
+  return burst->pkt_lens[seg][idx];
+}
+
+uint16_t SocketMgr::get_pkt_len(AdvNetBurstParams* burst, int idx) {
+  uint32_t len = 0;
+  for (int seg = 0; seg < burst->hdr.hdr.num_segs; seg++) { len += burst->pkt_lens[seg][idx]; }
+  return len;
+}
+
+uint16_t SocketMgr::get_pkt_flow_id(AdvNetBurstParams* burst, int idx) {
+  return reinterpret_cast<SocketPktInfo*>(burst->pkt_extra_info)[idx].flow_id;
+}
+
+void* SocketMgr::get_pkt_extra_info(AdvNetBurstParams* burst, int idx) {
+  return nullptr;
+}
+
+AdvNetStatus SocketMgr::get_tx_pkt_burst(AdvNetBurstParams* burst) {
+  const uint32_t key = (burst->hdr.hdr.port_id << 16) | burst->hdr.hdr.q_id;
+  const auto q = tx_qs_.find(key);
+  if (q == tx_qs_.end()) {
+    HOLOSCAN_LOG_ERROR("Failed to look up TX queue for port {} queue {}",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  if (burst->hdr.hdr.num_segs > q->second->num_segs ||
+      burst->hdr.hdr.num_pkts > burst_bufs_storage_[0]->info.size()) {
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  SocketBurstBufs* bufs;
+  if (!burst_bufs_pool_->pop(bufs)) { return AdvNetStatus::NO_FREE_BURST_BUFFERS; }
+
+  for (int seg = 0; seg < burst->hdr.hdr.num_segs; seg++) {
+    if (!q->second->pools[seg]->get_bulk(bufs->pkts[seg].data(), burst->hdr.hdr.num_pkts)) {
+      for (int s = 0; s < seg; s++) {
+        q->second->pools[s]->put_bulk(bufs->pkts[s].data(), burst->hdr.hdr.num_pkts);
+      }
+      burst_bufs_pool_->push(bufs);
+      return AdvNetStatus::NO_FREE_PACKET_BUFFERS;
+    }
+
+    burst->pkts[seg] = bufs->pkts[seg].data();
+    burst->pkt_lens[seg] = bufs->lens[seg].data();
+  }
+
+  burst->pkt_extra_info = reinterpret_cast<void**>(bufs->info.data());
+  burst->hdr.extra_burst_data = bufs;
+  return AdvNetStatus::SUCCESS;
+}
+
+AdvNetStatus SocketMgr::set_eth_hdr(AdvNetBurstParams* burst, int idx, char* dst_addr) {
+  auto pkt = static_cast<UDPIPV4Pkt*>(burst->pkts[0][idx]);
+  memcpy(pkt->eth.h_dest, dst_addr, sizeof(pkt->eth.h_dest));
+  memcpy(pkt->eth.h_source, mac_addrs_[burst->hdr.hdr.port_id].data(), sizeof(pkt->eth.h_source));
+  pkt->eth.h_proto = htons(ETH_P_IP);
+  return AdvNetStatus::SUCCESS;
+}
+
+AdvNetStatus SocketMgr::set_ipv4_hdr(AdvNetBurstParams* burst, int idx, int ip_len, uint8_t proto,
+                                     unsigned int src_host, unsigned int dst_host) {
+  auto pkt = static_cast<UDPIPV4Pkt*>(burst->pkts[0][idx]);
+  pkt->ip.protocol = proto;
+  pkt->ip.ihl = 5;
+  pkt->ip.tot_len = htons(sizeof(pkt->ip) + ip_len);
+  pkt->ip.version = 4;
+  pkt->ip.tos = 0;
+  pkt->ip.id = 0;
+  pkt->ip.frag_off = 0;
+  pkt->ip.ttl = 64;
+  pkt->ip.saddr = htonl(src_host);
+  pkt->ip.daddr = htonl(dst_host);
+
+  // There's no checksum offload on this path, so the header checksum is computed here
+  pkt->ip.check = 0;
+  pkt->ip.check = ipv4_hdr_cksum(reinterpret_cast<const uint8_t*>(pkt) + sizeof(pkt->eth),
+                                 pkt->ip.ihl * 4);
+  return AdvNetStatus::SUCCESS;
+}
+
+AdvNetStatus SocketMgr::set_udp_hdr(AdvNetBurstParams* burst, int idx, int udp_len,
+                                    uint16_t src_port, uint16_t dst_port) {
+  auto pkt = static_cast<UDPIPV4Pkt*>(burst->pkts[0][idx]);
+  pkt->udp.check = 0;  // Optional for UDP over IPv4
+  pkt->udp.source = htons(src_port);
+  pkt->udp.dest = htons(dst_port);
+  pkt->udp.len = htons(udp_len + sizeof(pkt->udp));
+  return AdvNetStatus::SUCCESS;
+}
+
+AdvNetStatus SocketMgr::set_udp_payload(AdvNetBurstParams* burst, int idx, void* data, int len) {
+  auto pkt = static_cast<UDPIPV4Pkt*>(burst->pkts[0][idx]);
+  memcpy(reinterpret_cast<uint8_t*>(pkt) + sizeof(*pkt), data, len);
+  return AdvNetStatus::SUCCESS;
+}
+
+AdvNetStatus SocketMgr::set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens,
+                                     uint16_t payload_len) {
+  auto tmpl = find_tx_template(burst);
+  if (tmpl == nullptr) { return AdvNetStatus::INVALID_PARAMETER; }
+  if (burst->hdr.hdr.num_segs > 2) { return AdvNetStatus::NOT_SUPPORTED; }
+
+  // Packet pointers are the buffers themselves, so the template goes straight into them
+  const int num = burst->hdr.hdr.num_pkts;
+  stamp_udp_hdrs(*tmpl, burst->pkts[0], payload_lens, payload_len, num);
+
+  for (int i = 0; i < num; i++) {
+    uint32_t seg0, seg1;
+    tx_seg_lens(*tmpl, payload_lens != nullptr ? payload_lens[i] : payload_len, seg0, seg1);
+    if (burst->hdr.hdr.num_segs == 1) {
+      burst->pkt_lens[0][i] = seg0 + seg1;
+    } else {
+      burst->pkt_lens[0][i] = seg0;
+      burst->pkt_lens[1][i] = seg1;
+    }
+  }
+
+  return AdvNetStatus::SUCCESS;
+}
+
+bool SocketMgr::tx_burst_available(AdvNetBurstParams* burst) {
+  const uint32_t key = (burst->hdr.hdr.port_id << 16) | burst->hdr.hdr.q_id;
+  const auto q = tx_qs_.find(key);
+  if (q == tx_qs_.end()) { return false; }
+
+  for (int seg = 0; seg < burst->hdr.hdr.num_segs; seg++) {
+    if (q->second->pools[seg]->avail() < burst->hdr.hdr.num_pkts * 2) { return false; }
+  }
+
+  return true;
+}
+
+AdvNetStatus SocketMgr::set_pkt_lens(AdvNetBurstParams* burst, int idx,
+                                     const std::initializer_list<int>& lens) {
+  if (lens.size() != static_cast<size_t>(burst->hdr.hdr.num_segs)) {
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  for (int seg = 0; seg < burst->hdr.hdr.num_segs; seg++) {
+    burst->pkt_lens[seg][idx] = *(lens.begin() + seg);
+  }
+
+  return AdvNetStatus::SUCCESS;
+}
+
+void SocketMgr::free_pkt_seg(AdvNetBurstParams* burst, int seg, int pkt) {
+  free_pkts(&burst->pkts[seg][pkt], 1);
+}
+
+void SocketMgr::free_all_seg_pkts(AdvNetBurstParams* burst, int seg) {
+  free_pkts(burst->pkts[seg], burst->hdr.hdr.num_pkts);
+}
+
+void SocketMgr::free_pkt(AdvNetBurstParams* burst, int pkt) {
+  for (int seg = 0; seg < burst->hdr.hdr.num_segs; seg++) { free_pkt_seg(burst, seg, pkt); }
+}
+
+void SocketMgr::free_all_pkts(AdvNetBurstParams* burst) {
+  for (int seg = 0; seg < burst->hdr.hdr.num_segs; seg++) { free_all_seg_pkts(burst, seg); }
+}
+
+void SocketMgr::free_rx_burst(AdvNetBurstParams* burst) {
+  auto bufs = get_burst_bufs(burst);
+  if (bufs != nullptr) { burst_bufs_pool_->push(bufs); }
+}
+
+void SocketMgr::free_tx_burst(AdvNetBurstParams* burst) {
+  auto bufs = get_burst_bufs(burst);
+  if (bufs != nullptr) { burst_bufs_pool_->push(bufs); }
+}
+
+std::optional<uint16_t> SocketMgr::get_port_from_ifname(const std::string& name) {
+  const int port = address_to_port(name);
+  if (port < 0) { return {}; }
+
+  return port;
+}
+
+AdvNetStatus SocketMgr::get_rx_burst(AdvNetBurstParams** burst) {
+  for (size_t i = 0; i < rx_qs_.size(); i++) {
+    auto& q = rx_qs_[rx_q_next_];
+    rx_q_next_ = (rx_q_next_ + 1) % rx_qs_.size();
+    if (q->ring->pop(*burst)) {
+      record_rx_latency(q->stats, *burst);
+      return AdvNetStatus::SUCCESS;
+    }
+  }
+
+  return AdvNetStatus::NOT_READY;
+}
+
+AdvNetStatus SocketMgr::get_rx_burst(AdvNetBurstParams** burst, int port, int q) {
+  const auto rxq = rx_q_map_.find((port << 16) | q);
+  if (rxq == rx_q_map_.end()) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_rx_burst: {}/{}", port, q);
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  if (!rxq->second->ring->pop(*burst)) { return AdvNetStatus::NOT_READY; }
+
+  record_rx_latency(rxq->second->stats, *burst);
+  return AdvNetStatus::SUCCESS;
+}
+
+AdvNetStatus SocketMgr::set_pkt_tx_time(AdvNetBurstParams* burst, int idx, uint64_t timestamp) {
+  return AdvNetStatus::NOT_SUPPORTED;
+}
+
+void SocketMgr::free_rx_meta(AdvNetBurstParams* burst) {
+  rx_meta_->push(burst);
+}
+
+void SocketMgr::free_tx_meta(AdvNetBurstParams* burst) {
+  tx_meta_->push(burst);
+}
+
+AdvNetStatus SocketMgr::get_tx_meta_buf(AdvNetBurstParams** burst) {
+  if (!tx_meta_->pop(*burst)) {
+    HOLOSCAN_LOG_CRITICAL("Failed to get TX meta descriptor");
+    return AdvNetStatus::NO_FREE_BURST_BUFFERS;
+  }
+
+  return AdvNetStatus::SUCCESS;
+}
+
+AdvNetStatus SocketMgr::send_tx_burst(AdvNetBurstParams* burst) {
+  const uint32_t key = (burst->hdr.hdr.port_id << 16) | burst->hdr.hdr.q_id;
+  const auto q = tx_qs_.find(key);
+
+  if (q == tx_qs_.end()) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in send_tx_burst: {}/{}",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  if (!q->second->ring->push(burst)) {
+    free_all_pkts(burst);
+    free_tx_burst(burst);
+    free_tx_meta(burst);
+    HOLOSCAN_LOG_CRITICAL("Failed to enqueue TX work");
+    return AdvNetStatus::NO_SPACE_AVAILABLE;
+  }
+
+  return AdvNetStatus::SUCCESS;
+}
+
+int SocketMgr::address_to_port(const std::string& addr) {
+  for (const auto& intf : cfg_.ifs_) {
+    if (intf.address_ == addr) { return intf.port_id_; }
+  }
+
+  return -1;
+}
+
+AdvNetStatus SocketMgr::get_mac(int port, char* mac) {
+  if (port < 0 || port >= static_cast<int>(mac_addrs_.size())) {
+    HOLOSCAN_LOG_CRITICAL("Port {} out of range in get_mac() lookup", port);
+    return AdvNetStatus::INVALID_PARAMETER;
+  }
+
+  memcpy(mac, mac_addrs_[port].data(), mac_addrs_[port].size());
+  return AdvNetStatus::SUCCESS;
+}
+
+void SocketMgr::shutdown() {
+  HOLOSCAN_LOG_INFO("Socket ANO shutdown called {}", num_init);
+  if (--num_init == 0) {
+    HOLOSCAN_LOG_INFO("ANO socket manager shutting down");
+    force_quit_.store(true);
+    for (auto& t : workers_) {
+      if (t.joinable()) { t.join(); }
+    }
+    workers_.clear();
+    print_stats();
+  }
+}
+
+void SocketMgr::print_stats() {
+  for (const auto& q : rx_qs_) {
+    HOLOSCAN_LOG_INFO("RX port {} queue {}:", q->port, q->queue);
+    HOLOSCAN_LOG_INFO(" - Received packets:    {}", q->stats->pkts.load());
+    HOLOSCAN_LOG_INFO(" - Received bytes:      {}", q->stats->bytes.load());
+    HOLOSCAN_LOG_INFO(" - Bursts:              {}", q->stats->bursts.load());
+    HOLOSCAN_LOG_INFO(" - Dropped packets:     {}", q->stats->dropped.load());
+    HOLOSCAN_LOG_INFO(" - Out of buffers:      {}", q->stats->no_buf.load());
+    const auto lat = q->stats->rx_latency.summarize();
+    HOLOSCAN_LOG_INFO(
+        " - Latency p50/p99/max: {}/{}/{} ns", lat.p50_ns, lat.p99_ns, lat.max_ns);
+  }
+
+  for (const auto& g : steer_groups_) {
+    HOLOSCAN_LOG_INFO("RX port {} flow steering:", g->port);
+    HOLOSCAN_LOG_INFO(" - Unmatched packets:   {}", g->unmatched.load());
+  }
+
+  for (const auto& q : tx_qs_) {
+    HOLOSCAN_LOG_INFO("TX port {} queue {}:", q.second->port, q.second->queue);
+    HOLOSCAN_LOG_INFO(" - Transmit packets:    {}", q.second->stats->pkts.load());
+    HOLOSCAN_LOG_INFO(" - Transmit bytes:      {}", q.second->stats->bytes.load());
+    HOLOSCAN_LOG_INFO(" - Bursts:              {}", q.second->stats->bursts.load());
+    HOLOSCAN_LOG_INFO(" - Dropped packets:     {}", q.second->stats->dropped.load());
+  }
+}
+
+void SocketMgr::fill_queue_gauges(AdvNetQueueStats& stats) const {
+  const uint32_t key = (stats.port << 16) | stats.queue;
+  const SocketRing<AdvNetBurstParams*>* ring = nullptr;
+  const SocketPktPool* pool = nullptr;
+
+  if (stats.dir == AdvNetDirection::RX) {
+    const auto q = rx_q_map_.find(key);
+    if (q == rx_q_map_.end()) { return; }
+    ring = q->second->ring.get();
+    pool = q->second->pools[0];
+  } else {
+    const auto q = tx_qs_.find(key);
+    if (q == tx_qs_.end()) { return; }
+    ring = q->second->ring.get();
+    pool = q->second->pools[0];
+  }
+
+  stats.ring_depth = ring->size();
+  stats.ring_capacity = ring->capacity();
+  if (pool != nullptr) {
+    stats.pool_avail = pool->avail();
+    stats.pool_size = pool->num_;
+  }
+}
+
+uint64_t SocketMgr::get_burst_tot_byte(AdvNetBurstParams* burst) {
+  return burst->hdr.hdr.nbytes;
+}
+
+AdvNetBurstParams* SocketMgr::create_burst_params() {
+  return new AdvNetBurstParams();
+}
+
+SocketMgr::~SocketMgr() {
+  force_quit_.store(true);
+  for (auto& t : workers_) {
+    if (t.joinable()) { t.join(); }
+  }
+
+  for (auto& q : rx_qs_) {
+    if (q->fd >= 0) { close(q->fd); }
+  }
+  for (auto& q : tx_qs_) {
+    if (q.second->fd >= 0) { close(q.second->fd); }
+  }
+  for (auto& g : steer_groups_) {
+    if (g->fd >= 0) { close(g->fd); }
+  }
+
+  // The workers are gone, so no packet buffer is in use anymore
+  for (const auto& region : owned_regions_) {
+    switch (region.alloc) {
+      case RegionAlloc::ALIGNED:
+        free(region.ptr);
+        break;
+      case RegionAlloc::PINNED:
+        cudaFreeHost(region.ptr);
+        break;
+      case RegionAlloc::MAPPED:
+        munmap(region.ptr, region.len);
+        break;
+    }
+  }
+  owned_regions_.clear();
+  ar_.clear();
+}
+
+};  // namespace holoscan::ops
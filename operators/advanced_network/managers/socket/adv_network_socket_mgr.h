@@ -0,0 +1,351 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "adv_network_mgr.h"
+#include "adv_network_common.h"
+#include "adv_network_flow.h"
+#include "adv_network_pcap.h"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Bounded multi-producer/multi-consumer ring of trivially copyable objects
+ *
+ * Used both as the free list for every pool in the socket manager and as the hand-off ring
+ * between the socket worker threads and the operators. Each slot carries a sequence number so
+ * producers and consumers only contend on a single atomic index each.
+ */
+template <typename T>
+class SocketRing {
+ public:
+  explicit SocketRing(size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) { cap <<= 1; }
+    mask_ = cap - 1;
+    slots_ = std::make_unique<Slot[]>(cap);
+    for (size_t i = 0; i < cap; i++) { slots_[i].seq.store(i, std::memory_order_relaxed); }
+  }
+
+  bool push(T val) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      const size_t seq = slot.seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.val = val;
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool pop(T& val) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      const size_t seq = slot.seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          val = slot.val;
+          slot.seq.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief Approximate number of queued elements. Only exact when the ring is quiescent.
+   */
+  size_t size() const {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    return head >= tail ? head - tail : 0;
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    T val;
+  };
+
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+/**
+ * @brief Fixed-size packet buffer pool carved out of a single memory region
+ */
+struct SocketPktPool {
+  SocketPktPool(std::string name, char* base, size_t stride, size_t num)
+      : name_(std::move(name)), base_(base), stride_(stride), num_(num), free_(num) {
+    for (size_t i = 0; i < num; i++) { free_.push(base + i * stride); }
+  }
+
+  bool owns(const void* ptr) const {
+    const char* p = static_cast<const char*>(ptr);
+    return p >= base_ && p < base_ + stride_ * num_;
+  }
+
+  bool get_bulk(void** ptrs, size_t n);
+  void put_bulk(void* const* ptrs, size_t n);
+  size_t avail() const { return free_.size(); }
+
+  std::string name_;
+  char* base_;
+  size_t stride_;
+  size_t num_;
+  SocketRing<void*> free_;
+};
+
+/**
+ * @brief Per-packet metadata returned through get_pkt_flow_id()
+ */
+struct SocketPktInfo {
+  uint16_t flow_id;
+};
+
+/**
+ * @brief Backing storage for the packet pointer and length arrays of one burst
+ *
+ * A pointer to this object travels with the burst in hdr.extra_burst_data so that the storage can
+ * be returned to its pool from any copy of the AdvNetBurstParams structure.
+ */
+struct SocketBurstBufs {
+  explicit SocketBurstBufs(size_t max_pkts) {
+    for (int seg = 0; seg < MAX_NUM_SEGS; seg++) {
+      pkts[seg].resize(max_pkts);
+      lens[seg].resize(max_pkts);
+    }
+    info.resize(max_pkts);
+  }
+
+  std::array<std::vector<void*>, MAX_NUM_SEGS> pkts;
+  std::array<std::vector<uint32_t>, MAX_NUM_SEGS> lens;
+  std::vector<SocketPktInfo> info;
+};
+
+/**
+ * @brief Socket manager specific RX queue settings
+ *
+ * A queue with a replay file reads packets from a pcap/pcapng capture instead of a socket. Captures
+ * recorded by AdvNetworkOpRx keep their burst boundaries and flow IDs, and only packets recorded
+ * from the queue with the same ID are replayed. replay_speed_ scales the original inter-burst
+ * timing; 0 replays as fast as possible.
+ */
+struct SocketRxQueueConfig : public AnoMgrExtraQueueConfig {
+  std::string replay_file_;
+  double replay_speed_ = 1.0;
+  bool replay_loop_ = false;
+};
+
+struct SocketRxQueue {
+  uint16_t port;
+  uint16_t queue;
+  int fd = -1;
+  int num_segs;
+  int cpu_core;
+  uint32_t batch_size;
+  std::array<SocketPktPool*, MAX_NUM_SEGS> pools{};
+  std::unique_ptr<SocketRing<AdvNetBurstParams*>> ring;
+  std::unique_ptr<AdvNetCaptureReader> replay;
+  double replay_speed = 1.0;
+  bool replay_loop = false;
+  bool steered = false;
+  AdvNetQueueCounters* stats = nullptr;
+};
+
+/**
+ * @brief RX queues of one interface that are fed by software flow steering
+ *
+ * A single socket receives every frame on the interface. Each frame is classified against the
+ * interface's flow rules and copied into the current burst of the queue the rule points to, with
+ * the rule's ID as the packet's flow ID. Frames no rule matches go to default_q, or are dropped
+ * when flow isolation is enabled, the same as with hardware flow rules.
+ */
+struct SocketSteerGroup {
+  uint16_t port;
+  int fd = -1;
+  int cpu_core;
+  bool isolate;
+  size_t max_frame = 0;
+  AdvNetFlowClassifier classifier;
+  std::vector<SocketRxQueue*> queues;  // Indexed by queue ID, nullptr for unused IDs
+  SocketRxQueue* default_q = nullptr;
+  std::atomic<uint64_t> unmatched{0};
+};
+
+struct SocketTxQueue {
+  uint16_t port;
+  uint16_t queue;
+  int fd = -1;
+  int num_segs;
+  int cpu_core;
+  uint32_t batch_size;
+  std::array<SocketPktPool*, MAX_NUM_SEGS> pools{};
+  std::unique_ptr<SocketRing<AdvNetBurstParams*>> ring;
+  AdvNetQueueCounters* stats = nullptr;
+};
+
+/**
+ * @brief ANO backend built on Linux AF_PACKET sockets
+ *
+ * The socket manager mirrors the DPDK manager's threading and burst model (one worker thread per
+ * queue, pooled bursts handed to the operators through a ring per queue) but moves packets with
+ * batched recvmmsg/sendmmsg calls on raw packet sockets instead of a poll-mode driver. Packets are
+ * delivered as full Ethernet frames, so operators written against the DPDK manager see the same
+ * layout. No special NIC is needed, which makes it usable on commodity hosts and CI runners (for
+ * example on the "lo" interface). RX queues can also replay a capture file instead of reading a
+ * socket, and interfaces with flow rules are steered in software. Only host memory kinds are
+ * supported.
+ */
+class SocketMgr : public ANOMgr {
+ public:
+  SocketMgr() = default;
+  ~SocketMgr();
+  bool set_config_and_initialize(const AdvNetConfigYaml& cfg) override;
+  void initialize() override;
+  void run() override;
+
+  static constexpr int DEFAULT_NUM_RX_BURST = 64;
+  static constexpr int DEFAULT_NUM_TX_BURST = 64;
+  static constexpr int NUM_META_BUFS = 4096;
+  static constexpr int NUM_BURST_BUFS = 256;
+  static constexpr int TX_RING_SIZE = 2048;
+  static constexpr int RX_RING_SIZE = 2048;
+  static constexpr int SOCKET_BUF_BYTES = 64 * 1024 * 1024;
+  static constexpr int RX_POLL_TIMEOUT_MS = 100;
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  void* get_seg_pkt_ptr(AdvNetBurstParams* burst, int seg, int idx) override;
+  void* get_pkt_ptr(AdvNetBurstParams* burst, int idx) override;
+  uint16_t get_seg_pkt_len(AdvNetBurstParams* burst, int seg, int idx) override;
+  uint16_t get_pkt_len(AdvNetBurstParams* burst, int idx) override;
+  uint16_t get_pkt_flow_id(AdvNetBurstParams* burst, int idx) override;
+  void* get_pkt_extra_info(AdvNetBurstParams* burst, int idx) override;
+  AdvNetStatus get_tx_pkt_burst(AdvNetBurstParams* burst) override;
+  AdvNetStatus set_eth_hdr(AdvNetBurstParams* burst, int idx, char* dst_addr) override;
+  AdvNetStatus set_ipv4_hdr(AdvNetBurstParams* burst, int idx, int ip_len, uint8_t proto,
+                            unsigned int src_host, unsigned int dst_host) override;
+  AdvNetStatus set_udp_hdr(AdvNetBurstParams* burst, int idx, int udp_len, uint16_t src_port,
+                           uint16_t dst_port) override;
+  AdvNetStatus set_udp_payload(AdvNetBurstParams* burst, int idx, void* data, int len) override;
+  AdvNetStatus set_udp_hdrs(AdvNetBurstParams* burst, const uint16_t* payload_lens,
+                            uint16_t payload_len) override;
+  bool tx_burst_available(AdvNetBurstParams* burst) override;
+
+  AdvNetStatus set_pkt_lens(AdvNetBurstParams* burst, int idx,
+                            const std::initializer_list<int>& lens) override;
+  void free_all_seg_pkts(AdvNetBurstParams* burst, int seg) override;
+  void free_pkt_seg(AdvNetBurstParams* burst, int seg, int pkt) override;
+  void free_pkt(AdvNetBurstParams* burst, int pkt) override;
+  void free_all_pkts(AdvNetBurstParams* burst) override;
+  void free_rx_burst(AdvNetBurstParams* burst) override;
+  void free_tx_burst(AdvNetBurstParams* burst) override;
+  std::optional<uint16_t> get_port_from_ifname(const std::string& name) override;
+
+  AdvNetStatus get_rx_burst(AdvNetBurstParams** burst) override;
+  AdvNetStatus get_rx_burst(AdvNetBurstParams** burst, int port, int q) override;
+  AdvNetStatus set_pkt_tx_time(AdvNetBurstParams* burst, int idx, uint64_t timestamp) override;
+  void free_rx_meta(AdvNetBurstParams* burst) override;
+  void free_tx_meta(AdvNetBurstParams* burst) override;
+  AdvNetStatus get_tx_meta_buf(AdvNetBurstParams** burst) override;
+  AdvNetStatus send_tx_burst(AdvNetBurstParams* burst) override;
+  int address_to_port(const std::string& addr) override;
+  AdvNetStatus get_mac(int port, char* mac) override;
+  void shutdown() override;
+  void print_stats() override;
+  uint64_t get_burst_tot_byte(AdvNetBurstParams* burst) override;
+  AdvNetBurstParams* create_burst_params() override;
+  bool validate_config() const override;
+
+  static AdvNetStatus parse_rx_queue_socket_config(const YAML::Node& q_item, RxQueueConfig& q);
+
+ protected:
+  AdvNetStatus allocate_memory_regions() override;
+  void adjust_memory_regions() override;
+  void fill_queue_gauges(AdvNetQueueStats& stats) const override;
+
+ private:
+  // How a memory region was allocated, so the destructor frees it the same way
+  enum class RegionAlloc { ALIGNED, PINNED, MAPPED };
+  struct OwnedRegion {
+    void* ptr;
+    size_t len;
+    RegionAlloc alloc;
+  };
+
+  void rx_worker(SocketRxQueue* q);
+  void replay_worker(SocketRxQueue* q);
+  void steer_worker(SocketSteerGroup* g);
+  bool setup_steering(const AdvNetConfigInterface& intf);
+  AdvNetBurstParams* alloc_rx_burst(SocketRxQueue* q);
+  void flush_rx_burst(SocketRxQueue* q, AdvNetBurstParams* burst);
+  void tx_worker(SocketTxQueue* q);
+  int open_rx_socket(const AdvNetConfigInterface& intf, int fanout_group);
+  int open_tx_socket(const AdvNetConfigInterface& intf);
+  SocketPktPool* find_pool(const void* ptr) const;
+  void free_pkts(void* const* ptrs, size_t n);
+  SocketBurstBufs* get_burst_bufs(AdvNetBurstParams* burst);
+  static void pin_thread(int core);
+
+  std::atomic<bool> force_quit_{false};
+  std::array<std::array<uint8_t, 6>, MAX_IFS> mac_addrs_{};
+  std::array<int, MAX_IFS> if_indices_{};
+  std::vector<std::unique_ptr<SocketPktPool>> pools_;
+  std::unordered_map<std::string, SocketPktPool*> mr_pools_;
+  std::vector<OwnedRegion> owned_regions_;
+  std::vector<std::unique_ptr<SocketBurstBufs>> burst_bufs_storage_;
+  std::unique_ptr<SocketRing<SocketBurstBufs*>> burst_bufs_pool_;
+  std::vector<AdvNetBurstParams> meta_storage_;
+  std::unique_ptr<SocketRing<AdvNetBurstParams*>> rx_meta_;
+  std::unique_ptr<SocketRing<AdvNetBurstParams*>> tx_meta_;
+  std::vector<std::unique_ptr<SocketRxQueue>> rx_qs_;
+  std::unordered_map<uint32_t, SocketRxQueue*> rx_q_map_;
+  std::vector<std::unique_ptr<SocketSteerGroup>> steer_groups_;
+  size_t rx_q_next_ = 0;
+  std::unordered_map<uint32_t, std::unique_ptr<SocketTxQueue>> tx_qs_;
+  std::vector<std::thread> workers_;
+  int num_init = 0;
+};
+
+};  // namespace holoscan::ops
@@ -16,15 +16,36 @@
 
 #pragma once
 
+#include <netinet/in.h>
+#include <cstdint>
+
 enum class L4Proto {
   TCP,
   UDP
 };
 
+// How messages are delimited on TCP streams. With LENGTH_PREFIX every message is preceded by its
+// length as a 32-bit big-endian integer, so receivers always see whole messages.
+enum class TcpFraming {
+  NONE,
+  LENGTH_PREFIX
+};
+
+static constexpr uint32_t TCP_LEN_PREFIX_SIZE = 4;
+
 struct NetworkOpBurstParams {
   NetworkOpBurstParams(uint8_t *data, uint32_t len, uint32_t num_pkts) :
     data(data), len(len), num_pkts(num_pkts) {}
   uint8_t *data;
   uint32_t len;
   uint32_t num_pkts;
+
+  // Bursts from BasicNetworkOpRx keep every packet in its own slot: packet i is pkt_lens[i] bytes
+  // at data + i * stride and was sent from src_addrs[i]. A zero stride means the payloads are
+  // concatenated. Pooled bursts return to the receiver's pool when the last reference to them is
+  // dropped, so their data must not be deleted.
+  uint32_t stride = 0;
+  const uint32_t *pkt_lens = nullptr;
+  const sockaddr_in *src_addrs = nullptr;
+  bool pooled = false;
 };
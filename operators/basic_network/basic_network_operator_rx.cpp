@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
 #include <memory>
 #include <string>
 
@@ -21,6 +25,104 @@
 
 namespace holoscan::ops {
 
+BasicNetworkBurstPool::BasicNetworkBurstPool(size_t num_bursts, uint32_t batch_size,
+                                             uint32_t stride) {
+  for (size_t i = 0; i < num_bursts; i++) {
+    auto slot = std::make_unique<Slot>();
+    slot->buf.resize(static_cast<size_t>(batch_size) * stride);
+    slot->lens.resize(batch_size);
+    slot->addrs.resize(batch_size);
+    slot->params.data = slot->buf.data();
+    slot->params.stride = stride;
+    slot->params.pkt_lens = slot->lens.data();
+    slot->params.src_addrs = slot->addrs.data();
+    slot->params.pooled = true;
+    free_.push_back(slot.get());
+    slots_.emplace_back(std::move(slot));
+  }
+}
+
+BasicNetworkBurstPool::~BasicNetworkBurstPool() {
+  for (auto block : free_blocks_) { ::operator delete(block); }
+}
+
+BasicNetworkBurstPool::Slot* BasicNetworkBurstPool::get() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_.empty()) { return nullptr; }
+  auto slot = free_.back();
+  free_.pop_back();
+  return slot;
+}
+
+void BasicNetworkBurstPool::put(Slot* slot) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_.push_back(slot);
+}
+
+void* BasicNetworkBurstPool::get_block(size_t bytes) {
+  if (bytes > BLOCK_SIZE) { return ::operator new(bytes); }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_blocks_.empty()) { return ::operator new(BLOCK_SIZE); }
+  auto block = free_blocks_.back();
+  free_blocks_.pop_back();
+  return block;
+}
+
+void BasicNetworkBurstPool::put_block(void* block, size_t bytes) {
+  if (bytes > BLOCK_SIZE) {
+    ::operator delete(block);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_blocks_.push_back(block);
+}
+
+namespace {
+
+/**
+ * @brief Allocator for the control blocks of emitted bursts
+ *
+ * Holds a reference to the pool so the pool outlives the operator while bursts are still in flight.
+ * The control block is released after the burst's deleter has run, so the pool stays valid until
+ * the very last use.
+ */
+template <typename T>
+struct BurstBlockAllocator {
+  using value_type = T;
+
+  explicit BurstBlockAllocator(std::shared_ptr<BasicNetworkBurstPool> pool)
+      : pool(std::move(pool)) {}
+  template <typename U>
+  BurstBlockAllocator(const BurstBlockAllocator<U>& other) : pool(other.pool) {}
+
+  T* allocate(size_t n) { return static_cast<T*>(pool->get_block(n * sizeof(T))); }
+  void deallocate(T* p, size_t n) { pool->put_block(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const BurstBlockAllocator<U>& other) const {
+    return pool == other.pool;
+  }
+  template <typename U>
+  bool operator!=(const BurstBlockAllocator<U>& other) const {
+    return pool != other.pool;
+  }
+
+  std::shared_ptr<BasicNetworkBurstPool> pool;
+};
+
+}  // namespace
+
+std::shared_ptr<NetworkOpBurstParams> BasicNetworkOpRx::make_burst_handle(
+    BasicNetworkBurstPool::Slot* slot) {
+  auto pool = pool_.get();
+  return std::shared_ptr<NetworkOpBurstParams>(
+      &slot->params,
+      [pool, slot](NetworkOpBurstParams*) { pool->put(slot); },
+      BurstBlockAllocator<NetworkOpBurstParams>(pool_));
+}
+
 void BasicNetworkOpRx::setup(OperatorSpec& spec) {
   spec.output<std::shared_ptr<NetworkOpBurstParams>>("burst_out");
 
@@ -31,10 +133,31 @@ void BasicNetworkOpRx::setup(OperatorSpec& spec) {
   spec.param<uint32_t>(batch_size_, "batch_size", "Batch size", "Number of packets in batch");
   spec.param<uint16_t>(
       max_payload_size_, "max_payload_size", "Max payload size", "Largest payload size");
+  spec.param<uint32_t>(num_bursts_,
+                       "num_bursts",
+                       "Number of bursts",
+                       "Bursts in the receive pool. Bounds how many batches can be in flight",
+                       4U);
+  spec.param<std::string>(tcp_framing_p_,
+                          "tcp_framing",
+                          "TCP framing",
+                          "Message framing on TCP streams (none or length_prefix)",
+                          std::string("none"));
 }
 
 BasicNetworkOpRx::~BasicNetworkOpRx() {
-  HOLOSCAN_LOG_INFO("{} packets left in buffer for RX operator", pkts_in_batch_);
+  HOLOSCAN_LOG_INFO("{} packets left in buffer for RX operator",
+                    cur_ != nullptr ? cur_->params.num_pkts : 0);
+  if (pool_empty_cnt_ > 0 || truncated_cnt_ > 0) {
+    HOLOSCAN_LOG_INFO("RX operator waited {} times for a free burst and truncated {} packets",
+                      pool_empty_cnt_,
+                      truncated_cnt_);
+  }
+  if (cur_ != nullptr) { pool_->put(cur_); }
+
+  for (const auto& c : clients_) { close(c.first); }
+  if (epoll_fd_ >= 0) { close(epoll_fd_); }
+  if (sockfd_ >= 0) { close(sockfd_); }
 }
 
 void BasicNetworkOpRx::initialize() {
@@ -61,13 +184,23 @@ void BasicNetworkOpRx::initialize() {
   } else {
     l4_proto_ = L4Proto::TCP;
 
-    if ((sockfd_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) < 0) {
+    if (tcp_framing_p_.get() == "length_prefix") {
+      tcp_framing_ = TcpFraming::LENGTH_PREFIX;
+    } else if (tcp_framing_p_.get() != "none") {
+      HOLOSCAN_LOG_CRITICAL("Invalid TCP framing {}", tcp_framing_p_.get());
+      throw;
+    }
+
+    // The listening socket and every client are non-blocking so compute() never stalls the
+    // scheduler thread waiting for a peer
+    if ((sockfd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, IPPROTO_TCP)) < 0) {
       HOLOSCAN_LOG_CRITICAL("Failed to create TCP socket");
       throw;
     }
 
     int opt = 1;
-    if (setsockopt(sockfd_, SOL_SOCKET, SO_REUSEADDR | SO_REUSEPORT, &opt, sizeof(opt))) {
+    if (setsockopt(sockfd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) ||
+        setsockopt(sockfd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt))) {
       HOLOSCAN_LOG_CRITICAL("Failed to set socket options");
       throw;
     }
@@ -80,66 +213,244 @@ void BasicNetworkOpRx::initialize() {
   }
 
   if (l4_proto_ == L4Proto::TCP) {
-    if (listen(sockfd_, 1) < 0) {
+    if (listen(sockfd_, SOMAXCONN) < 0) {
         HOLOSCAN_LOG_CRITICAL("Error when listening on TCP port");
         throw;
     }
+
+    if ((epoll_fd_ = epoll_create1(0)) < 0) {
+      HOLOSCAN_LOG_CRITICAL("Failed to create epoll instance");
+      throw;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = sockfd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, sockfd_, &ev) < 0) {
+      HOLOSCAN_LOG_CRITICAL("Failed to add TCP listening socket to epoll");
+      throw;
+    }
+
+    events_.resize(MAX_EPOLL_EVENTS);
+    HOLOSCAN_LOG_INFO("Network RX operator listening for TCP connections on {}:{}",
+                      ip_addr_.get(),
+                      port_.get());
   } else {
     HOLOSCAN_LOG_INFO("Network RX operator bound to {}:{}", ip_addr_.get(), port_.get());
   }
+
+  const uint32_t batch = batch_size_.get();
+  pool_ =
+      std::make_shared<BasicNetworkBurstPool>(num_bursts_.get(), batch, max_payload_size_.get());
+  msgs_.resize(batch);
+  iovs_.resize(batch);
 }
 
-void BasicNetworkOpRx::compute([[maybe_unused]] InputContext&, OutputContext& op_output,
-                               [[maybe_unused]] ExecutionContext&) {
-  HOLOSCAN_LOG_DEBUG("BasicNetworkOpRx::compute");
-  sockaddr_in addr;
-  socklen_t from_len;
-  from_len = sizeof(addr);
-
-  if (l4_proto_ == L4Proto::TCP && !connected_) {
-    HOLOSCAN_LOG_INFO("Waiting for incoming TCP connection on {}:{}", ip_addr_.get(), port_.get());
-    if ((tcp_sock_ = accept(sockfd_, (struct sockaddr*)&server_addr_,
-                            (socklen_t*)&server_addr_)) < 0) {
-        HOLOSCAN_LOG_CRITICAL("Failed to accept incoming TCP connection");
-        throw;
+bool BasicNetworkOpRx::receive_udp() {
+  auto& burst = cur_->params;
+  const uint32_t batch = batch_size_.get();
+  const uint32_t stride = burst.stride;
+
+  while (burst.num_pkts < batch) {
+    // Fill as much of the batch as is queued with a single syscall, each datagram in its own slot
+    const uint32_t want = batch - burst.num_pkts;
+    for (uint32_t i = 0; i < want; i++) {
+      const uint32_t idx = burst.num_pkts + i;
+      iovs_[i].iov_base = &cur_->buf[static_cast<size_t>(idx) * stride];
+      iovs_[i].iov_len = stride;
+      memset(&msgs_[i].msg_hdr, 0, sizeof(msgs_[i].msg_hdr));
+      msgs_[i].msg_hdr.msg_name = &cur_->addrs[idx];
+      msgs_[i].msg_hdr.msg_namelen = sizeof(cur_->addrs[idx]);
+      msgs_[i].msg_hdr.msg_iov = &iovs_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
     }
 
-    HOLOSCAN_LOG_INFO("Successfully attached to incoming connection");
-    connected_ = true;
+    const int n = recvmmsg(sockfd_, msgs_.data(), want, MSG_DONTWAIT, nullptr);
+    if (n <= 0) { return false; }
+
+    for (int i = 0; i < n; i++) {
+      if (msgs_[i].msg_hdr.msg_flags & MSG_TRUNC) { truncated_cnt_++; }
+      cur_->lens[burst.num_pkts + i] = msgs_[i].msg_len;
+      burst.len += msgs_[i].msg_len;
+    }
+    burst.num_pkts += n;
   }
 
-  if (byte_cnt_ == 0) { pkt_buf = new uint8_t[max_payload_size_.get() * batch_size_.get()]; }
+  return true;
+}
 
-  while (pkts_in_batch_ < batch_size_.get()) {
-    int n;
+void BasicNetworkOpRx::accept_clients() {
+  for (;;) {
+    TcpClient client;
+    socklen_t addr_len = sizeof(client.addr);
+    client.fd = accept4(
+        sockfd_, reinterpret_cast<struct sockaddr*>(&client.addr), &addr_len, SOCK_NONBLOCK);
+    if (client.fd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        HOLOSCAN_LOG_ERROR("Failed to accept incoming TCP connection: {}", strerror(errno));
+      }
+      return;
+    }
 
-    if (l4_proto_ == L4Proto::UDP) {
-      n = recvfrom(sockfd_,
-                  &pkt_buf[byte_cnt_],
-                  max_payload_size_.get(),
-                  MSG_DONTWAIT,
-                  (sockaddr*)&addr,
-                  &from_len);
-    } else if (l4_proto_ == L4Proto::TCP) {
-      n = recv(tcp_sock_,
-                  &pkt_buf[byte_cnt_],
-                  max_payload_size_.get(),
-                  0);
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN | EPOLLRDHUP;
+    ev.data.fd = client.fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client.fd, &ev) < 0) {
+      HOLOSCAN_LOG_ERROR("Failed to add TCP client to epoll: {}", strerror(errno));
+      close(client.fd);
+      continue;
     }
 
+    // Large enough for several maximum-size messages, so a message never has to wait for
+    // space to be freed by the next burst
+    const size_t max_msg = TCP_LEN_PREFIX_SIZE + max_payload_size_.get();
+    client.buf.resize(std::max(TCP_READ_BUF_SIZE, 2 * max_msg));
+
+    char addr_str[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &client.addr.sin_addr, addr_str, sizeof(addr_str));
+    HOLOSCAN_LOG_INFO("Accepted TCP connection from {}:{} ({} clients connected)",
+                      addr_str,
+                      ntohs(client.addr.sin_port),
+                      clients_.size() + 1);
+    clients_.emplace(client.fd, std::move(client));
+  }
+}
+
+void BasicNetworkOpRx::read_client(TcpClient& client) {
+  if (client.head > 0) {
+    memmove(client.buf.data(), client.buf.data() + client.head, client.tail - client.head);
+    client.tail -= client.head;
+    client.head = 0;
+  }
+
+  // Level-triggered epoll reports the socket again if the buffer fills before it is drained
+  while (client.tail < client.buf.size()) {
+    const ssize_t n =
+        read(client.fd, client.buf.data() + client.tail, client.buf.size() - client.tail);
     if (n > 0) {
-      byte_cnt_ += n;
-      pkts_in_batch_++;
+      client.tail += n;
+    } else if (n == 0) {
+      client.eof = true;
+      return;
     } else {
+      if (errno == EINTR) { continue; }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        HOLOSCAN_LOG_ERROR("Error reading from TCP client: {}", strerror(errno));
+        client.eof = true;
+      }
+      return;
+    }
+  }
+}
+
+bool BasicNetworkOpRx::extract_msgs(TcpClient& client) {
+  auto& burst = cur_->params;
+  const uint32_t batch = batch_size_.get();
+  const uint32_t stride = burst.stride;
+
+  while (burst.num_pkts < batch) {
+    const size_t avail = client.tail - client.head;
+    const uint8_t* p = client.buf.data() + client.head;
+    size_t hdr_len = 0;
+    size_t msg_len;
+
+    if (tcp_framing_ == TcpFraming::LENGTH_PREFIX) {
+      if (avail < TCP_LEN_PREFIX_SIZE) { break; }
+      msg_len = (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+                (static_cast<uint32_t>(p[2]) << 8) | p[3];
+      hdr_len = TCP_LEN_PREFIX_SIZE;
+      if (msg_len > stride) {
+        HOLOSCAN_LOG_ERROR("TCP message of {} bytes exceeds max_payload_size {}; closing client",
+                           msg_len,
+                           stride);
+        return false;
+      }
+      if (avail < hdr_len + msg_len) { break; }
+    } else {
+      if (avail == 0) { break; }
+      msg_len = std::min<size_t>(avail, stride);
+    }
+
+    const uint32_t idx = burst.num_pkts;
+    memcpy(&cur_->buf[static_cast<size_t>(idx) * stride], p + hdr_len, msg_len);
+    cur_->lens[idx] = msg_len;
+    cur_->addrs[idx] = client.addr;
+    burst.len += msg_len;
+    burst.num_pkts++;
+    client.head += hdr_len + msg_len;
+  }
+
+  // Whatever is left of a closed stream can't form another message
+  return !(client.eof && burst.num_pkts < batch);
+}
+
+void BasicNetworkOpRx::close_client(int fd) {
+  const auto it = clients_.find(fd);
+  if (it == clients_.end()) { return; }
+
+  if (it->second.tail > it->second.head) {
+    HOLOSCAN_LOG_WARN("Dropping {} bytes of incomplete message from closed TCP client",
+                      it->second.tail - it->second.head);
+  }
+
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  clients_.erase(it);
+  HOLOSCAN_LOG_INFO("TCP client disconnected ({} clients connected)", clients_.size());
+}
+
+bool BasicNetworkOpRx::receive_tcp() {
+  auto& burst = cur_->params;
+  const uint32_t batch = batch_size_.get();
+  to_close_.clear();
+
+  // Messages read on an earlier call come first, since epoll won't report that data again
+  for (auto& c : clients_) {
+    if (burst.num_pkts == batch) { break; }
+    if (!extract_msgs(c.second)) { to_close_.push_back(c.first); }
+  }
+
+  if (burst.num_pkts < batch) {
+    const int n = epoll_wait(epoll_fd_, events_.data(), events_.size(), 0);
+    for (int i = 0; i < n && burst.num_pkts < batch; i++) {
+      const int fd = events_[i].data.fd;
+      if (fd == sockfd_) {
+        accept_clients();
+        continue;
+      }
+
+      const auto it = clients_.find(fd);
+      if (it == clients_.end()) { continue; }
+      read_client(it->second);
+      if (!extract_msgs(it->second)) { to_close_.push_back(fd); }
+    }
+  }
+
+  for (const int fd : to_close_) { close_client(fd); }
+  return burst.num_pkts == batch;
+}
+
+void BasicNetworkOpRx::compute([[maybe_unused]] InputContext&, OutputContext& op_output,
+                               [[maybe_unused]] ExecutionContext&) {
+  HOLOSCAN_LOG_DEBUG("BasicNetworkOpRx::compute");
+
+  if (cur_ == nullptr) {
+    // All bursts are still held downstream. Leave the packets in the socket buffer until one
+    // comes back instead of allocating more memory.
+    if ((cur_ = pool_->get()) == nullptr) {
+      pool_empty_cnt_++;
       return;
     }
+
+    cur_->params.len = 0;
+    cur_->params.num_pkts = 0;
   }
 
-  auto msg = std::make_shared<NetworkOpBurstParams>(pkt_buf, byte_cnt_, pkts_in_batch_);
-  byte_cnt_ = 0;
-  pkts_in_batch_ = 0;
+  const bool full = l4_proto_ == L4Proto::UDP ? receive_udp() : receive_tcp();
+  if (!full) { return; }
 
-  op_output.emit(msg, "burst_out");
+  op_output.emit(make_burst_handle(cur_), "burst_out");
+  cur_ = nullptr;
   HOLOSCAN_LOG_DEBUG("BasicNetworkOpRx::compute");
 }
 
@@ -19,12 +19,53 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "basic_network_operator_common.h"
 #include "holoscan/holoscan.hpp"
 
 namespace holoscan::ops {
 
+/**
+ * @brief Fixed set of receive bursts shared by BasicNetworkOpRx and the bursts it emits
+ *
+ * Every slot owns a buffer with room for a full batch of max-size packets plus the per-packet
+ * length and address arrays, so nothing is allocated per batch. Emitted bursts hold a reference to
+ * the pool and give their slot back when the last consumer drops them. The shared_ptr control
+ * blocks of the emitted bursts are recycled here as well.
+ */
+class BasicNetworkBurstPool {
+ public:
+  struct Slot {
+    NetworkOpBurstParams params{nullptr, 0, 0};
+    std::vector<uint8_t> buf;
+    std::vector<uint32_t> lens;
+    std::vector<sockaddr_in> addrs;
+  };
+
+  BasicNetworkBurstPool(size_t num_bursts, uint32_t batch_size, uint32_t stride);
+  ~BasicNetworkBurstPool();
+
+  // Returns nullptr when every burst is still held downstream
+  Slot* get();
+  void put(Slot* slot);
+
+  void* get_block(size_t bytes);
+  void put_block(void* block, size_t bytes);
+
+  static constexpr size_t BLOCK_SIZE = 128;
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Slot>> slots_;
+  std::vector<Slot*> free_;
+  std::vector<void*> free_blocks_;
+};
+
 class BasicNetworkOpRx : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(BasicNetworkOpRx);
@@ -41,15 +82,49 @@ class BasicNetworkOpRx : public Operator {
   Parameter<std::string> l4_proto_p_;
   Parameter<uint32_t> batch_size_;
   Parameter<uint16_t> max_payload_size_;
+  Parameter<uint32_t> num_bursts_;
+  Parameter<std::string> tcp_framing_p_;
+
+  static constexpr size_t TCP_READ_BUF_SIZE = 256 * 1024;
+  static constexpr int MAX_EPOLL_EVENTS = 64;
+
+  /**
+   * @brief Connected TCP peer
+   *
+   * Stream data is read into buf in large chunks and split into messages from there. Bytes in
+   * [head, tail) have been read but not yet placed in a burst.
+   */
+  struct TcpClient {
+    int fd;
+    struct sockaddr_in addr;
+    std::vector<uint8_t> buf;
+    size_t head = 0;
+    size_t tail = 0;
+    bool eof = false;
+  };
+
+  std::shared_ptr<NetworkOpBurstParams> make_burst_handle(BasicNetworkBurstPool::Slot* slot);
+  bool receive_udp();
+  bool receive_tcp();
+  void accept_clients();
+  void read_client(TcpClient& client);
+  bool extract_msgs(TcpClient& client);
+  void close_client(int fd);
 
-  int sockfd_;
-  int tcp_sock_;
+  int sockfd_ = -1;
+  int epoll_fd_ = -1;
   L4Proto l4_proto_;
+  TcpFraming tcp_framing_ = TcpFraming::NONE;
   struct sockaddr_in server_addr_;
-  uint32_t byte_cnt_ = 0;
-  uint8_t* pkt_buf = nullptr;
-  uint32_t pkts_in_batch_ = 0;
-  bool connected_ = false;
+  std::shared_ptr<BasicNetworkBurstPool> pool_;
+  BasicNetworkBurstPool::Slot* cur_ = nullptr;
+  std::vector<struct mmsghdr> msgs_;
+  std::vector<struct iovec> iovs_;
+  std::unordered_map<int, TcpClient> clients_;
+  std::vector<struct epoll_event> events_;
+  std::vector<int> to_close_;
+  uint64_t pool_empty_cnt_ = 0;
+  uint64_t truncated_cnt_ = 0;
 };
 
 };  // namespace holoscan::ops
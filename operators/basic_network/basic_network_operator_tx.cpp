@@ -16,6 +16,7 @@
 
 #include <unistd.h>
 #include <algorithm>
+#include <cerrno>
 #include <string>
 #include "basic_network_operator_tx.h"
 
@@ -40,6 +41,11 @@ void BasicNetworkOpTx::setup(OperatorSpec& spec) {
                        "Re-connect() interval",
                        "Interval to retry connecting to server in seconds",
                        1);
+  spec.param<std::string>(tcp_framing_p_,
+                          "tcp_framing",
+                          "TCP framing",
+                          "Message framing on TCP streams (none or length_prefix)",
+                          std::string("none"));
 }
 void BasicNetworkOpTx::initialize() {
   HOLOSCAN_LOG_INFO("BasicNetworkOpTx::initialize()");
@@ -65,6 +71,13 @@ void BasicNetworkOpTx::initialize() {
   } else {
     l4_proto_ = L4Proto::TCP;
 
+    if (tcp_framing_p_.get() == "length_prefix") {
+      tcp_framing_ = TcpFraming::LENGTH_PREFIX;
+    } else if (tcp_framing_p_.get() != "none") {
+      HOLOSCAN_LOG_CRITICAL("Invalid TCP framing {}", tcp_framing_p_.get());
+      throw;
+    }
+
     if ((sockfd_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) < 0) {
       HOLOSCAN_LOG_CRITICAL("Failed to create TCP socket");
       throw;
@@ -75,13 +88,119 @@ void BasicNetworkOpTx::initialize() {
     ts_.tv_sec = 0;
     ts_.tv_nsec = ipg_.get();
   }
+
+  msgs_.resize(TX_BATCH);
+  iovs_.resize(TX_BATCH);
+}
+
+void BasicNetworkOpTx::send_udp(const NetworkOpBurstParams& burst) {
+  // Packets are either the slots of a pooled burst, or max_payload_size chunks of a concatenated
+  // buffer like before
+  const uint32_t max_payload = max_payload_size_.get();
+  const uint32_t num_pkts =
+      burst.pkt_lens != nullptr ? burst.num_pkts : (burst.len + max_payload - 1) / max_payload;
+  // A minimum gap between packets means sending them one at a time
+  const uint32_t per_call = ipg_.get() > 0 ? 1 : TX_BATCH;
+
+  uint32_t next = 0;
+  while (next < num_pkts) {
+    const uint32_t n = std::min(per_call, num_pkts - next);
+    for (uint32_t i = 0; i < n; i++) {
+      const uint32_t idx = next + i;
+      if (burst.pkt_lens != nullptr) {
+        iovs_[i].iov_base = burst.data + static_cast<size_t>(idx) * burst.stride;
+        iovs_[i].iov_len = burst.pkt_lens[idx];
+      } else {
+        iovs_[i].iov_base = burst.data + static_cast<size_t>(idx) * max_payload;
+        iovs_[i].iov_len = std::min(max_payload, burst.len - idx * max_payload);
+      }
+      memset(&msgs_[i].msg_hdr, 0, sizeof(msgs_[i].msg_hdr));
+      msgs_[i].msg_hdr.msg_name = &server_addr_;
+      msgs_[i].msg_hdr.msg_namelen = sizeof(server_addr_);
+      msgs_[i].msg_hdr.msg_iov = &iovs_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const int sent = sendmmsg(sockfd_, msgs_.data(), n, MSG_DONTWAIT);
+    if (sent == -1) {
+      if (errno == EAGAIN || errno == ENOBUFS || errno == EINTR) { continue; }
+      HOLOSCAN_LOG_ERROR("Error while sending UDP packets: {}", errno);
+      return;
+    }
+
+    next += sent;
+    pkts_sent_ += sent;
+    if (ipg_.get() > 0) { nanosleep(&ts_, nullptr); }
+  }
+}
+
+bool BasicNetworkOpTx::send_tcp_msg(const uint8_t* data, uint32_t len) {
+  uint8_t hdr[TCP_LEN_PREFIX_SIZE] = {static_cast<uint8_t>(len >> 24),
+                                      static_cast<uint8_t>(len >> 16),
+                                      static_cast<uint8_t>(len >> 8),
+                                      static_cast<uint8_t>(len)};
+  struct iovec iov[2];
+  int iov_cnt = 0;
+  if (tcp_framing_ == TcpFraming::LENGTH_PREFIX) {
+    iov[iov_cnt++] = {hdr, sizeof(hdr)};
+  }
+  iov[iov_cnt++] = {const_cast<uint8_t*>(data), len};
+
+  // The prefix and payload go out in one call so a message isn't split into two segments
+  struct msghdr mh = {};
+  mh.msg_iov = iov;
+  mh.msg_iovlen = iov_cnt;
+  while (mh.msg_iovlen > 0) {
+    const ssize_t sent = sendmsg(sockfd_, &mh, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent == -1) {
+      if (errno == EAGAIN || errno == EINTR) { continue; }
+      HOLOSCAN_LOG_ERROR("Error while sending TCP packet: {}", errno);
+      return false;
+    }
+
+    // Skip over whatever the kernel took on a partial send
+    size_t left = sent;
+    while (mh.msg_iovlen > 0 && left >= mh.msg_iov->iov_len) {
+      left -= mh.msg_iov->iov_len;
+      mh.msg_iov++;
+      mh.msg_iovlen--;
+    }
+    if (mh.msg_iovlen > 0) {
+      mh.msg_iov->iov_base = static_cast<uint8_t*>(mh.msg_iov->iov_base) + left;
+      mh.msg_iov->iov_len -= left;
+    }
+  }
+
+  return true;
+}
+
+void BasicNetworkOpTx::send_tcp(const NetworkOpBurstParams& burst) {
+  const uint32_t num_pkts = burst.pkt_lens != nullptr ? burst.num_pkts : 1;
+  for (uint32_t p = 0; p < num_pkts; p++) {
+    const uint8_t* data = burst.data + static_cast<size_t>(p) * burst.stride;
+    uint32_t remaining = burst.pkt_lens != nullptr ? burst.pkt_lens[p] : burst.len;
+
+    // Packets of a pooled burst are sent whole. A flat buffer is split into max_payload_size
+    // chunks, each its own message when framing is on.
+    const uint32_t chunk_size =
+        burst.pkt_lens != nullptr ? remaining : static_cast<uint32_t>(max_payload_size_.get());
+    do {
+      const auto pkt_size = std::min(remaining, chunk_size);
+      if (!send_tcp_msg(data, pkt_size)) { return; }
+
+      data += pkt_size;
+      remaining -= pkt_size;
+      if (ipg_.get() > 0) { nanosleep(&ts_, nullptr); }
+    } while (remaining > 0);
+
+    pkts_sent_++;
+  }
 }
 
 void BasicNetworkOpTx::compute(InputContext& op_input, [[maybe_unused]] OutputContext& op_output,
                                [[maybe_unused]] ExecutionContext&) {
   HOLOSCAN_LOG_DEBUG("BasicNetworkOpTx::compute");
   auto msg = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in").value();
-  int sent;
 
   if (!connected_) {
     auto ret = connect(sockfd_, (struct sockaddr*)&server_addr_, sizeof(server_addr_));
@@ -105,41 +224,14 @@ void BasicNetworkOpTx::compute(InputContext& op_input, [[maybe_unused]] OutputCo
   }
 
 
-  while (msg->len > 0) {
-    auto pkt_size = std::min(msg->len, static_cast<uint32_t>(max_payload_size_.get()));
-    if (l4_proto_ == L4Proto::UDP) {
-      sent = sendto(sockfd_,
-                        msg->data + byte_cnt_,
-                        static_cast<size_t>(pkt_size),
-                        MSG_DONTWAIT,
-                        reinterpret_cast<const struct sockaddr*>(&server_addr_),
-                        sizeof(server_addr_));
-
-      if (sent == -1) {
-        HOLOSCAN_LOG_ERROR("Error while sending UDP packet: {}", errno);
-        continue;
-      }
-    } else if (l4_proto_ == L4Proto::TCP) {
-      sent = send(sockfd_,
-                        msg->data + byte_cnt_,
-                        static_cast<size_t>(pkt_size),
-                        MSG_DONTWAIT);
-
-      if (sent == -1) {
-        HOLOSCAN_LOG_ERROR("Error while sending TCP packet: {}", errno);
-        continue;
-      }
-    }
-
-    msg->len -= sent;
-    byte_cnt_ += sent;
-
-    if (ipg_.get() > 0) { nanosleep(&ts_, nullptr); }
+  if (l4_proto_ == L4Proto::UDP) {
+    send_udp(*msg);
+  } else if (l4_proto_ == L4Proto::TCP) {
+    send_tcp(*msg);
   }
 
-  byte_cnt_ = 0;
-
-  delete[] msg->data;
+  // Pooled bursts go back to the receiver's pool once the last reference is dropped
+  if (!msg->pooled) { delete[] msg->data; }
 
   HOLOSCAN_LOG_DEBUG("BasicNetworkOpTx::compute done");
 }
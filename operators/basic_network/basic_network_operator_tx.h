@@ -20,6 +20,7 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <string>
+#include <vector>
 #include "basic_network_operator_common.h"
 #include "holoscan/holoscan.hpp"
 
@@ -42,14 +43,23 @@ class BasicNetworkOpTx : public Operator {
   Parameter<std::string> l4_proto_p_;
   Parameter<uint16_t> max_payload_size_;
   Parameter<uint32_t> ipg_;
+  Parameter<std::string> tcp_framing_p_;
+
+  static constexpr int TX_BATCH = 64;
+
+  void send_udp(const NetworkOpBurstParams& burst);
+  void send_tcp(const NetworkOpBurstParams& burst);
+  bool send_tcp_msg(const uint8_t* data, uint32_t len);
 
   int sockfd_;
   L4Proto l4_proto_;
+  TcpFraming tcp_framing_ = TcpFraming::NONE;
   struct sockaddr_in server_addr_;
-  uint32_t byte_cnt_ = 0;
   uint32_t pkts_sent_ = 0;
   struct timespec ts_;
   bool connected_ = false;
+  std::vector<struct mmsghdr> msgs_;
+  std::vector<struct iovec> iovs_;
 };
 
 };  // namespace holoscan::ops
@@ -17,6 +17,8 @@
 
 #include "dds_video_publisher.hpp"
 
+#include <chrono>
+
 #include <dds/topic/find.hpp>
 
 namespace holoscan::ops {
@@ -47,6 +49,32 @@ void DDSVideoPublisherOp::initialize() {
                                              qos_provider_.datawriter_qos(writer_qos_.get()));
 }
 
+namespace {
+
+VideoFrameFormat dds_video_format(nvidia::gxf::VideoFormat format) {
+  switch (format) {
+    case nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA:
+      return VideoFrameFormat::RGBA;
+    case nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB:
+      return VideoFrameFormat::RGB;
+    case nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_GRAY:
+      return VideoFrameFormat::GRAY;
+    case nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_NV12:
+      return VideoFrameFormat::NV12;
+    default:
+      throw std::runtime_error(
+          "Invalid buffer format; Only RGBA, RGB, GRAY and NV12 are supported");
+  }
+}
+
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
 void DDSVideoPublisherOp::compute(InputContext& op_input,
                                   OutputContext& op_output,
                                   ExecutionContext& context) {
@@ -55,27 +83,65 @@ void DDSVideoPublisherOp::compute(InputContext& op_input,
     throw std::runtime_error("No input available");
   }
 
-  const auto& buffer = static_cast<nvidia::gxf::Entity>(input).get<nvidia::gxf::VideoBuffer>();
+  const auto& entity = static_cast<nvidia::gxf::Entity>(input);
+  const auto& buffer = entity.get<nvidia::gxf::VideoBuffer>();
   if (!buffer) {
     throw std::runtime_error("No video buffer attached to input");
   }
 
   const auto& info = buffer.value()->video_frame_info();
-  if (info.color_format != nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA) {
-    throw std::runtime_error("Invalid buffer format; Only RGBA is supported");
+  const auto format = dds_video_format(info.color_format);
+  const auto& planes = info.color_planes;
+
+  // Planes are sent back to back with a single row stride, the default layout of GXF buffers
+  uint64_t size = 0;
+  for (const auto& plane : planes) {
+    if (plane.stride != planes[0].stride) {
+      throw std::runtime_error("Invalid buffer layout; All planes must have the same stride");
+    }
+    size += static_cast<uint64_t>(plane.stride) * plane.height;
+  }
+  if (size > VIDEO_FRAME_MAX_SIZE) {
+    throw std::runtime_error(fmt::format(
+        "Frame of {} bytes exceeds the VideoFrame limit of {} bytes", size, VIDEO_FRAME_MAX_SIZE));
+  }
+
+  uint64_t timestamp_ns = now_ns();
+  if (auto timestamp = entity.get<nvidia::gxf::Timestamp>()) {
+    timestamp_ns = timestamp.value()->acqtime;
   }
 
-  // Create the VideoFrame sample from the input buffer
-  std::vector<uint8_t> data(buffer.value()->size());
-  if (buffer.value()->storage_type() == nvidia::gxf::MemoryStorageType::kHost) {
-    memcpy(data.data(), buffer.value()->pointer(), data.size());
-  } else {
-    cudaMemcpy(data.data(), buffer.value()->pointer(), data.size(), cudaMemcpyDeviceToHost);
+  // Build the sample in place in a buffer loaned from the writer. With the shared memory
+  // transport, co-located readers get a reference to this buffer and the frame is never copied
+  // again.
+  VideoFrameBuilder builder = rti::flat::build_data(writer_);
+  builder.add_stream_id(stream_id_.get());
+  builder.add_frame_num(frame_num_++);
+  builder.add_width(info.width);
+  builder.add_height(info.height);
+  builder.add_format(format);
+  builder.add_row_stride(planes.empty() ? 0 : planes[0].stride);
+  builder.add_timestamp_ns(timestamp_ns);
+
+  auto data_builder = builder.build_data();
+  data_builder.add_n(size);
+  uint8_t* data = rti::flat::plain_cast(data_builder.finish());
+
+  const auto* src = static_cast<const uint8_t*>(buffer.value()->pointer());
+  uint64_t dst_offset = 0;
+  for (const auto& plane : planes) {
+    const uint64_t plane_size = static_cast<uint64_t>(plane.stride) * plane.height;
+    if (buffer.value()->storage_type() == nvidia::gxf::MemoryStorageType::kHost) {
+      memcpy(data + dst_offset, src + plane.offset, plane_size);
+    } else {
+      cudaMemcpy(data + dst_offset, src + plane.offset, plane_size, cudaMemcpyDeviceToHost);
+    }
+    dst_offset += plane_size;
   }
-  VideoFrame frame(stream_id_.get(), frame_num_++, info.width, info.height, data);
 
-  // Write the VideoFrame to the writer
-  writer_.write(frame);
+  // Write the VideoFrame to the writer; the writer takes the loaned sample back
+  VideoFrame* frame = builder.finish_sample();
+  writer_.write(*frame);
 }
 
 }  // namespace holoscan::ops
@@ -17,6 +17,10 @@
 
 #include "dds_video_subscriber.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 #include "dds/topic/find.hpp"
 
 namespace holoscan::ops {
@@ -26,14 +30,38 @@ void DDSVideoSubscriberOp::setup(OperatorSpec& spec) {
 
   spec.output<gxf::Entity>("output");
 
-  spec.param(allocator_, "allocator", "Allocator", "Allocator for output buffers.");
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the output buffers.");
   spec.param(reader_qos_, "reader_qos", "Reader QoS", "Data Reader QoS Profile", std::string());
   spec.param(stream_id_, "stream_id", "Stream ID for the video stream");
+  spec.param(queue_policy_, "queue_policy", "Queue policy",
+             "keep_latest to only emit the newest frame, emit_all to emit every frame in order",
+             std::string("keep_latest"));
+  spec.param(max_queue_size_, "max_queue_size", "Max queue size",
+             "Frames pending with emit_all before the oldest is dropped, at least 1 and less "
+             "than the max_samples of the reader",
+             8U);
+  spec.param(max_latency_ms_, "max_latency_ms", "Max latency",
+             "Frames pending for longer than this (in ms) are dropped; 0 to disable",
+             0U);
 }
 
 void DDSVideoSubscriberOp::initialize() {
+  // compute() is only scheduled once the reader thread queued a frame
+  frame_available_ =
+      fragment()->make_condition<AsynchronousCondition>(name() + "_frame_available");
+  add_arg(frame_available_);
+
   DDSOperatorBase::initialize();
 
+  if (queue_policy_.get() == "keep_latest") {
+    policy_ = QueuePolicy::KEEP_LATEST;
+  } else if (queue_policy_.get() == "emit_all") {
+    policy_ = QueuePolicy::EMIT_ALL;
+  } else {
+    throw std::runtime_error(fmt::format(
+        "Invalid queue_policy '{}'; Must be keep_latest or emit_all", queue_policy_.get()));
+  }
+
   // Create the subscriber
   dds::sub::Subscriber subscriber(participant_);
 
@@ -52,21 +80,177 @@ void DDSVideoSubscriberOp::initialize() {
   reader_ = dds::sub::DataReader<VideoFrame>(subscriber, filtered_topic,
                                              qos_provider_.datareader_qos(reader_qos_.get()));
 
+  // Every pending frame holds a loan on the reader until compute() copies it, so the queue must
+  // stay below the samples the reader can hand out
+  if (max_queue_size_.get() == 0) {
+    throw std::runtime_error("max_queue_size must be at least 1");
+  }
+  queue_limit_ = max_queue_size_.get();
+  const int32_t max_samples =
+      reader_.qos().policy<dds::core::policy::ResourceLimits>().max_samples();
+  if (max_samples != dds::core::LENGTH_UNLIMITED && queue_limit_ + 1 >= uint32_t(max_samples)) {
+    queue_limit_ = std::max(max_samples - 2, 1);
+    HOLOSCAN_LOG_WARN("DDSVideoSubscriberOp: max_queue_size {} reduced to {} to stay below the "
+                      "max_samples {} of the reader",
+                      max_queue_size_.get(),
+                      queue_limit_,
+                      max_samples);
+  }
+
   // Obtain the reader's status condition
   status_condition_ = dds::core::cond::StatusCondition(reader_);
 
   // Enable the 'data available' status
   status_condition_.enabled_statuses(dds::core::status::StatusMask::data_available());
 
-  // Attach the status condition to the waitset
+  // Attach the status condition to the waitset, and the condition used to stop the reader thread
   waitset_ += status_condition_;
+  waitset_ += stop_condition_;
+}
+
+void DDSVideoSubscriberOp::start() {
+  frame_available_->event_state(AsynchronousEventState::EVENT_WAITING);
+  stop_condition_.trigger_value(false);
+  running_ = true;
+  reader_thread_ = std::thread(&DDSVideoSubscriberOp::take_frames, this);
+}
+
+void DDSVideoSubscriberOp::stop() {
+  running_ = false;
+  stop_condition_.trigger_value(true);
+  if (reader_thread_.joinable()) { reader_thread_.join(); }
+  frame_available_->event_state(AsynchronousEventState::EVENT_NEVER);
+
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.clear();
+  }
+  HOLOSCAN_LOG_INFO(
+      "DDSVideoSubscriberOp: {} frames dropped, {} samples lost by DDS, {} failed takes",
+      dropped_count(),
+      reader_.sample_lost_status().total_count(),
+      take_errors_.load(std::memory_order_relaxed));
+}
+
+void DDSVideoSubscriberOp::take_frames() {
+  while (running_) {
+    try {
+      waitset_.wait(dds::core::Duration::infinite());
+      if (!running_) { break; }
+
+      // Take every pending frame, each with its own loan so that it can be released on its own
+      while (true) {
+        auto samples = std::make_shared<dds::sub::LoanedSamples<VideoFrame>>(
+            reader_.select().max_samples(1).take());
+        if (samples->length() == 0) { break; }
+        if (!(*samples)[0].info().valid()) { continue; }
+
+        uint64_t dropped = 0;
+        {
+          std::lock_guard<std::mutex> lock(queue_mutex_);
+          if (policy_ == QueuePolicy::KEEP_LATEST) {
+            dropped = queue_.size();
+            queue_.clear();
+          } else if (queue_.size() >= queue_limit_) {
+            queue_.pop_front();
+            dropped = 1;
+          }
+          queue_.push_back({std::move(samples), std::chrono::steady_clock::now()});
+          frame_available_->event_state(AsynchronousEventState::EVENT_DONE);
+        }
+        if (dropped > 0) { count_dropped(dropped, "superseded by newer frames"); }
+      }
+    } catch (const std::exception& e) {
+      // e.g. the reader ran out of loans; an exception must not escape the thread, so back off
+      // and let compute() return samples
+      const uint64_t errors = take_errors_.fetch_add(1, std::memory_order_relaxed) + 1;
+      if (errors == 1 || errors % 100 == 0) {
+        HOLOSCAN_LOG_ERROR(
+            "DDSVideoSubscriberOp: failed to take frames ({} so far): {}", errors, e.what());
+      }
+      std::this_thread::sleep_for(kTakeErrorBackoff);
+    }
+  }
 }
 
+void DDSVideoSubscriberOp::count_dropped(uint64_t count, const char* reason) {
+  const uint64_t total = dropped_.fetch_add(count, std::memory_order_relaxed) + count;
+  if (total == count || total / 100 != (total - count) / 100) {
+    HOLOSCAN_LOG_WARN(
+        "DDSVideoSubscriberOp: {} frames dropped ({}), {} dropped so far", count, reason, total);
+  }
+}
+
+namespace {
+
+template <nvidia::gxf::VideoFormat Format>
+nvidia::gxf::VideoBufferInfo video_buffer_info(uint32_t width, uint32_t height,
+                                               uint32_t row_stride) {
+  // The planes of a VideoFrame are packed back to back, all with the same row stride
+  nvidia::gxf::VideoFormatSize<Format> format_size;
+  auto planes = format_size.getDefaultColorPlanes(width, height, false);
+  uint32_t offset = 0;
+  for (auto& plane : planes) {
+    plane.stride = row_stride;
+    plane.offset = offset;
+    plane.size = static_cast<uint64_t>(row_stride) * plane.height;
+    offset += plane.size;
+  }
+  return {width, height, Format, std::move(planes),
+          nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
+}
+
+nvidia::gxf::VideoBufferInfo video_buffer_info(const VideoFrameFormat format, uint32_t width,
+                                               uint32_t height, uint32_t row_stride) {
+  switch (format) {
+    case VideoFrameFormat::RGBA:
+      return video_buffer_info<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(
+          width, height, row_stride);
+    case VideoFrameFormat::RGB:
+      return video_buffer_info<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB>(
+          width, height, row_stride);
+    case VideoFrameFormat::GRAY:
+      return video_buffer_info<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_GRAY>(
+          width, height, row_stride);
+    case VideoFrameFormat::NV12:
+      return video_buffer_info<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_NV12>(
+          width, height, row_stride);
+    default:
+      throw std::runtime_error("Unsupported VideoFrame format");
+  }
+}
+
+}  // namespace
+
 void DDSVideoSubscriberOp::compute(InputContext& op_input,
                                    OutputContext& op_output,
                                    ExecutionContext& context) {
-  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
-      context.context(), allocator_->gxf_cid());
+  // Pop the next frame that is still within the latency budget
+  std::shared_ptr<dds::sub::LoanedSamples<VideoFrame>> frames;
+  uint64_t stale = 0;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    const auto max_latency = std::chrono::milliseconds(max_latency_ms_.get());
+    const auto now = std::chrono::steady_clock::now();
+    while (!frames && !queue_.empty()) {
+      auto pending = std::move(queue_.front());
+      queue_.pop_front();
+      if (max_latency.count() > 0 && now - pending.received > max_latency) {
+        stale++;
+      } else {
+        frames = std::move(pending.samples);
+      }
+    }
+    // Stay scheduled while frames are pending; the reader thread sets EVENT_DONE under the same
+    // lock, so no wake-up is lost
+    frame_available_->event_state(queue_.empty() ? AsynchronousEventState::EVENT_WAITING
+                                                 : AsynchronousEventState::EVENT_DONE);
+  }
+  if (stale > 0) { count_dropped(stale, "older than max_latency_ms"); }
+  if (!frames) { return; }
+
+  auto allocator =
+      nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(), allocator_->gxf_cid());
 
   auto output = nvidia::gxf::Entity::New(context.context());
   if (!output) {
@@ -78,29 +262,32 @@ void DDSVideoSubscriberOp::compute(InputContext& op_input,
     throw std::runtime_error("Failed to allocate video buffer");
   }
 
-  bool output_written = false;
-  while (!output_written) {
-    // Wait for a new frame
-    dds::core::cond::WaitSet::ConditionSeq active_conditions =
-        waitset_.wait(dds::core::Duration::from_secs(1));
-    for (const auto& cond : active_conditions) {
-      if (cond == status_condition_) {
-        // Take the available frame
-        dds::sub::LoanedSamples<VideoFrame> frames = reader_.take();
-        for (const auto& frame : frames) {
-          if (frame.info().valid()) {
-            // Copy the frame to the output buffer
-            video_buffer.value()->resize<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(
-                frame.data().width(), frame.data().height(),
-                nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR,
-                nvidia::gxf::MemoryStorageType::kHost, allocator.value());
-            memcpy(video_buffer.value()->pointer(), frame.data().data().data(),
-                   frame.data().data().size());
-            output_written = true;
-          }
-        }
-      }
-    }
+  const auto& frame = (*frames)[0];
+  const auto root = frame.data().root();
+  const auto data = root.data();
+  auto info = video_buffer_info(root.format(), root.width(), root.height(), root.row_stride());
+  const uint64_t timestamp_ns = root.timestamp_ns();
+
+  auto resized = video_buffer.value()->resizeCustom(
+      info, data.element_count(), nvidia::gxf::MemoryStorageType::kHost, allocator.value());
+  if (!resized) {
+    throw std::runtime_error("Failed to allocate the output video buffer");
+  }
+
+  // A zero-copy sample lives in the writer's memory, which the writer may reuse at any time.
+  // The sample is copied first and only checked afterwards, so that a copy the writer raced
+  // with is caught; the loan is then returned right away.
+  memcpy(video_buffer.value()->pointer(), rti::flat::plain_cast(data), data.element_count());
+  const bool consistent = reader_.extensions().is_data_consistent(frame);
+  frames.reset();
+  if (!consistent) {
+    count_dropped(1, "overwritten by the writer while it was read");
+    return;
+  }
+
+  auto timestamp = output.value().add<nvidia::gxf::Timestamp>("timestamp");
+  if (timestamp) {
+    timestamp.value()->acqtime = timestamp_ns;
   }
 
   // Output the buffer
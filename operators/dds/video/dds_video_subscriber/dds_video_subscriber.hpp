@@ -17,6 +17,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include <dds/sub/ddssub.hpp>
 
 #include "dds_operator_base.hpp"
@@ -26,6 +35,16 @@ namespace holoscan::ops {
 
 /**
  * @brief Operator class to subscribe to a DDS video stream.
+ *
+ * Frames are taken from the DataReader by a background thread and queued for compute(), which is
+ * scheduled through an AsynchronousCondition only when a frame is ready. The operator never
+ * blocks a scheduler worker while the publisher is idle.
+ *
+ * The `queue_policy` parameter selects what happens when frames arrive faster than they are
+ * consumed: `keep_latest` only keeps the newest frame, `emit_all` emits every frame in order,
+ * dropping the oldest once `max_queue_size` frames are pending. Pending frames hold loans on the
+ * DataReader, so `max_queue_size` is kept below the `max_samples` of the reader. Frames that
+ * waited longer than `max_latency_ms` are dropped as stale. Dropped frames are counted and logged.
  */
 class DDSVideoSubscriberOp : public DDSOperatorBase {
  public:
@@ -35,17 +54,51 @@ class DDSVideoSubscriberOp : public DDSOperatorBase {
 
   void setup(OperatorSpec& spec) override;
   void initialize() override;
+  void start() override;
+  void stop() override;
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override;
 
+  /**
+   * @brief Frames dropped so far by the queue policy, as stale or as inconsistent samples.
+   */
+  uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
  private:
+  enum class QueuePolicy { KEEP_LATEST, EMIT_ALL };
+
+  struct PendingFrame {
+    std::shared_ptr<dds::sub::LoanedSamples<VideoFrame>> samples;
+    std::chrono::steady_clock::time_point received;
+  };
+
+  // How long the reader thread waits after take() failed
+  static constexpr auto kTakeErrorBackoff = std::chrono::milliseconds(10);
+
+  void take_frames();
+  void count_dropped(uint64_t count, const char* reason);
+
   Parameter<std::shared_ptr<Allocator>> allocator_;
   Parameter<std::string> reader_qos_;
   Parameter<uint32_t> stream_id_;
+  Parameter<std::string> queue_policy_;
+  Parameter<uint32_t> max_queue_size_;
+  Parameter<uint32_t> max_latency_ms_;
 
   dds::sub::DataReader<VideoFrame> reader_ = dds::core::null;
   dds::core::cond::StatusCondition status_condition_ = dds::core::null;
+  dds::core::cond::GuardCondition stop_condition_;
   dds::core::cond::WaitSet waitset_;
+
+  QueuePolicy policy_ = QueuePolicy::KEEP_LATEST;
+  std::shared_ptr<AsynchronousCondition> frame_available_;
+  std::thread reader_thread_;
+  std::atomic<bool> running_{false};
+  std::mutex queue_mutex_;
+  std::deque<PendingFrame> queue_;
+  uint32_t queue_limit_ = 1;
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> take_errors_{0};
 };
 
 }  // namespace holoscan::ops
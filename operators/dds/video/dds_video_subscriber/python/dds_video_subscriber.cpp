@@ -62,13 +62,19 @@ class PyDDSVideoSubscriberOp : public DDSVideoSubscriberOp {
                          uint32_t domain_id = 0,
                          const std::string& reader_qos = "",
                          uint32_t stream_id = 0,
+                         const std::string& queue_policy = "keep_latest",
+                         uint32_t max_queue_size = 8,
+                         uint32_t max_latency_ms = 0,
                          const std::string& name = "dds_video_subscriber")
       : DDSVideoSubscriberOp(ArgList{Arg{"allocator", allocator},
                                      Arg{"qos_provider", qos_provider},
                                      Arg{"participant_qos", participant_qos},
                                      Arg{"domain_id", domain_id},
                                      Arg{"reader_qos", reader_qos},
-                                     Arg{"stream_id", stream_id}}) {
+                                     Arg{"stream_id", stream_id},
+                                     Arg{"queue_policy", queue_policy},
+                                     Arg{"max_queue_size", max_queue_size},
+                                     Arg{"max_latency_ms", max_latency_ms}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -109,6 +115,9 @@ PYBIND11_MODULE(_dds_video_subscriber, m) {
                     uint32_t,
                     const std::string&,
                     uint32_t,
+                    const std::string&,
+                    uint32_t,
+                    uint32_t,
                     const std::string&>(),
            "fragment"_a,
            "allocator"_a,
@@ -117,6 +126,9 @@ PYBIND11_MODULE(_dds_video_subscriber, m) {
            "domain_id"_a = 0,
            "reader_qos"_a = ""s,
            "stream_id"_a = 0,
+           "queue_policy"_a = "keep_latest"s,
+           "max_queue_size"_a = 8,
+           "max_latency_ms"_a = 0,
            "name"_a = "dds_video_subscriber"s,
            doc::DDSVideoSubscriberOp::doc_DDSVideoSubscriberOp)
       .def("initialize", &DDSVideoSubscriberOp::initialize,
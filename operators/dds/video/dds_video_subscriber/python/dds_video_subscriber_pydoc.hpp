@@ -34,7 +34,7 @@ DDS Video Subscriber operator.
 Parameters
 ----------
 allocator : holoscan.resources.Allocator
-    Memory pool allocator used by the operator.
+    Allocator for the output buffers.
 qos_provider: str, optional
     URI for the QoS Provider
 participant_qos: str, optional
@@ -45,6 +45,13 @@ reader_qos: str, optional
     QoS profile for the data reader
 stream_id : int, optional
     Stream ID of the video stream.
+queue_policy : str, optional
+    ``"keep_latest"`` to only emit the newest frame, ``"emit_all"`` to emit every frame in order.
+max_queue_size : int, optional
+    Frames pending with ``"emit_all"`` before the oldest is dropped, at least 1 and kept below
+    the ``max_samples`` of the reader.
+max_latency_ms : int, optional
+    Frames pending for longer than this are dropped; 0 to disable.
 name : str, optional
     The name of the operator.
 )doc")
@@ -20,6 +20,11 @@
 
 namespace holoscan::ops {
 
+namespace {
+// How long the writer thread sleeps waiting for a request before re-checking the RPC timeout
+constexpr auto kWriterPollInterval = std::chrono::milliseconds(100);
+}  // namespace
+
 EntityClient::EntityClient(
     const std::string& server_address, const uint32_t rpc_timeout,
     std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue,
@@ -57,7 +62,6 @@ EntityClient::EntityStreamInternal::EntityStreamInternal(
   client_->stub_->async()->EntityStream(&context_, this);
   context_.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(rpc_timeout_));
   StartCall();
-  Write();
   Read();
   writer_thread_ = std::thread(&EntityStreamInternal::ProcessOutgoingQueue, this);
 }
@@ -68,16 +72,25 @@ EntityClient::EntityStreamInternal::~EntityStreamInternal() {
 
 void EntityClient::EntityStreamInternal::OnWriteDone(bool ok) {
   last_network_activity_ = std::chrono::high_resolution_clock::now();
+  bool close = false;
   if (!ok) {
     HOLOSCAN_LOG_WARN("grpc client: write failed, error transmitting request");
     if (auto status = client_->channel_->GetState(true);
         status == GRPC_CHANNEL_TRANSIENT_FAILURE || status == GRPC_CHANNEL_SHUTDOWN) {
       HOLOSCAN_LOG_WARN("grpc client: closing connection");
-      done_ = true;
-      StartWritesDone();
+      close = true;
     }
   }
-  write_mutex_.unlock();
+
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    close = close && !writes_done_;
+    writes_done_ = writes_done_ || close;
+    write_in_flight_ = false;
+    pending_request_.reset();
+    write_cv_.notify_one();
+  }
+  if (close) { StartWritesDone(); }
 }
 
 void EntityClient::EntityStreamInternal::OnReadDone(bool ok) {
@@ -85,15 +98,23 @@ void EntityClient::EntityStreamInternal::OnReadDone(bool ok) {
   if (ok) {
     auto entity = response_cb_(response_);
 
-    client_->response_queue_->push(entity);
-    HOLOSCAN_LOG_DEBUG("grpc client: Response received and queued for display");
+    if (entity) {
+      client_->response_queue_->push(entity);
+      HOLOSCAN_LOG_DEBUG("grpc client: Response received and queued for display");
+    }
     Read();
   }
 }
 void EntityClient::EntityStreamInternal::OnDone(const grpc::Status& status) {
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    writes_done_ = true;
+    write_cv_.notify_one();
+  }
+  rpc_completed_cb_();
+  std::lock_guard<std::mutex> lock(done_mutex_);
   status_ = status;
   done_ = true;
-  rpc_completed_cb_();
   done_cv_.notify_one();
 }
 
@@ -108,24 +129,40 @@ void EntityClient::EntityStreamInternal::Read() {
   StartRead(&response_);
 }
 
-void EntityClient::EntityStreamInternal::Write() {
-  if (!client_->request_queue_->empty()) {
-    write_mutex_.lock();
-    std::shared_ptr<EntityRequest> request;
-    request = client_->request_queue_->pop();
-    StartWrite(&*request);
-    HOLOSCAN_LOG_DEBUG("grpc client: Sending request to server");
-  }
-}
-
 void EntityClient::EntityStreamInternal::ProcessOutgoingQueue() {
+  // gRPC allows a single outstanding write per stream, so wait for OnWriteDone() before taking the
+  // next request. Neither wait spins: the thread sleeps until a write completes or a request
+  // arrives, waking every kWriterPollInterval to check the RPC timeout.
   while (true) {
+    {
+      std::unique_lock<std::mutex> lock(write_mutex_);
+      write_cv_.wait(lock, [this] { return !write_in_flight_ || writes_done_; });
+      if (writes_done_) { break; }
+    }
+
     if (network_timed_out()) {
-      HOLOSCAN_LOG_INFO("grpc client: Connection timed out, closing connection");
-      StartWritesDone();
+      std::unique_lock<std::mutex> lock(write_mutex_);
+      if (!writes_done_) {
+        HOLOSCAN_LOG_INFO("grpc client: Connection timed out, closing connection");
+        writes_done_ = true;
+        lock.unlock();
+        StartWritesDone();
+      }
       break;
     }
-    Write();
+
+    auto request = client_->request_queue_->pop_for(kWriterPollInterval);
+    if (!request) { continue; }
+
+    {
+      std::lock_guard<std::mutex> lock(write_mutex_);
+      if (writes_done_) { break; }
+      write_in_flight_ = true;
+      pending_request_ = std::move(request);
+    }
+    // Called without the lock held since gRPC may run OnWriteDone() inline
+    StartWrite(pending_request_.get());
+    HOLOSCAN_LOG_DEBUG("grpc client: Sending request to server");
   }
 }
 
@@ -45,7 +45,8 @@ using namespace holoscan::ops;
  * @typedef on_new_response_available_callback
  * @brief Callback type for handling new responses from the server.
  *
- * A callback function that is invoked when a new response is received from the server.
+ * A callback function that is invoked when a new response is received from the server. Returns
+ * nullptr while the response is part of a chunked entity that isn't complete yet.
  */
 using on_new_response_available_callback =
     std::function<std::shared_ptr<nvidia::gxf::Entity>(EntityResponse& response)>;
@@ -99,7 +100,6 @@ class EntityClient {
 
    private:
     void Read();
-    void Write();
     void ProcessOutgoingQueue();
     bool network_timed_out();
 
@@ -109,12 +109,18 @@ class EntityClient {
     on_new_response_available_callback response_cb_;
     on_rpc_completed_callback rpc_completed_cb_;
 
-    bool done_;
+    bool done_ = false;
     std::mutex done_mutex_;
     std::condition_variable done_cv_;
     Status status_;
 
+    // Guards the writer state below. The writer thread sleeps on write_cv_ while a write is in
+    // flight and on the request queue while there is nothing to send.
     std::mutex write_mutex_;
+    std::condition_variable write_cv_;
+    bool write_in_flight_ = false;
+    bool writes_done_ = false;
+    std::shared_ptr<EntityRequest> pending_request_;
     std::thread writer_thread_;
     int rpc_timeout_;
     std::chrono::time_point<std::chrono::system_clock> last_network_activity_;
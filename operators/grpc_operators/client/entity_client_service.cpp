@@ -48,21 +48,28 @@ void EntityClientService::start_entity_stream_internal() {
   try {
     entity_client_->EntityStream(
         // Handle incoming responses
-        [this](EntityResponse& response) {
+        [this](EntityResponse& response) -> std::shared_ptr<nvidia::gxf::Entity> {
           auto gxf_allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
               grpc_request_operator_->executor().context(),
               grpc_request_operator_->allocator()->gxf_cid());
           if (!gxf_allocator) { throw std::runtime_error("Failed to create GXF allocator"); }
 
-          auto out_message = nvidia::gxf::Entity::New(grpc_request_operator_->executor().context());
-          if (!out_message) { throw std::runtime_error("Failed to create GXF entity"); }
+          if (!pending_response_) {
+            auto out_message =
+                nvidia::gxf::Entity::New(grpc_request_operator_->executor().context());
+            if (!out_message) { throw std::runtime_error("Failed to create GXF entity"); }
+            pending_response_ = std::make_shared<nvidia::gxf::Entity>(out_message.value());
+          }
 
           holoscan::ops::TensorProto::entity_response_to_tensor(
               response,
-              out_message.value(),
+              *pending_response_,
               gxf_allocator.value(),
               grpc_request_operator_->get_cuda_stream());
-          return std::make_shared<nvidia::gxf::Entity>(out_message.value());
+
+          // Hold the entity back until its last chunk arrives
+          if (response.has_more_chunks()) { return nullptr; }
+          return std::move(pending_response_);
         },
         // Handle RPC completed event
         [this]() {});
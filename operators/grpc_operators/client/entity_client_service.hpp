@@ -90,6 +90,8 @@ class EntityClientService {
   std::shared_ptr<GrpcClientRequestOp> grpc_request_operator_;
 
   std::shared_ptr<EntityClient> entity_client_;
+  // Entity being assembled from a chunked response; only touched by the gRPC reactor
+  std::shared_ptr<nvidia::gxf::Entity> pending_response_;
   std::thread streaming_thread_;
 };
 }  // namespace holoscan::ops
@@ -24,6 +24,11 @@ void GrpcClientRequestOp::setup(OperatorSpec& spec) {
 
   spec.param(request_queue_, "request_queue", "Request Queue", "Outgoing gRPC requests.");
   spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
+  spec.param(max_chunk_size_,
+             "max_chunk_size",
+             "Max chunk size",
+             "Largest amount of tensor data in bytes per request; 0 to disable chunking.",
+             0U);
 
   cuda_stream_handler_.define_params(spec);
 }
@@ -35,10 +40,13 @@ void GrpcClientRequestOp::compute(InputContext& op_input, OutputContext& op_outp
     HOLOSCAN_LOG_ERROR("grpc: Failed to receive input message");
     return;
   }
-  auto request = std::make_shared<EntityRequest>();
-  holoscan::ops::TensorProto::tensor_to_entity_request(
-      maybe_input_message.value(), request, get_cuda_stream());
-  request_queue_->push(request);
+  // Each chunk is queued as soon as it is encoded so the writer can start sending
+  TensorProtoChunker<EntityRequest> chunker(
+      max_chunk_size_.get(), get_cuda_stream(), [this](std::shared_ptr<EntityRequest> request) {
+        request_queue_->push(request);
+      });
+  chunker.add(maybe_input_message.value());
+  chunker.finish();
   HOLOSCAN_LOG_DEBUG("grpc: request converted and queued for transmission");
 }
 
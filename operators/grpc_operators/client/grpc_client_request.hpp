@@ -51,6 +51,9 @@ namespace holoscan::ops {
  * ==Parameters==
  * - **request_queue** : A queue for storing outgoing gRPC requests.
  * - **allocator** : An allocator used when converting EntityResponse to GXF Entity.
+ * - **max_chunk_size** : Largest amount of tensor data in bytes per request. Larger entities are
+ *                        split into several requests so transmission starts before the whole
+ *                        entity is encoded. 0 (default) sends each entity as a single request.
  */
 class GrpcClientRequestOp : public holoscan::Operator {
  public:
@@ -71,6 +74,7 @@ class GrpcClientRequestOp : public holoscan::Operator {
  private:
   Parameter<std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>>> request_queue_;
   Parameter<std::shared_ptr<Allocator>> allocator_;
+  Parameter<uint32_t> max_chunk_size_;
 
   CudaStreamHandler cuda_stream_handler_;
 };
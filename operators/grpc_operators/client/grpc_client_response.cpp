@@ -25,6 +25,7 @@ void GrpcClientResponseOp::start() {
 
 void GrpcClientResponseOp::stop() {
   condition_->event_state(AsynchronousEventState::EVENT_NEVER);
+  response_queue_->shutdown();
   HOLOSCAN_LOG_INFO("grpc: GrpcClientResponseOp::stop()");
 }
 
@@ -48,6 +49,6 @@ void GrpcClientResponseOp::compute(InputContext& op_input, OutputContext& op_out
     auto result = nvidia::gxf::Entity(std::move(*response));
     op_output.emit(result, "output");
   }
-  condition_->event_state(AsynchronousEventState::EVENT_WAITING);
+  response_queue_->wait_for_data();
 }
 }  // namespace holoscan::ops
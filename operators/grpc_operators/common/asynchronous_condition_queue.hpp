@@ -18,8 +18,12 @@
 #ifndef COMMON_ASYNCHRONOUS_CONDITION_QUEUE_HPP
 #define COMMON_ASYNCHRONOUS_CONDITION_QUEUE_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <vector>
 
 #include <holoscan/holoscan.hpp>
 
@@ -27,42 +31,179 @@ namespace holoscan::ops {
 
 using namespace holoscan;
 
+/**
+ * @brief What AsynchronousConditionQueue::push() does when the queue is full.
+ *
+ * BLOCK makes the producer wait for the consumer to free a slot, which pushes back on the gRPC
+ * stream. DROP discards the new item and counts it in dropped().
+ */
+enum class QueueFullPolicy { BLOCK, DROP };
+
 /**
  * @class AsynchronousConditionQueue
  * @brief This class is a Holoscan Resource that is responsible for storing a queue of data
  * entities.
  *
- * The AsynchronousCondition is used to notify when data is available.
+ * The queue is a bounded lock-free ring buffer that may be pushed from any number of threads (the
+ * gRPC reactor threads) and popped from a single consumer (the operator's compute()). The
+ * AsynchronousCondition is used to notify when data is available.
+ *
+ * The capacity is rounded up to a power of two.
  */
-
 template <typename DataT>
 class AsynchronousConditionQueue : public Resource {
  public:
   HOLOSCAN_RESOURCE_FORWARD_ARGS_SUPER(AsynchronousConditionQueue, Resource)
 
   explicit AsynchronousConditionQueue(
-      std::shared_ptr<AsynchronousCondition> request_available_condition)
-      : data_available_condition_(request_available_condition), queue_() {}
+      std::shared_ptr<AsynchronousCondition> request_available_condition, size_t capacity = 64,
+      QueueFullPolicy policy = QueueFullPolicy::BLOCK)
+      : data_available_condition_(request_available_condition),
+        policy_(policy),
+        buffer_(round_up_pow2(capacity)),
+        mask_(buffer_.size() - 1) {
+    for (size_t i = 0; i < buffer_.size(); i++) {
+      buffer_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
 
-  void push(DataT entity) {
-    queue_.push(entity);
-    if (data_available_condition_->event_state() == AsynchronousEventState::EVENT_WAITING) {
-      data_available_condition_->event_state(AsynchronousEventState::EVENT_DONE);
+  /**
+   * @brief Adds an entity to the queue and wakes the consumer.
+   *
+   * @return false if the entity was dropped because the queue is full (DROP) or shut down.
+   */
+  bool push(DataT entity) {
+    if (!try_push(entity)) {
+      if (policy_ == QueueFullPolicy::DROP || !wait_push(entity)) {
+        const auto dropped = dropped_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (dropped == 1 || dropped % 100 == 0) {
+          HOLOSCAN_LOG_WARN("grpc: queue full, {} entities dropped so far", dropped);
+        }
+        return false;
+      }
     }
+
+    notify_consumer();
+    return true;
   }
 
+  /**
+   * @brief Removes the oldest entity, or returns an empty DataT if there is none. Must only be
+   * called from the consumer thread.
+   */
   DataT pop() {
-    if (empty()) { return nullptr; }
-    auto item = queue_.front();
-    queue_.pop();
+    const uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    auto& cell = buffer_[pos & mask_];
+    if (cell.seq.load(std::memory_order_acquire) != pos + 1) { return DataT{}; }
+
+    DataT item = std::move(cell.data);
+    cell.data = DataT{};
+    cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+
+    // Pairs with the fence in wait_push() so either the producer sees the free slot or we see
+    // the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_producers_.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(full_mutex_);
+      not_full_.notify_all();
+    }
     return item;
   }
 
-  bool empty() { return queue_.empty(); }
+  bool empty() {
+    const uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    return buffer_[pos & mask_].seq.load(std::memory_order_acquire) != pos + 1;
+  }
+
+  /**
+   * @brief Re-arms the condition once the consumer is done with the queue, or marks it done again
+   * if entities arrived in the meantime. Call at the end of compute().
+   */
+  void wait_for_data() {
+    data_available_condition_->event_state(AsynchronousEventState::EVENT_WAITING);
+    // A push between the last pop() and re-arming would otherwise sit in the queue until the next
+    if (!empty()) {
+      data_available_condition_->event_state(AsynchronousEventState::EVENT_DONE);
+    }
+  }
+
+  /**
+   * @brief Releases producers blocked on a full queue. Later pushes that find the queue full are
+   * dropped.
+   */
+  void shutdown() {
+    std::lock_guard<std::mutex> lock(full_mutex_);
+    shutdown_.store(true, std::memory_order_relaxed);
+    not_full_.notify_all();
+  }
+
+  size_t capacity() const { return buffer_.size(); }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
 
  private:
+  struct Cell {
+    std::atomic<uint64_t> seq;
+    DataT data;
+  };
+
+  static size_t round_up_pow2(size_t n) {
+    size_t v = 1;
+    while (v < n) { v <<= 1; }
+    return v;
+  }
+
+  bool try_push(DataT& entity) {
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = buffer_[pos & mask_];
+      const uint64_t seq = cell.seq.load(std::memory_order_acquire);
+      const int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.data = std::move(entity);
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool wait_push(DataT& entity) {
+    std::unique_lock<std::mutex> lock(full_mutex_);
+    waiting_producers_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool pushed;
+    while (!(pushed = try_push(entity)) && !shutdown_.load(std::memory_order_relaxed)) {
+      not_full_.wait(lock);
+    }
+    waiting_producers_.fetch_sub(1, std::memory_order_relaxed);
+    return pushed;
+  }
+
+  void notify_consumer() {
+    if (data_available_condition_->event_state() == AsynchronousEventState::EVENT_WAITING) {
+      data_available_condition_->event_state(AsynchronousEventState::EVENT_DONE);
+    }
+  }
+
   std::shared_ptr<AsynchronousCondition> data_available_condition_;
-  std::queue<DataT> queue_;
+  QueueFullPolicy policy_;
+  std::vector<Cell> buffer_;
+  const size_t mask_;
+
+  alignas(64) std::atomic<uint64_t> enqueue_pos_{0};
+  alignas(64) std::atomic<uint64_t> dequeue_pos_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  std::mutex full_mutex_;
+  std::condition_variable not_full_;
+  std::atomic<int> waiting_producers_{0};
+  std::atomic<bool> shutdown_{false};
 };
 
 }  // namespace holoscan::ops
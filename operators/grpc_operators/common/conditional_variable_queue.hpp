@@ -18,6 +18,9 @@
 #ifndef COMMON_CONDITIONAL_VARIABLE_QUEUE_HPP
 #define COMMON_CONDITIONAL_VARIABLE_QUEUE_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <queue>
 
 #include <holoscan/holoscan.hpp>
@@ -57,7 +60,22 @@ class ConditionVariableQueue : public Resource {
     return item;
   }
 
+  /**
+   * @brief Like pop(), but gives up after the timeout and returns an empty DataT.
+   */
+  template <typename Rep, typename Period>
+  DataT pop_for(const std::chrono::duration<Rep, Period>& timeout) {
+    std::unique_lock<std::mutex> lock(response_available_mutex_);
+    if (!data_available_condition_.wait_for(lock, timeout, [this]() { return !queue_.empty(); })) {
+      return DataT{};
+    }
+    auto item = queue_.front();
+    queue_.pop();
+    return item;
+  }
+
   bool empty() {
+    std::lock_guard<std::mutex> lock(response_available_mutex_);
     return queue_.empty();
   }
 
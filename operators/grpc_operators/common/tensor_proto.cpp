@@ -17,6 +17,9 @@
 
 #include "tensor_proto.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace holoscan::ops {
 
 #ifndef CUDA_TRY
@@ -46,11 +49,53 @@ void TensorProto::gxf_time_to_proto(const nvidia::gxf::Entity& gxf_entity,
 
 void TensorProto::proto_to_gxf_time(nvidia::gxf::Entity& gxf_entity,
                                     const ::holoscan::entity::Timestamp& timestamp) {
+  // Only the first message of a chunked entity carries the timestamp
+  if (gxf_entity.get<nvidia::gxf::Timestamp>()) { return; }
   auto gxf_timestamp = gxf_entity.add<nvidia::gxf::Timestamp>("timestamp");
   (*gxf_timestamp)->acqtime = timestamp.acqtime();
   (*gxf_timestamp)->pubtime = timestamp.pubtime();
 }
 
+void TensorProto::fill_tensor_metadata(nvidia::gxf::Tensor& tensor,
+                                       ::holoscan::entity::Tensor& tensor_proto) {
+  tensor_proto.set_primitive_type(proto_primitive_type(tensor.element_type()));
+  tensor_proto.set_memory_storage_type(
+      tensor.storage_type() == nvidia::gxf::MemoryStorageType::kDevice
+          ? holoscan::entity::Tensor::kDevice
+          : holoscan::entity::Tensor::kHost);
+
+  const auto trivial_strides =
+      nvidia::gxf::ComputeTrivialStrides(tensor.shape(), tensor.bytes_per_element());
+  bool packed = true;
+  tensor_proto.clear_dimensions();
+  for (uint32_t i = 0; i < tensor.shape().rank(); i++) {
+    tensor_proto.add_dimensions(tensor.shape().dimension(i));
+    packed = packed && tensor.stride(i) == trivial_strides[i];
+  }
+
+  tensor_proto.clear_strides();
+  if (!packed) {
+    for (uint32_t i = 0; i < tensor.shape().rank(); i++) {
+      tensor_proto.add_strides(tensor.stride(i));
+    }
+  }
+}
+
+void TensorProto::copy_data_to_proto(nvidia::gxf::Tensor& tensor, size_t offset,
+                                     size_t size, ::holoscan::entity::Tensor& tensor_proto,
+                                     const cudaStream_t cuda_stream) {
+  // Copy straight into the message's own buffer instead of staging through a temporary. Device
+  // copies are asynchronous; the caller synchronizes the stream before the message is used.
+  std::string* data = tensor_proto.mutable_data();
+  data->resize(size);
+  const auto* src = static_cast<const uint8_t*>(tensor.pointer()) + offset;
+  if (tensor.storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
+    CUDA_TRY(cudaMemcpyAsync(data->data(), src, size, cudaMemcpyDeviceToHost, cuda_stream));
+  } else {
+    std::memcpy(data->data(), src, size);
+  }
+}
+
 void TensorProto::gxf_tensor_to_proto(
     const nvidia::gxf::Entity& gxf_entity,
     google::protobuf::Map<std::string, ::holoscan::entity::Tensor>* tensor_map,
@@ -58,79 +103,81 @@ void TensorProto::gxf_tensor_to_proto(
   auto tensors = gxf_entity.findAll<nvidia::gxf::Tensor, 4>();
   if (!tensors) { throw std::runtime_error("Tensor not found"); }
 
+  bool on_device = false;
   for (auto tensor : tensors.value()) {
+    nvidia::gxf::Tensor& gxf_tensor = *tensor.value().get();
     holoscan::entity::Tensor& tensor_proto = (*tensor_map)[tensor->name()];
-    for (uint32_t i = 0; i < (*tensor)->shape().rank(); i++) {
-      tensor_proto.add_dimensions((*tensor)->shape().dimension(i));
-    }
-    switch ((*tensor)->element_type()) {
-      case nvidia::gxf::PrimitiveType::kUnsigned8:
-        tensor_proto.set_primitive_type(holoscan::entity::Tensor::kUnsigned8);
-        copy_data_to_proto<uint8_t>(tensor.value(), tensor_proto, cuda_stream);
-        break;
-      case nvidia::gxf::PrimitiveType::kUnsigned16:
-        tensor_proto.set_primitive_type(holoscan::entity::Tensor::kUnsigned16);
-        copy_data_to_proto<uint16_t>(tensor.value(), tensor_proto, cuda_stream);
-        break;
-      case nvidia::gxf::PrimitiveType::kFloat32:
-        tensor_proto.set_primitive_type(holoscan::entity::Tensor::kFloat32);
-        copy_data_to_proto<float>(tensor.value(), tensor_proto, cuda_stream);
-        break;
-      default:
-        throw std::runtime_error("Unsupported primitive type");
-    }
+    fill_tensor_metadata(gxf_tensor, tensor_proto);
+    copy_data_to_proto(gxf_tensor, 0, gxf_tensor.bytes_size(), tensor_proto, cuda_stream);
+    on_device |= gxf_tensor.storage_type() == nvidia::gxf::MemoryStorageType::kDevice;
   }
+  if (on_device) { CUDA_TRY(cudaStreamSynchronize(cuda_stream)); }
 }
 
-template <typename T>
-void TensorProto::copy_data_to_proto(const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor,
-                                     ::holoscan::entity::Tensor& tensor_proto,
-                                     const cudaStream_t cuda_stream) {
-  if ((*tensor).storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
-    void* in_data_ptr = (*tensor).pointer();
-    size_t data_size = (*tensor).bytes_size();
-    std::vector<T> in_data(data_size);
-    CUDA_TRY(cudaMemcpyAsync(
-        in_data.data(), in_data_ptr, data_size, cudaMemcpyDeviceToHost, cuda_stream));
-    tensor_proto.set_data(in_data.data(), data_size);
-    tensor_proto.set_memory_storage_type(holoscan::entity::Tensor::kDevice);
-  } else {
-    tensor_proto.set_data((*tensor).pointer(), (*tensor).size());
-    tensor_proto.set_memory_storage_type(holoscan::entity::Tensor::kHost);
+bool TensorProto::copy_data_to_tensor(const ::holoscan::entity::Tensor& tensor_proto,
+                                      nvidia::gxf::Tensor& tensor,
+                                      const cudaStream_t cuda_stream) {
+  const uint64_t offset = tensor_proto.chunk_offset();
+  if (offset + tensor_proto.data().size() > tensor.bytes_size()) {
+    throw std::runtime_error("Tensor data exceeds the tensor size");
+  }
+
+  auto* dst = static_cast<uint8_t*>(tensor.pointer()) + offset;
+  if (tensor.storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
+    CUDA_TRY(cudaMemcpyAsync(dst,
+                             tensor_proto.data().data(),
+                             tensor_proto.data().size(),
+                             cudaMemcpyHostToDevice,
+                             cuda_stream));
+    return true;
   }
+  std::memcpy(dst, tensor_proto.data().data(), tensor_proto.data().size());
+  return false;
 }
 
 void TensorProto::proto_to_gxf_tensor(
     nvidia::gxf::Entity& gxf_entity,
     const google::protobuf::Map<std::string, ::holoscan::entity::Tensor>& tensor_map,
     nvidia::gxf::Handle<nvidia::gxf::Allocator>& allocator, const cudaStream_t cuda_stream) {
-  for (auto tensor_entry : tensor_map) {
+  bool on_device = false;
+  for (const auto& tensor_entry : tensor_map) {
     const holoscan::entity::Tensor& tensor_proto = tensor_entry.second;
-    auto tensor = gxf_entity.add<nvidia::gxf::Tensor>(tensor_entry.first.c_str());
-    if (!tensor) { throw std::runtime_error("Failed to create tensor"); }
-
-    nvidia::gxf::Shape shape({tensor_proto.dimensions().begin(), tensor_proto.dimensions().end()});
-    switch (tensor_proto.primitive_type()) {
-      case holoscan::entity::Tensor::kUnsigned8:
-        tensor.value()->reshape<uint8_t>(
-            shape, memory_storage_type(tensor_proto.memory_storage_type()), allocator);
-        copy_data_to_tensor<uint8_t>(tensor_proto, tensor.value(), cuda_stream);
-        break;
-      case holoscan::entity::Tensor::kUnsigned16:
-        tensor.value()->reshape<uint16_t>(
-            shape, memory_storage_type(tensor_proto.memory_storage_type()), allocator);
-        copy_data_to_tensor<uint16_t>(tensor_proto, tensor.value(), cuda_stream);
-        break;
-      case holoscan::entity::Tensor::kFloat32:
-        tensor.value()->reshape<float>(
-            shape, memory_storage_type(tensor_proto.memory_storage_type()), allocator);
-        copy_data_to_tensor<float>(tensor_proto, tensor.value(), cuda_stream);
-        break;
-      default:
-        throw std::runtime_error("Unsupported primitive type");
+
+    // Later chunks of a tensor land in the buffer allocated for its first chunk
+    auto tensor = gxf_entity.get<nvidia::gxf::Tensor>(tensor_entry.first.c_str());
+    if (!tensor) {
+      tensor = gxf_entity.add<nvidia::gxf::Tensor>(tensor_entry.first.c_str());
+      if (!tensor) { throw std::runtime_error("Failed to create tensor"); }
+
+      nvidia::gxf::Shape shape(
+          {tensor_proto.dimensions().begin(), tensor_proto.dimensions().end()});
+      const auto type = gxf_primitive_type(tensor_proto.primitive_type());
+      const uint64_t bytes_per_element = nvidia::gxf::PrimitiveTypeSize(type);
+      auto strides = nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element);
+      if (tensor_proto.strides_size() > 0) {
+        if (static_cast<uint32_t>(tensor_proto.strides_size()) != shape.rank()) {
+          throw std::runtime_error("Tensor strides don't match its rank");
+        }
+        std::copy(tensor_proto.strides().begin(), tensor_proto.strides().end(), strides.begin());
+      }
+
+      if (!tensor.value()->reshapeCustom(shape,
+                                         type,
+                                         bytes_per_element,
+                                         strides,
+                                         memory_storage_type(tensor_proto.memory_storage_type()),
+                                         allocator)) {
+        throw std::runtime_error("Failed to allocate tensor");
+      }
     }
+
+    on_device |= copy_data_to_tensor(tensor_proto, *tensor.value().get(), cuda_stream);
   }
+
+  // The message buffer is reused for the next read, so the copies must be done before returning
+  if (on_device) { CUDA_TRY(cudaStreamSynchronize(cuda_stream)); }
 }
+
 nvidia::gxf::MemoryStorageType TensorProto::memory_storage_type(
     holoscan::entity::Tensor_MemoryStorageType mem_storage_type) {
   switch (mem_storage_type) {
@@ -145,18 +192,71 @@ nvidia::gxf::MemoryStorageType TensorProto::memory_storage_type(
   }
 }
 
-template <typename T>
-void TensorProto::copy_data_to_tensor(const ::holoscan::entity::Tensor& tensor_proto,
-                                      nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor,
-                                      const cudaStream_t cuda_stream) {
-  if (tensor_proto.memory_storage_type() == holoscan::entity::Tensor::kDevice) {
-    CUDA_TRY(cudaMemcpyAsync((*tensor).pointer(),
-                             tensor_proto.data().data(),
-                             tensor_proto.data().size(),
-                             cudaMemcpyHostToDevice,
-                             cuda_stream));
-  } else {
-    std::copy(tensor_proto.data().begin(), tensor_proto.data().end(), (*tensor).pointer());
+holoscan::entity::Tensor_PrimitiveType TensorProto::proto_primitive_type(
+    nvidia::gxf::PrimitiveType type) {
+  switch (type) {
+    case nvidia::gxf::PrimitiveType::kInt8:
+      return holoscan::entity::Tensor::kInt8;
+    case nvidia::gxf::PrimitiveType::kUnsigned8:
+      return holoscan::entity::Tensor::kUnsigned8;
+    case nvidia::gxf::PrimitiveType::kInt16:
+      return holoscan::entity::Tensor::kInt16;
+    case nvidia::gxf::PrimitiveType::kUnsigned16:
+      return holoscan::entity::Tensor::kUnsigned16;
+    case nvidia::gxf::PrimitiveType::kInt32:
+      return holoscan::entity::Tensor::kInt32;
+    case nvidia::gxf::PrimitiveType::kUnsigned32:
+      return holoscan::entity::Tensor::kUnsigned32;
+    case nvidia::gxf::PrimitiveType::kInt64:
+      return holoscan::entity::Tensor::kInt64;
+    case nvidia::gxf::PrimitiveType::kUnsigned64:
+      return holoscan::entity::Tensor::kUnsigned64;
+    case nvidia::gxf::PrimitiveType::kFloat16:
+      return holoscan::entity::Tensor::kFloat16;
+    case nvidia::gxf::PrimitiveType::kFloat32:
+      return holoscan::entity::Tensor::kFloat32;
+    case nvidia::gxf::PrimitiveType::kFloat64:
+      return holoscan::entity::Tensor::kFloat64;
+    case nvidia::gxf::PrimitiveType::kComplex64:
+      return holoscan::entity::Tensor::kComplex64;
+    case nvidia::gxf::PrimitiveType::kComplex128:
+      return holoscan::entity::Tensor::kComplex128;
+    default:
+      throw std::runtime_error("Unsupported primitive type");
+  }
+}
+
+nvidia::gxf::PrimitiveType TensorProto::gxf_primitive_type(
+    holoscan::entity::Tensor_PrimitiveType type) {
+  switch (type) {
+    case holoscan::entity::Tensor::kInt8:
+      return nvidia::gxf::PrimitiveType::kInt8;
+    case holoscan::entity::Tensor::kUnsigned8:
+      return nvidia::gxf::PrimitiveType::kUnsigned8;
+    case holoscan::entity::Tensor::kInt16:
+      return nvidia::gxf::PrimitiveType::kInt16;
+    case holoscan::entity::Tensor::kUnsigned16:
+      return nvidia::gxf::PrimitiveType::kUnsigned16;
+    case holoscan::entity::Tensor::kInt32:
+      return nvidia::gxf::PrimitiveType::kInt32;
+    case holoscan::entity::Tensor::kUnsigned32:
+      return nvidia::gxf::PrimitiveType::kUnsigned32;
+    case holoscan::entity::Tensor::kInt64:
+      return nvidia::gxf::PrimitiveType::kInt64;
+    case holoscan::entity::Tensor::kUnsigned64:
+      return nvidia::gxf::PrimitiveType::kUnsigned64;
+    case holoscan::entity::Tensor::kFloat16:
+      return nvidia::gxf::PrimitiveType::kFloat16;
+    case holoscan::entity::Tensor::kFloat32:
+      return nvidia::gxf::PrimitiveType::kFloat32;
+    case holoscan::entity::Tensor::kFloat64:
+      return nvidia::gxf::PrimitiveType::kFloat64;
+    case holoscan::entity::Tensor::kComplex64:
+      return nvidia::gxf::PrimitiveType::kComplex64;
+    case holoscan::entity::Tensor::kComplex128:
+      return nvidia::gxf::PrimitiveType::kComplex128;
+    default:
+      throw std::runtime_error("Unsupported primitive type");
   }
 }
 
@@ -189,4 +289,58 @@ void TensorProto::entity_response_to_tensor(
   TensorProto::proto_to_gxf_tensor(
       gxf_entity, entity_response.tensors(), gxf_allocator, cuda_stream);
 }
+template <typename MessageT>
+void TensorProtoChunker<MessageT>::add(const nvidia::gxf::Entity& gxf_entity) {
+  if (!has_timestamp_) {
+    TensorProto::gxf_time_to_proto(gxf_entity, current_->mutable_timestamp());
+    has_timestamp_ = true;
+  }
+
+  auto tensors = gxf_entity.findAll<nvidia::gxf::Tensor, 4>();
+  if (!tensors) { throw std::runtime_error("Tensor not found"); }
+
+  for (auto tensor : tensors.value()) {
+    nvidia::gxf::Tensor& gxf_tensor = *tensor.value().get();
+    const size_t total = gxf_tensor.bytes_size();
+    size_t offset = 0;
+    do {
+      if (max_chunk_size_ > 0 && current_bytes_ >= max_chunk_size_) {
+        flush(false);
+      }
+
+      const size_t room = max_chunk_size_ > 0 ? max_chunk_size_ - current_bytes_ : total;
+      const size_t size = std::min(room, total - offset);
+      holoscan::entity::Tensor& tensor_proto = (*current_->mutable_tensors())[tensor->name()];
+      TensorProto::fill_tensor_metadata(gxf_tensor, tensor_proto);
+      tensor_proto.set_total_bytes(total);
+      tensor_proto.set_chunk_offset(offset);
+      TensorProto::copy_data_to_proto(gxf_tensor, offset, size, tensor_proto, cuda_stream_);
+      on_device_ |= gxf_tensor.storage_type() == nvidia::gxf::MemoryStorageType::kDevice;
+
+      current_bytes_ += size;
+      offset += size;
+    } while (offset < total);
+  }
+}
+
+template <typename MessageT>
+void TensorProtoChunker<MessageT>::finish() {
+  flush(true);
+}
+
+template <typename MessageT>
+void TensorProtoChunker<MessageT>::flush(bool last) {
+  // Device-to-host copies into the message are still in flight; host-only entities never touch
+  // the CUDA runtime so they can be sent from machines without a GPU
+  if (on_device_) { CUDA_TRY(cudaStreamSynchronize(cuda_stream_)); }
+  on_device_ = false;
+  current_->set_has_more_chunks(!last);
+  emit_(std::move(current_));
+  current_ = std::make_shared<MessageT>();
+  current_bytes_ = 0;
+}
+
+template class TensorProtoChunker<EntityRequest>;
+template class TensorProtoChunker<EntityResponse>;
+
 }  // namespace holoscan::ops
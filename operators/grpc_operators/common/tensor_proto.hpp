@@ -20,6 +20,7 @@
 
 #include <cuda_runtime.h>
 #include <gxf/std/tensor.hpp>
+#include <functional>
 #include <memory>
 
 #include <holoscan/core/operator.hpp>
@@ -68,6 +69,8 @@ class TensorProto {
    *
    * This function takes an EntityRequest object and converts it into a GXF tensor entity.
    * It uses the provided GXF allocator handle to allocate necessary resources.
+   * Messages of a chunked entity are passed in order with the same gxf_entity; tensors are
+   * allocated on their first chunk and every chunk is copied straight to its offset.
    *
    * @param entity_request Pointer to the EntityRequest object to be converted.
    * @param gxf_entity Reference to the GXF entity where the tensor will be stored.
@@ -83,7 +86,8 @@ class TensorProto {
    *
    * This function takes an EntityResponse object and converts it into a GXF tensor,
    * storing the result in the provided GXF entity. It also uses the specified GXF
-   * allocator for memory management.
+   * allocator for memory management. Chunked entities are handled as in
+   * entity_request_to_tensor().
    *
    * @param entity_request The EntityResponse object to be converted.
    * @param gxf_entity The GXF entity where the tensor will be stored.
@@ -95,14 +99,16 @@ class TensorProto {
                                         const cudaStream_t cuda_stream);
 
  private:
-  template <typename T>
-  static void copy_data_to_proto(const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor,
+  template <typename MessageT>
+  friend class TensorProtoChunker;
+
+  static void fill_tensor_metadata(nvidia::gxf::Tensor& tensor,
+                                   ::holoscan::entity::Tensor& tensor_proto);
+  static void copy_data_to_proto(nvidia::gxf::Tensor& tensor, size_t offset, size_t size,
                                  ::holoscan::entity::Tensor& tensor_proto,
                                  const cudaStream_t cuda_stream);
-  template <typename T>
-  static void copy_data_to_tensor(const ::holoscan::entity::Tensor& tensor_proto,
-                                  nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor,
-                                  const cudaStream_t cuda_stream);
+  static bool copy_data_to_tensor(const ::holoscan::entity::Tensor& tensor_proto,
+                                  nvidia::gxf::Tensor& tensor, const cudaStream_t cuda_stream);
   static void gxf_time_to_proto(const nvidia::gxf::Entity& gxf_entity,
                                 ::holoscan::entity::Timestamp* timestamp);
   static void gxf_tensor_to_proto(
@@ -117,6 +123,54 @@ class TensorProto {
       nvidia::gxf::Handle<nvidia::gxf::Allocator>& allocator, const cudaStream_t cuda_stream);
   static nvidia::gxf::MemoryStorageType memory_storage_type(
       holoscan::entity::Tensor_MemoryStorageType mem_storage_type);
+  static holoscan::entity::Tensor_PrimitiveType proto_primitive_type(
+      nvidia::gxf::PrimitiveType type);
+  static nvidia::gxf::PrimitiveType gxf_primitive_type(
+      holoscan::entity::Tensor_PrimitiveType type);
+};
+
+/**
+ * @class TensorProtoChunker
+ * @brief Splits GXF entities into a sequence of stream messages of bounded size.
+ *
+ * Tensors are copied straight from their GXF buffers into the protobuf messages. Each message is
+ * handed to the callback as soon as it holds max_chunk_size bytes of tensor data, so the first
+ * part of a large frame can be sent while the rest is still being encoded. All messages but the
+ * last have has_more_chunks set; a receiver passes them in order to
+ * entity_request_to_tensor()/entity_response_to_tensor() with the same GXF entity.
+ *
+ * A max_chunk_size of 0 disables splitting and produces a single message.
+ *
+ * @tparam MessageT EntityRequest or EntityResponse.
+ */
+template <typename MessageT>
+class TensorProtoChunker {
+ public:
+  using emit_callback = std::function<void(std::shared_ptr<MessageT>)>;
+
+  TensorProtoChunker(size_t max_chunk_size, const cudaStream_t cuda_stream, emit_callback emit)
+      : max_chunk_size_(max_chunk_size), cuda_stream_(cuda_stream), emit_(std::move(emit)) {}
+
+  /**
+   * @brief Adds the timestamp (of the first entity only) and the tensors of a GXF entity.
+   */
+  void add(const nvidia::gxf::Entity& gxf_entity);
+
+  /**
+   * @brief Emits the last message of the sequence.
+   */
+  void finish();
+
+ private:
+  void flush(bool last);
+
+  size_t max_chunk_size_;
+  cudaStream_t cuda_stream_;
+  emit_callback emit_;
+  std::shared_ptr<MessageT> current_ = std::make_shared<MessageT>();
+  size_t current_bytes_ = 0;
+  bool has_timestamp_ = false;
+  bool on_device_ = false;
 };
 
 }  // namespace holoscan::ops
@@ -27,5 +27,6 @@
 #include "server/grpc_application.hpp"
 #include "server/grpc_server_request.hpp"
 #include "server/grpc_server_response.hpp"
+#include "server/session_multiplexer.hpp"
 
 #endif /* GRPC_SERVER_HPP */
@@ -17,6 +17,8 @@
 
 #include "application_factory.hpp"
 
+#include <algorithm>
+
 namespace holoscan::ops {
 
 ApplicationFactory::ApplicationFactory() {
@@ -35,45 +37,105 @@ std::shared_ptr<ApplicationFactory> ApplicationFactory::get_instance() {
 }
 
 void ApplicationFactory::register_application(const std::string& service_name,
-                                              create_application_instance_func func) {
-  if (application_registry_.find(service_name) != application_registry_.end()) {
+                                              create_application_instance_func func,
+                                              ApplicationPoolOptions options) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (services_.find(service_name) != services_.end()) {
     HOLOSCAN_LOG_WARN("Overwriting existing application registry: {}", service_name);
   }
-  application_registry_[service_name] = func;
+
+  options.max_instances = std::max({options.max_instances, options.warm_instances, 1U});
+  options.max_sessions_per_instance = std::max(options.max_sessions_per_instance, 1U);
+
+  auto& pool = services_[service_name];
+  pool.func = func;
+  pool.options = options;
+  for (uint32_t i = pool.instances.size(); i < options.warm_instances; i++) {
+    start_instance(service_name, pool, true);
+  }
 }
 
 std::shared_ptr<HoloscanGrpcApplication> ApplicationFactory::create_application_instance(
-    const std::string& service_name,
-    std::queue<std::shared_ptr<nvidia::gxf::Entity>>& incoming_request_queue,
-    std::queue<std::shared_ptr<EntityResponse>>& outgoing_response_queue) {
-  if (application_registry_.find(service_name) == application_registry_.end()) {
+    const std::string& service_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = services_.find(service_name);
+  if (it == services_.end()) {
     HOLOSCAN_LOG_ERROR("Application not found in registry: {}", service_name);
     return nullptr;
   }
+  auto& pool = it->second;
 
-  if (application_instances_.find(service_name) != application_instances_.end()) {
-    HOLOSCAN_LOG_WARN("Another application instance is running: {}", service_name);
-    return nullptr;
+  // Forget instances whose application has exited on its own
+  pool.instances.erase(
+      std::remove_if(pool.instances.begin(),
+                     pool.instances.end(),
+                     [&service_name](PooledInstance& instance) {
+                       if (instance.application.future.wait_for(std::chrono::seconds(0)) !=
+                           std::future_status::ready) {
+                         return false;
+                       }
+                       HOLOSCAN_LOG_WARN("Application instance for {} has exited", service_name);
+                       return true;
+                     }),
+      pool.instances.end());
+
+  PooledInstance* chosen = nullptr;
+  for (auto& instance : pool.instances) {
+    if (instance.sessions < pool.options.max_sessions_per_instance &&
+        (chosen == nullptr || instance.sessions < chosen->sessions)) {
+      chosen = &instance;
+    }
   }
 
-  HOLOSCAN_LOG_INFO("Creating application instance for {}", service_name);
+  if (chosen == nullptr) {
+    if (pool.instances.size() >= pool.options.max_instances) {
+      HOLOSCAN_LOG_WARN("All application instances are busy: {}", service_name);
+      return nullptr;
+    }
+    chosen = &start_instance(service_name, pool, false);
+  }
 
-  create_application_instance_func func = application_registry_[service_name];
-  application_instances_[service_name] = func(incoming_request_queue, outgoing_response_queue);
-  application_instances_[service_name].instance->start_streaming();
-  return application_instances_[service_name].instance;
+  chosen->sessions++;
+  HOLOSCAN_LOG_INFO("Assigned {} session to an instance serving {} sessions",
+                    service_name,
+                    chosen->sessions);
+  return chosen->application.instance;
 }
 
 void ApplicationFactory::destroy_application_instance(
     std::shared_ptr<HoloscanGrpcApplication> application_instance) {
-  for (auto& [service_name, instance] : application_instances_) {
-    if (instance.instance == application_instance) {
-      instance.instance->stop_streaming();
-      instance.future.wait_for(std::chrono::seconds(1));
-      application_instances_.erase(service_name);
-      HOLOSCAN_LOG_INFO("Application instance deleted for {}", service_name);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [service_name, pool] : services_) {
+    for (auto it = pool.instances.begin(); it != pool.instances.end(); ++it) {
+      if (it->application.instance != application_instance) { continue; }
+
+      if (it->sessions > 0) { it->sessions--; }
+      if (it->sessions == 0 && !it->warm) {
+        stop_instance(*it);
+        pool.instances.erase(it);
+        HOLOSCAN_LOG_INFO("Application instance deleted for {}", service_name);
+      }
       return;
     }
   }
 }
+
+ApplicationFactory::PooledInstance& ApplicationFactory::start_instance(
+    const std::string& service_name, ServicePool& pool, bool warm) {
+  HOLOSCAN_LOG_INFO("Creating {}application instance for {}", warm ? "warm " : "", service_name);
+  PooledInstance instance;
+  instance.application = pool.func();
+  instance.warm = warm;
+  // Warm instances keep streaming enabled while idle; disabling every operator would let the
+  // scheduler stop the application on deadlock
+  instance.application.instance->start_streaming();
+  pool.instances.push_back(std::move(instance));
+  return pool.instances.back();
+}
+
+void ApplicationFactory::stop_instance(PooledInstance& instance) {
+  instance.application.instance->stop_streaming();
+  instance.application.future.wait_for(std::chrono::seconds(1));
+}
+
 }  // namespace holoscan::ops
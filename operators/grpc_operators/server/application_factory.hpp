@@ -19,8 +19,12 @@
 #define SERVER_APPLICATION_FACTORY_HPP
 
 #include <functional>
+#include <future>
+#include <map>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include <gxf/core/entity.hpp>
 #include <holoscan/holoscan.hpp>
@@ -56,12 +60,35 @@ struct ApplicationInstance {
  * @typedef create_application_instance_func
  * @brief A function type for creating an instance of a Holoscan application.
  *
- * This function type takes a queue of incoming requests and a queue of outgoing responses
- * and returns an ApplicationInstance object.
+ * This function type composes and starts a new application and returns an ApplicationInstance
+ * object.
  */
-using create_application_instance_func = std::function<ApplicationInstance(
-    std::queue<std::shared_ptr<nvidia::gxf::Entity>> incoming_request_queue,
-    std::queue<std::shared_ptr<EntityResponse>> outgoing_response_queue)>;
+using create_application_instance_func = std::function<ApplicationInstance()>;
+
+/**
+ * @struct ApplicationPoolOptions
+ * @brief Controls how RPC sessions of a service are spread over application instances.
+ *
+ * The defaults start an instance for each RPC on demand, give it to that RPC alone, and allow a
+ * single instance, so a second concurrent RPC is rejected.
+ *
+ * @var ApplicationPoolOptions::warm_instances
+ * Instances composed and started when the service is registered. They stay up while idle so a new
+ * RPC doesn't wait for the pipeline to be built.
+ *
+ * @var ApplicationPoolOptions::max_instances
+ * Most instances running at once, including warm ones. Instances above warm_instances are started
+ * on demand and stopped when their last session ends.
+ *
+ * @var ApplicationPoolOptions::max_sessions_per_instance
+ * Most RPC sessions sharing one instance. Only raise it for pipelines that keep no per-stream
+ * state between requests.
+ */
+struct ApplicationPoolOptions {
+  uint32_t warm_instances = 0;
+  uint32_t max_instances = 1;
+  uint32_t max_sessions_per_instance = 1;
+};
 
 /**
  * @class ApplicationFactory
@@ -73,6 +100,8 @@ using create_application_instance_func = std::function<ApplicationInstance(
  *
  * Register each gRPC service with a Holoscan application with the Application Factory.
  * This decouples the application creation from the gRPC service and the application pipeline.
+ * Each service keeps a pool of instances configured with ApplicationPoolOptions; a new RPC is
+ * given the least loaded instance with a free session slot.
  *
  * @note Copy constructor and assignment operator are deleted to prevent copying.
  */
@@ -92,29 +121,36 @@ class ApplicationFactory {
   /**
    * @brief Register an application creation function with a service name.
    *
+   * Starts options.warm_instances instances right away.
+   *
    * @param service_name The name of the service.
    * @param func The function to create an application instance.
+   * @param options How sessions of the service are spread over instances.
    */
-  void register_application(const std::string& service_name, create_application_instance_func func);
+  void register_application(const std::string& service_name, create_application_instance_func func,
+                            ApplicationPoolOptions options = {});
 
   /**
-   * @brief Create an instance of HoloscanGrpcApplication.
+   * @brief Get an instance of HoloscanGrpcApplication for a new RPC session.
+   *
+   * Returns the least loaded running instance with a free session slot, or starts a new one if
+   * max_instances allows.
    *
    * @param service_name The name of the service.
-   * @param incoming_request_queue A queue for incoming requests.
-   * @param outgoing_response_queue A queue for outgoing responses.
-   * @return A shared pointer to the created HoloscanGrpcApplication instance.
+   * @return A shared pointer to the HoloscanGrpcApplication instance, or nullptr if every
+   * instance is full.
    */
   std::shared_ptr<HoloscanGrpcApplication> create_application_instance(
-      const std::string& service_name,
-      std::queue<std::shared_ptr<nvidia::gxf::Entity>>& incoming_request_queue,
-      std::queue<std::shared_ptr<EntityResponse>>& outgoing_response_queue);
+      const std::string& service_name);
 
   /**
-   * @brief Destroy an instance of HoloscanGrpcApplication.
+   * @brief Release an instance of HoloscanGrpcApplication at the end of an RPC session.
+   *
+   * The instance is stopped and destroyed once it has no sessions left, unless it is one of the
+   * warm instances.
    *
    * @param application_instance A shared pointer to the HoloscanGrpcApplication instance to be
-   * destroyed.
+   * released.
    */
   void destroy_application_instance(std::shared_ptr<HoloscanGrpcApplication> application_instance);
 
@@ -131,11 +167,26 @@ class ApplicationFactory {
     void operator()(ApplicationFactory* factory) { delete factory; }
   };
 
+  struct PooledInstance {
+    ApplicationInstance application;
+    uint32_t sessions = 0;
+    bool warm = false;
+  };
+
+  struct ServicePool {
+    create_application_instance_func func;
+    ApplicationPoolOptions options;
+    std::vector<PooledInstance> instances;
+  };
+
   ApplicationFactory();
   ~ApplicationFactory();
 
-  std::map<std::string, create_application_instance_func> application_registry_;
-  std::map<std::string, ApplicationInstance> application_instances_;
+  PooledInstance& start_instance(const std::string& service_name, ServicePool& pool, bool warm);
+  static void stop_instance(PooledInstance& instance);
+
+  std::mutex mutex_;
+  std::map<std::string, ServicePool> services_;
 };
 }  // namespace holoscan::ops
 #endif /* SERVER_APPLICATION_FACTORY_HPP */
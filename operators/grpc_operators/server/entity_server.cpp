@@ -19,6 +19,11 @@
 
 namespace holoscan::ops {
 
+namespace {
+// How long the writer thread sleeps waiting for a response before re-checking the RPC timeout
+constexpr auto kWriterPollInterval = std::chrono::milliseconds(100);
+}  // namespace
+
 HoloscanEntityServiceImpl::HoloscanEntityServiceImpl(
     on_new_entity_stream_rpc new_entity_stream_rpc,
     on_entity_stream_rpc_complete entity_stream_rpc_complete)
@@ -28,14 +33,8 @@ HoloscanEntityServiceImpl::HoloscanEntityServiceImpl(
 grpc::ServerBidiReactor<EntityRequest, EntityResponse>* HoloscanEntityServiceImpl::EntityStream(
     CallbackServerContext* context) {
   HOLOSCAN_LOG_INFO("grpc server: EntityStreamInternal - new RPC received");
-  std::queue<std::shared_ptr<nvidia::gxf::Entity>> incoming_request_queue;
-  std::queue<std::shared_ptr<EntityResponse>> outgoing_response_queue;
-  auto client = context->client_metadata();
-  auto auth = context->auth_context();
   return new EntityStreamInternal(
-      this,
-      new_entity_stream_rpc_("EntityStream", incoming_request_queue, outgoing_response_queue),
-      entity_stream_rpc_complete_);
+      this, new_entity_stream_rpc_("EntityStream"), entity_stream_rpc_complete_);
 }
 
 HoloscanEntityServiceImpl::EntityStreamInternal::EntityStreamInternal(
@@ -45,9 +44,9 @@ HoloscanEntityServiceImpl::EntityStreamInternal::EntityStreamInternal(
   if (app == nullptr) {
     Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Resource occupied"));
   } else {
+    session_ = app_->open_session();
     last_network_activity_ = std::chrono::time_point<std::chrono::system_clock>::min();
     writer_thread_ = std::thread(&EntityStreamInternal::processOutgoingQueue, this);
-    Write();
     Read();
   }
 }
@@ -60,13 +59,16 @@ HoloscanEntityServiceImpl::EntityStreamInternal::~EntityStreamInternal() {
 void HoloscanEntityServiceImpl::EntityStreamInternal::OnWriteDone(bool ok) {
   last_network_activity_ = std::chrono::high_resolution_clock::now();
   if (!ok) { HOLOSCAN_LOG_WARN("grpc server: write failed, error writing response"); }
-  write_mutex_.unlock();
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  write_in_flight_ = false;
+  pending_response_.reset();
+  write_cv_.notify_one();
 }
 
 void HoloscanEntityServiceImpl::EntityStreamInternal::OnReadDone(bool ok) {
   last_network_activity_ = std::chrono::high_resolution_clock::now();
   if (ok) {
-    app_->enqueue_request(request_);
+    app_->enqueue_request(session_, request_);
     HOLOSCAN_LOG_DEBUG("grpc server: Request received and queued for processing");
     Read();
   } else {
@@ -76,6 +78,13 @@ void HoloscanEntityServiceImpl::EntityStreamInternal::OnReadDone(bool ok) {
 
 void HoloscanEntityServiceImpl::EntityStreamInternal::OnDone() {
   HOLOSCAN_LOG_DEBUG("grpc server: server streaming complete");
+  // Closing the session also wakes the writer thread if it is waiting for a response
+  if (app_) { app_->close_session(session_); }
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    finished_ = true;
+    write_cv_.notify_one();
+  }
   entity_stream_rpc_complete_(app_);
   delete this;
 }
@@ -85,24 +94,38 @@ void HoloscanEntityServiceImpl::EntityStreamInternal::Read() {
   StartRead(&request_);
 }
 
-void HoloscanEntityServiceImpl::EntityStreamInternal::Write() {
-  if (app_->is_response_available()) {
-    write_mutex_.lock();
-    std::shared_ptr<EntityResponse> response;
-    response = app_->dequeue_response();
-    StartWrite(&*response);
-    HOLOSCAN_LOG_DEBUG("grpc server: Sending response to client");
-  }
-}
-
 void HoloscanEntityServiceImpl::EntityStreamInternal::processOutgoingQueue() {
+  // One outstanding write per stream: wait for OnWriteDone() before taking the next response.
+  // Neither wait spins; the thread wakes every kWriterPollInterval to check the RPC timeout.
   while (true) {
+    {
+      std::unique_lock<std::mutex> lock(write_mutex_);
+      write_cv_.wait(lock, [this] { return !write_in_flight_ || finished_; });
+      if (finished_) { break; }
+    }
+
     if (processing_timed_out()) {
-      HOLOSCAN_LOG_DEBUG("grpc server: sending finish event");
-      Finish(grpc::Status::OK);
+      std::unique_lock<std::mutex> lock(write_mutex_);
+      if (!finished_) {
+        HOLOSCAN_LOG_DEBUG("grpc server: sending finish event");
+        finished_ = true;
+        lock.unlock();
+        Finish(grpc::Status::OK);
+      }
       break;
     }
-    Write();
+
+    auto response = app_->dequeue_response(session_, kWriterPollInterval);
+    if (!response) { continue; }
+
+    {
+      std::lock_guard<std::mutex> lock(write_mutex_);
+      if (finished_) { break; }
+      write_in_flight_ = true;
+      pending_response_ = std::move(response);
+    }
+    StartWrite(pending_response_.get());
+    HOLOSCAN_LOG_DEBUG("grpc server: Sending response to client");
   }
 }
 
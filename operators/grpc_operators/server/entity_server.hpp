@@ -23,6 +23,7 @@
 #include <grpc/grpc.h>
 #include <grpcpp/grpcpp.h>
 #include <algorithm>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <string>
@@ -46,16 +47,13 @@ namespace holoscan::ops {
 
 /**
  * @typedef on_new_entity_stream_rpc
- * @brief Callback function type to create a new instance of a Holoscan application.
+ * @brief Callback function type to get an instance of a Holoscan application for a new RPC.
  * @param std::string& The name of the application.
- * @param std::queue<std::shared_ptr<nvidia::gxf::Entity>>& Output messages.
- * @param std::queue<std::shared_ptr<EntityResponse>>& Incoming messages.
- * @return std::shared_ptr<HoloscanGrpcApplication> Shared pointer to the created Holoscan
- * application.
+ * @return std::shared_ptr<HoloscanGrpcApplication> Shared pointer to the Holoscan application, or
+ * nullptr if none is available. The RPC attaches to it as a new session.
  */
-using on_new_entity_stream_rpc = std::function<std::shared_ptr<HoloscanGrpcApplication>(
-    const std::string&, std::queue<std::shared_ptr<nvidia::gxf::Entity>>&,
-    std::queue<std::shared_ptr<EntityResponse>>&)>;
+using on_new_entity_stream_rpc =
+    std::function<std::shared_ptr<HoloscanGrpcApplication>(const std::string&)>;
 
 /**
  * @typedef on_entity_stream_rpc_complete
@@ -106,19 +104,24 @@ class HoloscanEntityServiceImpl final : public Entity::CallbackService {
 
    private:
     void Read();
-    void Write();
     void processOutgoingQueue();
     bool processing_timed_out();
 
     std::shared_ptr<HoloscanGrpcApplication> app_;
+    SessionId session_ = 0;
     on_entity_stream_rpc_complete entity_stream_rpc_complete_;
     HoloscanEntityServiceImpl* server_;
     EntityRequest request_;
     std::chrono::time_point<std::chrono::system_clock> last_network_activity_;
     bool is_read_done_ = false;
 
-    // std::mutex read_mutex_;
+    // Guards the writer state below. The writer thread sleeps on write_cv_ while a write is in
+    // flight and on the session's response queue while there is nothing to send.
     std::mutex write_mutex_;
+    std::condition_variable write_cv_;
+    bool write_in_flight_ = false;
+    bool finished_ = false;
+    std::shared_ptr<EntityResponse> pending_response_;
     std::thread writer_thread_;
   };
 
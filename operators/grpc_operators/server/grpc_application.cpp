@@ -19,13 +19,10 @@
 
 namespace holoscan::ops {
 
-HoloscanGrpcApplication::HoloscanGrpcApplication(
-    std::queue<std::shared_ptr<nvidia::gxf::Entity>>& incoming_request_queue,
-    std::queue<std::shared_ptr<EntityResponse>>& outgoing_response_queue) {
-  request_queue = make_resource<ConditionVariableQueue<std::shared_ptr<nvidia::gxf::Entity>>>(
-      "request_queue", incoming_request_queue);
-  response_queue = make_resource<ConditionVariableQueue<std::shared_ptr<EntityResponse>>>(
-      "response_queue", outgoing_response_queue);
+HoloscanGrpcApplication::HoloscanGrpcApplication() {
+  // Results are routed to their sessions by metadata carried through the pipeline
+  enable_metadata(true);
+  sessions = make_resource<SessionMultiplexer>("sessions");
   streaming_enabled = make_condition<BooleanCondition>("streaming_enabled");
 }
 
@@ -34,13 +31,15 @@ void HoloscanGrpcApplication::compose() {
       "grpc_request_op",
       streaming_enabled,
       make_condition<PeriodicCondition>("periodic-condition",
-                                        Arg("recess_period") = std::string("60hz")),
-      Arg("request_queue") = request_queue,
+                                        Arg("recess_period") = request_rate_),
+      Arg("sessions") = sessions,
       Arg("allocator") = make_resource<UnboundedAllocator>("pool"),
       from_config("grpc_server"));
 
   grpc_response_op = make_operator<GrpcServerResponseOp>(
-      "grpc_response_op", streaming_enabled, Arg("response_queue") = response_queue);
+      "grpc_response_op", streaming_enabled, Arg("sessions") = sessions);
+  // Inputs of different ticks must never be merged into one result
+  grpc_response_op->metadata_policy(MetadataPolicy::kRaise);
 }
 
 void HoloscanGrpcApplication::set_scheduler(const std::string& config_name) {
@@ -52,28 +51,57 @@ void HoloscanGrpcApplication::set_data_path(const std::string path) {
   data_path = path;
 }
 
-void HoloscanGrpcApplication::enqueue_request(const EntityRequest& request) {
-  auto gxf_allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
-      executor().context(), grpc_request_op->allocator()->gxf_cid());
-  auto out_message = nvidia::gxf::Entity::New(executor().context());
+void HoloscanGrpcApplication::set_request_rate(const std::string& rate) {
+  request_rate_ = rate;
+}
 
-  holoscan::ops::TensorProto::entity_request_to_tensor(
-      &request, out_message.value(), gxf_allocator.value(), grpc_request_op->get_cuda_stream());
+SessionId HoloscanGrpcApplication::open_session() {
+  return sessions->add_session();
+}
 
-  auto entity = std::make_shared<nvidia::gxf::Entity>(out_message.value());
-  request_queue->push(entity);
+void HoloscanGrpcApplication::close_session(SessionId session) {
+  sessions->remove_session(session);
+  std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+  pending_requests_.erase(session);
 }
 
-void HoloscanGrpcApplication::enqueue_response(std::shared_ptr<EntityResponse> response) {
-  response_queue->push(response);
+size_t HoloscanGrpcApplication::session_count() {
+  return sessions->session_count();
 }
 
-bool HoloscanGrpcApplication::is_response_available() {
-  return !response_queue->empty();
+void HoloscanGrpcApplication::enqueue_request(SessionId session, const EntityRequest& request) {
+  auto gxf_allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+      executor().context(), grpc_request_op->allocator()->gxf_cid());
+
+  // Each session's reads are sequential, so only the map itself needs the lock
+  std::shared_ptr<nvidia::gxf::Entity> pending;
+  {
+    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+    pending = pending_requests_[session];
+  }
+  if (!pending) {
+    auto out_message = nvidia::gxf::Entity::New(executor().context());
+    pending = std::make_shared<nvidia::gxf::Entity>(out_message.value());
+  }
+
+  holoscan::ops::TensorProto::entity_request_to_tensor(
+      &request, *pending, gxf_allocator.value(), grpc_request_op->get_cuda_stream());
+
+  // A chunked request is queued once its last chunk has been copied in
+  {
+    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+    if (request.has_more_chunks()) {
+      pending_requests_[session] = pending;
+      return;
+    }
+    pending_requests_.erase(session);
+  }
+  sessions->push_request(session, std::move(pending));
 }
 
-std::shared_ptr<EntityResponse> HoloscanGrpcApplication::dequeue_response() {
-  return response_queue->pop();
+std::shared_ptr<EntityResponse> HoloscanGrpcApplication::dequeue_response(
+    SessionId session, std::chrono::milliseconds timeout) {
+  return sessions->pop_response(session, timeout);
 }
 
 const uint32_t HoloscanGrpcApplication::rpc_timeout() {
@@ -18,11 +18,16 @@
 #ifndef SERVER_GRPC_APPLICATION_HPP
 #define SERVER_GRPC_APPLICATION_HPP
 
+#include <chrono>
+#include <map>
+#include <mutex>
+
 #include <gxf/app/graph_entity.hpp>
 #include <holoscan/holoscan.hpp>
 
 #include "grpc_server_request.hpp"
 #include "grpc_server_response.hpp"
+#include "session_multiplexer.hpp"
 
 #include "../common/tensor_proto.hpp"
 
@@ -38,8 +43,9 @@ namespace holoscan::ops {
  * A class extends the holoscan::Application and provides functionalities
  * to handle gRPC requests and responses using queues.
  *
- * This base class creates `incoming_request_queue` and `outgoing_response_queue` queues that can
- * be used by the derived classes to handle incoming requests and outgoing responses.
+ * This base class creates a `sessions` SessionMultiplexer that holds the incoming requests and
+ * outgoing responses of each RPC session attached to the application. One application instance may
+ * serve several sessions at once when the ApplicationFactory is configured to share it.
  *
  * The `streaming_enabled` BooleanCondition can be added to all operators to know when an RPC call
  * is active or not.
@@ -48,8 +54,7 @@ namespace holoscan::ops {
  */
 class HoloscanGrpcApplication : public holoscan::Application {
  public:
-  HoloscanGrpcApplication(std::queue<std::shared_ptr<nvidia::gxf::Entity>>& incoming_request_queue,
-                          std::queue<std::shared_ptr<EntityResponse>>& outgoing_response_queue);
+  HoloscanGrpcApplication();
 
   /**
    * @brief Composes the gRPC application by setting up necessary components and configurations.
@@ -82,49 +87,54 @@ class HoloscanGrpcApplication : public holoscan::Application {
   void set_data_path(const std::string path);
 
   /**
-   * @brief Enqueues an EntityRequest for processing.
+   * @brief Sets how often the `grpc_request_op` operator polls for queued requests.
    *
-   * This function takes an EntityRequest object and adds it to the queue
-   * for further processing. The queued items will be processed by the `GrpcServerRequestOp`
-   * operator.
+   * Must be called before the application runs. The default of 60hz suits video pipelines; a
+   * higher rate lowers the time a request waits in the queue at the cost of more idle ticks.
    *
-   * @param request The entity request to be enqueued.
+   * @param rate The rate in a form accepted by PeriodicCondition, e.g. "60hz" or "2ms".
    */
-  void enqueue_request(const EntityRequest& request);
+  void set_request_rate(const std::string& rate);
 
   /**
-   * @brief Enqueues an EntityResponse to be sent to the client.
+   * @brief Attaches a new RPC session to the application.
    *
-   * This function adds the provided response to the queue of responses
-   * that will be sent to the client.
-   *
-   * @param response A shared pointer to the EntityResponse object that
-   *                 needs to be enqueued.
+   * @return The id used for the session's requests and responses.
+   */
+  SessionId open_session();
+
+  /**
+   * @brief Detaches an RPC session, dropping its queued requests and responses.
    */
-  void enqueue_response(std::shared_ptr<EntityResponse> response);
+  void close_session(SessionId session);
 
   /**
-   * @brief Checks if a response is available.
+   * @brief Returns the number of RPC sessions attached to the application.
+   */
+  size_t session_count();
+
+  /**
+   * @brief Enqueues an EntityRequest for processing.
    *
-   * This function determines whether a response is currently available
-   * for processing or retrieval.
+   * This function converts an EntityRequest object and adds it to the session's queue
+   * for further processing. The queued items will be processed by the `GrpcServerRequestOp`
+   * operator. Chunks of a request are assembled until the last one arrives.
    *
-   * @return true if a response is available, false otherwise.
+   * @param session The session the request was received on.
+   * @param request The entity request to be enqueued.
    */
-  bool is_response_available();
+  void enqueue_request(SessionId session, const EntityRequest& request);
 
   /**
-   * @brief Dequeues a response from the internal queue.
+   * @brief Dequeues a response of a session.
    *
-   * This function retrieves and removes the next available response from the
-   * internal queue of responses. If the queue is empty, the function is blcocked until a response
-   * is available.
+   * Waits up to timeout for the next response to be sent on the session.
    *
-   * @return A shared pointer to an EntityResponse object, representing the
-   *         dequeued response. If the queue is empty, the returned pointer
-   *         may be null.
+   * @return A shared pointer to an EntityResponse object, or nullptr if none arrived in time or
+   *         the session was closed.
    */
-  std::shared_ptr<EntityResponse> dequeue_response();
+  std::shared_ptr<EntityResponse> dequeue_response(SessionId session,
+                                                   std::chrono::milliseconds timeout);
 
   /**
    * @brief Retrieves the RPC call timeout value.
@@ -154,10 +164,16 @@ class HoloscanGrpcApplication : public holoscan::Application {
  protected:
   std::shared_ptr<GrpcServerRequestOp> grpc_request_op;
   std::shared_ptr<GrpcServerResponseOp> grpc_response_op;
-  std::shared_ptr<ConditionVariableQueue<std::shared_ptr<nvidia::gxf::Entity>>> request_queue;
-  std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityResponse>>> response_queue;
+  std::shared_ptr<SessionMultiplexer> sessions;
   std::shared_ptr<BooleanCondition> streaming_enabled;
   std::string data_path;
+
+ private:
+  std::string request_rate_ = "60hz";
+
+  // Entities being assembled from chunked requests, per session
+  std::mutex pending_requests_mutex_;
+  std::map<SessionId, std::shared_ptr<nvidia::gxf::Entity>> pending_requests_;
 };
 
 }  // namespace holoscan::ops
@@ -17,10 +17,46 @@
 
 #include "grpc_server_request.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 namespace holoscan::ops {
 
+#ifndef CUDA_TRY
+#define CUDA_TRY(stmt)                                                                     \
+  ({                                                                                       \
+    cudaError_t _holoscan_cuda_err = stmt;                                                 \
+    if (cudaSuccess != _holoscan_cuda_err) {                                               \
+      GXF_LOG_ERROR("CUDA Runtime call %s in line %d of file %s failed with '%s' (%d).\n", \
+                    #stmt,                                                                 \
+                    __LINE__,                                                              \
+                    __FILE__,                                                              \
+                    cudaGetErrorString(_holoscan_cuda_err),                                \
+                    _holoscan_cuda_err);                                                   \
+    }                                                                                      \
+    _holoscan_cuda_err;                                                                    \
+  })
+#endif
+
+namespace {
+bool is_packed(nvidia::gxf::Tensor& tensor) {
+  const auto strides =
+      nvidia::gxf::ComputeTrivialStrides(tensor.shape(), tensor.bytes_per_element());
+  for (uint32_t i = 0; i < tensor.rank(); i++) {
+    if (tensor.stride(i) != strides[i]) { return false; }
+  }
+  return true;
+}
+}  // namespace
+
 void GrpcServerRequestOp::setup(OperatorSpec& spec) {
-  spec.param(request_queue_, "request_queue", "Request Queue", "Incoming gRPC requests.");
+  spec.param(sessions_, "sessions", "Sessions", "Incoming gRPC requests of each session.");
+  spec.param(max_batch_size_,
+             "max_batch_size",
+             "Max batch size",
+             "Most requests from different sessions combined into one tick.",
+             1U);
   spec.param(allocator_,
              "allocator",
              "Allocator",
@@ -38,13 +74,111 @@ void GrpcServerRequestOp::setup(OperatorSpec& spec) {
 
 void GrpcServerRequestOp::compute(InputContext& op_input, OutputContext& op_output,
                                   ExecutionContext& context) {
-  if (!request_queue_->empty()) {
-    auto request = request_queue_->pop();
-    auto result = nvidia::gxf::Entity(std::move(*request));
+  const uint32_t max_batch = std::max(max_batch_size_.get(), 1U);
+  TickId tick = 0;
+  auto batch = sessions_->next_batch(max_batch, tick, max_batch > 1 ? batch_compatible : nullptr);
+  if (batch.empty()) { return; }
+
+  // The tick travels with the data so that GrpcServerResponseOp can find its sessions
+  metadata()->set(kTickMetadataKey, tick);
+
+  if (batch.size() == 1) {
+    auto result = nvidia::gxf::Entity(std::move(*batch.front().second));
+    op_output.emit(result, "output");
+  } else {
+    HOLOSCAN_LOG_DEBUG("grpc server: batching {} requests", batch.size());
+    auto result = batch_requests(batch);
     op_output.emit(result, "output");
   }
 }
 
+bool GrpcServerRequestOp::batch_compatible(nvidia::gxf::Entity& first,
+                                           nvidia::gxf::Entity& candidate) {
+  auto first_tensors = first.findAll<nvidia::gxf::Tensor, 4>();
+  auto candidate_tensors = candidate.findAll<nvidia::gxf::Tensor, 4>();
+  if (!first_tensors || !candidate_tensors ||
+      first_tensors->size() != candidate_tensors->size()) {
+    return false;
+  }
+
+  for (auto tensor : first_tensors.value()) {
+    auto other = candidate.get<nvidia::gxf::Tensor>(tensor->name());
+    if (!other) { return false; }
+    nvidia::gxf::Tensor& a = *tensor.value().get();
+    nvidia::gxf::Tensor& b = *other.value().get();
+    // The batch adds a dimension, and each request is copied as one contiguous block
+    if (a.rank() >= nvidia::gxf::Shape::kMaxRank || a.shape() != b.shape() ||
+        a.element_type() != b.element_type() || a.storage_type() != b.storage_type() ||
+        !is_packed(a) || !is_packed(b)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+nvidia::gxf::Entity GrpcServerRequestOp::batch_requests(
+    const std::vector<SessionMultiplexer::Request>& batch) {
+  auto context = fragment()->executor().context();
+  auto allocator =
+      nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context, allocator_->gxf_cid());
+  if (!allocator) { throw std::runtime_error("Failed to create GXF allocator"); }
+  auto batched = nvidia::gxf::Entity::New(context);
+  if (!batched) { throw std::runtime_error("Failed to create GXF entity"); }
+
+  nvidia::gxf::Entity& first = *batch.front().second;
+  if (auto timestamp = first.get<nvidia::gxf::Timestamp>()) {
+    auto out_timestamp = batched->add<nvidia::gxf::Timestamp>("timestamp");
+    (*out_timestamp)->acqtime = (*timestamp)->acqtime;
+    (*out_timestamp)->pubtime = (*timestamp)->pubtime;
+  }
+
+  const cudaStream_t cuda_stream = get_cuda_stream();
+  bool on_device = false;
+  auto tensors = first.findAll<nvidia::gxf::Tensor, 4>();
+  for (auto tensor : tensors.value()) {
+    nvidia::gxf::Tensor& src = *tensor.value().get();
+    std::array<int32_t, nvidia::gxf::Shape::kMaxRank> dims;
+    dims[0] = batch.size();
+    for (uint32_t i = 0; i < src.rank(); i++) { dims[i + 1] = src.shape().dimension(i); }
+    nvidia::gxf::Shape shape(dims, src.rank() + 1);
+
+    auto out = batched->add<nvidia::gxf::Tensor>(tensor->name());
+    if (!out || !out.value()->reshapeCustom(
+                    shape,
+                    src.element_type(),
+                    src.bytes_per_element(),
+                    nvidia::gxf::ComputeTrivialStrides(shape, src.bytes_per_element()),
+                    src.storage_type(),
+                    allocator.value())) {
+      throw std::runtime_error("Failed to allocate batched tensor");
+    }
+
+    const bool device = src.storage_type() == nvidia::gxf::MemoryStorageType::kDevice;
+    on_device |= device;
+    const size_t size = src.bytes_size();
+    auto* dst = static_cast<uint8_t*>(out.value()->pointer());
+    for (size_t i = 0; i < batch.size(); i++) {
+      auto in = batch[i].second->get<nvidia::gxf::Tensor>(tensor->name());
+      if (device) {
+        if (CUDA_TRY(cudaMemcpyAsync(dst + i * size,
+                                     in.value()->pointer(),
+                                     size,
+                                     cudaMemcpyDeviceToDevice,
+                                     cuda_stream)) != cudaSuccess) {
+          throw std::runtime_error("Failed to copy a request into the batched tensor");
+        }
+      } else {
+        std::memcpy(dst + i * size, in.value()->pointer(), size);
+      }
+    }
+  }
+
+  if (on_device && CUDA_TRY(cudaStreamSynchronize(cuda_stream)) != cudaSuccess) {
+    throw std::runtime_error("Failed to copy the requests into the batched tensors");
+  }
+  return batched.value();
+}
+
 std::shared_ptr<UnboundedAllocator> GrpcServerRequestOp::allocator() {
   return allocator_.get();
 }
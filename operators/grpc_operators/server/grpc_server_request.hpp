@@ -22,7 +22,7 @@
 #include <holoscan/holoscan.hpp>
 #include <holoscan/utils/cuda_stream_handler.hpp>
 
-#include "../common/conditional_variable_queue.hpp"
+#include "session_multiplexer.hpp"
 
 namespace holoscan::ops {
 using namespace holoscan::ops;
@@ -31,10 +31,13 @@ using namespace holoscan::ops;
  * @class GrpcServerRequestOp
  * @brief A Holoscan Operator class for handling incoming gRPC requests.
  *
- * This class is Holoscan Operator that is responsible emitting GXF Entities from the request_queue
- * to the connected downstream operator(s).
+ * This class is Holoscan Operator that is responsible emitting GXF Entities received by the RPC
+ * sessions attached to the application to the connected downstream operator(s).
  *
- * The compute() method checks the request_queue and emits the GXF Entity to the output port.
+ * The compute() method takes the next requests from the sessions and emits them as one GXF Entity
+ * to the output port. With max_batch_size > 1, requests of different sessions whose tensors have
+ * identical names, types and shapes are stacked along a new leading dimension into a single
+ * entity so the pipeline processes them in one tick.
 
  * ==Named Outputs==
  *
@@ -42,7 +45,8 @@ using namespace holoscan::ops;
  *   - A GXF Entity with tensors to be emitted to the downstream operator.
  *
  * ==Parameters==
- * - **request_queue** : A queue for storing incoming gRPC requests.
+ * - **sessions** : The per-session request and response queues.
+ * - **max_batch_size** : Most requests from different sessions combined into one tick (default 1).
  * - **allocator** : An allocator used when converting EntityRequest to GXF Entity.
  * - **rpc_timeout** : Timeout in seconds for gRPC server to issue a Finish command if no data
  *                          is transmitted or received.
@@ -65,8 +69,11 @@ class GrpcServerRequestOp : public holoscan::Operator {
  private:
   Parameter<std::shared_ptr<UnboundedAllocator>> allocator_;
   Parameter<uint32_t> rpc_timeout_;
-  Parameter<std::shared_ptr<ConditionVariableQueue<std::shared_ptr<nvidia::gxf::Entity>>>>
-      request_queue_;
+  Parameter<std::shared_ptr<SessionMultiplexer>> sessions_;
+  Parameter<uint32_t> max_batch_size_;
+
+  static bool batch_compatible(nvidia::gxf::Entity& first, nvidia::gxf::Entity& candidate);
+  nvidia::gxf::Entity batch_requests(const std::vector<SessionMultiplexer::Request>& batch);
 
   CudaStreamHandler cuda_stream_handler_;
 };
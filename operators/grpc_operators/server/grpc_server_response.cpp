@@ -17,33 +17,124 @@
 
 #include "grpc_server_response.hpp"
 
+#include <array>
+#include <vector>
+
 namespace holoscan::ops {
 
 void GrpcServerResponseOp::setup(OperatorSpec& spec) {
   spec.input<nvidia::gxf::Entity>("input", IOSpec::kAnySize);
 
-  spec.param(response_queue_, "response_queue", "Response Queue", "Outgoing gRPC results.");
+  spec.param(sessions_, "sessions", "Sessions", "Outgoing gRPC results of each session.");
+  spec.param(max_chunk_size_,
+             "max_chunk_size",
+             "Max chunk size",
+             "Largest amount of tensor data in bytes per response; 0 to disable chunking.",
+             0U);
 
   cuda_stream_handler_.define_params(spec);
 }
 
 void GrpcServerResponseOp::compute(InputContext& op_input, OutputContext& op_output,
                                    ExecutionContext& context) {
-  auto tensors = 0;
-  auto response = std::make_shared<EntityResponse>();
-
   auto input_messages = op_input.receive<std::vector<holoscan::gxf::Entity>>("input").value();
+  if (input_messages.empty()) { return; }
+
+  // Results are routed by the tick of the request they came from, never by arrival order
+  const auto meta = metadata();
+  std::vector<SessionId> session_ids;
+  if (meta->has_key(kTickMetadataKey)) {
+    const auto tick = meta->get<TickId>(kTickMetadataKey);
+    session_ids = sessions_->tick_sessions(tick);
+    if (session_ids.empty()) {
+      HOLOSCAN_LOG_WARN("grpc server: dropping result of tick {} with no session waiting for it",
+                        tick);
+      return;
+    }
+  } else {
+    // Operators that don't forward metadata, such as the asynchronous video decoder, lose the
+    // tick. A result can then only be routed if a single session uses the pipeline.
+    const SessionId session = sessions_->sole_session();
+    if (session == 0) {
+      HOLOSCAN_LOG_WARN(
+          "grpc server: dropping result without the {} metadata of its request, which is needed "
+          "to route results while several sessions share the pipeline",
+          kTickMetadataKey);
+      return;
+    }
+    session_ids.push_back(session);
+  }
+
+  const auto cuda_stream = cuda_stream_handler_.get_cuda_stream(fragment()->executor().context());
+  for (size_t i = 0; i < session_ids.size(); i++) {
+    const SessionId session = session_ids[i];
+    TensorProtoChunker<EntityResponse> chunker(
+        max_chunk_size_.get(), cuda_stream, [this, session](std::shared_ptr<EntityResponse> r) {
+          sessions_->push_response(session, r);
+        });
+    for (auto&& message : input_messages) {
+      if (session_ids.size() == 1) {
+        chunker.add(message);
+      } else {
+        chunker.add(slice_entity(message, i, session_ids.size()));
+      }
+    }
+    chunker.finish();
+  }
+  HOLOSCAN_LOG_DEBUG("Sending response with {} messages to {} sessions.",
+                     input_messages.size(),
+                     session_ids.size());
+}
+
+nvidia::gxf::Entity GrpcServerResponseOp::slice_entity(nvidia::gxf::Entity& entity, size_t index,
+                                                       size_t count) {
+  auto slice = nvidia::gxf::Entity::New(fragment()->executor().context());
+  if (!slice) { throw std::runtime_error("Failed to create GXF entity"); }
 
-  for (auto&& message : input_messages) {
-    holoscan::ops::TensorProto::tensor_to_entity_response(
-        message, response, cuda_stream_handler_.get_cuda_stream(fragment()->executor().context()));
-    tensors++;
+  if (auto timestamp = entity.get<nvidia::gxf::Timestamp>()) {
+    auto out_timestamp = slice->add<nvidia::gxf::Timestamp>("timestamp");
+    (*out_timestamp)->acqtime = (*timestamp)->acqtime;
+    (*out_timestamp)->pubtime = (*timestamp)->pubtime;
   }
 
-  if (tensors > 0) {
-    HOLOSCAN_LOG_DEBUG("Sending response with {} tensors.", tensors);
-    response_queue_->push(response);
+  auto tensors = entity.findAll<nvidia::gxf::Tensor, 4>();
+  if (!tensors) { throw std::runtime_error("Tensor not found"); }
+  for (auto tensor : tensors.value()) {
+    nvidia::gxf::Tensor& src = *tensor.value().get();
+    auto* pointer = src.pointer();
+    // A tensor without the batch dimension can't be split, and sending it whole would hand every
+    // session data computed from the requests of the others
+    if (src.rank() < 1 || src.shape().dimension(0) != static_cast<int32_t>(count)) {
+      throw std::runtime_error(fmt::format(
+          "grpc server: tensor '{}' of a batch of {} requests has no leading batch dimension; "
+          "use max_batch_size 1 for this pipeline",
+          tensor->name(),
+          count));
+    }
+
+    std::array<int32_t, nvidia::gxf::Shape::kMaxRank> dims{};
+    nvidia::gxf::Tensor::stride_array_t strides{};
+    for (uint32_t d = 1; d < src.rank(); d++) {
+      dims[d - 1] = src.shape().dimension(d);
+      strides[d - 1] = src.stride(d);
+    }
+    pointer += index * src.stride(0);
+
+    // The slice only views the batched tensor, which outlives it: the messages are encoded
+    // before compute() returns
+    auto out = slice->add<nvidia::gxf::Tensor>(tensor->name());
+    if (!out ||
+        !out.value()->wrapMemory(nvidia::gxf::Shape(dims, src.rank() - 1),
+                                 src.element_type(),
+                                 src.bytes_per_element(),
+                                 strides,
+                                 src.storage_type(),
+                                 pointer,
+                                 [](void*) { return nvidia::gxf::Success; })) {
+      throw std::runtime_error("Failed to slice batched tensor");
+    }
   }
+  return slice.value();
 }
 
 }  // namespace holoscan::ops
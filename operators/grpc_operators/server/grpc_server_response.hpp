@@ -20,8 +20,8 @@
 
 #include <holoscan/utils/cuda_stream_handler.hpp>
 
-#include "../common/conditional_variable_queue.hpp"
 #include "../common/tensor_proto.hpp"
+#include "session_multiplexer.hpp"
 #include "holoscan.pb.h"
 
 using holoscan::entity::EntityResponse;
@@ -36,7 +36,9 @@ namespace holoscan::ops {
  * and queueing them for transmission to the remote client.
  *
  * The compute() method receives an GXF Entity, converts it to an EntityResponse (protobuf message),
- * and queues it for transmission.
+ * and queues it for transmission to the session(s) whose requests produced it, found by the tick
+ * id GrpcServerRequestOp attached as metadata. For a batched tick, every tensor must have the batch
+ * size as leading dimension and is split so each session receives its own slice.
 
  * ==Named Input==
  *
@@ -44,7 +46,9 @@ namespace holoscan::ops {
  *   - A GXF Entity with tensors to be transmitted to the remote client.
  *
  * ==Parameters==
- * - **response_queue** : A queue for storing outgoing gRPC results.
+ * - **sessions** : The per-session request and response queues.
+ * - **max_chunk_size** : Largest amount of tensor data in bytes per response. Larger results are
+ *                        split into several responses. 0 (default) disables chunking.
  */
 class GrpcServerResponseOp : public holoscan::Operator {
  public:
@@ -56,10 +60,12 @@ class GrpcServerResponseOp : public holoscan::Operator {
                ExecutionContext& context) override;
 
  private:
-  Parameter<std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityResponse>>>>
-      response_queue_;
+  Parameter<std::shared_ptr<SessionMultiplexer>> sessions_;
+  Parameter<uint32_t> max_chunk_size_;
 
   CudaStreamHandler cuda_stream_handler_;
+
+  nvidia::gxf::Entity slice_entity(nvidia::gxf::Entity& entity, size_t index, size_t count);
 };
 }  // namespace holoscan::ops
 #endif /* GRPC_SERVER_RESPONSE_HPP */
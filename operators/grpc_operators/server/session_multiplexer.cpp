@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "session_multiplexer.hpp"
+
+namespace holoscan::ops {
+
+SessionId SessionMultiplexer::add_session() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const SessionId session = next_session_id_++;
+  sessions_.emplace(session, Session{});
+  HOLOSCAN_LOG_INFO("grpc server: session {} attached ({} active)", session, sessions_.size());
+  return session;
+}
+
+void SessionMultiplexer::remove_session(SessionId session) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = sessions_.find(session);
+  if (it == sessions_.end()) { return; }
+  if (it->second.dropped > 0) {
+    HOLOSCAN_LOG_INFO("grpc server: session {} dropped {} requests while its queue was full",
+                      session,
+                      it->second.dropped);
+  }
+  if (it->second.dropped_responses > 0) {
+    HOLOSCAN_LOG_INFO("grpc server: session {} dropped {} results while its client fell behind",
+                      session,
+                      it->second.dropped_responses);
+  }
+  sessions_.erase(it);
+  response_cv_.notify_all();
+  response_space_cv_.notify_all();
+  HOLOSCAN_LOG_INFO("grpc server: session {} detached ({} active)", session, sessions_.size());
+}
+
+size_t SessionMultiplexer::session_count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sessions_.size();
+}
+
+bool SessionMultiplexer::push_request(SessionId session,
+                                      std::shared_ptr<nvidia::gxf::Entity> request) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = sessions_.find(session);
+  if (it == sessions_.end()) { return false; }
+
+  auto& requests = it->second.requests;
+  if (requests.size() >= max_queued_requests_) {
+    requests.pop_front();
+    it->second.dropped++;
+  }
+  requests.push_back(std::move(request));
+  return true;
+}
+
+std::vector<SessionMultiplexer::Request> SessionMultiplexer::next_batch(
+    size_t max_batch, TickId& tick, const compatible_func& compatible) {
+  std::vector<Request> batch;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (sessions_.empty()) { return batch; }
+
+  // Start with the session after the one served first last time so every session gets a turn
+  // at the head of the batch
+  auto start = sessions_.upper_bound(last_served_);
+  if (start == sessions_.end()) { start = sessions_.begin(); }
+
+  auto it = start;
+  do {
+    auto& requests = it->second.requests;
+    if (!requests.empty() &&
+        (batch.empty() || !compatible || compatible(*batch.front().second, *requests.front()))) {
+      batch.emplace_back(it->first, std::move(requests.front()));
+      requests.pop_front();
+    }
+    if (++it == sessions_.end()) { it = sessions_.begin(); }
+  } while (it != start && batch.size() < max_batch);
+
+  if (batch.empty()) { return batch; }
+
+  last_served_ = batch.front().first;
+  tick = next_tick_id_++;
+  auto& tick_sessions = ticks_[tick];
+  tick_sessions.reserve(batch.size());
+  for (const auto& request : batch) { tick_sessions.push_back(request.first); }
+  if (ticks_.size() > kMaxRecordedTicks) { ticks_.erase(ticks_.begin()); }
+  return batch;
+}
+
+std::vector<SessionId> SessionMultiplexer::tick_sessions(TickId tick) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = ticks_.find(tick);
+  if (it == ticks_.end()) { return {}; }
+  // a pipeline may produce several results per tick, so the tick is kept until it's evicted
+  return it->second;
+}
+
+SessionId SessionMultiplexer::sole_session() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sessions_.size() == 1 ? sessions_.begin()->first : 0;
+}
+
+bool SessionMultiplexer::push_response(SessionId session,
+                                       std::shared_ptr<EntityResponse> response) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = sessions_.find(session);
+  if (it == sessions_.end()) { return false; }
+
+  if (response_policy_ == QueueFullPolicy::BLOCK) {
+    response_space_cv_.wait(lock, [&] {
+      it = sessions_.find(session);
+      return it == sessions_.end() || it->second.responses.size() < max_queued_responses_;
+    });
+    if (it == sessions_.end()) { return false; }
+  } else {
+    // Results are dropped whole: the client can't use a tensor that misses chunks. The chunks of
+    // an accepted result are all queued, which exceeds the limit by at most one result.
+    Session& state = it->second;
+    if (!state.in_result) {
+      state.dropping_result = state.responses.size() >= max_queued_responses_;
+      if (state.dropping_result) {
+        const auto dropped = ++state.dropped_responses;
+        if (dropped == 1 || dropped % 100 == 0) {
+          HOLOSCAN_LOG_WARN("grpc server: session {} response queue full, {} results dropped",
+                            session,
+                            dropped);
+        }
+      }
+    }
+    state.in_result = response->has_more_chunks();
+    if (state.dropping_result) { return false; }
+  }
+
+  it->second.responses.push_back(std::move(response));
+  response_cv_.notify_all();
+  return true;
+}
+
+std::shared_ptr<EntityResponse> SessionMultiplexer::pop_response(
+    SessionId session, std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_ptr<EntityResponse> response;
+  response_cv_.wait_for(lock, timeout, [&] {
+    auto it = sessions_.find(session);
+    if (it == sessions_.end()) { return true; }
+    if (it->second.responses.empty()) { return false; }
+    response = std::move(it->second.responses.front());
+    it->second.responses.pop_front();
+    return true;
+  });
+  if (response) { response_space_cv_.notify_all(); }
+  return response;
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVER_SESSION_MULTIPLEXER_HPP
+#define SERVER_SESSION_MULTIPLEXER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <gxf/core/entity.hpp>
+#include <holoscan/holoscan.hpp>
+
+#include "../common/asynchronous_condition_queue.hpp"
+#include "holoscan.pb.h"
+
+using holoscan::entity::EntityResponse;
+
+namespace holoscan::ops {
+
+using namespace holoscan;
+
+/**
+ * @typedef SessionId
+ * @brief Identifies one EntityStream RPC attached to an application instance. 0 is never used.
+ */
+using SessionId = uint64_t;
+
+/**
+ * @typedef TickId
+ * @brief Identifies the requests taken in one tick of GrpcServerRequestOp. 0 is never used.
+ */
+using TickId = uint64_t;
+
+/// Metadata key carrying the TickId of a request through the pipeline to GrpcServerResponseOp
+constexpr char kTickMetadataKey[] = "grpc_server_tick";
+
+/**
+ * @class SessionMultiplexer
+ * @brief A Holoscan Resource that shares one application pipeline between several RPC sessions.
+ *
+ * Each session has its own bounded request queue and response queue. The GrpcServerRequestOp
+ * takes requests with next_batch(), which serves sessions round-robin and takes at most one
+ * request per session per tick, so a fast client can't starve a slow one. Every tick gets a
+ * TickId, which GrpcServerRequestOp attaches to the emitted entity as metadata and the pipeline
+ * carries along. GrpcServerResponseOp looks the sessions of a result up by that id, so results
+ * reach the right sessions even if the pipeline drops, skips, repeats or reorders ticks. The most
+ * recent ticks are kept, a result of an older tick is dropped.
+ *
+ * All methods are thread safe.
+ */
+class SessionMultiplexer : public Resource {
+ public:
+  HOLOSCAN_RESOURCE_FORWARD_ARGS_SUPER(SessionMultiplexer, Resource)
+
+  using Request = std::pair<SessionId, std::shared_ptr<nvidia::gxf::Entity>>;
+  using compatible_func =
+      std::function<bool(nvidia::gxf::Entity& first, nvidia::gxf::Entity& candidate)>;
+
+  /**
+   * @param max_queued_requests Requests held per session. When a session's queue is full its
+   * oldest request is dropped, so a stalled pipeline always serves the most recent data.
+   * @param max_queued_responses Responses held per session for a client that reads slower than
+   * the pipeline produces.
+   * @param response_policy What push_response() does when a session's response queue is full.
+   * BLOCK holds the pipeline until the client catches up or the session ends. DROP discards the
+   * new result, all of its chunks, and counts it.
+   */
+  explicit SessionMultiplexer(size_t max_queued_requests = 4, size_t max_queued_responses = 64,
+                              QueueFullPolicy response_policy = QueueFullPolicy::BLOCK)
+      : max_queued_requests_(max_queued_requests),
+        max_queued_responses_(std::max<size_t>(max_queued_responses, 1)),
+        response_policy_(response_policy) {}
+
+  SessionId add_session();
+  void remove_session(SessionId session);
+  size_t session_count();
+
+  /**
+   * @brief Queues a request of a session. Returns false if the session no longer exists.
+   */
+  bool push_request(SessionId session, std::shared_ptr<nvidia::gxf::Entity> request);
+
+  /**
+   * @brief Takes the next requests to process in one tick.
+   *
+   * Up to max_batch requests are taken, one from each session with pending requests in round-robin
+   * order. Requests after the first are only included if compatible() accepts them. Unless nothing
+   * was taken, the tick is recorded and its id returned in `tick` for tick_sessions().
+   */
+  std::vector<Request> next_batch(size_t max_batch, TickId& tick,
+                                  const compatible_func& compatible = nullptr);
+
+  /**
+   * @brief Returns the sessions of a tick, in the order of its batch. Empty if the tick is unknown
+   * or was evicted.
+   */
+  std::vector<SessionId> tick_sessions(TickId tick);
+
+  /**
+   * @brief Returns the session if exactly one is attached, 0 otherwise.
+   */
+  SessionId sole_session();
+
+  /**
+   * @brief Queues a response of a session, applying the response policy if its queue is full.
+   * Returns false if the response was dropped or the session no longer exists.
+   */
+  bool push_response(SessionId session, std::shared_ptr<EntityResponse> response);
+
+  /**
+   * @brief Waits up to timeout for a response of the session. Returns nullptr on timeout or once
+   * the session has been removed.
+   */
+  std::shared_ptr<EntityResponse> pop_response(SessionId session,
+                                               std::chrono::milliseconds timeout);
+
+ private:
+  struct Session {
+    std::deque<std::shared_ptr<nvidia::gxf::Entity>> requests;
+    std::deque<std::shared_ptr<EntityResponse>> responses;
+    uint64_t dropped = 0;
+    uint64_t dropped_responses = 0;
+    // Whether the last response pushed has more chunks, and whether its result is dropped
+    bool in_result = false;
+    bool dropping_result = false;
+  };
+
+  // Ticks kept for tick_sessions(); a result arriving later than this many ticks is dropped
+  static constexpr size_t kMaxRecordedTicks = 256;
+
+  const size_t max_queued_requests_;
+  const size_t max_queued_responses_;
+  const QueueFullPolicy response_policy_;
+  std::mutex mutex_;
+  std::condition_variable response_cv_;
+  std::condition_variable response_space_cv_;
+  std::map<SessionId, Session> sessions_;
+  std::map<TickId, std::vector<SessionId>> ticks_;
+  TickId next_tick_id_ = 1;
+  SessionId next_session_id_ = 1;
+  SessionId last_served_ = 0;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* SERVER_SESSION_MULTIPLEXER_HPP */
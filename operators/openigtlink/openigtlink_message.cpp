@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "openigtlink_message.hpp"
+
+#include <cstring>
+
+#include "igtlImageMessage.h"
+#include "igtl_util.h"
+
+namespace holoscan::ops::openigtlink {
+
+namespace {
+
+constexpr uint16_t kHeaderVersion = 1;
+constexpr uint16_t kImageHeaderVersion = 1;
+constexpr uint8_t kImageEndianBig = 1;
+constexpr uint8_t kImageEndianLittle = 2;
+constexpr uint8_t kImageCoordinateRAS = 1;
+
+/// Read the element at `index` of data of `type`, see is_float() and is_integer()
+double element(const uint8_t* data, nvidia::gxf::PrimitiveType type, size_t index) {
+  const auto read = [data, index](auto value) {
+    std::memcpy(&value, data + index * sizeof(value), sizeof(value));
+    return static_cast<double>(value);
+  };
+  switch (type) {
+    case nvidia::gxf::PrimitiveType::kFloat32:
+      return read(float());
+    case nvidia::gxf::PrimitiveType::kFloat64:
+      return read(double());
+    case nvidia::gxf::PrimitiveType::kInt32:
+      return read(int32_t());
+    case nvidia::gxf::PrimitiveType::kUnsigned32:
+      return read(uint32_t());
+    case nvidia::gxf::PrimitiveType::kInt64:
+      return read(int64_t());
+    case nvidia::gxf::PrimitiveType::kUnsigned64:
+      return read(uint64_t());
+    default:
+      return 0.0;
+  }
+}
+
+/// Appends values in network byte order as used by OpenIGTLink
+class BigEndianWriter {
+ public:
+  explicit BigEndianWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+  void u8(uint8_t value) { out_.push_back(value); }
+  void u16(uint16_t value) {
+    u8(value >> 8);
+    u8(value & 0xFF);
+  }
+  void u32(uint32_t value) {
+    u16(value >> 16);
+    u16(value & 0xFFFF);
+  }
+  void u64(uint64_t value) {
+    u32(value >> 32);
+    u32(value & 0xFFFFFFFF);
+  }
+  void f32(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    u32(bits);
+  }
+  /// A fixed size string, zero padded
+  void chars(const std::string& value, size_t size) {
+    for (size_t index = 0; index < size; ++index) {
+      u8(index < value.size() ? value[index] : 0);
+    }
+  }
+
+ private:
+  std::vector<uint8_t>& out_;
+};
+
+}  // namespace
+
+bool message_type(const std::string& name, MessageType& type) {
+  if (name == "IMAGE") {
+    type = MessageType::IMAGE;
+  } else if (name == "TRANSFORM") {
+    type = MessageType::TRANSFORM;
+  } else if (name == "POINT") {
+    type = MessageType::POINT;
+  } else if (name == "POLYDATA") {
+    type = MessageType::POLYDATA;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+int scalar_type(nvidia::gxf::PrimitiveType element_type) {
+  switch (element_type) {
+    case nvidia::gxf::PrimitiveType::kInt8:
+      return igtl::ImageMessage::TYPE_INT8;
+    case nvidia::gxf::PrimitiveType::kUnsigned8:
+      return igtl::ImageMessage::TYPE_UINT8;
+    case nvidia::gxf::PrimitiveType::kInt16:
+      return igtl::ImageMessage::TYPE_INT16;
+    case nvidia::gxf::PrimitiveType::kUnsigned16:
+      return igtl::ImageMessage::TYPE_UINT16;
+    case nvidia::gxf::PrimitiveType::kInt32:
+      return igtl::ImageMessage::TYPE_INT32;
+    case nvidia::gxf::PrimitiveType::kUnsigned32:
+      return igtl::ImageMessage::TYPE_UINT32;
+    case nvidia::gxf::PrimitiveType::kFloat32:
+      return igtl::ImageMessage::TYPE_FLOAT32;
+    case nvidia::gxf::PrimitiveType::kFloat64:
+      return igtl::ImageMessage::TYPE_FLOAT64;
+    default:
+      return -1;
+  }
+}
+
+bool is_float(nvidia::gxf::PrimitiveType type) {
+  return (type == nvidia::gxf::PrimitiveType::kFloat32) ||
+         (type == nvidia::gxf::PrimitiveType::kFloat64);
+}
+
+bool is_integer(nvidia::gxf::PrimitiveType type) {
+  return (type == nvidia::gxf::PrimitiveType::kInt32) ||
+         (type == nvidia::gxf::PrimitiveType::kUnsigned32) ||
+         (type == nvidia::gxf::PrimitiveType::kInt64) ||
+         (type == nvidia::gxf::PrimitiveType::kUnsigned64);
+}
+
+void pack(const Item& item, uint64_t timestamp, const std::string& device_name,
+          PackedMessage& message) {
+  BigEndianWriter body(message.body);
+  const auto value = [&item](size_t index) {
+    return static_cast<float>(element(item.data, item.element_type, index));
+  };
+
+  const char* type_name = "";
+  switch (item.type) {
+    case MessageType::IMAGE: {
+      type_name = "IMAGE";
+      body.u16(kImageHeaderVersion);
+      body.u8(item.components);
+      body.u8(item.scalar_type);
+      // the pixel data is sent in host byte order
+      body.u8(igtl_is_little_endian() ? kImageEndianLittle : kImageEndianBig);
+      body.u8(kImageCoordinateRAS);
+      const uint16_t size[3] = {
+          static_cast<uint16_t>(item.width), static_cast<uint16_t>(item.height), 1};
+      for (uint16_t dimension : size) { body.u16(dimension); }
+      // Orientation matrix is the identity with a spacing of 1, at the origin
+      const float matrix[12] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f};
+      for (float coefficient : matrix) { body.f32(coefficient); }
+      // The sub-volume is the whole image: offset, then size, as igtl_image_header
+      for (int axis = 0; axis < 3; ++axis) { body.u16(0); }
+      for (uint16_t dimension : size) { body.u16(dimension); }
+      message.payload = item.data;
+      message.payload_size = item.size;
+    } break;
+    case MessageType::TRANSFORM: {
+      type_name = "TRANSFORM";
+      // Rotation columns, then the translation
+      for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 3; ++row) { body.f32(value(row * 4 + column)); }
+      }
+    } break;
+    case MessageType::POINT: {
+      type_name = "POINT";
+      for (int32_t point = 0; point < item.height; ++point) {
+        const size_t offset = size_t(point) * item.width;
+        body.chars(std::to_string(point), 64);
+        body.chars("Point", 32);
+        for (int channel = 0; channel < 4; ++channel) { body.u8(255); }
+        for (int axis = 0; axis < 3; ++axis) { body.f32(value(offset + axis)); }
+        body.f32(item.width == 4 ? value(offset + 3) : 0.f);
+        body.chars("", 20);
+      }
+    } break;
+    case MessageType::POLYDATA: {
+      type_name = "POLYDATA";
+      const uint32_t points = item.height;
+      const uint32_t triangles = item.triangle_count;
+      // Without triangles, every point is a vertex
+      const uint32_t vertices = item.triangles ? 0 : points;
+      body.u32(points);
+      body.u32(vertices);
+      body.u32(vertices * 2 * sizeof(uint32_t));
+      body.u32(0);  // lines
+      body.u32(0);
+      body.u32(triangles);
+      body.u32(triangles * 4 * sizeof(uint32_t));
+      body.u32(0);  // triangle strips
+      body.u32(0);
+      body.u32(0);  // attributes
+      for (size_t index = 0; index < size_t(points) * 3; ++index) { body.f32(value(index)); }
+      for (uint32_t vertex = 0; vertex < vertices; ++vertex) {
+        body.u32(1);
+        body.u32(vertex);
+      }
+      for (size_t triangle = 0; triangle < triangles; ++triangle) {
+        body.u32(3);
+        for (int corner = 0; corner < 3; ++corner) {
+          body.u32(static_cast<uint32_t>(
+              element(item.triangles, item.triangle_type, triangle * 3 + corner)));
+        }
+      }
+    } break;
+  }
+
+  igtl_uint64 crc = igtl_crc64(message.body.data(), message.body.size(), 0);
+  if (message.payload_size > 0) {
+    crc = igtl_crc64(const_cast<uint8_t*>(message.payload), message.payload_size, crc);
+  }
+
+  BigEndianWriter header(message.header);
+  header.u16(kHeaderVersion);
+  header.chars(type_name, 12);
+  header.chars(device_name, 20);
+  header.u64(timestamp);
+  header.u64(message.body.size() + message.payload_size);
+  header.u64(crc);
+}
+
+
+}  // namespace holoscan::ops::openigtlink
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_OPENIGTLINK_MESSAGE_HPP
+#define HOLOSCAN_OPERATORS_OPENIGTLINK_MESSAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <holoscan/holoscan.hpp>
+
+// Serialization of the messages sent by OpenIGTLinkTxOp, OpenIGTLink version 1
+namespace holoscan::ops::openigtlink {
+
+enum class MessageType { IMAGE, TRANSFORM, POINT, POLYDATA };
+
+/// Message type from its OpenIGTLink name, returns false if not supported
+bool message_type(const std::string& name, MessageType& type);
+
+/// IGT scalar type from Holoscan data type, -1 if not supported
+int scalar_type(nvidia::gxf::PrimitiveType element_type);
+
+bool is_float(nvidia::gxf::PrimitiveType type);
+bool is_integer(nvidia::gxf::PrimitiveType type);
+
+/// A message ready to be sent: header and body, optionally followed by data sent in place
+struct PackedMessage {
+  std::vector<uint8_t> header;
+  std::vector<uint8_t> body;
+  const uint8_t* payload = nullptr;
+  size_t payload_size = 0;
+};
+
+/// An input to send, its data is in host memory once the batch is ready
+struct Item {
+  MessageType type;
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  nvidia::gxf::PrimitiveType element_type = nvidia::gxf::PrimitiveType::kCustom;
+  // IMAGE: width, height and components; else rows and columns of the tensor
+  int32_t width = 0;
+  int32_t height = 0;
+  int32_t components = 0;
+  int scalar_type = 0;
+  // POLYDATA triangles, optional
+  const uint8_t* triangles = nullptr;
+  size_t triangle_count = 0;
+  nvidia::gxf::PrimitiveType triangle_type = nvidia::gxf::PrimitiveType::kCustom;
+};
+
+/// Pack an item into an OpenIGTLink version 1 message
+void pack(const Item& item, uint64_t timestamp, const std::string& device_name,
+          PackedMessage& message);
+
+}  // namespace holoscan::ops::openigtlink
+
+#endif /* HOLOSCAN_OPERATORS_OPENIGTLINK_MESSAGE_HPP */
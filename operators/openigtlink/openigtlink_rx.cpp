@@ -17,7 +17,15 @@
 
 #include "openigtlink_rx.hpp"
 
+#include <algorithm>
+#include <utility>
+
+#include <gxf/std/timestamp.hpp>
+
 #include "igtlImageMessage.h"
+#include "igtl_header.h"
+#include "igtl_image.h"
+#include "igtl_util.h"
 
 #ifndef CUDA_TRY
 #define CUDA_TRY(stmt)                                                                     \
@@ -37,6 +45,59 @@
 
 namespace holoscan::ops {
 
+namespace {
+
+// How long the receiver waits for a connection or a message before checking for stop()
+constexpr unsigned long kConnectionTimeoutMs = 100;
+constexpr int kReceiveTimeoutMs = 100;
+constexpr int kStalledPeerTimeoutMs = 5000;
+
+// The receiver writes one frame while compute() copies another and a third holds the newest one
+constexpr uint32_t kMinBuffers = 3;
+
+// Metadata key of the device name of an emitted frame
+constexpr char kDeviceNameMetadataKey[] = "device_name";
+
+/// Holoscan data type from IGT scalar type
+bool primitive_type(int scalar_type, nvidia::gxf::PrimitiveType& dtype) {
+  switch (scalar_type) {
+    case igtl::ImageMessage::TYPE_INT8:
+      dtype = nvidia::gxf::PrimitiveType::kInt8;
+      return true;
+    case igtl::ImageMessage::TYPE_UINT8:
+      dtype = nvidia::gxf::PrimitiveType::kUnsigned8;
+      return true;
+    case igtl::ImageMessage::TYPE_INT16:
+      dtype = nvidia::gxf::PrimitiveType::kInt16;
+      return true;
+    case igtl::ImageMessage::TYPE_UINT16:
+      dtype = nvidia::gxf::PrimitiveType::kUnsigned16;
+      return true;
+    case igtl::ImageMessage::TYPE_INT32:
+      dtype = nvidia::gxf::PrimitiveType::kInt32;
+      return true;
+    case igtl::ImageMessage::TYPE_UINT32:
+      dtype = nvidia::gxf::PrimitiveType::kUnsigned32;
+      return true;
+    case igtl::ImageMessage::TYPE_FLOAT32:
+      dtype = nvidia::gxf::PrimitiveType::kFloat32;
+      return true;
+    case igtl::ImageMessage::TYPE_FLOAT64:
+      dtype = nvidia::gxf::PrimitiveType::kFloat64;
+      return true;
+  }
+  return false;
+}
+
+/// Swap the byte order of `count` elements of `element_size` bytes
+void swap_byte_order(uint8_t* data, size_t count, size_t element_size) {
+  for (size_t index = 0; index < count; ++index, data += element_size) {
+    std::reverse(data, data + element_size);
+  }
+}
+
+}  // namespace
+
 void OpenIGTLinkRxOp::setup(OperatorSpec& spec) {
   auto& out_tensor = spec.output<gxf::Entity>("out_tensor");
 
@@ -62,33 +123,309 @@ void OpenIGTLinkRxOp::setup(OperatorSpec& spec) {
     "FlipWidthHeight",
     "Flip width and height (necessary for receiving from 3D Slicer).",
     true);
+
+  spec.param(
+    device_names_,
+    "device_names",
+    "DeviceNames",
+    "Device names of the IMAGE messages to receive, all are received if empty.",
+    std::vector<std::string>{});
+
+  spec.param(
+    num_buffers_,
+    "num_buffers",
+    "NumBuffers",
+    "Number of pinned frame buffers, at least 3 and at least the number of device names plus 2.",
+    kMinBuffers);
+
   spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
 }
 
+void OpenIGTLinkRxOp::initialize() {
+  // compute() is only scheduled once the receiver thread completed a frame
+  frame_available_ =
+      fragment()->make_condition<AsynchronousCondition>(name() + "_frame_available");
+  add_arg(frame_available_);
+
+  Operator::initialize();
+}
+
 void OpenIGTLinkRxOp::start() {
-  // Create client socket
+  // Create server socket
   server_socket_ = igtl::ServerSocket::New();
   HOLOSCAN_LOG_INFO("Creating OpenIGTLink server socket...");
   int r = server_socket_->CreateServer(port_.get());
   if (r < 0) {
     throw std::runtime_error("Cannot create server socket.");
   }
-  socket_ = server_socket_->WaitForConnection(1000);
   HOLOSCAN_LOG_INFO("Creating server socket successful");
   // Create timer
   time_stamp_ = igtl::TimeStamp::New();
+  header_ = igtl::MessageHeader::New();
+
+  CUDA_TRY(cudaStreamCreateWithFlags(&cuda_stream_, cudaStreamNonBlocking));
+
+  // Frame buffers are allocated on first use and grown to the largest image received
+  // One frame per device can wait to be emitted besides the two being received and copied
+  const uint32_t min_buffers =
+      std::max(kMinBuffers, static_cast<uint32_t>(device_names_.get().size() + 2));
+  frames_.assign(std::max(num_buffers_.get(), min_buffers), Frame{});
+  free_frames_.clear();
+  for (size_t index = 0; index < frames_.size(); ++index) { free_frames_.push_back(index); }
+  ready_frames_.clear();
+
+  frame_available_->event_state(AsynchronousEventState::EVENT_WAITING);
+  running_ = true;
+  receive_thread_ = std::thread(&OpenIGTLinkRxOp::receive_frames, this);
 }
 
 void OpenIGTLinkRxOp::stop() {
+  running_ = false;
+  if (receive_thread_.joinable()) { receive_thread_.join(); }
+  frame_available_->event_state(AsynchronousEventState::EVENT_NEVER);
+
   // Close connection
-  socket_->CloseSocket();
+  if (socket_.IsNotNull()) {
+    socket_->CloseSocket();
+    socket_ = nullptr;
+  }
   server_socket_->CloseSocket();
+
+  if (cuda_stream_) {
+    cudaStreamSynchronize(cuda_stream_);
+    cudaStreamDestroy(cuda_stream_);
+    cuda_stream_ = nullptr;
+  }
+  for (auto& frame : frames_) { cudaFreeHost(frame.data); }
+  frames_.clear();
+  free_frames_.clear();
+  ready_frames_.clear();
+
+  HOLOSCAN_LOG_INFO("OpenIGTLinkRxOp: {} frames dropped", dropped_frames_);
+}
+
+void OpenIGTLinkRxOp::receive_frames() {
+  while (running_) {
+    // Wait for a peer, also after the previous one disconnected
+    if (socket_.IsNull()) {
+      socket_ = server_socket_->WaitForConnection(kConnectionTimeoutMs);
+      if (socket_.IsNull()) { continue; }
+      HOLOSCAN_LOG_INFO("OpenIGTLink client connected");
+    }
+
+    if (!receive_message()) {
+      HOLOSCAN_LOG_INFO("OpenIGTLink client disconnected, waiting for a new connection");
+      socket_->CloseSocket();
+      socket_ = nullptr;
+    }
+  }
+}
+
+bool OpenIGTLinkRxOp::receive_message() {
+  // Wait for the next message briefly to check for stop() regularly
+  socket_->SetReceiveTimeout(kReceiveTimeoutMs);
+  header_->InitPack();
+  bool timeout = false;
+  igtlUint64 r = socket_->Receive(header_->GetPackPointer(), header_->GetPackSize(), timeout);
+  if (timeout && (r == 0)) {
+    // No message yet
+    return true;
+  }
+  // Once a message started, a peer that does not send the rest is considered gone
+  socket_->SetReceiveTimeout(kStalledPeerTimeoutMs);
+  if (timeout && (r < header_->GetPackSize())) {
+    // The header arrived in part, read the rest to stay in sync with the stream
+    timeout = false;
+    r += socket_->Receive(static_cast<uint8_t*>(header_->GetPackPointer()) + r,
+                          header_->GetPackSize() - r, timeout);
+  }
+  if (r != header_->GetPackSize()) {
+    return false;
+  }
+
+  // Deserialize the header
+  header_->Unpack();
+  if (header_->GetHeaderVersion() != IGTL_HEADER_VERSION_2) {
+    HOLOSCAN_LOG_ERROR("Version of the client and server doesn't match.");
+    return false;
+  }
+
+  const bool accepted =
+      device_names_.get().empty() ||
+      (std::find(device_names_.get().begin(),
+                 device_names_.get().end(),
+                 header_->GetDeviceName()) != device_names_.get().end());
+  if ((strcmp(header_->GetDeviceType(), "IMAGE") != 0) || !accepted) {
+    HOLOSCAN_LOG_DEBUG("Skipping : {} {}", header_->GetDeviceType(), header_->GetDeviceName());
+    const igtlUint64 body_size = header_->GetBodySizeToRead();
+    return (body_size == 0) || (socket_->Skip(body_size, 1) != 0);
+  }
+
+  return receive_image(header_);
+}
+
+bool OpenIGTLinkRxOp::receive_image(const igtl::MessageHeader::Pointer& header) {
+  // Receive a message part, a timeout in the middle of a message means the peer stalled
+  const auto receive = [this](void* data, igtlUint64 size) {
+    bool timeout = false;
+    return (size == 0) || (socket_->Receive(data, size, timeout) == size);
+  };
+  const auto skip = [this](igtlUint64 size) {
+    return (size == 0) || (socket_->Skip(size, 1) != 0);
+  };
+
+  igtlUint64 remaining = header->GetBodySizeToRead();
+
+  // Version 2 bodies start with an extended header and end with the meta data
+  igtl_extended_header extended_header;
+  if (remaining < sizeof(extended_header) ||
+      !receive(&extended_header, sizeof(extended_header))) {
+    return false;
+  }
+  igtl_extended_header_convert_byte_order(&extended_header);
+  remaining -= sizeof(extended_header);
+  const igtlUint64 extended_header_rest =
+      extended_header.extended_header_size > sizeof(extended_header)
+          ? extended_header.extended_header_size - sizeof(extended_header)
+          : 0;
+  if (remaining < extended_header_rest || !skip(extended_header_rest)) {
+    return false;
+  }
+  remaining -= extended_header_rest;
+
+  igtl_image_header image_header;
+  if (remaining < IGTL_IMAGE_HEADER_SIZE || !receive(&image_header, IGTL_IMAGE_HEADER_SIZE)) {
+    return false;
+  }
+  igtl_image_convert_byte_order(&image_header);
+  remaining -= IGTL_IMAGE_HEADER_SIZE;
+
+  nvidia::gxf::PrimitiveType dtype;
+  if (!primitive_type(image_header.scalar_type, dtype)) {
+    HOLOSCAN_LOG_ERROR("Unsupported data type {}.", image_header.scalar_type);
+    return skip(remaining);
+  }
+  const igtlUint64 data_size = igtl_image_get_data_size(&image_header);
+  if (remaining < data_size) {
+    HOLOSCAN_LOG_ERROR("IMAGE message body too small.");
+    return false;
+  }
+
+  // Take a free frame, grow its buffer if the image is larger than any before
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    if (free_frames_.empty()) {
+      // More devices than device_names are sent, drop the oldest frame not emitted yet
+      free_frames_.push_back(ready_frames_.front());
+      ready_frames_.pop_front();
+      ++dropped_frames_;
+    }
+    index = free_frames_.back();
+    free_frames_.pop_back();
+  }
+  Frame& frame = frames_[index];
+  const auto release = [this, index]() {
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    free_frames_.push_back(index);
+  };
+  if (frame.capacity < data_size) {
+    cudaFreeHost(frame.data);
+    frame.data = nullptr;
+    frame.capacity = 0;
+    if (CUDA_TRY(cudaHostAlloc(reinterpret_cast<void**>(&frame.data), data_size,
+                               cudaHostAllocDefault)) != cudaSuccess) {
+      release();
+      return false;
+    }
+    frame.capacity = data_size;
+  }
+
+  // Read the pixels straight into the pinned buffer
+  if (!receive(frame.data, data_size)) {
+    release();
+    return false;
+  }
+  remaining -= data_size;
+  // Skip the meta data
+  if (!skip(remaining)) {
+    release();
+    return false;
+  }
+
+  const size_t element_size = nvidia::gxf::PrimitiveTypeSize(dtype);
+  if ((image_header.endian == IGTL_IMAGE_ENDIAN_BIG) != (igtl_is_little_endian() == 0) &&
+      element_size > 1) {
+    swap_byte_order(frame.data, data_size / element_size, element_size);
+  }
+
+  // Only the sub-volume is transmitted
+  const int32_t width = image_header.subvol_size[0];
+  const int32_t height = image_header.subvol_size[1];
+  const int32_t depth = image_header.subvol_size[2];
+  const int32_t components = image_header.num_components;
+  if (flip_width_height_) {
+    frame.shape = nvidia::gxf::Shape{height, width, components};
+  } else {
+    frame.shape = nvidia::gxf::Shape{width, height, components};
+  }
+  if (depth > 1) {
+    frame.shape = flip_width_height_ ? nvidia::gxf::Shape{depth, height, width, components}
+                                     : nvidia::gxf::Shape{depth, width, height, components};
+  }
+  frame.type = dtype;
+  frame.size = data_size;
+  frame.device_name = header->GetDeviceName();
+
+  // Get time stamp
+  igtlUint32 sec;
+  igtlUint32 nanosec;
+  header->GetTimeStamp(time_stamp_);
+  time_stamp_->GetTimeStamp(&sec, &nanosec);
+  frame.timestamp_ns = int64_t(sec) * 1000000000 + nanosec;
+
+  // Publish the frame, a frame of the same device that was not emitted yet is superseded
+  {
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    const auto superseded =
+        std::find_if(ready_frames_.begin(), ready_frames_.end(), [this, &frame](size_t ready) {
+          return frames_[ready].device_name == frame.device_name;
+        });
+    if (superseded != ready_frames_.end()) {
+      free_frames_.push_back(*superseded);
+      ready_frames_.erase(superseded);
+      ++dropped_frames_;
+    }
+    ready_frames_.push_back(index);
+    frame_available_->event_state(AsynchronousEventState::EVENT_DONE);
+  }
+  return true;
 }
 
 void OpenIGTLinkRxOp::compute(InputContext& op_input, OutputContext& op_output,
               ExecutionContext& context) {
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    if (ready_frames_.empty()) {
+      frame_available_->event_state(AsynchronousEventState::EVENT_WAITING);
+      return;
+    }
+    index = ready_frames_.front();
+    ready_frames_.pop_front();
+    // Stay scheduled while frames of other devices are waiting
+    frame_available_->event_state(ready_frames_.empty() ? AsynchronousEventState::EVENT_WAITING
+                                                        : AsynchronousEventState::EVENT_DONE);
+  }
+  const Frame& frame = frames_[index];
+  const auto release = [this, index]() {
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    free_frames_.push_back(index);
+  };
+
   auto entity = nvidia::gxf::Entity::New(context.context());
   if (!entity) {
+    release();
     throw std::runtime_error("Failed to allocate message for output tensor.");
   }
 
@@ -99,112 +436,35 @@ void OpenIGTLinkRxOp::compute(InputContext& op_input, OutputContext& op_output,
 
   auto tensor = entity.value().add<nvidia::gxf::Tensor>(out_tensor_name_.get().c_str());
   if (!tensor) {
+    release();
     throw std::runtime_error("Failed to allocate output tensor.");
   }
 
-  if (socket_.IsNotNull()) {
-    igtl::MessageHeader::Pointer header;
-    while (1) {
-      header = igtl::MessageHeader::New();
-      header->InitPack();
-      bool timeout = false;
-      igtlUint64 r = socket_->Receive(header->GetPackPointer(), header->GetPackSize(), timeout);
-      if (r == 0) {
-        throw std::runtime_error("Failed to receive message.");
-      }
-      if (r != header->GetPackSize()) {
-        throw std::runtime_error("Packet size zero.");
-      }
-
-      // Deserialize the header
-      header->Unpack();
-      if (header->GetHeaderVersion() != IGTL_HEADER_VERSION_2) {
-        throw std::runtime_error("Version of the client and server doesn't match.");
-      }
-
-      // Get time stamp
-      igtlUint32 sec;
-      igtlUint32 nanosec;
-      header->GetTimeStamp(time_stamp_);
-      time_stamp_->GetTimeStamp(&sec, &nanosec);
-
-      if (strcmp(header->GetDeviceType(), "IMAGE") == 0) {
-        // OBS: Could be GetDeviceName()
-        break;
-      } else {
-        HOLOSCAN_LOG_INFO("Skipping : {}", header->GetDeviceType());
-        socket_->Skip(header->GetBodySizeToRead(), 0);
-      }
-    }
-
-    igtl::ImageMessage::Pointer image_msg;
-    int scalar_type;
-    int size[3];
-    int num_components;
-
-    // Receive image data
-    image_msg = igtl::ImageMessage::New();
-    image_msg->SetMessageHeader(header);
-    image_msg->AllocatePack();
-
-    bool timeout = false;
-    socket_->Receive(image_msg->GetPackBodyPointer(), image_msg->GetPackBodySize(), timeout);
-    int c = image_msg->Unpack(1);
-
-    if (c & igtl::MessageHeader::UNPACK_BODY) {
-      scalar_type = image_msg->GetScalarType();
-      image_msg->GetDimensions(size);
-      num_components = image_msg->GetNumComponents();
-    } else {
-      throw std::runtime_error("Unpacking body failed");
-    }
+  const uint64_t bytes_per_element = nvidia::gxf::PrimitiveTypeSize(frame.type);
+  auto strides = nvidia::gxf::ComputeTrivialStrides(frame.shape, bytes_per_element);
+  auto reshape_result = tensor.value()->reshapeCustom(
+      frame.shape, frame.type, bytes_per_element, strides,
+      nvidia::gxf::MemoryStorageType::kDevice, allocator.value());
+  if (!reshape_result) {
+    release();
+    throw std::runtime_error("Failed to generate tensor.");
+  }
 
-    // Holoscan data type from IGT scalar type
-    nvidia::gxf::PrimitiveType dtype;
-    if (scalar_type == igtl::ImageMessage::TYPE_INT8) {
-      dtype = nvidia::gxf::PrimitiveType::kInt8;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_UINT8) {
-      dtype = nvidia::gxf::PrimitiveType::kUnsigned8;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_INT16) {
-      dtype = nvidia::gxf::PrimitiveType::kInt16;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_UINT16) {
-      dtype = nvidia::gxf::PrimitiveType::kUnsigned16;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_INT32) {
-      dtype = nvidia::gxf::PrimitiveType::kInt32;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_UINT32) {
-      dtype = nvidia::gxf::PrimitiveType::kUnsigned32;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_FLOAT32) {
-      dtype = nvidia::gxf::PrimitiveType::kFloat32;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_FLOAT64) {
-      dtype = nvidia::gxf::PrimitiveType::kFloat64;
-    } else {
-      throw std::runtime_error("Unsupported data type.");
-    }
-    // Shape
-    nvidia::gxf::Shape shape;
-    if (flip_width_height_) {
-      shape = {size[1], size[0], num_components};
-    } else {
-      shape = {size[0], size[1], num_components};
-    }
-    // Size
-    const uint64_t bytes_per_element = nvidia::gxf::PrimitiveTypeSize(dtype);
-    auto strides = nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element);
-    int bytes_size = size[0] * size[1] * num_components * bytes_per_element;
-    // Allocate tensor
-    auto reshape_result = tensor.value()->reshapeCustom(
-        shape, dtype, bytes_per_element, strides, nvidia::gxf::MemoryStorageType::kDevice,
-        allocator.value());
-    if (!reshape_result) {
-      throw std::runtime_error("Failed to generate tensor.");
-    }
-    // Copy data from OpenIGTLink message to tensor
-    CUDA_TRY(cudaMemcpy(
-      (void*)tensor.value()->pointer(),
-      image_msg->GetScalarPointer(),
-      bytes_size,
-      cudaMemcpyHostToDevice));
+  auto timestamp = entity.value().add<nvidia::gxf::Timestamp>("timestamp");
+  if (timestamp) {
+    timestamp.value()->acqtime = frame.timestamp_ns;
   }
+  metadata()->set(kDeviceNameMetadataKey, frame.device_name);
+
+  // Copy data from the pinned frame to the tensor, the frame is free again once that completed
+  CUDA_TRY(cudaMemcpyAsync(
+      tensor.value()->pointer(),
+      frame.data,
+      frame.size,
+      cudaMemcpyHostToDevice,
+      cuda_stream_));
+  CUDA_TRY(cudaStreamSynchronize(cuda_stream_));
+  release();
 
   // Emit output message
   auto result = gxf::Entity(std::move(entity.value()));
@@ -18,6 +18,14 @@
 #ifndef HOLOSCAN_OPERATORS_OPENIGTLINK_RX_HPP
 #define HOLOSCAN_OPERATORS_OPENIGTLINK_RX_HPP
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
 
 #include "igtlMessageHeader.h"
@@ -26,26 +34,69 @@
 
 namespace holoscan::ops {
 
+/**
+ * @brief Operator class to receive images using the OpenIGTLink protocol.
+ *
+ * A receiver thread accepts connections on `port` and reads the pixel data of IMAGE messages
+ * straight into a pool of pinned host frame buffers. compute() is only scheduled once a frame is
+ * complete. The newest frame of each device is kept until it is emitted, older frames of the same
+ * device that were not emitted yet are dropped. Devices are emitted in the order their frames
+ * completed, with the device name in the `device_name` metadata. When the peer disconnects, the
+ * receiver waits for the next connection.
+ */
 class OpenIGTLinkRxOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(OpenIGTLinkRxOp)
 
+  void initialize() override;
   void start() override;
   void stop() override;
   void setup(OperatorSpec& spec) override;
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
  private:
+  /// A pinned host buffer holding one received image
+  struct Frame {
+    uint8_t* data = nullptr;
+    size_t capacity = 0;
+    size_t size = 0;
+    nvidia::gxf::Shape shape;
+    nvidia::gxf::PrimitiveType type = nvidia::gxf::PrimitiveType::kUnsigned8;
+    std::string device_name;
+    int64_t timestamp_ns = 0;
+  };
+
+  /// Receiver thread function
+  void receive_frames();
+  /// Receive the next message, returns false if the connection failed
+  bool receive_message();
+  /// Receive the body of an IMAGE message into a free frame
+  bool receive_image(const igtl::MessageHeader::Pointer& header);
+
   Parameter<holoscan::IOSpec*> out_;
   Parameter<std::shared_ptr<Allocator>> allocator_;
   Parameter<std::string> out_tensor_name_;
   Parameter<int> port_;
   Parameter<bool> flip_width_height_;
+  Parameter<std::vector<std::string>> device_names_;
+  Parameter<uint32_t> num_buffers_;
+
   igtl::ServerSocket::Pointer server_socket_;
   igtl::Socket::Pointer socket_;
   igtl::MessageHeader::Pointer header_;
-  std::map<std::string, std::string> input_;
   igtl::TimeStamp::Pointer time_stamp_;
+
+  std::shared_ptr<AsynchronousCondition> frame_available_;
+  std::thread receive_thread_;
+  std::atomic<bool> running_{false};
+  cudaStream_t cuda_stream_ = nullptr;
+
+  std::mutex frames_mutex_;
+  std::vector<Frame> frames_;
+  std::vector<size_t> free_frames_;
+  /// Indices of the complete frames not emitted yet, at most one per device, oldest first
+  std::deque<size_t> ready_frames_;
+  uint64_t dropped_frames_ = 0;
 };
 
 }  // namespace holoscan::ops
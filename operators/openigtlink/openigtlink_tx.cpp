@@ -17,10 +17,23 @@
 
 #include "openigtlink_tx.hpp"
 
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <utility>
+
 #include "holoscan/operators/holoviz/buffer_info.hpp"
 #include "gxf/multimedia/video.hpp"
 
-#include "igtl_util.h"
+#include "openigtlink_message.hpp"
 
 #ifndef CUDA_TRY
 #define CUDA_TRY(stmt)                                                                     \
@@ -38,15 +51,106 @@
   })
 #endif
 
-void identity_matrix(igtl::Matrix4x4& matrix) {
-  // Populate IGTL matrix as identity
-  matrix[0][0] = 1.0;  matrix[0][1] = 0.0;  matrix[0][2] = 0.0; matrix[0][3] = 0.0;
-  matrix[1][0] = 0.0;  matrix[1][1] = 1.0;  matrix[1][2] = 0.0; matrix[1][3] = 0.0;
-  matrix[2][0] = 0.0;  matrix[2][1] = 0.0;  matrix[2][2] = 1.0; matrix[2][3] = 0.0;
-  matrix[3][0] = 0.0;  matrix[3][1] = 0.0;  matrix[3][2] = 0.0; matrix[3][3] = 1.0;
+namespace holoscan::ops {
+
+using openigtlink::is_float;
+using openigtlink::is_integer;
+using openigtlink::Item;
+using openigtlink::message_type;
+using openigtlink::MessageType;
+using openigtlink::pack;
+using openigtlink::PackedMessage;
+using openigtlink::scalar_type;
+
+namespace {
+
+/// Write all buffers, at most IOV_MAX per system call
+bool write_all(int socket, std::vector<iovec>& iovecs) {
+  size_t first = 0;
+  while (first < iovecs.size()) {
+    msghdr message{};
+    message.msg_iov = &iovecs[first];
+    message.msg_iovlen = std::min<size_t>(iovecs.size() - first, IOV_MAX);
+    ssize_t written = sendmsg(socket, &message, MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) { continue; }
+      HOLOSCAN_LOG_ERROR("OpenIGTLink send failed: {}", strerror(errno));
+      return false;
+    }
+    // Advance past what was written, a partial write continues within a buffer
+    while ((first < iovecs.size()) && (static_cast<size_t>(written) >= iovecs[first].iov_len)) {
+      written -= iovecs[first].iov_len;
+      ++first;
+    }
+    if (written > 0) {
+      iovecs[first].iov_base = static_cast<uint8_t*>(iovecs[first].iov_base) + written;
+      iovecs[first].iov_len -= written;
+    }
+  }
+  return true;
 }
 
-namespace holoscan::ops {
+}  // namespace
+
+/// The inputs of one compute() call
+struct OpenIGTLinkTxOp::Batch {
+  ~Batch() {
+    if (ready) { cudaEventDestroy(ready); }
+  }
+
+  std::vector<Item> items;
+  uint64_t timestamp = 0;
+  // Keep the input tensors alive until they were sent
+  std::vector<holoscan::gxf::Entity> entities;
+  // Host copies of device data
+  std::vector<std::shared_ptr<uint8_t>> pinned;
+  // Recorded after the copies of device data, nullptr if there is no device data
+  cudaEvent_t ready = nullptr;
+};
+
+/// Pinned host buffers for device data, reused once a batch was sent
+class OpenIGTLinkTxOp::PinnedBufferPool
+    : public std::enable_shared_from_this<OpenIGTLinkTxOp::PinnedBufferPool> {
+ public:
+  ~PinnedBufferPool() {
+    for (auto& buffer : free_) { cudaFreeHost(buffer.second); }
+  }
+
+  std::shared_ptr<uint8_t> acquire(size_t size) {
+    uint8_t* buffer = nullptr;
+    size_t capacity = 0;
+    {
+      // take the smallest free buffer that is large enough
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto best = free_.end();
+      for (auto it = free_.begin(); it != free_.end(); ++it) {
+        if ((it->first >= size) && ((best == free_.end()) || (it->first < best->first))) {
+          best = it;
+        }
+      }
+      if (best != free_.end()) {
+        capacity = best->first;
+        buffer = best->second;
+        free_.erase(best);
+      }
+    }
+    if (!buffer) {
+      if (CUDA_TRY(cudaMallocHost(reinterpret_cast<void**>(&buffer), size)) != cudaSuccess) {
+        throw std::runtime_error("Failed to allocate pinned memory.");
+      }
+      capacity = size;
+    }
+    return std::shared_ptr<uint8_t>(
+        buffer, [pool = shared_from_this(), capacity](uint8_t* buffer) {
+          std::lock_guard<std::mutex> lock(pool->mutex_);
+          pool->free_.emplace_back(capacity, buffer);
+        });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::pair<size_t, uint8_t*>> free_;
+};
 
 void OpenIGTLinkTxOp::setup(OperatorSpec& spec) {
   spec.param(receivers_, "receivers", "Input Receivers", "List of input receivers.", {});
@@ -74,24 +178,97 @@ void OpenIGTLinkTxOp::setup(OperatorSpec& spec) {
     "InputNames",
     "Names of input messages.",
     std::vector<std::string>{});
+  spec.param(
+    message_types_,
+    "message_types",
+    "MessageTypes",
+    "OpenIGTLink message type of each input: IMAGE, TRANSFORM, POINT or POLYDATA. All inputs "
+    "are sent as IMAGE if empty.",
+    std::vector<std::string>{});
+  spec.param(
+    max_queue_size_,
+    "max_queue_size",
+    "MaxQueueSize",
+    "Maximum number of inputs waiting to be sent, the oldest are dropped when exceeded.",
+    4U);
+}
+
+bool OpenIGTLinkTxOp::connect() {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* addresses = nullptr;
+  if (getaddrinfo(host_name_.get().c_str(),
+                  std::to_string(port_.get()).c_str(),
+                  &hints,
+                  &addresses) != 0) {
+    return false;
+  }
+  for (addrinfo* address = addresses; address; address = address->ai_next) {
+    socket_ = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (socket_ == -1) { continue; }
+    if (::connect(socket_, address->ai_addr, address->ai_addrlen) == 0) { break; }
+    close(socket_);
+    socket_ = -1;
+  }
+  freeaddrinfo(addresses);
+  if (socket_ == -1) { return false; }
+
+  // Small messages such as transforms are sent right away
+  int no_delay = 1;
+  setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+  return true;
 }
 
 void OpenIGTLinkTxOp::start() {
-  // Create client socket
-  client_socket_ = igtl::ClientSocket::New();
+  if (!message_types_.get().empty() &&
+      (message_types_.get().size() != input_names_.get().size())) {
+    throw std::runtime_error("message_types must have one entry for each of input_names.");
+  }
+  for (const auto& name : message_types_.get()) {
+    MessageType type;
+    if (!message_type(name, type)) {
+      throw std::runtime_error(fmt::format("Unsupported OpenIGTLink message type '{}'.", name));
+    }
+  }
+
   HOLOSCAN_LOG_INFO("Connecting to OpenIGTLink server...");
-  int r = client_socket_->ConnectToServer(host_name_.get().c_str(), port_.get());
-  if (r < 0) {
+  if (!connect()) {
     throw std::runtime_error("Cannot connect to server.");
   }
   HOLOSCAN_LOG_INFO("Connection successful");
   // Create timer
   time_stamp_ = igtl::TimeStamp::New();
+
+  CUDA_TRY(cudaStreamCreateWithFlags(&cuda_stream_, cudaStreamNonBlocking));
+  pinned_buffers_ = std::make_shared<PinnedBufferPool>();
+
+  running_ = true;
+  sender_thread_ = std::thread(&OpenIGTLinkTxOp::send_batches, this);
 }
 
 void OpenIGTLinkTxOp::stop() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    running_ = false;
+    queue_.clear();
+  }
+  queue_cv_.notify_all();
+  if (sender_thread_.joinable()) { sender_thread_.join(); }
+
   // Close connection
-  client_socket_->CloseSocket();
+  if (socket_ != -1) {
+    close(socket_);
+    socket_ = -1;
+  }
+  if (cuda_stream_) {
+    cudaStreamSynchronize(cuda_stream_);
+    cudaStreamDestroy(cuda_stream_);
+    cuda_stream_ = nullptr;
+  }
+  HOLOSCAN_LOG_INFO("OpenIGTLinkTxOp: {} messages sent, {} inputs dropped",
+                    sent_messages_,
+                    dropped_batches_);
 }
 
 void OpenIGTLinkTxOp::compute(InputContext& op_input, OutputContext& op_output,
@@ -99,114 +276,120 @@ void OpenIGTLinkTxOp::compute(InputContext& op_input, OutputContext& op_output,
   std::vector<gxf::Entity> messages_h =
       op_input.receive<std::vector<gxf::Entity>>("receivers").value();
 
-  std::vector<nvidia::gxf::Entity> messages;
-  messages.reserve(messages_h.size());
-  for (auto& message_h : messages_h) {
-    // cast each holoscan::gxf:Entity to its base class
-    nvidia::gxf::Entity message = static_cast<nvidia::gxf::Entity>(message_h);
-    messages.push_back(message);
-  }
+  auto batch = std::make_shared<Batch>();
+  // Get time stamp
+  time_stamp_->GetTime();
+  batch->timestamp = time_stamp_->GetTimeStampUint64();
+
+  // Device data is copied to pinned memory, the sender waits for the copies to complete
+  const auto to_host = [this, &batch](const void* pointer, size_t size,
+                                      nvidia::gxf::MemoryStorageType storage_type) {
+    if (storage_type != nvidia::gxf::MemoryStorageType::kDevice) {
+      return static_cast<const uint8_t*>(pointer);
+    }
+    auto buffer = pinned_buffers_->acquire(size);
+    CUDA_TRY(cudaMemcpyAsync(
+        buffer.get(), pointer, size, cudaMemcpyDeviceToHost, cuda_stream_));
+    batch->pinned.push_back(buffer);
+    return static_cast<const uint8_t*>(buffer.get());
+  };
+
+  for (size_t i = 0; i < input_names_.get().size(); ++i) {
+    const std::string& name = input_names_.get()[i];
+    MessageType type = MessageType::IMAGE;
+    if (!message_types_.get().empty()) { message_type(message_types_.get()[i], type); }
 
-  for (int i=0; i < input_names_.get().size(); ++i) {
     // Loop over input messages
-    auto message = messages.begin();
     bool found = false;
-    std::string name = input_names_.get()[i];
-
-    // Check if message is in supported message types
-    while (message != messages.end()) {
-      // Message can be either tensor or video buffer
-      auto maybe_input_tensor = message->get<nvidia::gxf::Tensor>(name.c_str());
-      auto maybe_input_video = message->get<nvidia::gxf::VideoBuffer>(name.c_str());
-
-      // Get buffer info
-      BufferInfo buffer_info;
-      gxf_result_t result;
-      if (maybe_input_tensor) {
-        result = buffer_info.init(maybe_input_tensor.value());
-      } else if (maybe_input_video) {
-        result = buffer_info.init(maybe_input_video.value());
-      } else {
-        ++message;
-        continue;
-      }
-      found = true;
+    for (auto& message_h : messages_h) {
+      // cast each holoscan::gxf:Entity to its base class
+      nvidia::gxf::Entity message = static_cast<nvidia::gxf::Entity>(message_h);
+      auto maybe_input_tensor = message.get<nvidia::gxf::Tensor>(name.c_str());
 
-      if (result != GXF_SUCCESS) {
-        throw std::runtime_error(
-          fmt::format("Unsupported buffer format tensor/video buffer '{}'", name));
-      }
+      Item item;
+      item.type = type;
+      if (type == MessageType::IMAGE) {
+        // Message can be either tensor or video buffer
+        auto maybe_input_video = message.get<nvidia::gxf::VideoBuffer>(name.c_str());
 
-      // If the buffer is empty, skip processing it
-      if (buffer_info.bytes_size == 0) { continue; }
-
-      // Get time stamp
-      time_stamp_->GetTime();
-      // Image properties
-      int size[] = {
-        static_cast<int>(buffer_info.width),
-        static_cast<int>(buffer_info.height),
-        1
-      };
-      float spacing[]  = {1.0, 1.0, 1.0};
-      int endian = igtl::ImageMessage::ENDIAN_BIG;
-      if (igtl_is_little_endian()) {
-        endian = igtl::ImageMessage::ENDIAN_LITTLE;
-      }
-      // IGT scalar type from Holoscan data type
-      int scalar_type;
-      if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt8) {
-        scalar_type = igtl::ImageMessage::TYPE_INT8;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned8) {
-        scalar_type = igtl::ImageMessage::TYPE_UINT8;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt16) {
-        scalar_type = igtl::ImageMessage::TYPE_INT16;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned16) {
-        scalar_type = igtl::ImageMessage::TYPE_UINT16;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt32) {
-        scalar_type = igtl::ImageMessage::TYPE_INT32;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned32) {
-        scalar_type = igtl::ImageMessage::TYPE_UINT32;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kFloat32) {
-        scalar_type = igtl::ImageMessage::TYPE_FLOAT32;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kFloat64) {
-        scalar_type = igtl::ImageMessage::TYPE_FLOAT64;
-      } else {
-        throw std::runtime_error("Unsupported scalar type.");
-      }
-      // Create OpenIGTLink image message
-      igtl::ImageMessage::Pointer image_msg = igtl::ImageMessage::New();
-      image_msg->SetDimensions(size);
-      image_msg->SetSpacing(spacing);
-      image_msg->SetScalarType(scalar_type);
-      image_msg->SetEndian(endian);
-      image_msg->SetDeviceName(device_name_.get());
-      image_msg->SetTimeStamp(time_stamp_);
-      image_msg->SetNumComponents(buffer_info.components);
-      image_msg->AllocateScalars();
-      // Copy image data to message
-      if (buffer_info.storage_type == nvidia::gxf::MemoryStorageType::kDevice) {
-        // Copy device to host
-        CUDA_TRY(cudaMemcpy(
-          image_msg->GetScalarPointer(),
-          static_cast<const void*>(buffer_info.buffer_ptr),
-          buffer_info.bytes_size,
-          cudaMemcpyDeviceToHost));
+        // Get buffer info
+        BufferInfo buffer_info;
+        gxf_result_t result;
+        if (maybe_input_tensor) {
+          result = buffer_info.init(maybe_input_tensor.value());
+        } else if (maybe_input_video) {
+          result = buffer_info.init(maybe_input_video.value());
+        } else {
+          continue;
+        }
+        found = true;
+
+        if (result != GXF_SUCCESS) {
+          throw std::runtime_error(
+            fmt::format("Unsupported buffer format tensor/video buffer '{}'", name));
+        }
+
+        // If the buffer is empty, skip processing it
+        if (buffer_info.bytes_size == 0) { break; }
+
+        item.scalar_type = scalar_type(buffer_info.element_type);
+        if (item.scalar_type < 0) {
+          throw std::runtime_error("Unsupported scalar type.");
+        }
+        item.width = buffer_info.width;
+        item.height = buffer_info.height;
+        item.components = buffer_info.components;
+        item.size = buffer_info.bytes_size;
+        item.data = to_host(buffer_info.buffer_ptr, item.size, buffer_info.storage_type);
       } else {
-        // Copy host to host
-        std::memcpy(
-          image_msg->GetScalarPointer(),
-          static_cast<const void*>(buffer_info.buffer_ptr),
-          image_msg->GetImageSize());
+        if (!maybe_input_tensor) { continue; }
+        found = true;
+        const auto& tensor = maybe_input_tensor.value();
+        item.element_type = tensor->element_type();
+        item.size = tensor->size();
+        if (!is_float(item.element_type)) {
+          throw std::runtime_error(
+            fmt::format("Tensor '{}' must be float32 or float64.", name));
+        }
+
+        const size_t elements = tensor->element_count();
+        if (type == MessageType::TRANSFORM) {
+          if ((elements != 16) && (elements != 12)) {
+            throw std::runtime_error(
+              fmt::format("TRANSFORM tensor '{}' must be a 4x4 or 3x4 matrix.", name));
+          }
+        } else {
+          item.height = tensor->rank() == 2 ? tensor->shape().dimension(0) : 0;
+          item.width = tensor->rank() == 2 ? tensor->shape().dimension(1) : 0;
+          const bool valid_columns = (item.width == 3) ||
+                                     ((type == MessageType::POINT) && (item.width == 4));
+          if (!valid_columns) {
+            throw std::runtime_error(fmt::format(
+              "{} tensor '{}' must have shape [N, 3]{}.",
+              type == MessageType::POINT ? "POINT" : "POLYDATA",
+              name,
+              type == MessageType::POINT ? " or [N, 4]" : ""));
+          }
+
+          auto maybe_triangles = message.get<nvidia::gxf::Tensor>((name + "_triangles").c_str());
+          if ((type == MessageType::POLYDATA) && maybe_triangles) {
+            const auto& triangles = maybe_triangles.value();
+            if ((triangles->rank() != 2) || (triangles->shape().dimension(1) != 3) ||
+                !is_integer(triangles->element_type())) {
+              throw std::runtime_error(fmt::format(
+                "Tensor '{}_triangles' must be an integer tensor of shape [M, 3].", name));
+            }
+            item.triangle_count = triangles->shape().dimension(0);
+            item.triangle_type = triangles->element_type();
+            item.triangles = to_host(triangles->pointer(), triangles->size(),
+                                     triangles->storage_type());
+          }
+        }
+        item.data = to_host(tensor->pointer(), item.size, tensor->storage_type());
       }
-      // Set orientation matrix to identity
-      igtl::Matrix4x4 matrix;
-      identity_matrix(matrix);
-      image_msg->SetMatrix(matrix);
-      // Send message
-      image_msg->Pack();
-      client_socket_->Send(image_msg->GetPackPointer(), image_msg->GetPackSize());
 
+      batch->items.push_back(item);
+      batch->entities.push_back(message_h);
       break;
     }
 
@@ -215,6 +398,78 @@ void OpenIGTLinkTxOp::compute(InputContext& op_input, OutputContext& op_output,
         fmt::format("Tensor named `{}` not found in input messages.", name));
     }
   }
+  if (batch->items.empty()) { return; }
+
+  if (!batch->pinned.empty()) {
+    CUDA_TRY(cudaEventCreateWithFlags(&batch->ready, cudaEventDisableTiming));
+    CUDA_TRY(cudaEventRecord(batch->ready, cuda_stream_));
+  }
+
+  // Hand the batch to the sender, drop the oldest one if the sender falls behind
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if ((max_queue_size_.get() > 0) && (queue_.size() >= max_queue_size_.get())) {
+      queue_.pop_front();
+      ++dropped_batches_;
+    }
+    queue_.push_back(std::move(batch));
+  }
+  queue_cv_.notify_one();
+}
+
+void OpenIGTLinkTxOp::send_batches() {
+  std::vector<std::shared_ptr<Batch>> batches;
+  bool connected = true;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+      if (!running_) { break; }
+      // Everything queued since the last write is coalesced
+      batches.assign(queue_.begin(), queue_.end());
+      queue_.clear();
+    }
+
+    if ((socket_ == -1) && !connect()) {
+      if (connected) { HOLOSCAN_LOG_ERROR("Cannot reconnect to OpenIGTLink server."); }
+      connected = false;
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      dropped_batches_ += batches.size();
+    } else {
+      if (!connected) { HOLOSCAN_LOG_INFO("Reconnected to OpenIGTLink server."); }
+      connected = true;
+      if (!send(batches)) {
+        HOLOSCAN_LOG_ERROR("Lost connection to OpenIGTLink server, reconnecting.");
+        close(socket_);
+        socket_ = -1;
+      }
+    }
+    batches.clear();
+  }
+}
+
+bool OpenIGTLinkTxOp::send(const std::vector<std::shared_ptr<Batch>>& batches) {
+  std::vector<PackedMessage> messages;
+  for (const auto& batch : batches) {
+    if (batch->ready) { CUDA_TRY(cudaEventSynchronize(batch->ready)); }
+    for (const auto& item : batch->items) {
+      messages.emplace_back();
+      pack(item, batch->timestamp, device_name_.get(), messages.back());
+    }
+  }
+
+  std::vector<iovec> iovecs;
+  iovecs.reserve(messages.size() * 3);
+  for (auto& message : messages) {
+    iovecs.push_back({message.header.data(), message.header.size()});
+    iovecs.push_back({message.body.data(), message.body.size()});
+    if (message.payload_size > 0) {
+      iovecs.push_back({const_cast<uint8_t*>(message.payload), message.payload_size});
+    }
+  }
+  if (!write_all(socket_, iovecs)) { return false; }
+  sent_messages_ += messages.size();
+  return true;
 }
 
 }  // namespace holoscan::ops
@@ -18,15 +18,36 @@
 #ifndef HOLOSCAN_OPERATORS_OPENIGTLINK_TX_HPP
 #define HOLOSCAN_OPERATORS_OPENIGTLINK_TX_HPP
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
 
-#include "igtlClientSocket.h"
-#include "igtlImageMessage.h"
-#include "igtlMath.h"
 #include "igtlTimeStamp.h"
 
 namespace holoscan::ops {
 
+/**
+ * @brief Operator class to send data using the OpenIGTLink protocol.
+ *
+ * Each input named in `input_names` is sent as the message type at the same index of
+ * `message_types`:
+ * - IMAGE: a tensor or video buffer, the pixel data is sent as is
+ * - TRANSFORM: a tensor of a 4x4 or 3x4 matrix, row-major
+ * - POINT: a tensor of N points [N, 3], or [N, 4] with a radius
+ * - POLYDATA: a tensor of N vertices [N, 3], with an optional tensor `<name>_triangles` of M
+ *   triangles [M, 3] in the same message
+ *
+ * compute() only collects the inputs and starts copying device data to pinned host memory. A
+ * sender thread packs the messages and writes them with scatter-gather I/O, so the pixel data of
+ * host images is sent without copying it into a message body, and all messages queued since the
+ * previous write are coalesced into one system call.
+ */
 class OpenIGTLinkTxOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(OpenIGTLinkTxOp)
@@ -37,14 +58,36 @@ class OpenIGTLinkTxOp : public Operator {
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
  private:
+  struct Batch;
+  class PinnedBufferPool;
+
+  /// Connect to the server, returns false on failure
+  bool connect();
+  /// Sender thread function
+  void send_batches();
+  /// Pack and write the messages of batches, returns false if the connection failed
+  bool send(const std::vector<std::shared_ptr<Batch>>& batches);
+
   Parameter<std::vector<holoscan::IOSpec*>> receivers_;
   Parameter<std::vector<std::string>> input_names_;
+  Parameter<std::vector<std::string>> message_types_;
   Parameter<std::string> device_name_;
   Parameter<std::string> host_name_;
   Parameter<int> port_;
-  igtl::ClientSocket::Pointer client_socket_;
-  std::map<std::string, std::string> input_;
+  Parameter<uint32_t> max_queue_size_;
+
+  int socket_ = -1;
   igtl::TimeStamp::Pointer time_stamp_;
+  cudaStream_t cuda_stream_ = nullptr;
+  std::shared_ptr<PinnedBufferPool> pinned_buffers_;
+
+  std::thread sender_thread_;
+  bool running_ = false;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<std::shared_ptr<Batch>> queue_;
+  uint64_t dropped_batches_ = 0;
+  uint64_t sent_messages_ = 0;
 };
 
 }  // namespace holoscan::ops
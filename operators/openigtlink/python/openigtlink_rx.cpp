@@ -19,10 +19,12 @@
 #include "./openigtlink_rx_pydoc.hpp"
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../../operator_util.hpp"
 #include <holoscan/core/fragment.hpp>
@@ -48,11 +50,15 @@ class PyOpenIGTLinkRxOp : public OpenIGTLinkRxOp {
   // Define a constructor that fully initializes the object.
   PyOpenIGTLinkRxOp(Fragment* fragment, const py::args& args, std::shared_ptr<Allocator> allocator,
                     int port = 0, const std::string& out_tensor_name = std::string(""),
-                    bool flip_width_height = true, const std::string& name = "openigtlink_rx")
+                    bool flip_width_height = true,
+                    const std::vector<std::string>& device_names = std::vector<std::string>{},
+                    uint32_t num_buffers = 3, const std::string& name = "openigtlink_rx")
       : OpenIGTLinkRxOp(ArgList{Arg{"allocator", allocator},
                                 Arg{"port", port},
                                 Arg{"out_tensor_name", out_tensor_name},
-                                Arg{"flip_width_height", flip_width_height}}) {
+                                Arg{"flip_width_height", flip_width_height},
+                                Arg{"device_names", device_names},
+                                Arg{"num_buffers", num_buffers}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -86,12 +92,16 @@ PYBIND11_MODULE(_openigtlink_rx, m) {
                     int,
                     const std::string&,
                     bool,
+                    const std::vector<std::string>&,
+                    uint32_t,
                     const std::string&>(),
            "fragment"_a,
            "allocator"_a,
            "port"_a = 1,
            "out_tensor_name"_a = ""s,
            "flip_width_height"_a = true,
+           "device_names"_a = std::vector<std::string>{},
+           "num_buffers"_a = 3,
            "name"_a = "openigtlink_rx"s,
            doc::OpenIGTLinkRxOp::doc_OpenIGTLinkRxOp_python)
       .def("setup", &OpenIGTLinkRxOp::setup, "spec"_a, doc::OpenIGTLinkRxOp::doc_setup);
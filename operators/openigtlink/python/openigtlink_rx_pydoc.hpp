@@ -27,17 +27,23 @@ namespace holoscan::doc {
 namespace OpenIGTLinkRxOp {
 
 PYDOC(OpenIGTLinkRxOp, R"doc(
-Operator class to send data using the OpenIGTLink protocol.
+Operator class to receive data using the OpenIGTLink protocol.
+
+A receiver thread reads IMAGE messages into pinned frame buffers. The operator is scheduled
+once a frame is complete and emits the newest frame of each device, with the device name in the
+"device_name" metadata. Frames of a device superseded before they were emitted are dropped. The
+receiver accepts a new connection when the peer disconnects.
 )doc")
 
 // PyOpenIGTLinkRxOp Constructor
 PYDOC(OpenIGTLinkRxOp_python, R"doc(
-Operator class to send data using the OpenIGTLink protocol.
+Operator class to receive data using the OpenIGTLink protocol.
 
 Named outputs:
     out_tensor: nvidia::gxf::Tensor
         Emits a message containing a tensor named "out_tensor" that contains
-        the OpenIGTLink Image message converted to nvidia::gxf::Tensor.
+        the OpenIGTLink Image message converted to nvidia::gxf::Tensor, and a
+        timestamp with the time stamp of the message.
 
 Parameters
 ----------
@@ -51,6 +57,10 @@ out_tensor_name : str, optional
     Name of output tensor.
 flip_width_height : bool, optional
     Flip width and height (necessary for receiving from 3D Slicer).
+device_names : list of str, optional
+    Device names of the IMAGE messages to receive, all are received if empty.
+num_buffers : int, optional
+    Number of pinned frame buffers, at least 3 and at least the number of device names plus 2.
 
 name : str, optional
     The name of the operator.
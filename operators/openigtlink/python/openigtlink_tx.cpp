@@ -51,11 +51,15 @@ class PyOpenIGTLinkTxOp : public OpenIGTLinkTxOp {
                     const std::string& host_name = std::string(""), int port = 0,
                     const std::string& device_name = std::string("Holoscan"),
                     const std::vector<std::string>& input_names = std::vector<std::string>{},
+                    const std::vector<std::string>& message_types = std::vector<std::string>{},
+                    uint32_t max_queue_size = 4,
                     const std::string& name = "openigtlink_tx")
       : OpenIGTLinkTxOp(ArgList{Arg{"host_name", host_name},
                                 Arg{"port", port},
                                 Arg{"device_name", device_name},
-                                Arg{"input_names", input_names}}) {
+                                Arg{"input_names", input_names},
+                                Arg{"message_types", message_types},
+                                Arg{"max_queue_size", max_queue_size}}) {
     if (receivers.size() > 0) { this->add_arg(Arg{"receivers", receivers}); }
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
@@ -91,6 +95,8 @@ PYBIND11_MODULE(_openigtlink_tx, m) {
                     int,
                     const std::string&,
                     const std::vector<std::string>&,
+                    const std::vector<std::string>&,
+                    uint32_t,
                     const std::string&>(),
            "fragment"_a,
            "receivers"_a = std::vector<holoscan::IOSpec*>(),
@@ -98,6 +104,8 @@ PYBIND11_MODULE(_openigtlink_tx, m) {
            "port"_a = 1,
            "device_name"_a = "Holoscan"s,
            "input_names"_a = std::vector<std::string>{},
+           "message_types"_a = std::vector<std::string>{},
+           "max_queue_size"_a = 4U,
            "name"_a = "openigtlink_tx"s,
            doc::OpenIGTLinkTxOp::doc_OpenIGTLinkTxOp_python)
       .def("setup", &OpenIGTLinkTxOp::setup, "spec"_a, doc::OpenIGTLinkTxOp::doc_setup);
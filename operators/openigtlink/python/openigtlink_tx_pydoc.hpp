@@ -36,8 +36,8 @@ Operator class to transmit data using the OpenIGTLink protocol.
 
 Named inputs:
     receivers: multi-receiver accepting nvidia::gxf::Tensor and/or nvidia::gxf::VideoBuffer
-        The inputs are converted to igtl::ImageMessage and sent out over the network with
-        the OpenIGTLink protocol.
+        The inputs are packed as OpenIGTLink IMAGE, TRANSFORM, POINT or POLYDATA messages and
+        sent out over the network by a sender thread.
 
 Parameters
 ----------
@@ -51,6 +51,11 @@ host_name : str, optional.
     Host name.
 port : integer, optional
     Port number of server.
+message_types : std::vector<std::string>, optional.
+    OpenIGTLink message type of each input: IMAGE, TRANSFORM, POINT or POLYDATA. All inputs are
+    sent as IMAGE if empty.
+max_queue_size : int, optional
+    Maximum number of inputs waiting to be sent, the oldest are dropped when exceeded.
 
 name : str, optional
     The name of the operator.
@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "openigtlink_message.hpp"
+
+#include "igtl_header.h"
+#include "igtl_image.h"
+#include "igtl_point.h"
+#include "igtl_polydata.h"
+#include "igtl_transform.h"
+#include "igtl_util.h"
+
+// The messages packed by OpenIGTLinkTxOp are unpacked with the OpenIGTLink C library, as a
+// receiver does
+namespace holoscan::ops::openigtlink {
+
+namespace {
+
+constexpr uint64_t kTimestamp = 0x0123456789abcdefULL;
+const std::string kDeviceName = "Holoscan";
+
+/// Item of a row-major tensor of `rows` x `columns` floats
+Item float_item(MessageType type, const std::vector<float>& values, int32_t rows,
+                int32_t columns) {
+  Item item;
+  item.type = type;
+  item.data = reinterpret_cast<const uint8_t*>(values.data());
+  item.size = values.size() * sizeof(float);
+  item.element_type = nvidia::gxf::PrimitiveType::kFloat32;
+  item.width = columns;
+  item.height = rows;
+  return item;
+}
+
+/// The message body followed by the data sent in place
+std::vector<uint8_t> full_body(const PackedMessage& message) {
+  std::vector<uint8_t> body(message.body);
+  body.insert(body.end(), message.payload, message.payload + message.payload_size);
+  return body;
+}
+
+/// Check the header of a packed message and return its body
+std::vector<uint8_t> unpack_header(const PackedMessage& message, const char* type_name) {
+  EXPECT_EQ(message.header.size(), IGTL_HEADER_SIZE);
+  igtl_header header;
+  std::memcpy(&header, message.header.data(), IGTL_HEADER_SIZE);
+  igtl_header_convert_byte_order(&header);
+
+  std::vector<uint8_t> body = full_body(message);
+  EXPECT_EQ(header.header_version, 1);
+  EXPECT_EQ(std::string(header.name, strnlen(header.name, IGTL_HEADER_TYPE_SIZE)), type_name);
+  EXPECT_EQ(std::string(header.device_name, strnlen(header.device_name, IGTL_HEADER_NAME_SIZE)),
+            kDeviceName);
+  EXPECT_EQ(header.timestamp, kTimestamp);
+  EXPECT_EQ(header.body_size, body.size());
+  EXPECT_EQ(header.crc, igtl_crc64(body.data(), body.size(), 0));
+  return body;
+}
+
+}  // namespace
+
+TEST(OpenIGTLinkMessage, Image) {
+  // 3 x 2 pixels of 2 components, 16 bit
+  const std::vector<uint16_t> pixels = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  Item item;
+  item.type = MessageType::IMAGE;
+  item.data = reinterpret_cast<const uint8_t*>(pixels.data());
+  item.size = pixels.size() * sizeof(uint16_t);
+  item.element_type = nvidia::gxf::PrimitiveType::kUnsigned16;
+  item.width = 3;
+  item.height = 2;
+  item.components = 2;
+  item.scalar_type = scalar_type(item.element_type);
+  PackedMessage message;
+  pack(item, kTimestamp, kDeviceName, message);
+
+  const std::vector<uint8_t> body = unpack_header(message, "IMAGE");
+  ASSERT_EQ(message.body.size(), IGTL_IMAGE_HEADER_SIZE);
+  EXPECT_EQ(message.payload, item.data);
+
+  igtl_image_header image_header;
+  std::memcpy(&image_header, body.data(), IGTL_IMAGE_HEADER_SIZE);
+  igtl_image_convert_byte_order(&image_header);
+  EXPECT_EQ(image_header.header_version, 1);
+  EXPECT_EQ(image_header.num_components, 2);
+  EXPECT_EQ(image_header.scalar_type, IGTL_IMAGE_STYPE_TYPE_UINT16);
+  EXPECT_EQ(image_header.endian,
+            igtl_is_little_endian() ? IGTL_IMAGE_ENDIAN_LITTLE : IGTL_IMAGE_ENDIAN_BIG);
+  EXPECT_EQ(image_header.coord, IGTL_IMAGE_COORD_RAS);
+  const uint16_t size[3] = {3, 2, 1};
+  for (int axis = 0; axis < 3; ++axis) {
+    EXPECT_EQ(image_header.size[axis], size[axis]);
+    EXPECT_EQ(image_header.subvol_offset[axis], 0);
+    EXPECT_EQ(image_header.subvol_size[axis], size[axis]);
+  }
+  const float matrix[12] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f};
+  for (int index = 0; index < 12; ++index) { EXPECT_EQ(image_header.matrix[index], matrix[index]); }
+  EXPECT_EQ(igtl_image_get_data_size(&image_header), item.size);
+  EXPECT_EQ(std::memcmp(body.data() + IGTL_IMAGE_HEADER_SIZE, pixels.data(), item.size), 0);
+}
+
+TEST(OpenIGTLinkMessage, Transform) {
+  // Row-major 3 x 4: rotation and translation
+  const std::vector<float> values = {1.f, 2.f, 3.f, 10.f,
+                                     4.f, 5.f, 6.f, 20.f,
+                                     7.f, 8.f, 9.f, 30.f};
+  PackedMessage message;
+  pack(float_item(MessageType::TRANSFORM, values, 3, 4), kTimestamp, kDeviceName, message);
+
+  const std::vector<uint8_t> body = unpack_header(message, "TRANSFORM");
+  ASSERT_EQ(body.size(), IGTL_TRANSFORM_SIZE);
+  igtl_float32 transform[12];
+  std::memcpy(transform, body.data(), IGTL_TRANSFORM_SIZE);
+  igtl_transform_convert_byte_order(transform);
+  // OpenIGTLink sends the rotation column by column, then the translation
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 3; ++row) {
+      EXPECT_EQ(transform[column * 3 + row], values[row * 4 + column]);
+    }
+  }
+}
+
+TEST(OpenIGTLinkMessage, Point) {
+  // Two points with a radius
+  const std::vector<float> values = {1.f, 2.f, 3.f, 0.5f, 4.f, 5.f, 6.f, 1.5f};
+  PackedMessage message;
+  pack(float_item(MessageType::POINT, values, 2, 4), kTimestamp, kDeviceName, message);
+
+  const std::vector<uint8_t> body = unpack_header(message, "POINT");
+  ASSERT_EQ(body.size(), 2 * IGTL_POINT_ELEMENT_SIZE);
+  igtl_point_element points[2];
+  std::memcpy(points, body.data(), body.size());
+  igtl_point_convert_byte_order(points, 2);
+  for (int point = 0; point < 2; ++point) {
+    EXPECT_EQ(std::string(points[point].name), std::to_string(point));
+    EXPECT_EQ(std::string(points[point].group_name), "Point");
+    for (int axis = 0; axis < 3; ++axis) {
+      EXPECT_EQ(points[point].position[axis], values[point * 4 + axis]);
+    }
+    EXPECT_EQ(points[point].radius, values[point * 4 + 3]);
+  }
+}
+
+TEST(OpenIGTLinkMessage, PolyData) {
+  // A triangle, the indices are int32 as received from a tensor
+  const std::vector<float> vertices = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+  const std::vector<int32_t> triangles = {0, 1, 2};
+  Item item = float_item(MessageType::POLYDATA, vertices, 3, 3);
+  item.triangles = reinterpret_cast<const uint8_t*>(triangles.data());
+  item.triangle_count = 1;
+  item.triangle_type = nvidia::gxf::PrimitiveType::kInt32;
+  PackedMessage message;
+  pack(item, kTimestamp, kDeviceName, message);
+
+  std::vector<uint8_t> body = unpack_header(message, "POLYDATA");
+  igtl_polydata_info info;
+  igtl_polydata_init_info(&info);
+  ASSERT_EQ(igtl_polydata_unpack(IGTL_TYPE_PREFIX_NONE, body.data(), &info, body.size()), 1);
+  EXPECT_EQ(info.header.npoints, 3u);
+  EXPECT_EQ(info.header.nvertices, 0u);
+  EXPECT_EQ(info.header.nlines, 0u);
+  EXPECT_EQ(info.header.npolygons, 1u);
+  EXPECT_EQ(info.header.size_polygons, 4 * sizeof(igtl_uint32));
+  EXPECT_EQ(info.header.ntriangle_strips, 0u);
+  EXPECT_EQ(info.header.nattributes, 0u);
+  for (size_t index = 0; index < vertices.size(); ++index) {
+    EXPECT_EQ(info.points[index], vertices[index]);
+  }
+  EXPECT_EQ(info.polygons[0], 3u);
+  for (int corner = 0; corner < 3; ++corner) {
+    EXPECT_EQ(info.polygons[1 + corner], static_cast<igtl_uint32>(triangles[corner]));
+  }
+  igtl_polydata_free_info(&info);
+}
+
+TEST(OpenIGTLinkMessage, PolyDataVertices) {
+  // Without triangles every point is a vertex
+  const std::vector<float> points = {0.f, 0.f, 0.f, 1.f, 2.f, 3.f};
+  PackedMessage message;
+  pack(float_item(MessageType::POLYDATA, points, 2, 3), kTimestamp, kDeviceName, message);
+
+  std::vector<uint8_t> body = unpack_header(message, "POLYDATA");
+  igtl_polydata_info info;
+  igtl_polydata_init_info(&info);
+  ASSERT_EQ(igtl_polydata_unpack(IGTL_TYPE_PREFIX_NONE, body.data(), &info, body.size()), 1);
+  EXPECT_EQ(info.header.npoints, 2u);
+  EXPECT_EQ(info.header.nvertices, 2u);
+  EXPECT_EQ(info.header.npolygons, 0u);
+  for (uint32_t vertex = 0; vertex < 2; ++vertex) {
+    EXPECT_EQ(info.vertices[vertex * 2], 1u);
+    EXPECT_EQ(info.vertices[vertex * 2 + 1], vertex);
+  }
+  igtl_polydata_free_info(&info);
+}
+
+TEST(OpenIGTLinkMessage, MessageTypes) {
+  MessageType type;
+  EXPECT_TRUE(message_type("IMAGE", type));
+  EXPECT_EQ(type, MessageType::IMAGE);
+  EXPECT_TRUE(message_type("POLYDATA", type));
+  EXPECT_EQ(type, MessageType::POLYDATA);
+  EXPECT_FALSE(message_type("STRING", type));
+}
+
+}  // namespace holoscan::ops::openigtlink
@@ -52,39 +52,41 @@ __device__ uint16_t ConvertLittleEndianToBigEndian(uint16_t small_endian) {
   return (bits[1] << 8) + bits[0];
 }
 
-/// @brief  Convert a raw Velodyne VLP-16 packet to a list of XYZ points.
-/// @param d_packet The 1206-byte packet in device memory to convert.
-/// @param d_xyz_list The device memory destination for 384 XYZ points.
+/// @brief  Convert data blocks of raw Velodyne VLP-16 packets to a list of XYZ points.
+/// @param d_packets The 1206-byte packets in device memory to convert.
+/// @param first_block Index of the first block to convert, counted over all packets.
+/// @param d_xyz_list The device memory destination for 32 XYZ points per block.
 /// @param d_cos_rot_table Precomputed values for cosines of azimuth angles.
 /// @param d_sin_rot_table Precomputed values for sines of azimuth angles.
 /// @note The VLP-16 firing sequence does not follow the physical order of lasers,
 ///       but instead "jumps around". See the Velodyne VLP-16 User Manual for details.
-__global__ void ConvertRawPacketToXYZ(data_collection::sensors::RawVelodynePacket* d_packet,
-                                      Blocks* d_xyz_list, double* d_cos_rot_table,
-                                      double* d_sin_rot_table) {
-  // x: 0 -- 31, y: 0 -- 11
-  // i: 0 -- 31, j: 0 -- 11
+__global__ void ConvertRawBlocksToXYZ(const data_collection::sensors::RawVelodynePacket* d_packets,
+                                      size_t first_block, Lines* d_xyz_list,
+                                      double* d_cos_rot_table, double* d_sin_rot_table) {
+  // x: 0 -- 31, one CUDA block per data block
   int i = threadIdx.x;
-  int j = threadIdx.y;
 
   // out of size
-  if (i >= kVelodyneRecords || j >= kVelodyneBlocks) { return; }
+  if (i >= kVelodyneRecords) { return; }
+
+  const size_t block_index = first_block + blockIdx.x;
+  const RawVelodyneBlock& block =
+      d_packets[block_index / kVelodyneBlocks].blocks_[block_index % kVelodyneBlocks];
 
   // Convert from the default Velodyne little endian format to the default
-  // IGX big endian format.
+  // IGX big endian format. Corrupt azimuths are wrapped to stay inside the lookup tables.
   uint16_t azimuth =
-      ConvertLittleEndianToBigEndian(d_packet->blocks_[j].azimuth_hundredths_degrees_);
+      ConvertLittleEndianToBigEndian(block.azimuth_hundredths_degrees_) % kVelodyneMaxAzimuth;
   float range_meters =
-      ConvertLittleEndianToBigEndian(d_packet->blocks_[j].records_[i].distance_two_millimeters_) *
+      ConvertLittleEndianToBigEndian(block.records_[i].distance_two_millimeters_) *
       kRawVelodyneDefaultDistanceAccuracy * kMillimetersToMeters;
 
   // Use pre-computed lookup tables to translate from spherical coordinates
   // to Cartesian coordinates.
-  d_xyz_list->blocks_[j].lines_[i].x =
-      range_meters * d_vlp16_cos_pitch[i] * d_sin_rot_table[azimuth];
-  d_xyz_list->blocks_[j].lines_[i].y =
-      range_meters * d_vlp16_cos_pitch[i] * d_cos_rot_table[azimuth];
-  d_xyz_list->blocks_[j].lines_[i].z = range_meters * d_vlp16_sin_pitch[i];
+  PointXYZ& point = d_xyz_list[blockIdx.x].lines_[i];
+  point.x = range_meters * d_vlp16_cos_pitch[i] * d_sin_rot_table[azimuth];
+  point.y = range_meters * d_vlp16_cos_pitch[i] * d_cos_rot_table[azimuth];
+  point.z = range_meters * d_vlp16_sin_pitch[i];
 }
 
 /// @brief Pre-compute sine and cosine values for rapid lookup.
@@ -123,37 +125,80 @@ void VelodyneConvertXYZHelper::InitSinAndCosTable() {
   CUDA_TRY(
       cudaMemcpyToSymbol(d_vlp16_cos_pitch, vlp16_cos_pitch_table.data(), size_of_pitch_table));
 
-  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_packet_), sizeof(RawVelodynePacket)));
+  CUDA_TRY(cudaEventCreateWithFlags(&upload_event_, cudaEventDisableTiming));
 
   HOLOSCAN_LOG_DEBUG("Finished initializing sin and cos tables.\n");
 }
 
 void VelodyneConvertXYZHelper::ConvertRawPacketToDeviceXYZ(
     const data_collection::sensors::RawVelodynePacket* packet, PointXYZ* gpu_xyz_destination) {
+  *HostPackets(1) = *packet;
+  UploadPackets(1, 0);
+  ConvertBlocksToDeviceXYZ(0, kVelodyneBlocks, gpu_xyz_destination, 0);
+}
+
+RawVelodynePacket* VelodyneConvertXYZHelper::HostPackets(size_t packet_count) {
   if (!initialized_) {
     initialized_ = true;
     InitSinAndCosTable();
   }
 
-  size_t packet_size = sizeof(RawVelodynePacket);
-  CUDA_TRY(cudaMemcpy(d_packet_, packet, packet_size, cudaMemcpyHostToDevice));
+  // the previous upload may still read from the host buffer
+  CUDA_TRY(cudaEventSynchronize(upload_event_));
+  ReservePackets(packet_count);
+  return h_packets_;
+}
+
+void VelodyneConvertXYZHelper::UploadPackets(size_t packet_count, cudaStream_t stream) {
+  CUDA_TRY(cudaMemcpyAsync(d_packets_,
+                           h_packets_,
+                           packet_count * sizeof(RawVelodynePacket),
+                           cudaMemcpyHostToDevice,
+                           stream));
+  CUDA_TRY(cudaEventRecord(upload_event_, stream));
+}
+
+void VelodyneConvertXYZHelper::ConvertBlocksToDeviceXYZ(size_t first_block, size_t block_count,
+                                                        PointXYZ* gpu_xyz_destination,
+                                                        cudaStream_t stream) {
+  if (block_count == 0) { return; }
 
   // Defines compute resource's size.
-  dim3 block(kVelodyneRecords, kVelodyneBlocks);
-  dim3 grid(1, 1);
+  dim3 block(kVelodyneRecords);
+  dim3 grid(block_count);
+
+  ConvertRawBlocksToXYZ<<<grid, block, 0, stream>>>(d_packets_,
+                                                    first_block,
+                                                    reinterpret_cast<Lines*>(gpu_xyz_destination),
+                                                    d_cos_rot_table_,
+                                                    d_sin_rot_table_);
+  CUDA_TRY(cudaGetLastError());
+}
 
-  ConvertRawPacketToXYZ<<<grid, block>>>(d_packet_,
-                                         reinterpret_cast<Blocks*>(gpu_xyz_destination),
-                                         d_cos_rot_table_,
-                                         d_sin_rot_table_);
+void VelodyneConvertXYZHelper::ReservePackets(size_t packet_count) {
+  if (packet_count <= packet_capacity_) { return; }
 
-  return;
+  // the device buffer may still be read by a running conversion
+  CUDA_TRY(cudaDeviceSynchronize());
+  cudaFreeHost(h_packets_);
+  cudaFree(d_packets_);
+  h_packets_ = nullptr;
+  d_packets_ = nullptr;
+  packet_capacity_ = 0;
+
+  CUDA_TRY(cudaMallocHost(reinterpret_cast<void**>(&h_packets_),
+                          packet_count * sizeof(RawVelodynePacket)));
+  CUDA_TRY(
+      cudaMalloc(reinterpret_cast<void**>(&d_packets_), packet_count * sizeof(RawVelodynePacket)));
+  packet_capacity_ = packet_count;
 }
 
 VelodyneConvertXYZHelper::~VelodyneConvertXYZHelper() {
   cudaFree(d_sin_rot_table_);
   cudaFree(d_cos_rot_table_);
-  cudaFree(d_packet_);
+  cudaFree(d_packets_);
+  cudaFreeHost(h_packets_);
+  if (upload_event_) { cudaEventDestroy(upload_event_); }
 }
 
 }  // namespace sensors
@@ -57,6 +57,10 @@ struct Blocks {
 /// to reuse across packet transformations.
 /// Code is adapted from the NVIDIA Isaac DeepMap SDK.
 ///
+/// Batches of packets are converted by writing them to HostPackets(), copying them to the device
+/// with UploadPackets() and converting ranges of their data blocks with
+/// ConvertBlocksToDeviceXYZ().
+///
 /// @see https://developer.nvidia.com/isaac
 class VelodyneConvertXYZHelper {
  public:
@@ -81,18 +85,42 @@ class VelodyneConvertXYZHelper {
   void ConvertRawPacketToDeviceXYZ(const data_collection::sensors::RawVelodynePacket* packet,
                                    PointXYZ* gpu_xyz_intensity_destination);
 
+  /// @brief Returns a pinned host buffer for `packet_count` packets to be uploaded.
+  ///
+  /// Waits for the previous upload to complete before handing out the buffer again.
+  RawVelodynePacket* HostPackets(size_t packet_count);
+
+  /// @brief Copy the first `packet_count` packets of HostPackets() to the device.
+  void UploadPackets(size_t packet_count, cudaStream_t stream);
+
+  /// @brief Convert data blocks of the uploaded packets to XYZ points.
+  /// @param first_block Index of the first block, counted over all uploaded packets.
+  /// @param block_count Number of blocks to convert.
+  /// @param gpu_xyz_destination The device memory destination for block_count * 32 XYZ points.
+  void ConvertBlocksToDeviceXYZ(size_t first_block, size_t block_count,
+                                PointXYZ* gpu_xyz_destination, cudaStream_t stream);
+
  private:
   // Initialize all yaw table and pitch table, and copy them into Gpu
   // constants. This function will be called when first time call
   // RawVelodynePacketToXYZIntensityGpu.
   void InitSinAndCosTable();
 
+  // Grow the host and device packet buffers to hold at least `packet_count` packets.
+  void ReservePackets(size_t packet_count);
+
   // sin yaw. Cross 360 degrees. GPU data. resolution 0.01 degrees.
-  double* d_sin_rot_table_;
+  double* d_sin_rot_table_ = nullptr;
   // cos yaw. Cross 360 degrees. GPU data. resolution 0.01 degrees.
-  double* d_cos_rot_table_;
+  double* d_cos_rot_table_ = nullptr;
   // Raw Velodyne packets. GPU data.
-  RawVelodynePacket* d_packet_;
+  RawVelodynePacket* d_packets_ = nullptr;
+  // Raw Velodyne packets staged for upload. Pinned host data.
+  RawVelodynePacket* h_packets_ = nullptr;
+  // Number of packets the packet buffers can hold.
+  size_t packet_capacity_ = 0;
+  // Recorded after each upload, the host packets can be reused once it completed.
+  cudaEvent_t upload_event_ = nullptr;
   // If this flag is false. When calling RawVelodynePacketToXYZIntensityGpu will
   // tries to init all tables.
   bool initialized_ = false;
@@ -17,9 +17,17 @@
 
 #include "velodyne_lidar.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
 
 #include <basic_network_operator_common.h>
+#include <gxf/std/timestamp.hpp>
 
 #include "velodyne_constants.hpp"
 #include "velodyne_convert_xyz.hpp"
@@ -40,71 +48,238 @@
 
 namespace holoscan::ops {
 
-nvidia::gxf::Shape VelodyneLidarOp::output_cloud_shape() {
-  return {static_cast<int>(VLP16_PACKET_CLOUD_SIZE * packet_buffer_size_.get()),
-          CLOUD_DIMENSION};
+namespace sensors = data_collection::sensors;
+
+namespace {
+
+/**
+ * Returns the UTC time in nanoseconds of a Velodyne timestamp.
+ *
+ * The sensor reports microseconds past the hour, the hour is taken from the host clock. The
+ * timestamp is assumed to be less than half an hour old.
+ */
+int64_t sensor_time_ns(uint32_t microseconds_on_hour) {
+  using namespace std::chrono;
+  const auto now = system_clock::now();
+  const auto hour = floor<hours>(now);
+  auto time = hour + microseconds(microseconds_on_hour);
+  if (time > now + minutes(30)) { time -= hours(1); }
+  return duration_cast<nanoseconds>(time.time_since_epoch()).count();
+}
+
+}  // namespace
+
+class VelodyneLidarOp::SweepBufferPool {
+ public:
+  explicit SweepBufferPool(size_t size) : size_(size) {}
+  ~SweepBufferPool() {
+    for (float* buffer : free_) { cudaFree(buffer); }
+  }
+
+  float* acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_.empty()) {
+        float* buffer = free_.back();
+        free_.pop_back();
+        return buffer;
+      }
+    }
+    float* buffer;
+    CUDA_TRY(cudaMalloc(&buffer, size_));
+    return buffer;
+  }
+
+  void release(float* buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(buffer);
+  }
+
+ private:
+  const size_t size_;
+  std::mutex mutex_;
+  std::vector<float*> free_;
+};
+
+nvidia::gxf::Shape VelodyneLidarOp::output_cloud_shape(size_t block_count) {
+  return {static_cast<int>(sensors::kVelodyneRecords * block_count), CLOUD_DIMENSION};
 }
 
 void VelodyneLidarOp::initialize() {
   holoscan::Operator::initialize();
 
-  // Reserve and initialize space for the cloud tensor on the device
-  float* device_xyz_intensity_buffer_;
-  auto cloud_shape = output_cloud_shape();
-  CUDA_TRY(cudaMalloc(&device_xyz_intensity_buffer_, cloud_shape.size() * sizeof(float)));
-  CUDA_TRY(cudaMemset(device_xyz_intensity_buffer_, 0, cloud_shape.size() * sizeof(float)));
-
-  // Construct Tensor from allocated device memory
-  auto primitive_type = nvidia::gxf::PrimitiveType::kFloat32;
-  auto gxf_cloud_tensor = std::make_shared<nvidia::gxf::Tensor>();
-  gxf_cloud_tensor->wrapMemory(cloud_shape,
-                               primitive_type,
-                               nvidia::gxf::PrimitiveTypeSize(primitive_type),
-                               nvidia::gxf::ComputeTrivialStrides(
-                                   cloud_shape, nvidia::gxf::PrimitiveTypeSize(primitive_type)),
-                               nvidia::gxf::MemoryStorageType::kDevice,
-                               reinterpret_cast<void*>(device_xyz_intensity_buffer_),
-                               [orig_pointer = device_xyz_intensity_buffer_](void*) mutable {
-                                 CUDA_TRY(cudaFree(orig_pointer));
-                                 return nvidia::gxf::Success;
-                               });
-  auto maybe_dl_ctx = gxf_cloud_tensor->toDLManagedTensorContext();
-  if (!maybe_dl_ctx) {
-    HOLOSCAN_LOG_ERROR(
-        "failed to get std::shared_ptr<DLManagedTensorContext> from nvidia::gxf::Tensor");
+  // Buffers are sized for the longest revolution
+  sweep_buffers_ = std::make_shared<SweepBufferPool>(
+      output_cloud_shape(packet_buffer_size_.get() * sensors::kVelodyneBlocks).size() *
+      sizeof(float));
+}
+
+void VelodyneLidarOp::start() {
+  CUDA_TRY(cudaStreamCreateWithFlags(&cuda_stream_, cudaStreamNonBlocking));
+}
+
+void VelodyneLidarOp::stop() {
+  if (cuda_stream_) {
+    cudaStreamSynchronize(cuda_stream_);
+    cudaStreamDestroy(cuda_stream_);
+    cuda_stream_ = nullptr;
   }
-  cloud_tensor_ = std::make_shared<Tensor>(maybe_dl_ctx.value());
+  if (sweep_buffer_) { sweep_buffers_->release(sweep_buffer_); }
+  if (completed_buffer_) { sweep_buffers_->release(completed_buffer_); }
+  sweep_buffer_ = completed_buffer_ = nullptr;
+  sweep_blocks_ = completed_blocks_ = 0;
+  sweep_started_ = false;
+  last_azimuth_ = -1;
+
+  HOLOSCAN_LOG_INFO(
+      "Velodyne: {} packets skipped, {} revolutions dropped, {} revolutions truncated",
+      skipped_packets_,
+      dropped_sweeps_,
+      truncated_sweeps_);
+}
+
+void VelodyneLidarOp::append_blocks(size_t first_block, size_t block_count) {
+  // blocks before the first complete revolution are dropped
+  if (!sweep_started_ || (block_count == 0)) { return; }
+
+  const size_t capacity = packet_buffer_size_.get() * sensors::kVelodyneBlocks;
+  if (sweep_blocks_ + block_count > capacity) {
+    if (sweep_blocks_ < capacity) {
+      HOLOSCAN_LOG_WARN("Velodyne revolution exceeds {} packets, increase 'packet_buffer_size'",
+                        packet_buffer_size_.get());
+      ++truncated_sweeps_;
+    }
+    block_count = capacity - std::min(sweep_blocks_, capacity);
+    if (block_count == 0) { return; }
+  }
+
+  if (!sweep_buffer_) { sweep_buffer_ = sweep_buffers_->acquire(); }
+  velodyne_helper_.ConvertBlocksToDeviceXYZ(
+      first_block,
+      block_count,
+      reinterpret_cast<PointXYZ*>(sweep_buffer_) + sweep_blocks_ * sensors::kVelodyneRecords,
+      cuda_stream_);
+  sweep_blocks_ += block_count;
+}
+
+void VelodyneLidarOp::finish_sweep() {
+  if (sweep_blocks_ == 0) { return; }
+
+  // only the last revolution completed in a burst is emitted
+  if (completed_buffer_) {
+    sweep_buffers_->release(completed_buffer_);
+    ++dropped_sweeps_;
+  }
+  completed_buffer_ = sweep_buffer_;
+  completed_blocks_ = sweep_blocks_;
+  completed_timestamp_us_ = sweep_timestamp_us_;
+  sweep_buffer_ = nullptr;
+  sweep_blocks_ = 0;
 }
 
 void VelodyneLidarOp::compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
                               holoscan::ExecutionContext& context) {
-  // Advance our cloud ring buffer by one packet's cloud size on each tick, regardless of whether
-  // the packet can be parsed.
-  packet_buffer_index_ = (packet_buffer_index_ + 1) % packet_buffer_size_;
-
   auto data = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in");
-  HOLOSCAN_LOG_DEBUG("First packet byte: " + std::to_string((*data)->data[0]) +
-                     ", Last packet byte: " + std::to_string((*data)->data[(*data)->len - 1]) +
-                     ", Length: " + std::to_string((*data)->len) +
-                     ", Num packets: " + std::to_string((*data)->num_pkts));
-
-  if ((*data)->len != VLP16_PACKET_SIZE) {
-    HOLOSCAN_LOG_ERROR(
-        "Received data length does not match expected VLP16 packet size. Expected: " +
-        std::to_string(VLP16_PACKET_SIZE) + ", Received: " + std::to_string((*data)->len));
-    return;
+  if (!data || !data.value()) { return; }
+  const NetworkOpBurstParams& burst = *data.value();
+  HOLOSCAN_LOG_DEBUG("Burst length: {}, Num packets: {}", burst.len, burst.num_pkts);
+
+  // Bursts either keep every packet in its own slot or hold concatenated packets
+  size_t packet_count = burst.num_pkts;
+  if (burst.stride == 0) {
+    if (burst.len % VLP16_PACKET_SIZE != 0) {
+      HOLOSCAN_LOG_ERROR(
+          "Received data length is not a multiple of the VLP16 packet size. Expected: {}, "
+          "Received: {}",
+          VLP16_PACKET_SIZE,
+          burst.len);
+      return;
+    }
+    packet_count = burst.len / VLP16_PACKET_SIZE;
+  }
+
+  // Gather the packets of the burst to copy them to the device at once
+  auto* packets = velodyne_helper_.HostPackets(packet_count);
+  size_t valid_packets = 0;
+  for (size_t index = 0; index < packet_count; ++index) {
+    const size_t length = burst.pkt_lens ? burst.pkt_lens[index] : VLP16_PACKET_SIZE;
+    if (length != VLP16_PACKET_SIZE) {
+      HOLOSCAN_LOG_DEBUG("Skipping packet of {} bytes, expected {}", length, VLP16_PACKET_SIZE);
+      ++skipped_packets_;
+      continue;
+    }
+    const size_t stride = burst.stride ? burst.stride : VLP16_PACKET_SIZE;
+    std::memcpy(&packets[valid_packets++], burst.data + index * stride, VLP16_PACKET_SIZE);
   }
+  if (valid_packets == 0) { return; }
+  velodyne_helper_.UploadPackets(valid_packets, cuda_stream_);
 
-  velodyne_helper_.ConvertRawPacketToDeviceXYZ(
-      reinterpret_cast<data_collection::sensors::RawVelodynePacket*>((*data)->data),
-      reinterpret_cast<data_collection::sensors::PointXYZ*>(
-          reinterpret_cast<float*>(cloud_tensor_->data()) +
-          (packet_buffer_index_ * VLP16_PACKET_CLOUD_SIZE * CLOUD_DIMENSION)));
-  HOLOSCAN_LOG_DEBUG("Done processing Velodyne packet.");
+  // A revolution completes where the azimuth wraps around, convert the blocks in between into
+  // the cloud of the revolution they belong to
+  const size_t block_count = valid_packets * sensors::kVelodyneBlocks;
+  size_t first_block = 0;
+  for (size_t block = 0; block < block_count; ++block) {
+    const auto& packet = packets[block / sensors::kVelodyneBlocks];
+    const int32_t azimuth =
+        packet.blocks_[block % sensors::kVelodyneBlocks].azimuth_hundredths_degrees_ %
+        sensors::kVelodyneMaxAzimuth;
+    const bool wrapped =
+        (last_azimuth_ >= 0) && (last_azimuth_ - azimuth > sensors::kVelodyneMaxAzimuth / 2);
+    last_azimuth_ = azimuth;
+    if (!wrapped) { continue; }
+
+    append_blocks(first_block, block - first_block);
+    finish_sweep();
+    first_block = block;
+    sweep_started_ = true;
+    sweep_timestamp_us_ = packet.timestamp_microseconds_on_hour_;
+  }
+  append_blocks(first_block, block_count - first_block);
+
+  if (!completed_buffer_) { return; }
+
+  // The cloud is complete once the conversions queued so far finished
+  CUDA_TRY(cudaStreamSynchronize(cuda_stream_));
+
+  auto output = nvidia::gxf::Entity::New(context.context());
+  if (!output) { throw std::runtime_error("Failed to allocate message for output"); }
+
+  auto tensor = output.value().add<nvidia::gxf::Tensor>("xyz");
+  if (!tensor) { throw std::runtime_error("Failed to allocate cloud tensor"); }
+
+  // The buffer returns to the pool when the last user of the tensor releases it
+  const auto cloud_shape = output_cloud_shape(completed_blocks_);
+  const auto primitive_type = nvidia::gxf::PrimitiveType::kFloat32;
+  auto wrapped = tensor.value()->wrapMemory(
+      cloud_shape,
+      primitive_type,
+      nvidia::gxf::PrimitiveTypeSize(primitive_type),
+      nvidia::gxf::ComputeTrivialStrides(cloud_shape,
+                                         nvidia::gxf::PrimitiveTypeSize(primitive_type)),
+      nvidia::gxf::MemoryStorageType::kDevice,
+      completed_buffer_,
+      [pool = sweep_buffers_, buffer = completed_buffer_](void*) {
+        pool->release(buffer);
+        return nvidia::gxf::Success;
+      });
+  if (!wrapped) {
+    sweep_buffers_->release(completed_buffer_);
+    completed_buffer_ = nullptr;
+    throw std::runtime_error("Failed to wrap the cloud buffer");
+  }
+  completed_buffer_ = nullptr;
+
+  auto timestamp = output.value().add<nvidia::gxf::Timestamp>("timestamp");
+  if (timestamp) {
+    timestamp.value()->acqtime = sensor_time_ns(completed_timestamp_us_);
+    timestamp.value()->pubtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count();
+  }
+  HOLOSCAN_LOG_DEBUG("Emitting revolution of {} points.", cloud_shape.dimension(0));
 
-  TensorMap out_message;
-  out_message.insert({"xyz", cloud_tensor_});
-  op_output.emit(out_message);
+  auto result = gxf::Entity(std::move(output.value()));
+  op_output.emit(result, "cloud_out");
 }
 
 }  // namespace holoscan::ops
@@ -33,15 +33,20 @@ namespace holoscan::ops {
  * @brief Operator class to process Velodyne VLP-16 lidar sensor input.
  *
  * This operator receives packets from a Velodyne VLP-16 lidar and
- * processes them into a point cloud of fixed size in Cartesian space.
+ * processes them into one point cloud per sensor revolution in Cartesian space.
  *
  * The operator performs the following steps:
- * 1. Interpret a fixed-size UDP packet as a Velodyne VLP-16 lidar packet,
- *    which contains 12 data blocks (azimuths) and 32 spherical data points per block.
- * 2. Transform the spherical data points into Cartesian coordinates (x, y, z)
- *    and add them to the output point cloud tensor, overwriting a previous cloud segment.
- * 3. Output the point cloud tensor and update the tensor insertion pointer to prepare
- *    for the next incoming packet.
+ * 1. Interpret each fixed-size UDP packet of an incoming burst as a Velodyne VLP-16 lidar
+ *    packet, which contains 12 data blocks (azimuths) and 32 spherical data points per block.
+ *    All packets of a burst are copied to the device at once.
+ * 2. Follow the azimuth of the data blocks to find where the sensor completes a revolution.
+ * 3. Transform the spherical data points into Cartesian coordinates (x, y, z)
+ *    and append them to the point cloud of the current revolution.
+ * 4. Once a revolution is complete, output its point cloud with the sensor time of its first
+ *    packet and start the next one in a new buffer.
+ *
+ * Points received before the first complete revolution starts are dropped. If a burst completes
+ * more than one revolution, only the last one is output.
  *
  * We recommend relying on HoloHub networking operators to receive Velodyne VLP-16 lidar packets
  * over UDP/IP and forward them to this operator.
@@ -71,49 +76,72 @@ class VelodyneLidarOp : public Operator {
 
   void initialize() override;
   void setup(OperatorSpec& spec) override {
-    // The incoming UDP packet to possibly translate to a VLP-16 cloud.
+    // The incoming UDP packets to possibly translate to a VLP-16 cloud.
     spec.input<std::shared_ptr<NetworkOpBurstParams>>("burst_in");
-    // The outgoing point cloud tensor.
-    spec.output<holoscan::TensorMap>("cloud_out");
+    // The outgoing point cloud of a complete revolution, an entity holding the "xyz" tensor
+    // and a timestamp.
+    spec.output<holoscan::gxf::Entity>("cloud_out");
 
-    // User parameter to set the size of the point cloud tensor buffer.
-    // It typically takes between 80 and 82 packets to capture one
+    // User parameter to set the capacity of the point cloud of one revolution.
+    // It takes about 76 packets at 600 RPM and 151 packets at 300 RPM to capture one
     // full revolution of the VLP-16 lidar sensor.
     spec.param<size_t>(packet_buffer_size_,
                        "packet_buffer_size",
                        "Packet buffer size",
-                       "Ring buffer size for incoming packets",
-                       80);
+                       "Maximum number of packets in one revolution",
+                       160);
   };
 
+  void start() override;
+  void stop() override;
+
   void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
                holoscan::ExecutionContext&) override;
 
  protected:
-  // @brief Returns the shape of the output point cloud tensor.
-  //
-  // The point cloud tensor shape is fixed and determined by the packet buffer size
-  // user parameter at the time the operator is initialized.
-  nvidia::gxf::Shape output_cloud_shape();
+  // @brief Returns the shape of a point cloud holding `block_count` data blocks.
+  nvidia::gxf::Shape output_cloud_shape(size_t block_count);
 
  private:
+  class SweepBufferPool;
+
+  // Append data blocks of the uploaded packets to the current revolution.
+  void append_blocks(size_t first_block, size_t block_count);
+  // Complete the current revolution, keeping it to be emitted at the end of compute().
+  void finish_sweep();
+
   // Size of the point cloud tensor buffer in terms of discrete packets.
   Parameter<size_t> packet_buffer_size_;
 
   // Helper class to convert Velodyne packets to Cartesian data points
   data_collection::sensors::VelodyneConvertXYZHelper velodyne_helper_;
 
-  // Internal buffer to store the latest point cloud state.
-  //
-  // The operator performs a one-time cloud allocation of length
-  // (packet_buffer_size_ packets) * (12 data blocks / packet) * (32 points / data block).
-  // Packets are translated to clouds of 384 points and inserted into the buffer,
-  // overwriting some previous sub-cloud.
-  std::shared_ptr<holoscan::Tensor> cloud_tensor_;
-
-  // An increasing index to keep track of the number of packets processed.
-  // Used to determine where points from the next packet should be inserted into the cloud buffer.
-  size_t packet_buffer_index_ = 0;
+  // Stream the packets are uploaded and converted on
+  cudaStream_t cuda_stream_ = nullptr;
+
+  // Device buffers holding the cloud of one revolution each. A buffer is returned to the pool
+  // when the last tensor referencing it is released, so an emitted cloud is never overwritten.
+  std::shared_ptr<SweepBufferPool> sweep_buffers_;
+
+  // The revolution being assembled: its buffer, the data blocks converted into it so far and
+  // the sensor time of its first packet in microseconds past the hour.
+  float* sweep_buffer_ = nullptr;
+  size_t sweep_blocks_ = 0;
+  uint32_t sweep_timestamp_us_ = 0;
+  // Set once the first revolution starts, blocks before are dropped.
+  bool sweep_started_ = false;
+  // Azimuth of the last data block in hundredths of degrees, -1 before the first block.
+  int32_t last_azimuth_ = -1;
+
+  // Completed revolution waiting to be emitted
+  float* completed_buffer_ = nullptr;
+  size_t completed_blocks_ = 0;
+  uint32_t completed_timestamp_us_ = 0;
+
+  // Counters for diagnostics
+  uint64_t skipped_packets_ = 0;
+  uint64_t dropped_sweeps_ = 0;
+  uint64_t truncated_sweeps_ = 0;
 };
 
 }  // namespace holoscan::ops
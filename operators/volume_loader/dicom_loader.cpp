@@ -0,0 +1,856 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dicom_loader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "volume.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr uint32_t kUndefinedLength = 0xFFFFFFFF;
+/// Maximum nesting of sequences, protects against malformed files
+constexpr int kMaxSequenceDepth = 16;
+
+constexpr char kImplicitVRLittleEndian[] = "1.2.840.10008.1.2";
+constexpr char kExplicitVRLittleEndian[] = "1.2.840.10008.1.2.1";
+
+constexpr uint32_t tag(uint16_t group, uint16_t element) {
+  return (uint32_t(group) << 16) | element;
+}
+
+constexpr uint32_t kTransferSyntaxUID = tag(0x0002, 0x0010);
+constexpr uint32_t kSliceThickness = tag(0x0018, 0x0050);
+constexpr uint32_t kSeriesInstanceUID = tag(0x0020, 0x000E);
+constexpr uint32_t kInstanceNumber = tag(0x0020, 0x0013);
+constexpr uint32_t kImagePositionPatient = tag(0x0020, 0x0032);
+constexpr uint32_t kImageOrientationPatient = tag(0x0020, 0x0037);
+constexpr uint32_t kSamplesPerPixel = tag(0x0028, 0x0002);
+constexpr uint32_t kNumberOfFrames = tag(0x0028, 0x0008);
+constexpr uint32_t kRows = tag(0x0028, 0x0010);
+constexpr uint32_t kColumns = tag(0x0028, 0x0011);
+constexpr uint32_t kPixelSpacing = tag(0x0028, 0x0030);
+constexpr uint32_t kBitsAllocated = tag(0x0028, 0x0100);
+constexpr uint32_t kBitsStored = tag(0x0028, 0x0101);
+constexpr uint32_t kPixelRepresentation = tag(0x0028, 0x0103);
+constexpr uint32_t kRescaleIntercept = tag(0x0028, 0x1052);
+constexpr uint32_t kRescaleSlope = tag(0x0028, 0x1053);
+constexpr uint32_t kPixelData = tag(0x7FE0, 0x0010);
+constexpr uint32_t kItem = tag(0xFFFE, 0xE000);
+constexpr uint32_t kItemDelimitation = tag(0xFFFE, 0xE00D);
+constexpr uint32_t kSequenceDelimitation = tag(0xFFFE, 0xE0DD);
+
+/// Header information of a single DICOM image
+struct DicomSlice {
+  std::string file_name_;
+  std::string series_instance_uid_;
+  uint16_t rows_ = 0;
+  uint16_t columns_ = 0;
+  uint16_t samples_per_pixel_ = 1;
+  uint16_t bits_allocated_ = 0;
+  uint16_t bits_stored_ = 0;
+  uint16_t pixel_representation_ = 0;
+  int32_t number_of_frames_ = 1;
+  int32_t instance_number_ = 0;
+  std::array<double, 2> pixel_spacing_{1.0, 1.0};
+  double slice_thickness_ = 0.0;
+  bool has_position_ = false;
+  std::array<double, 3> position_{0.0, 0.0, 0.0};
+  std::array<double, 6> orientation_{1.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+  double rescale_slope_ = 1.0;
+  double rescale_intercept_ = 0.0;
+  uint64_t pixel_data_offset_ = 0;
+  uint64_t pixel_data_size_ = 0;
+  /// position along the slice normal
+  double projection_ = 0.0;
+};
+
+/// Reads DICOM data elements from a little endian buffer
+class ElementReader {
+ public:
+  ElementReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  struct Element {
+    uint32_t tag_ = 0;
+    std::array<char, 2> vr_{0, 0};
+    uint32_t length_ = 0;
+    /// offset of the value
+    size_t offset_ = 0;
+  };
+
+  size_t position() const { return position_; }
+  void seek(size_t position) { position_ = position; }
+  bool at_end() const { return position_ >= size_; }
+
+  bool peek_group(uint16_t& group) const {
+    if (position_ + 2 > size_) { return false; }
+    group = read_u16(position_);
+    return true;
+  }
+
+  /// Read the header of the next element and position the reader at its value
+  bool next(bool explicit_vr, Element& element) {
+    if (position_ + 8 > size_) { return false; }
+    element.tag_ = tag(read_u16(position_), read_u16(position_ + 2));
+    position_ += 4;
+    element.vr_ = {0, 0};
+    // items and delimiters have no VR
+    if (explicit_vr && ((element.tag_ >> 16) != 0xFFFE)) {
+      element.vr_ = {char(data_[position_]), char(data_[position_ + 1])};
+      position_ += 2;
+      if (has_long_length(element.vr_)) {
+        if (position_ + 6 > size_) { return false; }
+        element.length_ = read_u32(position_ + 2);
+        position_ += 6;
+      } else {
+        element.length_ = read_u16(position_);
+        position_ += 2;
+      }
+    } else {
+      element.length_ = read_u32(position_);
+      position_ += 4;
+    }
+    element.offset_ = position_;
+    return (element.length_ == kUndefinedLength) || (position_ + element.length_ <= size_);
+  }
+
+  /// Skip the value of an element with defined length
+  void skip(const Element& element) { position_ = element.offset_ + element.length_; }
+
+  /// Skip a sequence of undefined length, the reader is positioned at the first item
+  bool skip_sequence(bool explicit_vr, int depth) {
+    if (depth > kMaxSequenceDepth) { return false; }
+    Element item;
+    while (next(explicit_vr, item)) {
+      if (item.tag_ == kSequenceDelimitation) { return true; }
+      if (item.tag_ != kItem) { return false; }
+      if (item.length_ != kUndefinedLength) {
+        skip(item);
+      } else if (!skip_item(explicit_vr, depth)) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  std::string string_value(const Element& element) const {
+    std::string value(reinterpret_cast<const char*>(data_ + element.offset_), element.length_);
+    // values are padded with spaces or zeros to an even length
+    const auto end = value.find_last_not_of(std::string(" \0", 2));
+    value.erase((end == std::string::npos) ? 0 : end + 1);
+    const auto begin = value.find_first_not_of(' ');
+    value.erase(0, (begin == std::string::npos) ? value.size() : begin);
+    return value;
+  }
+
+  uint16_t u16_value(const Element& element) const {
+    return (element.length_ >= 2) ? read_u16(element.offset_) : 0;
+  }
+
+  /// @returns the numbers of a multi-valued decimal or integer string
+  std::vector<double> numbers_value(const Element& element) const {
+    std::vector<double> values;
+    std::stringstream stream(string_value(element));
+    std::string value;
+    while (std::getline(stream, value, '\\')) {
+      try {
+        values.push_back(std::stod(value));
+      } catch (const std::exception&) { return {}; }
+    }
+    return values;
+  }
+
+ private:
+  static bool has_long_length(const std::array<char, 2>& vr) {
+    static const std::array<std::array<char, 2>, 13> long_vrs{{{'O', 'B'},
+                                                               {'O', 'D'},
+                                                               {'O', 'F'},
+                                                               {'O', 'L'},
+                                                               {'O', 'V'},
+                                                               {'O', 'W'},
+                                                               {'S', 'Q'},
+                                                               {'S', 'V'},
+                                                               {'U', 'C'},
+                                                               {'U', 'N'},
+                                                               {'U', 'R'},
+                                                               {'U', 'T'},
+                                                               {'U', 'V'}}};
+    return std::find(long_vrs.begin(), long_vrs.end(), vr) != long_vrs.end();
+  }
+
+  /// Skip the data set of an item of undefined length
+  bool skip_item(bool explicit_vr, int depth) {
+    Element element;
+    while (next(explicit_vr, element)) {
+      if (element.tag_ == kItemDelimitation) { return true; }
+      if (element.length_ != kUndefinedLength) {
+        skip(element);
+      } else if (!skip_sequence(undefined_length_explicit_vr(explicit_vr, element), depth + 1)) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  uint16_t read_u16(size_t offset) const {
+    return uint16_t(data_[offset]) | (uint16_t(data_[offset + 1]) << 8);
+  }
+  uint32_t read_u32(size_t offset) const {
+    return uint32_t(read_u16(offset)) | (uint32_t(read_u16(offset + 2)) << 16);
+  }
+
+ public:
+  /// UN elements of undefined length are encoded in implicit VR
+  static bool undefined_length_explicit_vr(bool explicit_vr, const Element& element) {
+    return explicit_vr && (element.vr_ != std::array<char, 2>{'U', 'N'});
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+/// Read-only memory mapping of a file, only the pages touched are read from disk
+class MappedFile {
+ public:
+  ~MappedFile() {
+    if (data_ != MAP_FAILED) { munmap(data_, size_); }
+    if (fd_ != -1) { close(fd_); }
+  }
+
+  bool open(const std::string& file_name) {
+    fd_ = ::open(file_name.c_str(), O_RDONLY);
+    if (fd_ == -1) { return false; }
+    struct stat file_stat;
+    if ((fstat(fd_, &file_stat) != 0) || (file_stat.st_size == 0)) { return false; }
+    size_ = file_stat.st_size;
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    return data_ != MAP_FAILED;
+  }
+
+  const uint8_t* data() const { return static_cast<const uint8_t*>(data_); }
+  size_t size() const { return size_; }
+
+ private:
+  int fd_ = -1;
+  void* data_ = MAP_FAILED;
+  size_t size_ = 0;
+};
+
+bool has_dicom_preamble(const std::string& file_name) {
+  std::ifstream file(file_name, std::ios::in | std::ios::binary);
+  std::array<char, 132> preamble;
+  return file.read(preamble.data(), preamble.size()) &&
+         (memcmp(preamble.data() + 128, "DICM", 4) == 0);
+}
+
+/**
+ * Parse the header of a DICOM file up to the pixel data.
+ *
+ * @returns false if the file is not a DICOM file or not supported, `error` is set then
+ */
+bool parse_slice(const std::string& file_name, DicomSlice& slice, std::string& error) {
+  MappedFile file;
+  if (!file.open(file_name)) {
+    error = "could not open file";
+    return false;
+  }
+  if ((file.size() < 132) || (memcmp(file.data() + 128, "DICM", 4) != 0)) {
+    error = "not a DICOM file";
+    return false;
+  }
+  slice.file_name_ = file_name;
+
+  ElementReader reader(file.data(), file.size());
+  reader.seek(132);
+  ElementReader::Element element;
+
+  // the file meta information is always explicit VR little endian
+  std::string transfer_syntax;
+  uint16_t group = 0;
+  while (reader.peek_group(group) && (group == 0x0002)) {
+    if (!reader.next(true, element) || (element.length_ == kUndefinedLength)) {
+      error = "invalid file meta information";
+      return false;
+    }
+    if (element.tag_ == kTransferSyntaxUID) { transfer_syntax = reader.string_value(element); }
+    reader.skip(element);
+  }
+
+  bool explicit_vr;
+  if (transfer_syntax == kExplicitVRLittleEndian) {
+    explicit_vr = true;
+  } else if (transfer_syntax == kImplicitVRLittleEndian) {
+    explicit_vr = false;
+  } else {
+    error = fmt::format("unsupported transfer syntax '{}', only uncompressed little endian is "
+                        "supported",
+                        transfer_syntax);
+    return false;
+  }
+
+  while (reader.next(explicit_vr, element)) {
+    if (element.tag_ == kPixelData) {
+      if (element.length_ == kUndefinedLength) {
+        error = "encapsulated pixel data is not supported";
+        return false;
+      }
+      slice.pixel_data_offset_ = element.offset_;
+      slice.pixel_data_size_ = element.length_;
+      return true;
+    }
+    if (element.length_ == kUndefinedLength) {
+      if (!reader.skip_sequence(
+              ElementReader::undefined_length_explicit_vr(explicit_vr, element), 0)) {
+        error = "invalid sequence";
+        return false;
+      }
+      continue;
+    }
+
+    switch (element.tag_) {
+      case kSeriesInstanceUID:
+        slice.series_instance_uid_ = reader.string_value(element);
+        break;
+      case kInstanceNumber: {
+        const auto values = reader.numbers_value(element);
+        if (!values.empty()) { slice.instance_number_ = int32_t(values[0]); }
+      } break;
+      case kImagePositionPatient: {
+        const auto values = reader.numbers_value(element);
+        if (values.size() == 3) {
+          std::copy_n(values.begin(), 3, slice.position_.begin());
+          slice.has_position_ = true;
+        }
+      } break;
+      case kImageOrientationPatient: {
+        const auto values = reader.numbers_value(element);
+        if (values.size() == 6) { std::copy_n(values.begin(), 6, slice.orientation_.begin()); }
+      } break;
+      case kPixelSpacing: {
+        const auto values = reader.numbers_value(element);
+        if (values.size() == 2) { std::copy_n(values.begin(), 2, slice.pixel_spacing_.begin()); }
+      } break;
+      case kSliceThickness: {
+        const auto values = reader.numbers_value(element);
+        if (!values.empty()) { slice.slice_thickness_ = values[0]; }
+      } break;
+      case kNumberOfFrames: {
+        const auto values = reader.numbers_value(element);
+        if (!values.empty()) { slice.number_of_frames_ = int32_t(values[0]); }
+      } break;
+      case kRescaleIntercept: {
+        const auto values = reader.numbers_value(element);
+        if (!values.empty()) { slice.rescale_intercept_ = values[0]; }
+      } break;
+      case kRescaleSlope: {
+        const auto values = reader.numbers_value(element);
+        if (!values.empty()) { slice.rescale_slope_ = values[0]; }
+      } break;
+      case kSamplesPerPixel:
+        slice.samples_per_pixel_ = reader.u16_value(element);
+        break;
+      case kRows:
+        slice.rows_ = reader.u16_value(element);
+        break;
+      case kColumns:
+        slice.columns_ = reader.u16_value(element);
+        break;
+      case kBitsAllocated:
+        slice.bits_allocated_ = reader.u16_value(element);
+        break;
+      case kBitsStored:
+        slice.bits_stored_ = reader.u16_value(element);
+        break;
+      case kPixelRepresentation:
+        slice.pixel_representation_ = reader.u16_value(element);
+        break;
+    }
+    reader.skip(element);
+  }
+
+  error = "no pixel data";
+  return false;
+}
+
+/// Call `function` for each index in [0, count) using all cores
+void parallel_for(size_t count, const std::function<void(size_t)>& function) {
+  const size_t threads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), count);
+  std::atomic<size_t> next_index{0};
+  const auto worker = [&]() {
+    for (size_t index = next_index++; index < count; index = next_index++) { function(index); }
+  };
+  std::vector<std::thread> workers;
+  for (size_t index = 1; index < threads; ++index) { workers.emplace_back(worker); }
+  worker();
+  for (auto& thread : workers) { thread.join(); }
+}
+
+nvidia::gxf::PrimitiveType stored_type(const DicomSlice& slice) {
+  const bool is_signed = slice.pixel_representation_ == 1;
+  switch (slice.bits_allocated_) {
+    case 8:
+      return is_signed ? nvidia::gxf::PrimitiveType::kInt8 : nvidia::gxf::PrimitiveType::kUnsigned8;
+    case 16:
+      return is_signed ? nvidia::gxf::PrimitiveType::kInt16
+                       : nvidia::gxf::PrimitiveType::kUnsigned16;
+    case 32:
+      return is_signed ? nvidia::gxf::PrimitiveType::kInt32
+                       : nvidia::gxf::PrimitiveType::kUnsigned32;
+    default:
+      return nvidia::gxf::PrimitiveType::kCustom;
+  }
+}
+
+/**
+ * Select the element type of the volume: the stored type if no slice is rescaled, else the
+ * smallest integer type holding the rescaled range of the stored bits if slopes and intercepts
+ * are integers, else float.
+ */
+nvidia::gxf::PrimitiveType output_type(const std::vector<DicomSlice>& slices) {
+  bool identity = true;
+  bool integral = true;
+  double min_value = std::numeric_limits<double>::max();
+  double max_value = std::numeric_limits<double>::lowest();
+  for (const auto& slice : slices) {
+    const double slope = slice.rescale_slope_;
+    const double intercept = slice.rescale_intercept_;
+    identity = identity && (slope == 1.0) && (intercept == 0.0);
+    integral = integral && (std::floor(slope) == slope) && (std::floor(intercept) == intercept);
+
+    const int bits = (slice.bits_stored_ != 0) ? slice.bits_stored_ : slice.bits_allocated_;
+    const double stored_min = (slice.pixel_representation_ == 1) ? -std::ldexp(1.0, bits - 1) : 0;
+    const double stored_max = (slice.pixel_representation_ == 1) ? std::ldexp(1.0, bits - 1) - 1
+                                                                 : std::ldexp(1.0, bits) - 1;
+    const double a = stored_min * slope + intercept;
+    const double b = stored_max * slope + intercept;
+    min_value = std::min({min_value, a, b});
+    max_value = std::max({max_value, a, b});
+  }
+
+  if (identity) { return stored_type(slices.front()); }
+  if (integral) {
+    const auto fits = [min_value, max_value](auto type_min, auto type_max) {
+      return (min_value >= double(type_min)) && (max_value <= double(type_max));
+    };
+    if (fits(std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max())) {
+      return nvidia::gxf::PrimitiveType::kInt16;
+    }
+    if (fits(std::numeric_limits<uint16_t>::min(), std::numeric_limits<uint16_t>::max())) {
+      return nvidia::gxf::PrimitiveType::kUnsigned16;
+    }
+    if (fits(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max())) {
+      return nvidia::gxf::PrimitiveType::kInt32;
+    }
+  }
+  return nvidia::gxf::PrimitiveType::kFloat32;
+}
+
+/// Rescale stored values, written as a plain loop the compiler vectorizes
+template <typename SrcT, typename DstT, typename ScaleT>
+void rescale(const SrcT* __restrict src, DstT* __restrict dst, size_t count, ScaleT slope,
+             ScaleT intercept) {
+  for (size_t index = 0; index < count; ++index) {
+    dst[index] = DstT(ScaleT(src[index]) * slope + intercept);
+  }
+}
+
+template <typename SrcT, typename DstT>
+void rescale(const void* src, void* dst, size_t count, double slope, double intercept) {
+  if constexpr (std::is_floating_point_v<DstT>) {
+    rescale(static_cast<const SrcT*>(src),
+            static_cast<DstT*>(dst),
+            count,
+            float(slope),
+            float(intercept));
+  } else {
+    // integral slope and intercept, the output type holds the result
+    using ScaleT = std::conditional_t<(sizeof(SrcT) < 4), int32_t, int64_t>;
+    rescale(static_cast<const SrcT*>(src),
+            static_cast<DstT*>(dst),
+            count,
+            ScaleT(slope),
+            ScaleT(intercept));
+  }
+}
+
+template <typename SrcT>
+bool rescale(nvidia::gxf::PrimitiveType dst_type, const void* src, void* dst, size_t count,
+             double slope, double intercept) {
+  switch (dst_type) {
+    case nvidia::gxf::PrimitiveType::kInt16:
+      rescale<SrcT, int16_t>(src, dst, count, slope, intercept);
+      return true;
+    case nvidia::gxf::PrimitiveType::kUnsigned16:
+      rescale<SrcT, uint16_t>(src, dst, count, slope, intercept);
+      return true;
+    case nvidia::gxf::PrimitiveType::kInt32:
+      rescale<SrcT, int32_t>(src, dst, count, slope, intercept);
+      return true;
+    case nvidia::gxf::PrimitiveType::kFloat32:
+      rescale<SrcT, float>(src, dst, count, slope, intercept);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool rescale(nvidia::gxf::PrimitiveType src_type, nvidia::gxf::PrimitiveType dst_type,
+             const void* src, void* dst, size_t count, double slope, double intercept) {
+  switch (src_type) {
+    case nvidia::gxf::PrimitiveType::kInt8:
+      return rescale<int8_t>(dst_type, src, dst, count, slope, intercept);
+    case nvidia::gxf::PrimitiveType::kUnsigned8:
+      return rescale<uint8_t>(dst_type, src, dst, count, slope, intercept);
+    case nvidia::gxf::PrimitiveType::kInt16:
+      return rescale<int16_t>(dst_type, src, dst, count, slope, intercept);
+    case nvidia::gxf::PrimitiveType::kUnsigned16:
+      return rescale<uint16_t>(dst_type, src, dst, count, slope, intercept);
+    case nvidia::gxf::PrimitiveType::kInt32:
+      return rescale<int32_t>(dst_type, src, dst, count, slope, intercept);
+    case nvidia::gxf::PrimitiveType::kUnsigned32:
+      return rescale<uint32_t>(dst_type, src, dst, count, slope, intercept);
+    default:
+      return false;
+  }
+}
+
+/// Read `size` bytes at `offset` of a file
+bool read_file(const std::string& file_name, uint64_t offset, size_t size, void* data) {
+  const int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd == -1) { return false; }
+  auto* dst = static_cast<uint8_t*>(data);
+  while (size > 0) {
+    const ssize_t result = pread(fd, dst, size, offset);
+    if (result <= 0) { break; }
+    dst += result;
+    offset += result;
+    size -= result;
+  }
+  close(fd);
+  return size == 0;
+}
+
+/// Dominant anatomical direction of a vector in the DICOM patient coordinate system (LPS)
+char orientation_letter(const std::array<double, 3>& direction) {
+  int axis = 0;
+  for (int index = 1; index < 3; ++index) {
+    if (std::abs(direction[index]) > std::abs(direction[axis])) { axis = index; }
+  }
+  static const char letters[3][2] = {{'R', 'L'}, {'A', 'P'}, {'I', 'S'}};
+  return letters[axis][direction[axis] > 0.0 ? 1 : 0];
+}
+
+/// Directory holding the series of `path`, a DICOM file or a directory
+std::filesystem::path series_directory(const std::filesystem::path& path, bool is_directory) {
+  if (is_directory) { return path; }
+  // a bare file name is in the current directory
+  return path.parent_path().empty() ? std::filesystem::path(".") : path.parent_path();
+}
+
+}  // namespace
+
+bool is_dicom(const std::string& file_name) {
+  std::filesystem::path path(file_name);
+
+  if (path.extension() == ".dcm") { return true; }
+
+  // a directory is a DICOM series if the first file found is a DICOM file
+  std::error_code error;
+  if (std::filesystem::is_directory(path, error)) {
+    for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+      if (entry.is_regular_file(error)) { return has_dicom_preamble(entry.path().string()); }
+    }
+  }
+
+  return false;
+}
+
+std::vector<std::string> dicom_files(const std::string& file_name) {
+  std::filesystem::path path(file_name);
+  std::error_code error;
+  const bool is_directory = std::filesystem::is_directory(path, error);
+  std::vector<std::string> file_names;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(series_directory(path, is_directory), error)) {
+    if (entry.is_regular_file(error)) { file_names.push_back(entry.path().string()); }
+  }
+  std::sort(file_names.begin(), file_names.end());
+  return file_names;
+}
+
+bool load_dicom(const std::string& file_name, Volume& volume) {
+  const auto start = std::chrono::steady_clock::now();
+
+  // a directory is loaded as a series, a file loads the series it belongs to from its directory
+  std::filesystem::path path(file_name);
+  std::error_code error;
+  const bool is_directory = std::filesystem::is_directory(path, error);
+  const std::vector<std::string> file_names = dicom_files(file_name);
+  if (file_names.empty()) {
+    holoscan::log_error("DICOM no files found for {}", file_name);
+    return false;
+  }
+
+  // parse the headers of all files in parallel
+  std::vector<DicomSlice> parsed(file_names.size());
+  std::vector<std::string> errors(file_names.size());
+  std::vector<uint8_t> valid(file_names.size(), 0);
+  parallel_for(file_names.size(), [&](size_t index) {
+    valid[index] = parse_slice(file_names[index], parsed[index], errors[index]);
+  });
+
+  // select the series, the one of the file given or the series with the most images
+  std::string series_instance_uid;
+  if (!is_directory) {
+    // the files found are in the same directory, compare the names only
+    const auto it = std::find_if(file_names.begin(), file_names.end(), [&path](const auto& name) {
+      return std::filesystem::path(name).filename() == path.filename();
+    });
+    if ((it == file_names.end()) || !valid[it - file_names.begin()]) {
+      holoscan::log_error("DICOM failed to read {}: {}",
+                          file_name,
+                          (it == file_names.end()) ? "not found" : errors[it - file_names.begin()]);
+      return false;
+    }
+    series_instance_uid = parsed[it - file_names.begin()].series_instance_uid_;
+  } else {
+    std::map<std::string, size_t> series_sizes;
+    for (size_t index = 0; index < parsed.size(); ++index) {
+      if (valid[index]) { ++series_sizes[parsed[index].series_instance_uid_]; }
+    }
+    if (series_sizes.empty()) {
+      const auto it = std::find_if(
+          errors.begin(), errors.end(), [](const std::string& e) { return !e.empty(); });
+      holoscan::log_error("DICOM no supported images in {}, e.g. {}: {}",
+                          file_name,
+                          file_names[it - errors.begin()],
+                          *it);
+      return false;
+    }
+    series_instance_uid = std::max_element(series_sizes.begin(),
+                                           series_sizes.end(),
+                                           [](const auto& a, const auto& b) {
+                                             return a.second < b.second;
+                                           })->first;
+    if (series_sizes.size() > 1) {
+      holoscan::log_info("DICOM {} contains {} series, loading {}",
+                         file_name,
+                         series_sizes.size(),
+                         series_instance_uid);
+    }
+  }
+
+  std::vector<DicomSlice> slices;
+  for (size_t index = 0; index < parsed.size(); ++index) {
+    if (valid[index] && (parsed[index].series_instance_uid_ == series_instance_uid)) {
+      slices.push_back(std::move(parsed[index]));
+    }
+  }
+
+  // all images must have the same layout. A copy, the slices are sorted below
+  const DicomSlice first = slices.front();
+  for (const auto& slice : slices) {
+    if ((slice.rows_ != first.rows_) || (slice.columns_ != first.columns_) ||
+        (slice.bits_allocated_ != first.bits_allocated_) ||
+        (slice.pixel_representation_ != first.pixel_representation_)) {
+      holoscan::log_error("DICOM images of series {} have different sizes or pixel formats",
+                          series_instance_uid);
+      return false;
+    }
+    if ((slice.samples_per_pixel_ != 1) || (slice.number_of_frames_ != 1)) {
+      holoscan::log_error("DICOM only single frame, single sample images are supported");
+      return false;
+    }
+  }
+  const auto src_type = stored_type(first);
+  if (src_type == nvidia::gxf::PrimitiveType::kCustom) {
+    holoscan::log_error("DICOM unsupported bits allocated {}", first.bits_allocated_);
+    return false;
+  }
+  const size_t slice_elements = size_t(first.rows_) * first.columns_;
+  const size_t src_slice_size = slice_elements * nvidia::gxf::PrimitiveTypeSize(src_type);
+  for (const auto& slice : slices) {
+    if (slice.pixel_data_size_ < src_slice_size) {
+      holoscan::log_error("DICOM pixel data of {} is too small", slice.file_name_);
+      return false;
+    }
+  }
+
+  // sort the images by their position along the slice normal, or else by instance number
+  const std::array<double, 3> row{
+      first.orientation_[0], first.orientation_[1], first.orientation_[2]};
+  const std::array<double, 3> column{
+      first.orientation_[3], first.orientation_[4], first.orientation_[5]};
+  const std::array<double, 3> normal{row[1] * column[2] - row[2] * column[1],
+                                     row[2] * column[0] - row[0] * column[2],
+                                     row[0] * column[1] - row[1] * column[0]};
+  const bool has_positions = std::all_of(
+      slices.begin(), slices.end(), [](const DicomSlice& slice) { return slice.has_position_; });
+  for (auto& slice : slices) {
+    slice.projection_ = slice.position_[0] * normal[0] + slice.position_[1] * normal[1] +
+                        slice.position_[2] * normal[2];
+  }
+  std::sort(slices.begin(), slices.end(), [has_positions](const auto& a, const auto& b) {
+    return has_positions ? (a.projection_ < b.projection_)
+                         : (a.instance_number_ < b.instance_number_);
+  });
+
+  double slice_spacing = (first.slice_thickness_ > 0.0) ? first.slice_thickness_ : 1.0;
+  if (has_positions && (slices.size() > 1)) {
+    const double extent = slices.back().projection_ - slices.front().projection_;
+    if (extent > 0.0) {
+      slice_spacing = extent / (slices.size() - 1);
+    } else {
+      holoscan::log_warn("DICOM images of series {} all have the same position",
+                         series_instance_uid);
+    }
+  }
+
+  // allocate the tensor
+  const auto dst_type = output_type(slices);
+  const size_t dst_slice_size = slice_elements * nvidia::gxf::PrimitiveTypeSize(dst_type);
+  const std::array<int32_t, 3> dims{
+      int32_t(slices.size()), int32_t(first.rows_), int32_t(first.columns_)};
+  if (!volume.tensor_->reshapeCustom(nvidia::gxf::Shape(dims),
+                                     dst_type,
+                                     nvidia::gxf::PrimitiveTypeSize(dst_type),
+                                     nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+                                     volume.storage_type_,
+                                     volume.allocator_)) {
+    holoscan::log_error("DICOM failed to reshape tensor");
+    return false;
+  }
+
+  bool to_device;
+  switch (volume.storage_type_) {
+    case nvidia::gxf::MemoryStorageType::kDevice:
+      to_device = true;
+      break;
+    case nvidia::gxf::MemoryStorageType::kHost:
+    case nvidia::gxf::MemoryStorageType::kSystem:
+      to_device = false;
+      break;
+    default:
+      holoscan::log_error("DICOM unhandled storage type {}", int(volume.storage_type_));
+      return false;
+  }
+
+  // decode the slices in parallel. Host tensors are read into directly, rescaled in place when
+  // possible; else each slice goes through a buffer.
+  std::atomic<bool> failed{false};
+  uint8_t* dst = volume.tensor_->pointer();
+  parallel_for(slices.size(), [&](size_t index) {
+    const auto& slice = slices[index];
+    uint8_t* slice_dst = dst + index * dst_slice_size;
+    const bool direct = !to_device && (dst_slice_size >= src_slice_size);
+    std::vector<uint8_t> buffer;
+    if (!direct) { buffer.resize(std::max(src_slice_size, dst_slice_size)); }
+    uint8_t* src = direct ? slice_dst : buffer.data();
+
+    if (!read_file(slice.file_name_, slice.pixel_data_offset_, src_slice_size, src)) {
+      holoscan::log_error("DICOM failed to read pixel data of {}", slice.file_name_);
+      failed = true;
+      return;
+    }
+
+    uint8_t* out = to_device ? buffer.data() : slice_dst;
+    if ((dst_type != src_type) || (slice.rescale_slope_ != 1.0) ||
+        (slice.rescale_intercept_ != 0.0)) {
+      if (out == src) {
+        // in place, widening conversions have to run backwards: rescale into a copy
+        std::vector<uint8_t> stored(src, src + src_slice_size);
+        rescale(src_type,
+                dst_type,
+                stored.data(),
+                out,
+                slice_elements,
+                slice.rescale_slope_,
+                slice.rescale_intercept_);
+      } else {
+        rescale(src_type,
+                dst_type,
+                src,
+                out,
+                slice_elements,
+                slice.rescale_slope_,
+                slice.rescale_intercept_);
+      }
+    } else if (out != src) {
+      memcpy(out, src, dst_slice_size);
+    }
+
+    if (to_device &&
+        (cudaMemcpy(slice_dst, out, dst_slice_size, cudaMemcpyHostToDevice) != cudaSuccess)) {
+      holoscan::log_error("DICOM failed to copy to GPU memory");
+      failed = true;
+    }
+  });
+  if (failed) { return false; }
+
+  // volume axes are columns, rows and slices
+  volume.spacing_ = {float(first.pixel_spacing_[1]),
+                     float(first.pixel_spacing_[0]),
+                     float(slice_spacing)};
+  volume.space_origin_ = slices.front().position_;
+  volume.space_directions_.clear();
+  const std::array<std::array<double, 3>, 3> axes{row, column, normal};
+  for (int axis = 0; axis < 3; ++axis) {
+    std::array<double, 3> direction;
+    for (int index = 0; index < 3; ++index) {
+      direction[index] = axes[axis][index] * volume.spacing_[axis];
+    }
+    volume.space_directions_.push_back(direction);
+  }
+  volume.SetOrientation(std::string{
+      orientation_letter(row), orientation_letter(column), orientation_letter(normal)});
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  holoscan::log_info("DICOM loaded {} images of {}x{} from {} in {:.3f} s",
+                     slices.size(),
+                     first.columns_,
+                     first.rows_,
+                     file_name,
+                     elapsed.count());
+  return true;
+}
+
+}  // namespace holoscan::ops
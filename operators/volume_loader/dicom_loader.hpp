@@ -0,0 +1,40 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef VOLUME_LOADER_DICOM_LOADER
+#define VOLUME_LOADER_DICOM_LOADER
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace holoscan::ops {
+
+class Volume;
+
+bool is_dicom(const std::string& file_name);
+
+bool load_dicom(const std::string& file_name, Volume& volume);
+
+/**
+ * @returns the files load_dicom() may read: all files of the directory of the series, sorted
+ */
+std::vector<std::string> dicom_files(const std::string& file_name);
+
+}  // namespace holoscan::ops
+
+#endif /* VOLUME_LOADER_DICOM_LOADER */
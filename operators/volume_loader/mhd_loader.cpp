@@ -19,10 +19,10 @@
 
 #include <array>
 #include <filesystem>
-
-#include <zlib.h>
+#include <fstream>
 
 #include "volume.hpp"
+#include "volume_data_reader.hpp"
 
 namespace holoscan::ops {
 
@@ -34,6 +34,31 @@ bool is_mhd(const std::string& file_name) {
   return false;
 }
 
+std::vector<std::string> mhd_files(const std::string& file_name) {
+  std::vector<std::string> files{file_name};
+  std::ifstream file(file_name, std::ios::in);
+  std::string line;
+  while (std::getline(file, line)) {
+    const size_t delimiter = line.find('=');
+    if (delimiter == std::string::npos) { continue; }
+    std::string parameter = line.substr(0, delimiter);
+    parameter.erase(
+        std::remove_if(
+            parameter.begin(), parameter.end(), [](unsigned char x) { return std::isspace(x); }),
+        parameter.end());
+    if (parameter != "ElementDataFile") { continue; }
+    std::string value = line.substr(delimiter + 1);
+    auto it = value.begin();
+    while ((it != value.end()) && (std::isspace(*it))) { it = value.erase(it); }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) {
+      value.pop_back();
+    }
+    const std::string path = file_name.substr(0, file_name.find_last_of("/\\") + 1);
+    files.push_back(path + value);
+  }
+  return files;
+}
+
 bool load_mhd(const std::string& file_name, Volume& volume) {
   bool compressed = false;
   std::string data_file_name;
@@ -122,53 +147,6 @@ bool load_mhd(const std::string& file_name, Volume& volume) {
     }
   }
 
-  const size_t data_size =
-      dims[0] * dims[1] * dims[2] * nvidia::gxf::PrimitiveTypeSize(primitive_type);
-  std::unique_ptr<uint8_t> data(new uint8_t[data_size]);
-
-  std::ifstream file;
-
-  file.open(data_file_name, std::ios::in | std::ios::binary | std::ios::ate);
-  if (!file.is_open()) {
-    holoscan::log_error("MHD could not open {}", data_file_name);
-    return false;
-  }
-  const std::streampos file_size = file.tellg();
-  file.seekg(0, std::ios_base::beg);
-
-  if (compressed) {
-    // need to uncompress, first read to 'compressed_data' vector and then uncompress to 'data'
-    std::vector<uint8_t> compressed_data(file_size);
-
-    // read
-    file.read(reinterpret_cast<char*>(compressed_data.data()), compressed_data.size());
-
-    // uncompress
-    z_stream strm{};
-    int result = inflateInit2(&strm, 32 + MAX_WBITS);
-    if (result != Z_OK) {
-      holoscan::log_error("MHD failed to uncompress {}, inflateInit2 failed with error code {}",
-                          data_file_name,
-                          result);
-      return false;
-    }
-
-    strm.next_in = compressed_data.data();
-    strm.avail_in = compressed_data.size();
-    strm.next_out = data.get();
-    strm.avail_out = data_size;
-
-    result = inflate(&strm, Z_FINISH);
-    inflateEnd(&strm);
-    if (result != Z_STREAM_END) {
-      holoscan::log_error(
-          "MHD failed to uncompress {}, inflate failed with error code {}", data_file_name, result);
-      return false;
-    }
-  } else {
-    file.read(reinterpret_cast<char*>(data.get()), data_size);
-  }
-
   // allocate the tensor
   if (!volume.tensor_->reshapeCustom(nvidia::gxf::Shape(dims),
                                      primitive_type,
@@ -180,25 +158,8 @@ bool load_mhd(const std::string& file_name, Volume& volume) {
     return false;
   }
 
-  // copy the data
-  switch (volume.storage_type_) {
-    case nvidia::gxf::MemoryStorageType::kDevice:
-      if (cudaMemcpy(volume.tensor_->pointer(),
-                     reinterpret_cast<const void*>(data.get()),
-                     data_size,
-                     cudaMemcpyHostToDevice) != cudaSuccess) {
-        holoscan::log_error("MHD failed to copy to GPU memory");
-        return false;
-      }
-      break;
-    case nvidia::gxf::MemoryStorageType::kHost:
-    case nvidia::gxf::MemoryStorageType::kSystem:
-      memcpy(volume.tensor_->pointer(), data.get(), data_size);
-      break;
-    default:
-      holoscan::log_error("MHD unhandled storage type {}", int(volume.storage_type_));
-      return false;
-  }
+  // read the data straight into the tensor
+  if (!read_volume_data("MHD", data_file_name, 0, compressed, volume)) { return false; }
 
   return true;
 }
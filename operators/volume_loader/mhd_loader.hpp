@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace holoscan::ops {
 
@@ -28,6 +29,11 @@ bool is_mhd(const std::string& file_name);
 
 bool load_mhd(const std::string& file_name, Volume& volume);
 
+/**
+ * @returns the files load_mhd() reads: the header and the data file
+ */
+std::vector<std::string> mhd_files(const std::string& file_name);
+
 }  // namespace holoscan::ops
 
 #endif /* VOLUME_LOADER_MHD_LOADER */
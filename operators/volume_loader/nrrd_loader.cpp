@@ -22,9 +22,8 @@
 #include <filesystem>
 #include <string>
 
-#include <zlib.h>
-
 #include "volume.hpp"
+#include "volume_data_reader.hpp"
 
 namespace holoscan::ops {
 
@@ -83,55 +82,6 @@ bool is_nrrd(const std::string& file_name) {
   return false;
 }
 
-bool load_nrrd_data_file(const bool compressed, const std::string& data_file_name,
-                         const size_t& data_size, std::unique_ptr<uint8_t>& data) {
-  std::ifstream file;
-
-  file.open(data_file_name, std::ios::in | std::ios::binary | std::ios::ate);
-  if (!file.is_open()) {
-    holoscan::log_error("NRRD could not open {}", data_file_name);
-    return false;
-  }
-  const std::streampos file_size = file.tellg();
-  file.seekg(0, std::ios_base::beg);
-  if (compressed) {
-    // need to uncompress, first read to 'compressed_data' vector and then uncompress to 'data'
-    std::vector<uint8_t> compressed_data(file_size);
-
-    // read
-    file.read(reinterpret_cast<char*>(compressed_data.data()), compressed_data.size());
-
-    // uncompress
-    z_stream strm{};
-    int result = inflateInit2(&strm, 32 + MAX_WBITS);
-    if (result != Z_OK) {
-      holoscan::log_error("NRRD failed to uncompress {}, inflateInit2 failed with error code {}",
-                          data_file_name,
-                          result);
-      return false;
-    }
-
-    strm.next_in = compressed_data.data();
-    strm.avail_in = compressed_data.size();
-    strm.next_out = data.get();
-    strm.avail_out = data_size;
-
-    result = inflate(&strm, Z_FINISH);
-    inflateEnd(&strm);
-    if (result != Z_STREAM_END) {
-      holoscan::log_error("NRRD failed to uncompress {}, inflate failed with error code {}",
-                          data_file_name,
-                          result);
-      return false;
-    }
-
-  } else {
-    file.read(reinterpret_cast<char*>(data.get()), data_size);
-  }
-
-  return true;
-}
-
 bool parse_headers(const std::string& file_name, const std::string& key, const std::string& value,
                    bool& compressed, std::array<int32_t, 3>& dims, Volume& volume,
                    nvidia::gxf::PrimitiveType& primitive_type, std::string& data_file_name) {
@@ -226,6 +176,22 @@ bool parse_headers(const std::string& file_name, const std::string& key, const s
   return true;
 }
 
+std::vector<std::string> nrrd_files(const std::string& file_name) {
+  std::vector<std::string> files{file_name};
+  std::ifstream file(file_name, std::ios::in);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || (line == "\r")) { break; }
+    size_t delimiterPos = line.find(':');
+    if (delimiterPos == std::string::npos) { continue; }
+    if (remove_all_spaces(line.substr(0, delimiterPos)) == "datafile") {
+      const std::string path = file_name.substr(0, file_name.find_last_of("/\\") + 1);
+      files.push_back(path + trim(line.substr(delimiterPos + 1)));
+    }
+  }
+  return files;
+}
+
 bool load_nrrd(const std::string& file_name, Volume& volume) {
   bool compressed = false;
   std::string data_file_name;
@@ -243,6 +209,8 @@ bool load_nrrd(const std::string& file_name, Volume& volume) {
   std::string line;
   while (std::getline(file, line)) {
     if (file.tellg() != -1) { byte_skip = file.tellg(); }
+    // an empty line ends the header, attached data follows
+    if (line.empty() || (line == "\r")) { break; }
 
     size_t delimiterPos = line.find(':');
     if (delimiterPos == std::string::npos) { continue; }
@@ -256,35 +224,6 @@ bool load_nrrd(const std::string& file_name, Volume& volume) {
     }
   }
 
-  const size_t data_size =
-      dims[0] * dims[1] * dims[2] * nvidia::gxf::PrimitiveTypeSize(primitive_type);
-  std::unique_ptr<uint8_t> data(new uint8_t[data_size]);
-  if (is_nrrd(file_name) && data_file_name.size() == 0) {
-    if (compressed) {
-      holoscan::log_error("NRRD attached-header with compressed data is not supported.");
-      return false;
-    }
-    std::ifstream file;
-    file.open(file_name, std::ios::in | std::ios::binary);
-    if (!file.is_open()) {
-      holoscan::log_error("NRRD could not open {}", data_file_name);
-      return false;
-    }
-
-    file.seekg(byte_skip, std::ios_base::beg);
-
-    file.read(reinterpret_cast<char*>(data.get()), data_size);
-    file.close();
-  } else if (data_file_name.size() != 0) {
-    if (!load_nrrd_data_file(compressed, data_file_name, data_size, data)) {
-      holoscan::log_error("NRRD failed to process detached data file {}", data_file_name);
-      return false;
-    }
-  } else {
-    holoscan::log_error("NRRD unsupported file format");
-    return false;
-  }
-
   // allocate the tensor
   if (!volume.tensor_->reshapeCustom(nvidia::gxf::Shape(dims),
                                      primitive_type,
@@ -296,24 +235,18 @@ bool load_nrrd(const std::string& file_name, Volume& volume) {
     return false;
   }
 
-  // copy the data
-  switch (volume.storage_type_) {
-    case nvidia::gxf::MemoryStorageType::kDevice:
-      if (cudaMemcpy(volume.tensor_->pointer(),
-                     reinterpret_cast<const void*>(data.get()),
-                     data_size,
-                     cudaMemcpyHostToDevice) != cudaSuccess) {
-        holoscan::log_error("NRRD failed to copy to GPU memory");
-        return false;
-      }
-      break;
-    case nvidia::gxf::MemoryStorageType::kHost:
-    case nvidia::gxf::MemoryStorageType::kSystem:
-      memcpy(volume.tensor_->pointer(), data.get(), data_size);
-      break;
-    default:
-      holoscan::log_error("NRRD unhandled storage type {}", int(volume.storage_type_));
+  // read the data straight into the tensor
+  if (is_nrrd(file_name) && data_file_name.size() == 0) {
+    // attached header, the data follows the header
+    if (!read_volume_data("NRRD", file_name, byte_skip, compressed, volume)) { return false; }
+  } else if (data_file_name.size() != 0) {
+    if (!read_volume_data("NRRD", data_file_name, 0, compressed, volume)) {
+      holoscan::log_error("NRRD failed to process detached data file {}", data_file_name);
       return false;
+    }
+  } else {
+    holoscan::log_error("NRRD unsupported file format");
+    return false;
   }
 
   return true;
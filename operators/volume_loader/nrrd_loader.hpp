@@ -28,6 +28,11 @@ class Volume;
 bool is_nrrd(const std::string& file_name);
 
 bool load_nrrd(const std::string& file_name, Volume& volume);
+
+/**
+ * @returns the files load_nrrd() reads: the header and the detached data file, if any
+ */
+std::vector<std::string> nrrd_files(const std::string& file_name);
 }  // namespace holoscan::ops
 
 #endif /* VOLUME_LOADER_NRRD_LOADER */
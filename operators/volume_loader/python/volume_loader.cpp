@@ -60,8 +60,14 @@ class PyVolumeLoaderOp : public VolumeLoaderOp {
   // Define a constructor that fully initializes the object.
   PyVolumeLoaderOp(Fragment* fragment, const py::args& args,
                    const std::shared_ptr<Allocator>& allocator, const std::string& file_name,
+                   uint32_t slab_size = 0, uint32_t cache_size_mb = 0,
+                   const std::string& disk_cache_path = "",
                    const std::string& name = "volume_loader")
-      : VolumeLoaderOp(ArgList{Arg{"allocator", allocator}, Arg{"file_name", file_name}}) {
+      : VolumeLoaderOp(ArgList{Arg{"allocator", allocator},
+                               Arg{"file_name", file_name},
+                               Arg{"slab_size", slab_size},
+                               Arg{"cache_size_mb", cache_size_mb},
+                               Arg{"disk_cache_path", disk_cache_path}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -93,10 +99,16 @@ PYBIND11_MODULE(_volume_loader, m) {
                     const py::args&,
                     const std::shared_ptr<Allocator>&,
                     const std::string&,
+                    uint32_t,
+                    uint32_t,
+                    const std::string&,
                     const std::string&>(),
            "fragment"_a,
            "allocator"_a,
            "file_name"_a = "",
+           "slab_size"_a = 0,
+           "cache_size_mb"_a = 0,
+           "disk_cache_path"_a = "",
            "name"_a = "volume_loader"s,
            doc::VolumeLoaderOp::doc_VolumeLoaderOp_python)
       .def("setup", &VolumeLoaderOp::setup, "spec"_a, doc::VolumeLoaderOp::doc_setup);
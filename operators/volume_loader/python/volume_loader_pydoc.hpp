@@ -30,6 +30,7 @@ PYDOC(VolumeLoaderOp, R"doc(
 The `volume_loader` operator reads 3D volumes from the specified input file.
 
 The operator supports these file formats:
+* DICOM https://www.dicomstandard.org/ (directory of a series, uncompressed)
 * MHD https://itk.org/Wiki/ITK/MetaIO/Documentation
 * NIFTI https://nifti.nimh.nih.gov/
 * NRRD https://teem.sourceforge.net/nrrd/format.html
@@ -47,6 +48,13 @@ allocator: ``holoscan.resources.Allocator``
     Allocator used to allocate the volume data
 file_name : str, optional
     Volume data file name
+slab_size : int, optional
+    If not zero, stream the volume, emitting it each time this many more slices are loaded.
+    Only supported with the `file_name` parameter and MHD or NRRD files.
+cache_size_mb : int, optional
+    Memory budget in MB of the volume cache shared by all volume loaders. 0 disables the cache.
+disk_cache_path : str, optional
+    If set, decoded volumes are also cached in this directory.
 name : str, optional
     The name of the operator.
 )doc")
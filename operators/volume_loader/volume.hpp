@@ -25,6 +25,8 @@
 
 namespace holoscan::ops {
 
+class VolumeDataReader;
+
 /// This class holds the data and information for 3D volume
 class Volume {
  public:
@@ -62,6 +64,11 @@ class Volume {
   nvidia::gxf::MemoryStorageType storage_type_ = nvidia::gxf::MemoryStorageType::kDevice;
   nvidia::gxf::Handle<nvidia::gxf::Allocator> allocator_;
   nvidia::gxf::Handle<nvidia::gxf::Tensor> tensor_;
+
+  /// if set, loaders supporting it only open the data file and store the reader in `data_reader_`
+  bool stream_data_ = false;
+  /// reader of the data if `stream_data_` is set and the loader supports streaming
+  std::shared_ptr<VolumeDataReader> data_reader_;
 };
 
 }  // namespace holoscan::ops
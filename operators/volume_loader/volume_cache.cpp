@@ -0,0 +1,289 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "volume_cache.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "volume.hpp"
+#include "volume_data_reader.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr char kDiskCacheMagic[8] = {'H', 'S', 'V', 'O', 'L', 'C', '0', '1'};
+
+/// Header of a disk cache file, followed by the key and then by the volume data
+struct DiskCacheHeader {
+  char magic_[8];
+  uint64_t key_size_;
+  uint64_t data_size_;
+  int32_t element_type_;
+  std::array<int32_t, 3> dims_;
+  std::array<float, 3> spacing_;
+  std::array<uint32_t, 3> permute_axis_;
+  std::array<uint8_t, 3> flip_axes_;
+  std::array<double, 3> space_origin_;
+  uint32_t space_directions_count_;
+  std::array<std::array<double, 3>, 3> space_directions_;
+};
+
+std::filesystem::path disk_cache_file(const std::string& path, const std::string& key) {
+  return std::filesystem::path(path) / fmt::format("{:016x}.volume", std::hash<std::string>{}(key));
+}
+
+/// Copy the volume metadata, the tensor and the data reader are not copied
+void copy_metadata(const Volume& src, Volume& dst) {
+  dst.spacing_ = src.spacing_;
+  dst.permute_axis_ = src.permute_axis_;
+  dst.flip_axes_ = src.flip_axes_;
+  dst.frame_duration_ = src.frame_duration_;
+  dst.space_origin_ = src.space_origin_;
+  dst.space_directions_ = src.space_directions_;
+}
+
+}  // namespace
+
+struct VolumeCache::Entry {
+  gxf::Entity entity_;
+  Volume volume_;
+  size_t size_ = 0;
+};
+
+VolumeCache& VolumeCache::get() {
+  static VolumeCache cache;
+  return cache;
+}
+
+std::string VolumeCache::key(const std::vector<std::string>& file_names,
+                             nvidia::gxf::MemoryStorageType storage) {
+  std::string key = fmt::format("{}", int(storage));
+  for (const auto& file_name : file_names) {
+    std::error_code error;
+    const auto path = std::filesystem::canonical(file_name, error);
+    std::uintmax_t size = 0;
+    std::filesystem::file_time_type time;
+    if (!error) { size = std::filesystem::file_size(path, error); }
+    if (!error) { time = std::filesystem::last_write_time(path, error); }
+    if (error) {
+      holoscan::log_warn(
+          "VolumeCache can't key {}, not caching the volume: {}", file_name, error.message());
+      return std::string();
+    }
+    key += fmt::format("|{}|{}|{}", path.string(), time.time_since_epoch().count(), size);
+  }
+  return file_names.empty() ? std::string() : key;
+}
+
+void VolumeCache::add_user(size_t budget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++users_;
+  budget_ = std::max(budget_, budget);
+}
+
+void VolumeCache::remove_user() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ((users_ == 0) || (--users_ != 0)) { return; }
+  entries_.clear();
+  lru_.clear();
+  size_ = 0;
+  budget_ = 0;
+}
+
+bool VolumeCache::lookup(const std::string& key, Volume& volume) {
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) { return false; }
+    entry = it->second.first;
+    lru_.splice(lru_.begin(), lru_, it->second.second);
+  }
+
+  // reference the cached data, the entry is kept alive until the tensor is released
+  const auto& tensor = entry->volume_.tensor_;
+  if (!volume.tensor_->wrapMemory(tensor->shape(),
+                                  tensor->element_type(),
+                                  tensor->bytes_per_element(),
+                                  tensor->stride_array(),
+                                  tensor->storage_type(),
+                                  tensor->pointer(),
+                                  [entry](void*) mutable {
+                                    entry.reset();
+                                    return nvidia::gxf::Success;
+                                  })) {
+    holoscan::log_error("VolumeCache failed to reference the cached volume");
+    return false;
+  }
+  copy_metadata(entry->volume_, volume);
+  return true;
+}
+
+void VolumeCache::insert(const std::string& key, const gxf::Entity& entity,
+                         const Volume& volume) {
+  auto entry = std::make_shared<Entry>();
+  entry->entity_ = entity;
+  entry->volume_.tensor_ = volume.tensor_;
+  copy_metadata(volume, entry->volume_);
+  entry->size_ = volume.tensor_->size();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ((entry->size_ > budget_) || (entries_.find(key) != entries_.end())) { return; }
+
+  // evict the least recently used volumes
+  while (size_ + entry->size_ > budget_) {
+    auto it = entries_.find(lru_.back());
+    size_ -= it->second.first->size_;
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+
+  lru_.push_front(key);
+  entries_.emplace(key, std::make_pair(entry, lru_.begin()));
+  size_ += entry->size_;
+}
+
+bool VolumeCache::load_from_disk(const std::string& path, const std::string& key,
+                                 Volume& volume) {
+  const auto file_name = disk_cache_file(path, key);
+
+  DiskCacheHeader header;
+  std::string file_key;
+  {
+    std::ifstream file(file_name, std::ios::in | std::ios::binary);
+    if (!file.is_open()) { return false; }
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        (memcmp(header.magic_, kDiskCacheMagic, sizeof(kDiskCacheMagic)) != 0)) {
+      holoscan::log_warn("VolumeCache ignoring invalid cache file {}", file_name.string());
+      return false;
+    }
+    file_key.resize(header.key_size_);
+    if (!file.read(file_key.data(), file_key.size())) { return false; }
+  }
+  // different file with the same hash
+  if (file_key != key) { return false; }
+
+  const auto element_type = nvidia::gxf::PrimitiveType(header.element_type_);
+  if (!volume.tensor_->reshapeCustom(nvidia::gxf::Shape(header.dims_),
+                                     element_type,
+                                     nvidia::gxf::PrimitiveTypeSize(element_type),
+                                     nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+                                     volume.storage_type_,
+                                     volume.allocator_) ||
+      (volume.tensor_->size() != header.data_size_)) {
+    holoscan::log_error("VolumeCache failed to reshape tensor");
+    return false;
+  }
+
+  VolumeDataReader reader;
+  if (!reader.open("VolumeCache",
+                   file_name.string(),
+                   sizeof(header) + header.key_size_,
+                   false,
+                   volume) ||
+      !reader.read(reader.size())) {
+    return false;
+  }
+
+  volume.spacing_ = header.spacing_;
+  volume.permute_axis_ = header.permute_axis_;
+  std::copy(header.flip_axes_.begin(), header.flip_axes_.end(), volume.flip_axes_.begin());
+  volume.space_origin_ = header.space_origin_;
+  volume.space_directions_.assign(
+      header.space_directions_.begin(),
+      header.space_directions_.begin() + std::min(header.space_directions_count_, 3U));
+  return true;
+}
+
+void VolumeCache::store_to_disk(const std::string& path, const std::string& key,
+                                const Volume& volume) {
+  const auto& tensor = volume.tensor_;
+  if (tensor->rank() != 3) { return; }
+
+  DiskCacheHeader header{};
+  memcpy(header.magic_, kDiskCacheMagic, sizeof(kDiskCacheMagic));
+  header.key_size_ = key.size();
+  header.data_size_ = tensor->size();
+  header.element_type_ = int32_t(tensor->element_type());
+  for (uint32_t index = 0; index < 3; ++index) {
+    header.dims_[index] = tensor->shape().dimension(index);
+  }
+  header.spacing_ = volume.spacing_;
+  header.permute_axis_ = volume.permute_axis_;
+  std::copy(volume.flip_axes_.begin(), volume.flip_axes_.end(), header.flip_axes_.begin());
+  header.space_origin_ = volume.space_origin_;
+  header.space_directions_count_ = std::min<size_t>(volume.space_directions_.size(), 3);
+  std::copy_n(volume.space_directions_.begin(),
+              header.space_directions_count_,
+              header.space_directions_.begin());
+
+  std::error_code error;
+  std::filesystem::create_directories(path, error);
+  const auto file_name = disk_cache_file(path, key);
+  // write to a temporary file first, other processes may read the cache at the same time
+  auto temp_file_name = file_name;
+  temp_file_name += fmt::format(".{}.tmp", getpid());
+  {
+    std::ofstream file(temp_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      holoscan::log_warn("VolumeCache could not create {}", temp_file_name.string());
+      return;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(key.data(), key.size());
+
+    const auto* data = static_cast<const char*>(static_cast<const void*>(tensor->pointer()));
+    if (tensor->storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
+      // copy to the host in blocks
+      constexpr size_t kBlockSize = 64 * 1024 * 1024;
+      std::vector<char> block(std::min(kBlockSize, header.data_size_));
+      for (size_t offset = 0; file && (offset < header.data_size_); offset += block.size()) {
+        const size_t size = std::min(block.size(), header.data_size_ - offset);
+        if (cudaMemcpy(block.data(), data + offset, size, cudaMemcpyDeviceToHost) !=
+            cudaSuccess) {
+          holoscan::log_warn("VolumeCache failed to copy from GPU memory");
+          file.setstate(std::ios::failbit);
+          break;
+        }
+        file.write(block.data(), size);
+      }
+    } else {
+      file.write(data, header.data_size_);
+    }
+
+    if (!file) {
+      holoscan::log_warn("VolumeCache failed to write {}", temp_file_name.string());
+      file.close();
+      std::filesystem::remove(temp_file_name, error);
+      return;
+    }
+  }
+  std::filesystem::rename(temp_file_name, file_name, error);
+  if (error) {
+    holoscan::log_warn("VolumeCache could not create {}: {}", file_name.string(), error.message());
+    std::filesystem::remove(temp_file_name, error);
+  }
+}
+
+}  // namespace holoscan::ops
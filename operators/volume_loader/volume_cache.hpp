@@ -0,0 +1,117 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef VOLUME_LOADER_VOLUME_CACHE
+#define VOLUME_LOADER_VOLUME_CACHE
+
+#include <holoscan/holoscan.hpp>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace holoscan::ops {
+
+class Volume;
+
+/**
+ * In-process LRU cache of loaded volumes, shared by all VolumeLoaderOp instances.
+ *
+ * Volumes are keyed by the path, modification time and size of their files and by the storage type
+ * (see key()).
+ * A cache hit hands out a tensor referencing the cached memory, no data is copied. The memory of a
+ * volume is released when it had been evicted and the last tensor referencing it is gone.
+ *
+ * Optionally decoded volumes are also written to a directory on disk and read back from there on
+ * a miss, which is faster than parsing and decoding the original file again, and survives the
+ * process.
+ *
+ * The cached entities belong to the GXF context of the application, the cache is cleared when the
+ * last operator using it stops.
+ */
+class VolumeCache {
+ public:
+  /// @returns the process wide cache
+  static VolumeCache& get();
+
+  /**
+   * @returns the cache key of a volume, from the path, modification time and size of every file
+   * read to load it, e.g. the header and the detached data file; an empty string if a file can't
+   * be accessed
+   */
+  static std::string key(const std::vector<std::string>& file_names,
+                         nvidia::gxf::MemoryStorageType storage);
+
+  /// Register an operator using the cache, raising the memory budget to `budget` bytes if larger
+  void add_user(size_t budget);
+  /// Unregister an operator, the cache is cleared when there are no users left
+  void remove_user();
+
+  /**
+   * Look up a volume in memory. On a hit the volume metadata is set and `volume.tensor_` is made
+   * to reference the cached data.
+   *
+   * @returns true on a hit
+   */
+  bool lookup(const std::string& key, Volume& volume);
+
+  /**
+   * Add a loaded volume to the memory cache, evicting the least recently used volumes to stay
+   * within the budget. Volumes larger than the budget are not cached.
+   *
+   * @param key [in] cache key
+   * @param entity [in] entity owning the tensor of the volume
+   * @param volume [in] loaded volume
+   */
+  void insert(const std::string& key, const gxf::Entity& entity, const Volume& volume);
+
+  /**
+   * Read a volume from the disk cache into `volume.tensor_`, which is allocated.
+   *
+   * @returns true on a hit
+   */
+  static bool load_from_disk(const std::string& path, const std::string& key, Volume& volume);
+
+  /**
+   * Write a loaded volume to the disk cache. Failures are logged and otherwise ignored.
+   */
+  static void store_to_disk(const std::string& path, const std::string& key,
+                            const Volume& volume);
+
+ private:
+  VolumeCache() = default;
+
+  struct Entry;
+
+  std::mutex mutex_;
+  size_t users_ = 0;
+  size_t budget_ = 0;
+  size_t size_ = 0;
+  /// keys, most recently used first
+  std::list<std::string> lru_;
+  std::unordered_map<std::string,
+                     std::pair<std::shared_ptr<Entry>, std::list<std::string>::iterator>>
+      entries_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* VOLUME_LOADER_VOLUME_CACHE */
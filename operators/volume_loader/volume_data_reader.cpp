@@ -0,0 +1,371 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "volume_data_reader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "volume.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+/// Size of the blocks data is copied, inflated and uploaded in
+constexpr size_t kBlockSize = 64 * 1024 * 1024;
+/// Upper bound of the threads copying raw data, more don't help saturating a disk
+constexpr uint32_t kMaxCopyThreads = 8;
+
+/// Read-only memory mapping of a file
+class MappedFile {
+ public:
+  ~MappedFile() {
+    if (data_ != MAP_FAILED) { munmap(data_, size_); }
+    if (fd_ != -1) { close(fd_); }
+  }
+
+  bool open(const std::string& file_name) {
+    fd_ = ::open(file_name.c_str(), O_RDONLY);
+    if (fd_ == -1) { return false; }
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0) { return false; }
+    size_ = file_stat.st_size;
+    if (size_ == 0) { return true; }
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (data_ == MAP_FAILED) { return false; }
+    // the file is read once from start to end
+    madvise(data_, size_, MADV_SEQUENTIAL);
+    return true;
+  }
+
+  const uint8_t* data() const {
+    return (data_ == MAP_FAILED) ? nullptr : static_cast<const uint8_t*>(data_);
+  }
+  size_t size() const { return size_; }
+
+ private:
+  int fd_ = -1;
+  void* data_ = MAP_FAILED;
+  size_t size_ = 0;
+};
+
+/// Double buffered pinned staging memory used to stream data to the device
+class DeviceUploader {
+ public:
+  ~DeviceUploader() {
+    if (stream_) {
+      cudaStreamSynchronize(stream_);
+      cudaStreamDestroy(stream_);
+    }
+    for (auto event : events_) {
+      if (event) { cudaEventDestroy(event); }
+    }
+    for (auto buffer : buffers_) {
+      if (buffer) { cudaFreeHost(buffer); }
+    }
+  }
+
+  bool init() {
+    if (cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking) != cudaSuccess) { return false; }
+    for (size_t index = 0; index < buffers_.size(); ++index) {
+      if ((cudaMallocHost(&buffers_[index], kBlockSize) != cudaSuccess) ||
+          (cudaEventCreateWithFlags(&events_[index], cudaEventDisableTiming) != cudaSuccess)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @returns a staging block of kBlockSize bytes, waits until its previous upload is done
+  uint8_t* acquire() {
+    if (cudaEventSynchronize(events_[current_]) != cudaSuccess) { return nullptr; }
+    return static_cast<uint8_t*>(buffers_[current_]);
+  }
+
+  /// Start uploading the first size bytes of the block returned by acquire() to dst
+  bool upload(void* dst, size_t size) {
+    if ((cudaMemcpyAsync(dst, buffers_[current_], size, cudaMemcpyHostToDevice, stream_) !=
+         cudaSuccess) ||
+        (cudaEventRecord(events_[current_], stream_) != cudaSuccess)) {
+      return false;
+    }
+    current_ = (current_ + 1) % buffers_.size();
+    return true;
+  }
+
+  /// Wait for all uploads to finish
+  bool finish() { return cudaStreamSynchronize(stream_) == cudaSuccess; }
+
+ private:
+  cudaStream_t stream_ = nullptr;
+  std::array<void*, 2> buffers_{};
+  std::array<cudaEvent_t, 2> events_{};
+  size_t current_ = 0;
+};
+
+/// Copy host memory using several threads, each copying kBlockSize blocks
+void parallel_copy(uint8_t* dst, const uint8_t* src, size_t size) {
+  const size_t blocks = (size + kBlockSize - 1) / kBlockSize;
+  const size_t threads =
+      std::min<size_t>(std::clamp(std::thread::hardware_concurrency(), 1U, kMaxCopyThreads),
+                       blocks);
+  if (threads <= 1) {
+    memcpy(dst, src, size);
+    return;
+  }
+
+  std::atomic<size_t> next_block{0};
+  const auto copy_blocks = [&]() {
+    for (size_t block = next_block++; block < blocks; block = next_block++) {
+      const size_t offset = block * kBlockSize;
+      memcpy(dst + offset, src + offset, std::min(kBlockSize, size - offset));
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t index = 1; index < threads; ++index) { workers.emplace_back(copy_blocks); }
+  copy_blocks();
+  for (auto& worker : workers) { worker.join(); }
+}
+
+}  // namespace
+
+struct VolumeDataReader::Impl {
+  ~Impl() {
+    if (inflate_initialized_) { inflateEnd(&strm_); }
+  }
+
+  bool copy(size_t size);
+  bool inflate(size_t size);
+
+  std::string format_;
+  std::string data_file_name_;
+  std::chrono::steady_clock::time_point start_;
+
+  MappedFile file_;
+  const uint8_t* src_ = nullptr;
+  size_t src_size_ = 0;
+  bool compressed_ = false;
+
+  uint8_t* dst_ = nullptr;
+  size_t data_size_ = 0;
+  size_t out_offset_ = 0;
+
+  DeviceUploader device_uploader_;
+  DeviceUploader* uploader_ = nullptr;
+
+  z_stream strm_{};
+  bool inflate_initialized_ = false;
+  size_t in_offset_ = 0;
+};
+
+bool VolumeDataReader::Impl::copy(size_t size) {
+  if (!uploader_) {
+    parallel_copy(dst_ + out_offset_, src_ + out_offset_, size);
+    return true;
+  }
+
+  // copy the next block from the file while the previous one is uploaded
+  const size_t end = out_offset_ + size;
+  for (size_t offset = out_offset_; offset < end; offset += kBlockSize) {
+    const size_t block_size = std::min(kBlockSize, end - offset);
+    uint8_t* staging = uploader_->acquire();
+    if (!staging) {
+      holoscan::log_error("{} failed to copy {} to GPU memory", format_, data_file_name_);
+      return false;
+    }
+    parallel_copy(staging, src_ + offset, block_size);
+    if (!uploader_->upload(dst_ + offset, block_size)) {
+      holoscan::log_error("{} failed to copy {} to GPU memory", format_, data_file_name_);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool VolumeDataReader::Impl::inflate(size_t size) {
+  if (!inflate_initialized_) {
+    // 32 + MAX_WBITS: detect gzip or zlib headers
+    const int result = inflateInit2(&strm_, 32 + MAX_WBITS);
+    if (result != Z_OK) {
+      holoscan::log_error("{} failed to uncompress {}, inflateInit2 failed with error code {}",
+                          format_,
+                          data_file_name_,
+                          result);
+      return false;
+    }
+    inflate_initialized_ = true;
+  }
+
+  // inflate one block at a time, straight into the tensor or into a staging block which is then
+  // uploaded while the next block is inflated
+  const size_t end = out_offset_ + size;
+  int result = Z_OK;
+  for (size_t offset = out_offset_; offset < end;) {
+    const size_t block_size = std::min(kBlockSize, end - offset);
+    uint8_t* out = uploader_ ? uploader_->acquire() : dst_ + offset;
+    if (!out) {
+      holoscan::log_error("{} failed to copy {} to GPU memory", format_, data_file_name_);
+      return false;
+    }
+    strm_.next_out = out;
+    strm_.avail_out = block_size;
+
+    while ((strm_.avail_out > 0) && (result != Z_STREAM_END)) {
+      if (strm_.avail_in == 0) {
+        // avail_in is 32 bit, feed the mapped file in pieces
+        const size_t in_size = std::min<size_t>(UINT_MAX, src_size_ - in_offset_);
+        if (in_size == 0) { break; }
+        strm_.next_in = const_cast<Bytef*>(src_ + in_offset_);
+        strm_.avail_in = in_size;
+        in_offset_ += in_size;
+      }
+      result = ::inflate(&strm_, Z_NO_FLUSH);
+      if ((result != Z_OK) && (result != Z_STREAM_END)) {
+        holoscan::log_error("{} failed to uncompress {}, inflate failed with error code {}",
+                            format_,
+                            data_file_name_,
+                            result);
+        return false;
+      }
+    }
+
+    const size_t produced = block_size - strm_.avail_out;
+    if (uploader_ && (produced != 0) && !uploader_->upload(dst_ + offset, produced)) {
+      holoscan::log_error("{} failed to copy {} to GPU memory", format_, data_file_name_);
+      return false;
+    }
+    offset += produced;
+    if (produced < block_size) {
+      // the stream ended or the input is exhausted before the volume is complete
+      holoscan::log_error("{} failed to uncompress {}, expected {} bytes but got {}",
+                          format_,
+                          data_file_name_,
+                          data_size_,
+                          offset);
+      return false;
+    }
+  }
+  return true;
+}
+
+VolumeDataReader::VolumeDataReader() : impl_(new Impl) {}
+
+VolumeDataReader::~VolumeDataReader() {}
+
+bool VolumeDataReader::open(const char* format, const std::string& data_file_name,
+                            size_t offset, bool compressed, Volume& volume) {
+  impl_->format_ = format;
+  impl_->data_file_name_ = data_file_name;
+  impl_->start_ = std::chrono::steady_clock::now();
+  impl_->compressed_ = compressed;
+  impl_->data_size_ = volume.tensor_->size();
+  impl_->dst_ = volume.tensor_->pointer();
+
+  if (!impl_->file_.open(data_file_name)) {
+    holoscan::log_error("{} could not open {}", format, data_file_name);
+    return false;
+  }
+  const size_t file_size = impl_->file_.size();
+  if (file_size < offset || (!compressed && (file_size - offset < impl_->data_size_))) {
+    holoscan::log_error("{} data file {} is too small, expected {} bytes at offset {}",
+                        format,
+                        data_file_name,
+                        impl_->data_size_,
+                        offset);
+    return false;
+  }
+  impl_->src_ = impl_->file_.data() + offset;
+  impl_->src_size_ = file_size - offset;
+
+  switch (volume.storage_type_) {
+    case nvidia::gxf::MemoryStorageType::kDevice:
+      if (!impl_->device_uploader_.init()) {
+        holoscan::log_error("{} failed to allocate staging memory", format);
+        return false;
+      }
+      impl_->uploader_ = &impl_->device_uploader_;
+      break;
+    case nvidia::gxf::MemoryStorageType::kHost:
+    case nvidia::gxf::MemoryStorageType::kSystem:
+      break;
+    default:
+      holoscan::log_error("{} unhandled storage type {}", format, int(volume.storage_type_));
+      return false;
+  }
+  return true;
+}
+
+bool VolumeDataReader::read(size_t size) {
+  size = std::min(size, impl_->data_size_ - impl_->out_offset_);
+  if (size == 0) { return true; }
+
+  if (!(impl_->compressed_ ? impl_->inflate(size) : impl_->copy(size))) { return false; }
+  // the data has to be in the tensor when returning
+  if (impl_->uploader_ && !impl_->uploader_->finish()) {
+    holoscan::log_error(
+        "{} failed to copy {} to GPU memory", impl_->format_, impl_->data_file_name_);
+    return false;
+  }
+  impl_->out_offset_ += size;
+
+  if (impl_->out_offset_ == impl_->data_size_) {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - impl_->start_;
+    holoscan::log_info("{} loaded {:.1f} MB from {} in {:.3f} s ({:.1f} MB/s)",
+                       impl_->format_,
+                       impl_->data_size_ / 1e6,
+                       impl_->data_file_name_,
+                       elapsed.count(),
+                       impl_->data_size_ / 1e6 / std::max(elapsed.count(), 1e-9));
+  }
+  return true;
+}
+
+size_t VolumeDataReader::size() const {
+  return impl_->data_size_;
+}
+
+size_t VolumeDataReader::bytes_read() const {
+  return impl_->out_offset_;
+}
+
+bool read_volume_data(const char* format, const std::string& data_file_name, size_t offset,
+                      bool compressed, Volume& volume) {
+  auto reader = std::make_shared<VolumeDataReader>();
+  if (!reader->open(format, data_file_name, offset, compressed, volume)) { return false; }
+
+  // the caller reads the data slab by slab
+  if (volume.stream_data_) {
+    volume.data_reader_ = reader;
+    return true;
+  }
+  return reader->read(reader->size());
+}
+
+}  // namespace holoscan::ops
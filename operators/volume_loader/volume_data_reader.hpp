@@ -0,0 +1,96 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef VOLUME_LOADER_VOLUME_DATA_READER
+#define VOLUME_LOADER_VOLUME_DATA_READER
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace holoscan::ops {
+
+class Volume;
+
+/**
+ * Reads the elements of a volume from a data file straight into the volume tensor, in any number
+ * of steps.
+ *
+ * The data file is memory mapped. Raw data is copied from the mapping to the tensor by several
+ * threads. Compressed data is inflated block by block straight into the tensor, the compressed
+ * data is never read into memory as a whole. Device tensors are filled through pinned staging
+ * blocks which are copied asynchronously while the next block is read or inflated.
+ */
+class VolumeDataReader {
+ public:
+  VolumeDataReader();
+  ~VolumeDataReader();
+
+  /**
+   * Open the data file.
+   *
+   * @param format [in] name of the file format, used for log messages
+   * @param data_file_name [in] name of the data file
+   * @param offset [in] offset of the data in the data file in bytes
+   * @param compressed [in] true if the data is gzip or zlib compressed
+   * @param volume [in] volume with allocated tensor, its size is the number of bytes to read
+   *
+   * @returns false on failure, the error has been logged
+   */
+  bool open(const char* format, const std::string& data_file_name, size_t offset,
+            bool compressed, Volume& volume);
+
+  /**
+   * Read the next bytes into the tensor. The data is in the tensor when the function returns.
+   *
+   * @param size [in] number of bytes to read, clamped to the bytes left
+   *
+   * @returns false on failure, the error has been logged
+   */
+  bool read(size_t size);
+
+  /// @returns the number of bytes of the volume
+  size_t size() const;
+  /// @returns the number of bytes read so far
+  size_t bytes_read() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * Read the elements of a volume from a data file straight into the volume tensor using a
+ * VolumeDataReader. The tensor must already be allocated, its size is the number of bytes read.
+ *
+ * If `stream_data_` of the volume is set, the data is not read, instead the opened reader is
+ * stored in `data_reader_` of the volume and the caller reads the data in steps.
+ *
+ * @param format [in] name of the file format, used for log messages
+ * @param data_file_name [in] name of the data file
+ * @param offset [in] offset of the data in the data file in bytes
+ * @param compressed [in] true if the data is gzip or zlib compressed
+ * @param volume [in] volume with allocated tensor
+ *
+ * @returns false on failure, the error has been logged
+ */
+bool read_volume_data(const char* format, const std::string& data_file_name, size_t offset,
+                      bool compressed, Volume& volume);
+
+}  // namespace holoscan::ops
+
+#endif /* VOLUME_LOADER_VOLUME_DATA_READER */
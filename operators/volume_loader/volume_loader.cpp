@@ -16,18 +16,70 @@
  */
 #include "volume_loader.hpp"
 
+#include "dicom_loader.hpp"
 #include "mhd_loader.hpp"
 #include "nifti_loader.hpp"
 #include "nrrd_loader.hpp"
 #include "volume.hpp"
+#include "volume_cache.hpp"
+#include "volume_data_reader.hpp"
 
 namespace holoscan::ops {
 
+namespace {
+
+bool load_volume(const std::string& file_name, Volume& volume) {
+  if (is_nifty(file_name)) {
+    if (load_nifty(file_name, volume)) { return true; }
+    holoscan::log_error("Failed to load nifty file {}", file_name);
+  } else if (is_mhd(file_name)) {
+    if (load_mhd(file_name, volume)) { return true; }
+    holoscan::log_error("Failed to load mhd file {}", file_name);
+  } else if (is_nrrd(file_name)) {
+    if (load_nrrd(file_name, volume)) { return true; }
+    holoscan::log_error("Failed to load nrrd file {}", file_name);
+  } else if (is_dicom(file_name)) {
+    if (load_dicom(file_name, volume)) { return true; }
+    holoscan::log_error("Failed to load DICOM series {}", file_name);
+  } else {
+    holoscan::log_error("File is not a supported volume format {}", file_name);
+  }
+  return false;
+}
+
+/// Files read to load a volume, see VolumeCache::key()
+std::vector<std::string> volume_files(const std::string& file_name) {
+  if (is_mhd(file_name)) { return mhd_files(file_name); }
+  if (is_nrrd(file_name)) { return nrrd_files(file_name); }
+  if (is_dicom(file_name)) { return dicom_files(file_name); }
+  return {file_name};
+}
+
+}  // namespace
+
 void VolumeLoaderOp::initialize() {
+  // streaming a volume takes several calls of compute(), this condition is disabled once the
+  // last slab had been emitted
+  streaming_condition_ =
+      fragment()->make_condition<BooleanCondition>(name() + "_streaming_condition");
+  add_arg(streaming_condition_);
+
   // call base class
   Operator::initialize();
 }
 
+void VolumeLoaderOp::start() {
+  // the condition was disabled when the last run finished streaming, load the file again
+  streaming_condition_->enable_tick();
+  VolumeCache::get().add_user(size_t(cache_size_mb_.get()) * 1024 * 1024);
+}
+
+void VolumeLoaderOp::stop() {
+  streaming_volume_.reset();
+  streaming_entity_ = gxf::Entity();
+  VolumeCache::get().remove_user();
+}
+
 void VolumeLoaderOp::setup(OperatorSpec& spec) {
   // only add the file_name input port if no file name had been set as parameter
   bool has_file_name_set = false;
@@ -40,6 +92,23 @@ void VolumeLoaderOp::setup(OperatorSpec& spec) {
 
   spec.param(file_name_, "file_name", "FileName", "Volume data file name", {});
   spec.param(allocator_, "allocator", "Allocator", "Allocator used to allocate the volume data");
+  spec.param(slab_size_,
+             "slab_size",
+             "SlabSize",
+             "If not zero, stream the volume, emitting it each time this many more slices are "
+             "loaded. Only supported with the file_name parameter and MHD or NRRD files.",
+             0U);
+  spec.param(cache_size_mb_,
+             "cache_size_mb",
+             "CacheSizeMB",
+             "Memory budget in MB of the volume cache shared by all volume loaders, loading a "
+             "cached volume again hands out the cached tensor. 0 disables the cache.",
+             0U);
+  spec.param(disk_cache_path_,
+             "disk_cache_path",
+             "DiskCachePath",
+             "If set, decoded volumes are also cached in this directory.",
+             std::string());
 
   spec.output<holoscan::gxf::Entity>("volume");
   spec.output<std::array<float, 3>>("spacing").condition(ConditionType::kNone);
@@ -49,12 +118,19 @@ void VolumeLoaderOp::setup(OperatorSpec& spec) {
   spec.output<std::array<double, 3>>("space_origin").condition(ConditionType::kNone);
   spec.output<std::vector<std::array<double, 3>>>("space_directions")
       .condition(ConditionType::kNone);
+  spec.output<float>("progress").condition(ConditionType::kNone);
 }
 
 void VolumeLoaderOp::compute(InputContext& input, OutputContext& output,
                              ExecutionContext& context) {
   if (!allocator_.get()) { throw std::runtime_error("No allocator set."); }
 
+  // continue streaming the current volume
+  if (streaming_volume_) {
+    emit_next_slab(output);
+    return;
+  }
+
   std::string file_name = file_name_.get();
 
   // if no file name had been set by a parameter use the file name received at the input
@@ -70,7 +146,10 @@ void VolumeLoaderOp::compute(InputContext& input, OutputContext& output,
 
   auto entity = gxf::Entity::New(&context);
 
-  Volume volume;
+  auto volume_ptr = std::make_shared<Volume>();
+  Volume& volume = *volume_ptr;
+  // streaming needs compute() to be called again without a new input message
+  volume.stream_data_ = (slab_size_.get() != 0) && !file_name_.get().empty();
 
   // get Handle to underlying nvidia::gxf::Allocator from std::shared_ptr<holoscan::Allocator>
   volume.allocator_ = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
@@ -80,22 +159,80 @@ void VolumeLoaderOp::compute(InputContext& input, OutputContext& output,
   volume.tensor_ =
       static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Tensor>("volume").value();
 
-  if (is_nifty(file_name)) {
-    if (!load_nifty(file_name, volume)) {
-      holoscan::log_error("Failed to load nifty file {}", file_name);
+  const bool use_cache = (cache_size_mb_.get() != 0) || !disk_cache_path_.get().empty();
+  const std::string cache_key =
+      use_cache ? VolumeCache::key(volume_files(file_name), volume.storage_type_) : std::string();
+
+  bool loaded = false;
+  bool store_to_disk = !disk_cache_path_.get().empty();
+  if (!cache_key.empty()) {
+    if (VolumeCache::get().lookup(cache_key, volume)) {
+      // cached volumes are complete, no need to stream
+      if (volume.stream_data_) { streaming_condition_->disable_tick(); }
+      emit_volume(output, entity, volume, 1.f);
+      return;
     }
-  } else if (is_mhd(file_name)) {
-    if (!load_mhd(file_name, volume)) {
-      holoscan::log_error("Failed to load mhd file {}", file_name);
+    if (store_to_disk && VolumeCache::load_from_disk(disk_cache_path_.get(), cache_key, volume)) {
+      loaded = true;
+      store_to_disk = false;
     }
-  } else if (is_nrrd(file_name)) {
-    if (!load_nrrd(file_name, volume)) {
-      holoscan::log_error("Failed to load nrrd file {}", file_name);
+  }
+
+  if (!loaded) { loaded = load_volume(file_name, volume); }
+
+  if (volume.data_reader_) {
+    streaming_volume_ = volume_ptr;
+    streaming_entity_ = entity;
+    streaming_cache_key_ = loaded ? cache_key : std::string();
+    streaming_store_to_disk_ = store_to_disk;
+    emit_next_slab(output);
+    return;
+  }
+
+  if (loaded && !cache_key.empty()) { cache_volume(cache_key, entity, volume, store_to_disk); }
+
+  // the format does not support streaming, the volume had been loaded in one go
+  if (volume.stream_data_) { streaming_condition_->disable_tick(); }
+  emit_volume(output, entity, volume, 1.f);
+}
+
+void VolumeLoaderOp::cache_volume(const std::string& key, gxf::Entity& entity,
+                                  const Volume& volume, bool store_to_disk) {
+  if (store_to_disk) { VolumeCache::store_to_disk(disk_cache_path_.get(), key, volume); }
+  if (cache_size_mb_.get() != 0) { VolumeCache::get().insert(key, entity, volume); }
+}
+
+void VolumeLoaderOp::emit_next_slab(OutputContext& output) {
+  auto& reader = *streaming_volume_->data_reader_;
+  const size_t slices = streaming_volume_->tensor_->shape().dimension(0);
+  const size_t slice_size = (slices != 0) ? reader.size() / slices : reader.size();
+
+  bool done = true;
+  if (reader.read(slab_size_.get() * slice_size)) {
+    done = (reader.bytes_read() == reader.size());
+    if (done && !streaming_cache_key_.empty()) {
+      cache_volume(
+          streaming_cache_key_, streaming_entity_, *streaming_volume_, streaming_store_to_disk_);
     }
+    emit_volume(output,
+                streaming_entity_,
+                *streaming_volume_,
+                float(reader.bytes_read()) / std::max<size_t>(reader.size(), 1));
   } else {
-    holoscan::log_error("File is not a supported volume format {}", file_name);
+    holoscan::log_error("VolumeLoaderOp: Failed to stream volume, {} of {} bytes loaded",
+                        reader.bytes_read(),
+                        reader.size());
+  }
+
+  if (done) {
+    streaming_volume_.reset();
+    streaming_entity_ = gxf::Entity();
+    streaming_condition_->disable_tick();
   }
+}
 
+void VolumeLoaderOp::emit_volume(OutputContext& output, gxf::Entity& entity,
+                                 const Volume& volume, float progress) {
   output.emit(entity, "volume");
   output.emit(volume.spacing_, "spacing");
   output.emit(volume.permute_axis_, "permute_axis");
@@ -110,6 +247,7 @@ void VolumeLoaderOp::compute(InputContext& input, OutputContext& output,
                 volume.spacing_[volume.permute_axis_[i]];
   }
   output.emit(extent, "extent");
+  output.emit(progress, "progress");
 }
 
 }  // namespace holoscan::ops
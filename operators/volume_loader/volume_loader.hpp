@@ -20,19 +20,46 @@
 
 #include <holoscan/holoscan.hpp>
 
+#include <memory>
+#include <string>
+
 namespace holoscan::ops {
 
+class Volume;
+
 class VolumeLoaderOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(VolumeLoaderOp);
 
   void initialize() override;
   void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
 
  private:
+  /// read the next slab of the volume being streamed and emit it
+  void emit_next_slab(OutputContext& output);
+  void emit_volume(OutputContext& output, gxf::Entity& entity, const Volume& volume,
+                   float progress);
+  /// add a loaded volume to the memory cache and optionally to the disk cache
+  void cache_volume(const std::string& key, gxf::Entity& entity, const Volume& volume,
+                    bool store_to_disk);
+
   Parameter<std::string> file_name_;
   Parameter<std::shared_ptr<Allocator>> allocator_;
+  Parameter<uint32_t> slab_size_;
+  Parameter<uint32_t> cache_size_mb_;
+  Parameter<std::string> disk_cache_path_;
+
+  /// keeps the operator scheduled while a volume is streamed
+  std::shared_ptr<BooleanCondition> streaming_condition_;
+  /// volume being streamed and the entity holding its tensor
+  std::shared_ptr<Volume> streaming_volume_;
+  gxf::Entity streaming_entity_;
+  /// cache key of the volume being streamed, cached once complete
+  std::string streaming_cache_key_;
+  bool streaming_store_to_disk_ = false;
 };
 
 }  // namespace holoscan::ops